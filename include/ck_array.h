@@ -31,6 +31,7 @@
 #include <ck_cc.h>
 #include <ck_malloc.h>
 #include <ck_pr.h>
+#include <ck_stack.h>
 #include <ck_stdbool.h>
 #include <ck_stddef.h>
 
@@ -45,16 +46,55 @@ struct ck_array {
 	struct _ck_array *active;
 	unsigned int n_entries;
 	struct _ck_array *transaction;
+	unsigned int mode;
+	unsigned int combiner;
+	ck_stack_t records;
 };
 typedef struct ck_array ck_array_t;
 
+/*
+ * In CK_ARRAY_MODE_MPMC, every writer owns a record into which it stages
+ * operations. Staged operations are published on ck_array_record_commit
+ * and whichever committing writer acquires the combiner applies all
+ * published logs in a single copy of the array. Staging fails once the
+ * log holds CK_ARRAY_LOG operations, at which point it must be committed.
+ * ck_array_record_commit returns false if a removed value was not found,
+ * or if the array could not be grown. In the latter case, none of the
+ * operations were applied and they remain staged, so the commit may be
+ * retried.
+ * Records are never unregistered and must remain valid for the lifetime
+ * of the array. ck_array_put, ck_array_remove and ck_array_commit are
+ * only available in CK_ARRAY_MODE_SPMC.
+ */
+#ifndef CK_ARRAY_LOG
+#define CK_ARRAY_LOG 32
+#endif
+
+#define CK_ARRAY_OPERATION_PUT		0U
+#define CK_ARRAY_OPERATION_REMOVE	1U
+
+struct ck_array_operation {
+	void *value;
+	unsigned int type;
+};
+
+struct ck_array_record {
+	ck_stack_entry_t record_next;
+	unsigned int n_staged;
+	unsigned int n_pending;
+	unsigned int n_combined;
+	unsigned int n_failed;
+	struct ck_array_operation log[CK_ARRAY_LOG];
+};
+typedef struct ck_array_record ck_array_record_t;
+
 struct ck_array_iterator {
 	struct _ck_array *snapshot;
 };
 typedef struct ck_array_iterator ck_array_iterator_t;
 
 #define CK_ARRAY_MODE_SPMC 0U
-#define CK_ARRAY_MODE_MPMC (void) /* Unsupported. */
+#define CK_ARRAY_MODE_MPMC 1U
 
 bool ck_array_init(ck_array_t *, unsigned int, struct ck_malloc *, unsigned int);
 bool ck_array_commit(ck_array_t *);
@@ -63,6 +103,11 @@ int ck_array_put_unique(ck_array_t *, void *);
 bool ck_array_remove(ck_array_t *, void *);
 void ck_array_deinit(ck_array_t *, bool);
 
+void ck_array_register(ck_array_t *, ck_array_record_t *);
+bool ck_array_record_commit(ck_array_t *, ck_array_record_t *);
+bool ck_array_record_put(ck_array_t *, ck_array_record_t *, void *);
+bool ck_array_record_remove(ck_array_t *, ck_array_record_t *, void *);
+
 CK_CC_INLINE static unsigned int
 ck_array_length(struct ck_array *array)
 {
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_ART_H
+#define CK_ART_H
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+/*
+ * An adaptive radix tree mapping byte-string keys to entries. Inner nodes
+ * hold 4, 16, 48 or 256 children and are path compressed. Readers are
+ * lock-free and never write to shared memory, while a single writer at a
+ * time may modify the tree. Nodes are never modified in a way a reader
+ * could observe half-done; a node that must change shape is copied and
+ * the copy is published in its place.
+ *
+ * A reader that loaded the old node before the copy was published keeps
+ * descending through it, and a removed leaf may still be compared against
+ * a key. Replaced nodes and removed leaves are released through the
+ * allocator with the defer flag set, and must stay intact until every
+ * lookup that could have reached them has returned. Iterators resume from
+ * the key of the leaf they last returned, so the same holds for the whole
+ * iteration. With ck_epoch, the allocator retires them with ck_epoch_call
+ * and each lookup or iteration runs in one epoch section.
+ *
+ * Keys are ordered bytewise, with a key ordering before every longer key
+ * it is a prefix of. Keys may be prefixes of other keys.
+ */
+struct ck_art {
+	struct ck_malloc *m;
+	void *root;
+	unsigned int n_entries;
+};
+typedef struct ck_art ck_art_t;
+
+/*
+ * An iterator returns entries in key order, starting at a lower bound and
+ * optionally stopping at the first key that does not begin with a prefix.
+ * The memory of the lower bound and prefix must remain valid for the
+ * lifetime of the iterator. An iterator refers to the last leaf it
+ * returned, so it must not be used across sections.
+ */
+struct ck_art_iterator {
+	const void *key;
+	unsigned int length;
+	bool inclusive;
+	const void *prefix;
+	unsigned int prefix_length;
+};
+typedef struct ck_art_iterator ck_art_iterator_t;
+
+#define CK_ART_ITERATOR_INITIALIZER { NULL, 0, true, NULL, 0 }
+
+/*
+ * Integer keys are stored big-endian, so that key order matches numeric
+ * order and integers sharing high bits share a path.
+ */
+CK_CC_INLINE static void
+ck_art_key_64(unsigned char *key, uint64_t value)
+{
+	unsigned int i;
+
+	for (i = 0; i < 8; i++)
+		key[i] = (unsigned char)(value >> (56 - i * 8));
+
+	return;
+}
+
+CK_CC_INLINE static void
+ck_art_key_32(unsigned char *key, uint32_t value)
+{
+	unsigned int i;
+
+	for (i = 0; i < 4; i++)
+		key[i] = (unsigned char)(value >> (24 - i * 8));
+
+	return;
+}
+
+bool ck_art_init(ck_art_t *, struct ck_malloc *);
+void ck_art_destroy(ck_art_t *);
+void *ck_art_get(ck_art_t *, const void *, unsigned int);
+bool ck_art_put(ck_art_t *, const void *, unsigned int, const void *);
+bool ck_art_set(ck_art_t *, const void *, unsigned int, const void *, void **);
+void *ck_art_remove(ck_art_t *, const void *, unsigned int);
+unsigned int ck_art_count(ck_art_t *);
+void ck_art_iterator_init(ck_art_iterator_t *);
+void ck_art_lower_bound(ck_art_t *, ck_art_iterator_t *, const void *,
+    unsigned int);
+void ck_art_prefix(ck_art_t *, ck_art_iterator_t *, const void *,
+    unsigned int);
+bool ck_art_next(ck_art_t *, ck_art_iterator_t *, void **);
+
+#endif /* CK_ART_H */
@@ -29,6 +29,8 @@
 
 #include <ck_cc.h>
 #include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
 
 #ifndef CK_BACKOFF_CEILING
 #define CK_BACKOFF_CEILING ((1 << 20) - 1)
@@ -54,4 +56,150 @@ ck_backoff_eb(unsigned int *c)
 	return;
 }
 
+/*
+ * Adaptive back-off calibrated to wall-clock time.
+ *
+ * Delays are expressed in nanoseconds and converted to a number of
+ * ck_pr_stall operations using a scale measured by ck_backoff_ns_calibrate,
+ * which should be called once at start-up. Until then, a conservative
+ * default scale is used.
+ *
+ * Every wait is drawn uniformly from the upper half of the current delay
+ * so that contending threads do not retry in lock-step. The delay doubles
+ * after every wait up to a ceiling that is learned per call site: a
+ * ck_backoff_site records the delays at which operations at that site
+ * eventually succeeded and moves its ceiling towards twice that value.
+ * Sites are updated without synchronization, as they are only a hint.
+ *
+ * A CAS loop would typically be written as:
+ *
+ *	static struct ck_backoff_site site = CK_BACKOFF_SITE_INITIALIZER;
+ *	struct ck_backoff_ns backoff;
+ *
+ *	ck_backoff_ns_init(&backoff, &site);
+ *	while (ck_pr_cas_uint(&target, snapshot, update) == false) {
+ *		ck_backoff_ns(&backoff);
+ *		...
+ *	}
+ *	ck_backoff_ns_done(&backoff, &site);
+ */
+#ifndef CK_BACKOFF_NS_MIN
+#define CK_BACKOFF_NS_MIN 64U
+#endif
+
+#ifndef CK_BACKOFF_NS_MAX
+#define CK_BACKOFF_NS_MAX (1U << 20)
+#endif
+
+#define CK_BACKOFF_NS_CEILING (1U << 14)
+
+/*
+ * The scale is the number of ck_pr_stall operations per 1024 nanoseconds.
+ */
+#define CK_BACKOFF_NS_SCALE_SHIFT 10
+#define CK_BACKOFF_NS_SCALE_DEFAULT 64U
+
+extern unsigned int ck_backoff_ns_scale;
+
+/*
+ * Measures the duration of ck_pr_stall and updates ck_backoff_ns_scale.
+ * Returns false if no monotonic clock is available.
+ */
+bool ck_backoff_ns_calibrate(void);
+
+struct ck_backoff_site {
+	unsigned int ceiling;
+};
+typedef struct ck_backoff_site ck_backoff_site_t;
+
+#define CK_BACKOFF_SITE_INITIALIZER { CK_BACKOFF_NS_CEILING }
+
+struct ck_backoff_ns {
+	unsigned int delay;
+	unsigned int ceiling;
+	unsigned int seed;
+	unsigned int rounds;
+};
+typedef struct ck_backoff_ns ck_backoff_ns_t;
+
+CK_CC_INLINE static void
+ck_backoff_site_init(struct ck_backoff_site *site)
+{
+
+	site->ceiling = CK_BACKOFF_NS_CEILING;
+	return;
+}
+
+CK_CC_INLINE static void
+ck_backoff_ns_init(struct ck_backoff_ns *b, const struct ck_backoff_site *site)
+{
+
+	b->delay = CK_BACKOFF_NS_MIN;
+	b->ceiling = ck_pr_load_uint(&site->ceiling);
+	b->seed = (unsigned int)((uintptr_t)b >> 4) * 2654435761U;
+	b->rounds = 0;
+	return;
+}
+
+CK_CC_INLINE static void
+ck_backoff_ns(struct ck_backoff_ns *b)
+{
+	unsigned int delay, jitter, i, n;
+
+	/* xorshift32 */
+	b->seed ^= b->seed << 13;
+	b->seed ^= b->seed >> 17;
+	b->seed ^= b->seed << 5;
+
+	delay = b->delay;
+	jitter = b->seed % ((delay >> 1) + 1);
+	delay = (delay >> 1) + jitter;
+
+	n = (unsigned int)(((unsigned long long)delay *
+	    ck_pr_load_uint(&ck_backoff_ns_scale)) >> CK_BACKOFF_NS_SCALE_SHIFT);
+	for (i = 0; i < n; i++)
+		ck_pr_stall();
+
+	if (b->delay < b->ceiling) {
+		b->delay <<= 1;
+		if (b->delay > b->ceiling)
+			b->delay = b->ceiling;
+	}
+
+	b->rounds++;
+	return;
+}
+
+/*
+ * Reports a successful operation to its site. Operations that succeeded
+ * without backing off do not write to the site.
+ */
+CK_CC_INLINE static void
+ck_backoff_ns_done(const struct ck_backoff_ns *b, struct ck_backoff_site *site)
+{
+	unsigned int ceiling, target;
+
+	if (b->rounds == 0)
+		return;
+
+	/*
+	 * The delay has already been doubled past the last wait, unless it
+	 * reached the ceiling. Success at the ceiling suggests that the
+	 * ceiling is too low.
+	 */
+	target = b->delay;
+	if (target >= b->ceiling)
+		target = b->ceiling << 1;
+
+	ceiling = ck_pr_load_uint(&site->ceiling);
+	ceiling = ceiling - (ceiling >> 3) + (target >> 3);
+	if (ceiling < CK_BACKOFF_NS_MIN)
+		ceiling = CK_BACKOFF_NS_MIN;
+	else if (ceiling > CK_BACKOFF_NS_MAX)
+		ceiling = CK_BACKOFF_NS_MAX;
+
+	ck_pr_store_uint(&site->ceiling, ceiling);
+	return;
+}
+
 #endif /* CK_BACKOFF_H */
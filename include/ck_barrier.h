@@ -29,6 +29,10 @@
 #define CK_BARRIER_H
 
 #include <ck_spinlock.h>
+#include <ck_stdint.h>
+
+/* Defined in ck_barrier_reduce.h. */
+struct ck_barrier_reduce;
 
 struct ck_barrier_centralized {
 	unsigned int value;
@@ -51,6 +55,8 @@ struct ck_barrier_combining_group {
 	unsigned int k;
 	unsigned int count;
 	unsigned int sense;
+	uint64_t value;
+	uint64_t result;
 	struct ck_barrier_combining_group *parent;
 	struct ck_barrier_combining_group *left;
 	struct ck_barrier_combining_group *right;
@@ -68,6 +74,7 @@ typedef struct ck_barrier_combining_state ck_barrier_combining_state_t;
 struct ck_barrier_combining {
 	struct ck_barrier_combining_group *root;
 	ck_spinlock_fas_t mutex;
+	const struct ck_barrier_reduce *reduce;
 };
 typedef struct ck_barrier_combining ck_barrier_combining_t;
 
@@ -116,6 +123,7 @@ struct ck_barrier_tournament_round {
 	int role;
 	unsigned int *opponent;
 	unsigned int flag;
+	uint64_t value;
 };
 typedef struct ck_barrier_tournament_round ck_barrier_tournament_round_t;
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_BARRIER_ADAPTIVE_H
+#define CK_BARRIER_ADAPTIVE_H
+
+#include <ck_barrier.h>
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_malloc.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+/*
+ * The adaptive barrier wraps every algorithm of ck_barrier.h, and picks one from
+ * the thread count and the size of the cache (LLC or NUMA) domains.
+ * When threads outnumber the available cores and a ck_ec mode is
+ * provided, waiters sleep on an event count instead of spinning.
+ * Otherwise, the first subscriber periodically measures the latency of
+ * the current algorithm against another candidate, and switches to the
+ * faster one. Every thread must subscribe before any enters the
+ * barrier.
+ */
+enum ck_barrier_adaptive_algorithm {
+	CK_BARRIER_ADAPTIVE_CENTRALIZED = 0,
+	CK_BARRIER_ADAPTIVE_COMBINING,
+	CK_BARRIER_ADAPTIVE_DISSEMINATION,
+	CK_BARRIER_ADAPTIVE_TOURNAMENT,
+	CK_BARRIER_ADAPTIVE_MCS,
+	CK_BARRIER_ADAPTIVE_BLOCKING,
+	CK_BARRIER_ADAPTIVE_AUTO
+};
+
+struct ck_barrier_adaptive_blocking {
+	unsigned int value;
+	struct ck_ec32 generation;
+};
+
+/* Only ever accessed by the first subscriber. */
+struct ck_barrier_adaptive_policy {
+	unsigned int current;
+	unsigned int probe;
+	bool adapt;
+	uint64_t latency[2];
+	uint64_t samples[2];
+} CK_CC_CACHELINE;
+
+struct ck_barrier_adaptive {
+	unsigned int algorithm[2];
+	unsigned int fixed;
+	unsigned int available;
+	unsigned int nthr;
+	unsigned int cluster;
+	unsigned int n_groups;
+	unsigned int tid;
+	struct ck_barrier_centralized centralized;
+	struct ck_barrier_combining combining;
+	struct ck_barrier_combining_group *groups;
+	struct ck_barrier_dissemination *dissemination;
+	struct ck_barrier_dissemination_flag **flags;
+	struct ck_barrier_tournament tournament;
+	struct ck_barrier_tournament_round **rounds;
+	struct ck_barrier_mcs *mcs;
+	struct ck_barrier_adaptive_blocking blocking;
+	const struct ck_ec_mode *mode;
+	struct ck_malloc *allocator;
+	struct ck_barrier_adaptive_policy policy;
+};
+typedef struct ck_barrier_adaptive ck_barrier_adaptive_t;
+
+struct ck_barrier_adaptive_state {
+	unsigned int tid;
+	unsigned int episode;
+	struct ck_barrier_centralized_state centralized;
+	struct ck_barrier_combining_group *group;
+	struct ck_barrier_combining_state combining;
+	struct ck_barrier_dissemination_state dissemination;
+	struct ck_barrier_tournament_state tournament;
+	struct ck_barrier_mcs_state mcs;
+};
+typedef struct ck_barrier_adaptive_state ck_barrier_adaptive_state_t;
+
+/*
+ * n_cpus is the number of cores available to the nthr threads, and
+ * cluster the number of threads sharing a cache domain; either may be
+ * 0 if unknown. mode is a multiple producer ck_ec mode used to block
+ * oversubscribed threads, or NULL to always spin.
+ */
+bool ck_barrier_adaptive_init(ck_barrier_adaptive_t *, struct ck_malloc *,
+    unsigned int nthr, unsigned int n_cpus, unsigned int cluster,
+    const struct ck_ec_mode *mode);
+void ck_barrier_adaptive_destroy(ck_barrier_adaptive_t *);
+void ck_barrier_adaptive_subscribe(ck_barrier_adaptive_t *,
+    ck_barrier_adaptive_state_t *);
+
+/*
+ * Pins the barrier to an algorithm, or resumes adaptation with
+ * CK_BARRIER_ADAPTIVE_AUTO. The change takes effect within two
+ * episodes. Returns false if the algorithm is unavailable.
+ */
+bool ck_barrier_adaptive_set(ck_barrier_adaptive_t *,
+    enum ck_barrier_adaptive_algorithm);
+
+/* Returns the algorithm in use by the most recent episodes. */
+enum ck_barrier_adaptive_algorithm ck_barrier_adaptive_algorithm(
+    const ck_barrier_adaptive_t *);
+
+void ck_barrier_adaptive(ck_barrier_adaptive_t *, ck_barrier_adaptive_state_t *);
+
+#endif /* CK_BARRIER_ADAPTIVE_H */
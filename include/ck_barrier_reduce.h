@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_BARRIER_REDUCE_H
+#define CK_BARRIER_REDUCE_H
+
+#include <ck_barrier.h>
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_stdint.h>
+
+/*
+ * Reductions carried by the combining and tournament barriers. op must
+ * be associative and commutative, and identity its neutral element.
+ */
+typedef uint64_t ck_barrier_reduce_op_t(uint64_t, uint64_t);
+
+struct ck_barrier_reduce {
+	ck_barrier_reduce_op_t *op;
+	uint64_t identity;
+};
+typedef struct ck_barrier_reduce ck_barrier_reduce_t;
+
+CK_CC_INLINE static uint64_t
+ck_barrier_reduce_sum(uint64_t a, uint64_t b)
+{
+
+	return a + b;
+}
+
+CK_CC_INLINE static uint64_t
+ck_barrier_reduce_min(uint64_t a, uint64_t b)
+{
+
+	return a < b ? a : b;
+}
+
+CK_CC_INLINE static uint64_t
+ck_barrier_reduce_max(uint64_t a, uint64_t b)
+{
+
+	return a > b ? a : b;
+}
+
+#define CK_BARRIER_REDUCE_SUM { ck_barrier_reduce_sum, 0 }
+#define CK_BARRIER_REDUCE_MIN { ck_barrier_reduce_min, UINT64_MAX }
+#define CK_BARRIER_REDUCE_MAX { ck_barrier_reduce_max, 0 }
+
+#if defined(CK_F_PR_CAS_64) && defined(CK_F_PR_LOAD_64) && \
+    defined(CK_F_PR_STORE_64)
+#define CK_F_BARRIER_REDUCE
+#endif
+
+#ifdef CK_F_BARRIER_REDUCE
+/*
+ * Sets the reduction of ck_barrier_combining_reduce. Must be called
+ * while no thread is in the barrier; groups initialized later inherit
+ * the reduction.
+ */
+void ck_barrier_combining_reduce_init(ck_barrier_combining_t *,
+    const struct ck_barrier_reduce *);
+
+/*
+ * Same as ck_barrier_combining, but also returns the reduction of
+ * every thread's value for this episode. Each group accumulates the
+ * values of its members, and the last one to arrive carries the result
+ * up the tree; the root's result is handed down on release.
+ */
+uint64_t ck_barrier_combining_reduce(ck_barrier_combining_t *,
+    ck_barrier_combining_group_t *,
+    ck_barrier_combining_state_t *,
+    uint64_t);
+
+/*
+ * Same as ck_barrier_tournament, but also returns the reduction of
+ * every thread's value for this episode. Losers hand their partial
+ * result to their winner, and winners hand the champion's result back
+ * on release. Threads may pass a different reduction every episode, as
+ * long as they all pass the same one.
+ */
+uint64_t ck_barrier_tournament_reduce(ck_barrier_tournament_t *,
+    ck_barrier_tournament_state_t *,
+    uint64_t,
+    const struct ck_barrier_reduce *);
+#endif /* CK_F_BARRIER_REDUCE */
+
+#endif /* CK_BARRIER_REDUCE_H */
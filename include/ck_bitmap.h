@@ -39,23 +39,105 @@
 #include <ck_stddef.h>
 #include <ck_string.h>
 
+/*
+ * The bit map is made of unsigned int blocks by default. Defining
+ * CK_BITMAP_WORD_64 before including this header selects 64-bit blocks
+ * instead, halving the number of atomic operations performed by bulk
+ * operations and iteration. Every translation unit sharing a bitmap must
+ * agree on the block size.
+ */
+#ifdef CK_BITMAP_WORD_64
+#if !defined(CK_F_PR_LOAD_64) || !defined(CK_F_PR_STORE_64) || \
+    !defined(CK_F_PR_AND_64) || !defined(CK_F_PR_OR_64) || \
+    !defined(CK_F_PR_BTS_64) || !defined(CK_F_CC_CTZLL)
+#error "64-bit ck_bitmap blocks are not supported on your platform."
+#endif
+
+#define CK_BITMAP_WORD		uint64_t
+#define CK_BITMAP_ONE		((uint64_t)1)
+#define CK_BITMAP_PR(K)		ck_pr_##K##_64
+#define CK_BITMAP_CTZ(x)	ck_cc_ctzll(x)
+#define CK_BITMAP_POPCOUNT(x)	ck_cc_popcountll(x)
+#else
 #if !defined(CK_F_PR_LOAD_UINT) || !defined(CK_F_PR_STORE_UINT) || \
     !defined(CK_F_PR_AND_UINT) || !defined(CK_F_PR_OR_UINT) || \
     !defined(CK_F_CC_CTZ)
 #error "ck_bitmap is not supported on your platform."
 #endif
 
-#define CK_BITMAP_BLOCK 	(sizeof(unsigned int) * CHAR_BIT)
+#define CK_BITMAP_WORD		unsigned int
+#define CK_BITMAP_ONE		1U
+#define CK_BITMAP_PR(K)		ck_pr_##K##_uint
+#define CK_BITMAP_CTZ(x)	ck_cc_ctz(x)
+#define CK_BITMAP_POPCOUNT(x)	ck_cc_popcount(x)
+#endif /* CK_BITMAP_WORD_64 */
+
+#define CK_BITMAP_BLOCK 	(sizeof(CK_BITMAP_WORD) * CHAR_BIT)
 #define CK_BITMAP_OFFSET(i)	((i) % CK_BITMAP_BLOCK)
-#define CK_BITMAP_BIT(i)	(1U << CK_BITMAP_OFFSET(i))
+#define CK_BITMAP_BIT(i)	(CK_BITMAP_ONE << CK_BITMAP_OFFSET(i))
+#define CK_BITMAP_MASK(n)	((CK_BITMAP_ONE << (n)) - 1)
 #define CK_BITMAP_PTR(x, i)	((x) + ((i) / CK_BITMAP_BLOCK))
 #define CK_BITMAP_BLOCKS(n)	(((n) + CK_BITMAP_BLOCK - 1) / CK_BITMAP_BLOCK)
 
+/*
+ * The *_serial operations are for bitmaps that are not concurrently
+ * modified. They trade the per-block atomic operations for plain loads
+ * and stores, which are vectorized if the target supports SSE2 or AVX2.
+ * Define CK_BITMAP_VECTOR_DISABLE to always use the scalar kernels.
+ */
+#if defined(__GNUC__) && !defined(CK_BITMAP_VECTOR_DISABLE)
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+#define CK_BITMAP_VECTOR		__m256i
+#define CK_BITMAP_VECTOR_LOAD(p)	\
+	_mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define CK_BITMAP_VECTOR_STORE(p, v)	\
+	_mm256_storeu_si256((__m256i *)(void *)(p), (v))
+#define CK_BITMAP_VECTOR_OR(a, b)	_mm256_or_si256((a), (b))
+#define CK_BITMAP_VECTOR_AND(a, b)	_mm256_and_si256((a), (b))
+#define CK_BITMAP_VECTOR_ANDNOT(a, b)	_mm256_andnot_si256((b), (a))
+#define CK_BITMAP_VECTOR_ADD64(a, b)	_mm256_add_epi64((a), (b))
+#define CK_BITMAP_VECTOR_ZERO()		_mm256_setzero_si256()
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+
+#define CK_BITMAP_VECTOR		__m128i
+#define CK_BITMAP_VECTOR_LOAD(p)	\
+	_mm_loadu_si128((const __m128i *)(const void *)(p))
+#define CK_BITMAP_VECTOR_STORE(p, v)	\
+	_mm_storeu_si128((__m128i *)(void *)(p), (v))
+#define CK_BITMAP_VECTOR_OR(a, b)	_mm_or_si128((a), (b))
+#define CK_BITMAP_VECTOR_AND(a, b)	_mm_and_si128((a), (b))
+#define CK_BITMAP_VECTOR_ANDNOT(a, b)	_mm_andnot_si128((b), (a))
+#define CK_BITMAP_VECTOR_ADD64(a, b)	_mm_add_epi64((a), (b))
+#define CK_BITMAP_VECTOR_ZERO()		_mm_setzero_si128()
+#endif
+#endif /* __GNUC__ && !CK_BITMAP_VECTOR_DISABLE */
+
+#define CK_BITMAP_SCALAR_OR(a, b)	((a) | (b))
+#define CK_BITMAP_SCALAR_AND(a, b)	((a) & (b))
+#define CK_BITMAP_SCALAR_ANDNOT(a, b)	((a) & ~(b))
+
+#ifdef CK_BITMAP_VECTOR
+#define CK_BITMAP_VECTOR_BLOCKS					\
+	(sizeof(CK_BITMAP_VECTOR) / sizeof(CK_BITMAP_WORD))
+#define CK_BITMAP_VECTOR_BIN(K, dst, src, n, i)				\
+	for (; (i) + CK_BITMAP_VECTOR_BLOCKS <= (n);			\
+	    (i) += CK_BITMAP_VECTOR_BLOCKS) {				\
+		CK_BITMAP_VECTOR_STORE((dst) + (i),			\
+		    CK_BITMAP_VECTOR_##K(CK_BITMAP_VECTOR_LOAD((dst) + (i)),	\
+		    CK_BITMAP_VECTOR_LOAD((src) + (i))));		\
+	}
+#else
+#define CK_BITMAP_VECTOR_BIN(K, dst, src, n, i)
+#endif /* CK_BITMAP_VECTOR */
+
 #define CK_BITMAP_INSTANCE(n_entries)					\
 	union {								\
 		struct {						\
 			unsigned int n_bits;				\
-			unsigned int map[CK_BITMAP_BLOCKS(n_entries)];	\
+			CK_BITMAP_WORD map[CK_BITMAP_BLOCKS(n_entries)];	\
 		} content;						\
 		struct ck_bitmap bitmap;				\
 	}
@@ -90,6 +172,15 @@
 #define CK_BITMAP_INTERSECTION_NEGATE(a, b) \
 	ck_bitmap_intersection_negate(&(a)->bitmap, &(b)->bitmap)
 
+#define CK_BITMAP_UNION_SERIAL(a, b) \
+	ck_bitmap_union_serial(&(a)->bitmap, &(b)->bitmap)
+
+#define CK_BITMAP_INTERSECTION_SERIAL(a, b) \
+	ck_bitmap_intersection_serial(&(a)->bitmap, &(b)->bitmap)
+
+#define CK_BITMAP_INTERSECTION_NEGATE_SERIAL(a, b) \
+	ck_bitmap_intersection_negate_serial(&(a)->bitmap, &(b)->bitmap)
+
 #define CK_BITMAP_CLEAR(a) \
 	ck_bitmap_clear(&(a)->bitmap)
 
@@ -105,6 +196,12 @@
 #define CK_BITMAP_COUNT_INTERSECT(a, b, c) \
 	ck_bitmap_count_intersect(&(a)->bitmap, b, c)
 
+#define CK_BITMAP_COUNT_SERIAL(a, b) \
+	ck_bitmap_count_serial(&(a)->bitmap, b)
+
+#define CK_BITMAP_COUNT_INTERSECT_SERIAL(a, b, c) \
+	ck_bitmap_count_intersect_serial(&(a)->bitmap, b, c)
+
 #define CK_BITMAP_BITS(a) \
 	ck_bitmap_bits(&(a)->bitmap)
 
@@ -116,12 +213,12 @@
 
 struct ck_bitmap {
 	unsigned int n_bits;
-	unsigned int map[];
+	CK_BITMAP_WORD map[];
 };
 typedef struct ck_bitmap ck_bitmap_t;
 
 struct ck_bitmap_iterator {
-	unsigned int cache;
+	CK_BITMAP_WORD cache;
 	unsigned int n_block;
 	unsigned int n_limit;
 };
@@ -131,7 +228,7 @@ CK_CC_INLINE static unsigned int
 ck_bitmap_base(unsigned int n_bits)
 {
 
-	return CK_BITMAP_BLOCKS(n_bits) * sizeof(unsigned int);
+	return CK_BITMAP_BLOCKS(n_bits) * sizeof(CK_BITMAP_WORD);
 }
 
 /*
@@ -173,7 +270,7 @@ CK_CC_INLINE static void
 ck_bitmap_set(struct ck_bitmap *bitmap, unsigned int n)
 {
 
-	ck_pr_or_uint(CK_BITMAP_PTR(bitmap->map, n), CK_BITMAP_BIT(n));
+	CK_BITMAP_PR(or)(CK_BITMAP_PTR(bitmap->map, n), CK_BITMAP_BIT(n));
 	return;
 }
 
@@ -187,7 +284,7 @@ CK_CC_INLINE static bool
 ck_bitmap_bts(struct ck_bitmap *bitmap, unsigned int n)
 {
 
-	return ck_pr_bts_uint(CK_BITMAP_PTR(bitmap->map, n),
+	return CK_BITMAP_PR(bts)(CK_BITMAP_PTR(bitmap->map, n),
 	    CK_BITMAP_OFFSET(n));
 }
 
@@ -198,7 +295,7 @@ CK_CC_INLINE static void
 ck_bitmap_reset(struct ck_bitmap *bitmap, unsigned int n)
 {
 
-	ck_pr_and_uint(CK_BITMAP_PTR(bitmap->map, n), ~CK_BITMAP_BIT(n));
+	CK_BITMAP_PR(and)(CK_BITMAP_PTR(bitmap->map, n), ~CK_BITMAP_BIT(n));
 	return;
 }
 
@@ -209,9 +306,9 @@ ck_bitmap_reset(struct ck_bitmap *bitmap, unsigned int n)
 CK_CC_INLINE static bool
 ck_bitmap_test(const struct ck_bitmap *bitmap, unsigned int n)
 {
-	unsigned int block;
+	CK_BITMAP_WORD block;
 
-	block = ck_pr_load_uint(CK_BITMAP_PTR(bitmap->map, n));
+	block = CK_BITMAP_PR(load)(CK_BITMAP_PTR(bitmap->map, n));
 	return block & CK_BITMAP_BIT(n);
 }
 
@@ -230,8 +327,8 @@ ck_bitmap_union(struct ck_bitmap *dst, const struct ck_bitmap *src)
 
 	n_buckets = CK_BITMAP_BLOCKS(n_buckets);
 	for (n = 0; n < n_buckets; n++) {
-		ck_pr_or_uint(&dst->map[n],
-		    ck_pr_load_uint(&src->map[n]));
+		CK_BITMAP_PR(or)(&dst->map[n],
+		    CK_BITMAP_PR(load)(&src->map[n]));
 	}
 
 	return;
@@ -255,12 +352,12 @@ ck_bitmap_intersection(struct ck_bitmap *dst, const struct ck_bitmap *src)
 	n_buckets = CK_BITMAP_BLOCKS(n_buckets);
 	n_intersect = CK_BITMAP_BLOCKS(n_intersect);
 	for (n = 0; n < n_intersect; n++) {
-		ck_pr_and_uint(&dst->map[n],
-		    ck_pr_load_uint(&src->map[n]));
+		CK_BITMAP_PR(and)(&dst->map[n],
+		    CK_BITMAP_PR(load)(&src->map[n]));
 	}
 
 	for (; n < n_buckets; n++)
-		ck_pr_store_uint(&dst->map[n], 0);
+		CK_BITMAP_PR(store)(&dst->map[n], 0);
 
 	return;
 }
@@ -282,8 +379,8 @@ ck_bitmap_intersection_negate(struct ck_bitmap *dst,
 
 	n_intersect = CK_BITMAP_BLOCKS(n_intersect);
 	for (n = 0; n < n_intersect; n++) {
-		ck_pr_and_uint(&dst->map[n],
-		    (~ck_pr_load_uint(&src->map[n])));
+		CK_BITMAP_PR(and)(&dst->map[n],
+		    (~CK_BITMAP_PR(load)(&src->map[n])));
 	}
 
 	return;
@@ -297,11 +394,10 @@ CK_CC_INLINE static void
 ck_bitmap_clear(struct ck_bitmap *bitmap)
 {
 	unsigned int i;
-	unsigned int n_buckets = ck_bitmap_base(bitmap->n_bits) /
-	    sizeof(unsigned int);
+	unsigned int n_buckets = CK_BITMAP_BLOCKS(bitmap->n_bits);
 
 	for (i = 0; i < n_buckets; i++)
-		ck_pr_store_uint(&bitmap->map[i], 0);
+		CK_BITMAP_PR(store)(&bitmap->map[i], 0);
 
 	return;
 }
@@ -322,16 +418,16 @@ ck_bitmap_empty(const ck_bitmap_t *bitmap, unsigned int limit)
 	words = limit / CK_BITMAP_BLOCK;
 	slop = limit % CK_BITMAP_BLOCK;
 	for (i = 0; i < words; i++) {
-		if (ck_pr_load_uint(&bitmap->map[i]) != 0) {
+		if (CK_BITMAP_PR(load)(&bitmap->map[i]) != 0) {
 			return false;
 		}
 	}
 
 	if (slop > 0) {
-		unsigned int word;
+		CK_BITMAP_WORD word;
 
-		word = ck_pr_load_uint(&bitmap->map[i]);
-		if ((word & ((1U << slop) - 1)) != 0)
+		word = CK_BITMAP_PR(load)(&bitmap->map[i]);
+		if ((word & CK_BITMAP_MASK(slop)) != 0)
 			return false;
 	}
 
@@ -354,15 +450,15 @@ ck_bitmap_full(const ck_bitmap_t *bitmap, unsigned int limit)
 	words = limit / CK_BITMAP_BLOCK;
 	slop = limit % CK_BITMAP_BLOCK;
 	for (i = 0; i < words; i++) {
-		if (ck_pr_load_uint(&bitmap->map[i]) != -1U)
+		if (CK_BITMAP_PR(load)(&bitmap->map[i]) != ~(CK_BITMAP_WORD)0)
 			return false;
 	}
 
 	if (slop > 0) {
-		unsigned int word;
+		CK_BITMAP_WORD word;
 
-		word = ~ck_pr_load_uint(&bitmap->map[i]);
-		if ((word & ((1U << slop) - 1)) != 0)
+		word = ~CK_BITMAP_PR(load)(&bitmap->map[i]);
+		if ((word & CK_BITMAP_MASK(slop)) != 0)
 			return false;
 	}
 	return true;
@@ -384,13 +480,13 @@ ck_bitmap_count(const ck_bitmap_t *bitmap, unsigned int limit)
 	words = limit / CK_BITMAP_BLOCK;
 	slop = limit % CK_BITMAP_BLOCK;
 	for (i = 0, count = 0; i < words; i++)
-		count += ck_cc_popcount(ck_pr_load_uint(&bitmap->map[i]));
+		count += CK_BITMAP_POPCOUNT(CK_BITMAP_PR(load)(&bitmap->map[i]));
 
 	if (slop > 0) {
-		unsigned int word;
+		CK_BITMAP_WORD word;
 
-		word = ck_pr_load_uint(&bitmap->map[i]);
-		count += ck_cc_popcount(word & ((1U << slop) - 1));
+		word = CK_BITMAP_PR(load)(&bitmap->map[i]);
+		count += CK_BITMAP_POPCOUNT(word & CK_BITMAP_MASK(slop));
 	}
 	return count;
 }
@@ -415,21 +511,264 @@ ck_bitmap_count_intersect(const ck_bitmap_t *x, const ck_bitmap_t *y,
 	words = limit / CK_BITMAP_BLOCK;
 	slop = limit % CK_BITMAP_BLOCK;
 	for (i = 0, count = 0; i < words; i++) {
-		unsigned int xi, yi;
+		CK_BITMAP_WORD xi, yi;
 
-		xi = ck_pr_load_uint(&x->map[i]);
-		yi = ck_pr_load_uint(&y->map[i]);
-		count += ck_cc_popcount(xi & yi);
+		xi = CK_BITMAP_PR(load)(&x->map[i]);
+		yi = CK_BITMAP_PR(load)(&y->map[i]);
+		count += CK_BITMAP_POPCOUNT(xi & yi);
 	}
 
 	if (slop > 0) {
-		unsigned int word, xi, yi;
+		CK_BITMAP_WORD word, xi, yi;
 
-		xi = ck_pr_load_uint(&x->map[i]);
-		yi = ck_pr_load_uint(&y->map[i]);
+		xi = CK_BITMAP_PR(load)(&x->map[i]);
+		yi = CK_BITMAP_PR(load)(&y->map[i]);
 		word = xi & yi;
-		count += ck_cc_popcount(word & ((1U << slop) - 1));
+		count += CK_BITMAP_POPCOUNT(word & CK_BITMAP_MASK(slop));
+	}
+	return count;
+}
+
+#define CK_BITMAP_SERIAL_BIN(K, O)					\
+CK_CC_INLINE static void						\
+ck_bitmap_serial_##K(CK_BITMAP_WORD *dst, const CK_BITMAP_WORD *src,	\
+    unsigned int n)							\
+{									\
+	unsigned int i = 0;						\
+									\
+	CK_BITMAP_VECTOR_BIN(O, dst, src, n, i)				\
+	for (; i < n; i++)						\
+		dst[i] = CK_BITMAP_SCALAR_##O(dst[i], src[i]);		\
+									\
+	return;								\
+}
+
+CK_BITMAP_SERIAL_BIN(or, OR)
+CK_BITMAP_SERIAL_BIN(and, AND)
+CK_BITMAP_SERIAL_BIN(andnot, ANDNOT)
+
+#undef CK_BITMAP_SERIAL_BIN
+
+#if defined(CK_BITMAP_VECTOR) && defined(__AVX2__)
+/*
+ * Per-nibble table lookup population count, summed into the four
+ * 64-bit lanes of the result.
+ */
+CK_CC_INLINE static __m256i
+ck_bitmap_vector_popcount(__m256i v)
+{
+	const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+	    1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3,
+	    1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i nibble = _mm256_set1_epi8(0x0f);
+	__m256i lo, hi;
+
+	lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+	hi = _mm256_shuffle_epi8(table,
+	    _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+	return _mm256_sad_epu8(_mm256_add_epi8(lo, hi),
+	    _mm256_setzero_si256());
+}
+
+CK_CC_INLINE static unsigned int
+ck_bitmap_vector_sum(__m256i v)
+{
+	uint64_t lane[4];
+
+	_mm256_storeu_si256((__m256i *)(void *)lane, v);
+	return lane[0] + lane[1] + lane[2] + lane[3];
+}
+#elif defined(CK_BITMAP_VECTOR)
+/*
+ * SSE2 has no byte shuffle, so bits are summed within each byte by
+ * halving before the bytes of each 64-bit lane are added.
+ */
+CK_CC_INLINE static __m128i
+ck_bitmap_vector_popcount(__m128i v)
+{
+	const __m128i m1 = _mm_set1_epi8(0x55);
+	const __m128i m2 = _mm_set1_epi8(0x33);
+	const __m128i m4 = _mm_set1_epi8(0x0f);
+
+	v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+	v = _mm_add_epi8(_mm_and_si128(v, m2),
+	    _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+	v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+	return _mm_sad_epu8(v, _mm_setzero_si128());
+}
+
+CK_CC_INLINE static unsigned int
+ck_bitmap_vector_sum(__m128i v)
+{
+	uint64_t lane[2];
+
+	_mm_storeu_si128((__m128i *)(void *)lane, v);
+	return lane[0] + lane[1];
+}
+#endif /* CK_BITMAP_VECTOR */
+
+CK_CC_INLINE static unsigned int
+ck_bitmap_serial_count(const CK_BITMAP_WORD *x, unsigned int n)
+{
+	unsigned int count = 0;
+	unsigned int i = 0;
+
+#ifdef CK_BITMAP_VECTOR
+	if (n >= CK_BITMAP_VECTOR_BLOCKS) {
+		CK_BITMAP_VECTOR acc = CK_BITMAP_VECTOR_ZERO();
+
+		for (; i + CK_BITMAP_VECTOR_BLOCKS <= n;
+		    i += CK_BITMAP_VECTOR_BLOCKS) {
+			acc = CK_BITMAP_VECTOR_ADD64(acc,
+			    ck_bitmap_vector_popcount(
+			    CK_BITMAP_VECTOR_LOAD(x + i)));
+		}
+
+		count = ck_bitmap_vector_sum(acc);
+	}
+#endif
+
+	for (; i < n; i++)
+		count += CK_BITMAP_POPCOUNT(x[i]);
+
+	return count;
+}
+
+CK_CC_INLINE static unsigned int
+ck_bitmap_serial_count_intersect(const CK_BITMAP_WORD *x,
+    const CK_BITMAP_WORD *y, unsigned int n)
+{
+	unsigned int count = 0;
+	unsigned int i = 0;
+
+#ifdef CK_BITMAP_VECTOR
+	if (n >= CK_BITMAP_VECTOR_BLOCKS) {
+		CK_BITMAP_VECTOR acc = CK_BITMAP_VECTOR_ZERO();
+
+		for (; i + CK_BITMAP_VECTOR_BLOCKS <= n;
+		    i += CK_BITMAP_VECTOR_BLOCKS) {
+			acc = CK_BITMAP_VECTOR_ADD64(acc,
+			    ck_bitmap_vector_popcount(CK_BITMAP_VECTOR_AND(
+			    CK_BITMAP_VECTOR_LOAD(x + i),
+			    CK_BITMAP_VECTOR_LOAD(y + i))));
+		}
+
+		count = ck_bitmap_vector_sum(acc);
+	}
+#endif
+
+	for (; i < n; i++)
+		count += CK_BITMAP_POPCOUNT(x[i] & y[i]);
+
+	return count;
+}
+
+/*
+ * Equivalent to ck_bitmap_union for a destination bitmap that is not
+ * concurrently modified and a source that is not concurrently written.
+ */
+CK_CC_INLINE static void
+ck_bitmap_union_serial(struct ck_bitmap *dst, const struct ck_bitmap *src)
+{
+	unsigned int n_buckets = dst->n_bits;
+
+	if (src->n_bits < dst->n_bits)
+		n_buckets = src->n_bits;
+
+	ck_bitmap_serial_or(dst->map, src->map, CK_BITMAP_BLOCKS(n_buckets));
+	return;
+}
+
+/*
+ * Equivalent to ck_bitmap_intersection for a destination bitmap that is
+ * not concurrently modified and a source that is not concurrently
+ * written. Any trailing bit in dst is cleared.
+ */
+CK_CC_INLINE static void
+ck_bitmap_intersection_serial(struct ck_bitmap *dst,
+    const struct ck_bitmap *src)
+{
+	unsigned int n_buckets = CK_BITMAP_BLOCKS(dst->n_bits);
+	unsigned int n_intersect = dst->n_bits;
+
+	if (src->n_bits < n_intersect)
+		n_intersect = src->n_bits;
+
+	n_intersect = CK_BITMAP_BLOCKS(n_intersect);
+	ck_bitmap_serial_and(dst->map, src->map, n_intersect);
+	memset(dst->map + n_intersect, 0,
+	    (n_buckets - n_intersect) * sizeof(CK_BITMAP_WORD));
+	return;
+}
+
+/*
+ * Equivalent to ck_bitmap_intersection_negate for a destination bitmap
+ * that is not concurrently modified and a source that is not concurrently
+ * written. Any trailing bit in dst is left as is.
+ */
+CK_CC_INLINE static void
+ck_bitmap_intersection_negate_serial(struct ck_bitmap *dst,
+    const struct ck_bitmap *src)
+{
+	unsigned int n_intersect = dst->n_bits;
+
+	if (src->n_bits < n_intersect)
+		n_intersect = src->n_bits;
+
+	ck_bitmap_serial_andnot(dst->map, src->map,
+	    CK_BITMAP_BLOCKS(n_intersect));
+	return;
+}
+
+/*
+ * Equivalent to ck_bitmap_count for a bitmap that is not concurrently
+ * written.
+ */
+CK_CC_INLINE static unsigned int
+ck_bitmap_count_serial(const ck_bitmap_t *bitmap, unsigned int limit)
+{
+	unsigned int count, words, slop;
+
+	if (limit > bitmap->n_bits)
+		limit = bitmap->n_bits;
+
+	words = limit / CK_BITMAP_BLOCK;
+	slop = limit % CK_BITMAP_BLOCK;
+	count = ck_bitmap_serial_count(bitmap->map, words);
+	if (slop > 0) {
+		CK_BITMAP_WORD word = bitmap->map[words];
+
+		count += CK_BITMAP_POPCOUNT(word & CK_BITMAP_MASK(slop));
+	}
+
+	return count;
+}
+
+/*
+ * Equivalent to ck_bitmap_count_intersect for bitmaps that are not
+ * concurrently written.
+ */
+CK_CC_INLINE static unsigned int
+ck_bitmap_count_intersect_serial(const ck_bitmap_t *x, const ck_bitmap_t *y,
+    unsigned int limit)
+{
+	unsigned int count, words, slop;
+
+	if (limit > x->n_bits)
+		limit = x->n_bits;
+
+	if (limit > y->n_bits)
+		limit = y->n_bits;
+
+	words = limit / CK_BITMAP_BLOCK;
+	slop = limit % CK_BITMAP_BLOCK;
+	count = ck_bitmap_serial_count_intersect(x->map, y->map, words);
+	if (slop > 0) {
+		CK_BITMAP_WORD word = x->map[words] & y->map[words];
+
+		count += CK_BITMAP_POPCOUNT(word & CK_BITMAP_MASK(slop));
 	}
+
 	return count;
 }
 
@@ -438,7 +777,7 @@ ck_bitmap_count_intersect(const ck_bitmap_t *x, const ck_bitmap_t *y,
  * ck_bitmap_size(n_bits) bytes. Third argument determines whether
  * default bit value is 1 (true) or 0 (false).
  */
-CK_CC_INLINE static void
+CK_CC_FORCE_INLINE static void
 ck_bitmap_init(struct ck_bitmap *bitmap,
 	       unsigned int n_bits,
 	       bool set)
@@ -454,7 +793,7 @@ ck_bitmap_init(struct ck_bitmap *bitmap,
 		if (b == 0)
 			return;
 
-		*CK_BITMAP_PTR(bitmap->map, n_bits - 1) &= (1U << b) - 1U;
+		*CK_BITMAP_PTR(bitmap->map, n_bits - 1) &= CK_BITMAP_MASK(b);
 	}
 
 	return;
@@ -471,7 +810,7 @@ ck_bitmap_iterator_init(struct ck_bitmap_iterator *i,
 	i->n_block = 0;
 	i->n_limit = CK_BITMAP_BLOCKS(bitmap->n_bits);
 	if (i->n_limit > 0) {
-		i->cache = ck_pr_load_uint(&bitmap->map[0]);
+		i->cache = CK_BITMAP_PR(load)(&bitmap->map[0]);
 	} else {
 		i->cache = 0;
 	}
@@ -486,7 +825,7 @@ ck_bitmap_next(const struct ck_bitmap *bitmap,
 	       struct ck_bitmap_iterator *i,
 	       unsigned int *bit)
 {
-	unsigned int cache = i->cache;
+	CK_BITMAP_WORD cache = i->cache;
 	unsigned int n_block = i->n_block;
 	unsigned int n_limit = i->n_limit;
 
@@ -495,7 +834,7 @@ ck_bitmap_next(const struct ck_bitmap *bitmap,
 			return false;
 
 		for (n_block++; n_block < n_limit; n_block++) {
-			cache = ck_pr_load_uint(&bitmap->map[n_block]);
+			cache = CK_BITMAP_PR(load)(&bitmap->map[n_block]);
 			if (cache != 0)
 				goto non_zero;
 		}
@@ -506,7 +845,7 @@ ck_bitmap_next(const struct ck_bitmap *bitmap,
 	}
 
 non_zero:
-	*bit = CK_BITMAP_BLOCK * n_block + ck_cc_ctz(cache);
+	*bit = CK_BITMAP_BLOCK * n_block + CK_BITMAP_CTZ(cache);
 	i->cache = cache & (cache - 1);
 	i->n_block = n_block;
 	return true;
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_BLOOM_H
+#define CK_BLOOM_H
+
+/*
+ * Blocked Bloom filters. Every key is mapped to a single 64-byte block
+ * and all of its probes fall within that block, so that an insertion or
+ * a query touches one cache line. Keys are represented by a 64-bit hash
+ * provided by the caller: the upper half selects the block and the
+ * lower half the bits within it.
+ *
+ * In the default mode, insertions set bits with atomic or operations
+ * and are safe to run concurrently with each other and with queries.
+ * In counting mode, every probe is a saturating 4-bit counter updated
+ * with compare-and-swap, which allows keys to be removed. Removing a key
+ * that was never inserted corrupts the filter.
+ */
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_md.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+#if defined(CK_F_PR_LOAD_64) && defined(CK_F_PR_OR_64) && \
+    defined(CK_F_PR_CAS_64_VALUE)
+#define CK_F_BLOOM
+
+/*
+ * Filters are made of 64-byte blocks of 64-bit words.
+ */
+#define CK_BLOOM_BLOCK		8
+#define CK_BLOOM_PROBES		16
+
+/*
+ * Probes are counters rather than bits, so keys may be removed.
+ */
+#define CK_BLOOM_MODE_COUNTING	1
+
+struct ck_bloom {
+	uint64_t *map;
+	uint32_t n_blocks;
+	unsigned int k;
+	unsigned int mode;
+	struct ck_malloc *m;
+	void *allocation;
+	size_t size;
+};
+typedef struct ck_bloom ck_bloom_t;
+
+bool ck_bloom_init(struct ck_bloom *, unsigned int, struct ck_malloc *,
+    unsigned long, double);
+void ck_bloom_destroy(struct ck_bloom *);
+void ck_bloom_clear(struct ck_bloom *);
+size_t ck_bloom_size(const struct ck_bloom *);
+void ck_bloom_query_n(const struct ck_bloom *, const uint64_t *, bool *,
+    unsigned int);
+
+/*
+ * Multipliers mapping the lower half of the hash to the probes of a key.
+ * The top bits of each product select a bit or counter in the block.
+ */
+static const uint32_t ck_bloom_salt[CK_BLOOM_PROBES] CK_CC_UNUSED = {
+	0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+	0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+	0x2bd8c6a1U, 0x7c3f2b55U, 0xd1b54a33U, 0x3a8f05c5U,
+	0x94d049bbU, 0x6a09e667U, 0xbb67ae85U, 0x510e527fU
+};
+
+CK_CC_INLINE static uint64_t *
+ck_bloom_block(const struct ck_bloom *bloom, uint64_t hash)
+{
+	uint64_t block = ((hash >> 32) * bloom->n_blocks) >> 32;
+
+	return bloom->map + block * CK_BLOOM_BLOCK;
+}
+
+/*
+ * Issues a prefetch for the block that a query of the hash will read.
+ */
+CK_CC_INLINE static void
+ck_bloom_prefetch(const struct ck_bloom *bloom, uint64_t hash)
+{
+
+	ck_cc_prefetch(ck_bloom_block(bloom, hash));
+	return;
+}
+
+/*
+ * Computes the bits of every word of the block that belong to the key.
+ */
+CK_CC_INLINE static void
+ck_bloom_mask(const struct ck_bloom *bloom, uint64_t hash, uint64_t *mask)
+{
+	uint32_t h = (uint32_t)hash;
+	unsigned int i;
+
+	for (i = 0; i < CK_BLOOM_BLOCK; i++)
+		mask[i] = 0;
+
+	for (i = 0; i < bloom->k; i++) {
+		uint32_t bit = (h * ck_bloom_salt[i]) >> 23;
+
+		mask[bit / 64] |= (uint64_t)1 << (bit % 64);
+	}
+
+	return;
+}
+
+/*
+ * Returns the position of the i-th counter of the key in its block.
+ */
+CK_CC_INLINE static unsigned int
+ck_bloom_counter(uint64_t hash, unsigned int i)
+{
+
+	return ((uint32_t)hash * ck_bloom_salt[i]) >> 25;
+}
+
+/*
+ * Adds the key with the specified hash to the filter.
+ */
+CK_CC_INLINE static void
+ck_bloom_insert(struct ck_bloom *bloom, uint64_t hash)
+{
+	uint64_t *block = ck_bloom_block(bloom, hash);
+	unsigned int i;
+
+	if (bloom->mode & CK_BLOOM_MODE_COUNTING) {
+		for (i = 0; i < bloom->k; i++) {
+			unsigned int c = ck_bloom_counter(hash, i);
+			uint64_t *word = &block[c / 16];
+			unsigned int shift = (c % 16) * 4;
+			uint64_t snapshot = ck_pr_load_64(word);
+
+			/* Saturated counters are never modified again. */
+			do {
+				if (((snapshot >> shift) & 15) == 15)
+					break;
+			} while (ck_pr_cas_64_value(word, snapshot,
+			    snapshot + ((uint64_t)1 << shift),
+			    &snapshot) == false);
+		}
+	} else {
+		uint64_t mask[CK_BLOOM_BLOCK];
+
+		ck_bloom_mask(bloom, hash, mask);
+		for (i = 0; i < CK_BLOOM_BLOCK; i++) {
+			/* Avoid invalidating the line if the bits are set. */
+			if (mask[i] != 0 &&
+			    (ck_pr_load_64(&block[i]) & mask[i]) != mask[i])
+				ck_pr_or_64(&block[i], mask[i]);
+		}
+	}
+
+	return;
+}
+
+/*
+ * Returns false if the key with the specified hash was never inserted
+ * and true if it may have been.
+ */
+CK_CC_INLINE static bool
+ck_bloom_query(const struct ck_bloom *bloom, uint64_t hash)
+{
+	const uint64_t *block = ck_bloom_block(bloom, hash);
+	unsigned int i;
+
+	if (bloom->mode & CK_BLOOM_MODE_COUNTING) {
+		for (i = 0; i < bloom->k; i++) {
+			unsigned int c = ck_bloom_counter(hash, i);
+			uint64_t word = ck_pr_load_64(&block[c / 16]);
+
+			if (((word >> ((c % 16) * 4)) & 15) == 0)
+				return false;
+		}
+	} else {
+		uint64_t mask[CK_BLOOM_BLOCK];
+
+		ck_bloom_mask(bloom, hash, mask);
+		for (i = 0; i < CK_BLOOM_BLOCK; i++) {
+			if ((ck_pr_load_64(&block[i]) & mask[i]) != mask[i])
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Removes a previously inserted key from a counting filter. Returns
+ * false if the filter is not counting or if the key was not present,
+ * in which case the counters that were found non-zero have still been
+ * decremented.
+ */
+CK_CC_INLINE static bool
+ck_bloom_remove(struct ck_bloom *bloom, uint64_t hash)
+{
+	uint64_t *block = ck_bloom_block(bloom, hash);
+	bool present = true;
+	unsigned int i;
+
+	if ((bloom->mode & CK_BLOOM_MODE_COUNTING) == 0)
+		return false;
+
+	for (i = 0; i < bloom->k; i++) {
+		unsigned int c = ck_bloom_counter(hash, i);
+		uint64_t *word = &block[c / 16];
+		unsigned int shift = (c % 16) * 4;
+		uint64_t snapshot = ck_pr_load_64(word);
+
+		do {
+			uint64_t counter = (snapshot >> shift) & 15;
+
+			if (counter == 0) {
+				present = false;
+				break;
+			}
+
+			/* The true count of a saturated counter is unknown. */
+			if (counter == 15)
+				break;
+		} while (ck_pr_cas_64_value(word, snapshot,
+		    snapshot - ((uint64_t)1 << shift), &snapshot) == false);
+	}
+
+	return present;
+}
+
+#endif /* CK_F_PR_LOAD_64 && CK_F_PR_OR_64 && CK_F_PR_CAS_64_VALUE */
+#endif /* CK_BLOOM_H */
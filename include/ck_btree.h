@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_BTREE_H
+#define CK_BTREE_H
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_md.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+/*
+ * A B+tree mapping 64-bit keys to values, synchronized with optimistic
+ * lock coupling. Every node carries a sequence counter in the style of
+ * ck_sequence that doubles as a write latch. Readers never write to shared
+ * memory: they record the counter of each node they visit and validate it
+ * after use, retrying on a conflict. Writers latch only the nodes they
+ * modify, so writers in different parts of the tree do not contend.
+ *
+ * Nodes span CK_BTREE_NODE_LINES cache lines, which keeps the keys a
+ * lookup inspects at each level in a few lines if the allocator returns
+ * cache line aligned memory. Leaves are linked for range scans. Leaves
+ * that fall below a quarter full are merged with a sibling. Inner nodes
+ * are never merged, so the height of the tree does not shrink.
+ *
+ * A reader only learns that a node was merged away when it validates the
+ * counter of the node, after it has already read from it. Merged nodes are
+ * therefore marked obsolete and released through the allocator with the
+ * defer flag set, and their memory, counter included, must remain
+ * readable until every reader that may have loaded a pointer to them has
+ * finished. With ck_epoch, the allocator retires them with ck_epoch_call
+ * and each operation runs in an epoch section.
+ */
+#ifndef CK_BTREE_NODE_LINES
+#define CK_BTREE_NODE_LINES 4
+#endif
+
+#define CK_BTREE_NODE_SIZE (CK_MD_CACHELINE * CK_BTREE_NODE_LINES)
+
+struct ck_btree_node;
+struct ck_btree {
+	struct ck_malloc *m;
+	struct ck_btree_node *root;
+};
+typedef struct ck_btree ck_btree_t;
+
+/*
+ * An iterator refers to the leaf it last read from, so it must not be used
+ * across sections.
+ */
+struct ck_btree_iterator {
+	struct ck_btree_node *leaf;
+	unsigned int version;
+	unsigned int index;
+	uint64_t key;
+	bool end;
+};
+typedef struct ck_btree_iterator ck_btree_iterator_t;
+
+#define CK_BTREE_ITERATOR_INITIALIZER { NULL, 0, 0, 0, false }
+
+bool ck_btree_init(ck_btree_t *, struct ck_malloc *);
+void ck_btree_destroy(ck_btree_t *);
+void *ck_btree_get(ck_btree_t *, uint64_t);
+bool ck_btree_put(ck_btree_t *, uint64_t, const void *);
+bool ck_btree_set(ck_btree_t *, uint64_t, const void *, void **);
+void *ck_btree_remove(ck_btree_t *, uint64_t);
+void ck_btree_iterator_init(ck_btree_t *, ck_btree_iterator_t *);
+void ck_btree_lower_bound(ck_btree_t *, ck_btree_iterator_t *, uint64_t);
+bool ck_btree_next(ck_btree_t *, ck_btree_iterator_t *, uint64_t *, void **);
+
+#endif /* CK_BTREE_H */
@@ -165,6 +165,46 @@ ck_cc_popcount(unsigned int x)
 }
 #endif
 
+#ifndef CK_F_CC_PREFETCH
+#define CK_F_CC_PREFETCH
+CK_CC_INLINE static void
+ck_cc_prefetch(const void *p)
+{
+
+	(void)p;
+	return;
+}
+#endif
+
+#ifndef CK_F_CC_CTZLL
+#define CK_F_CC_CTZLL
+CK_CC_INLINE static int
+ck_cc_ctzll(unsigned long long x)
+{
+	unsigned int i;
+
+	if (x == 0)
+		return 0;
+
+	for (i = 0; (x & 1) == 0; i++, x >>= 1);
+	return i;
+}
+#endif
+
+#ifndef CK_F_CC_POPCOUNTLL
+#define CK_F_CC_POPCOUNTLL
+CK_CC_INLINE static int
+ck_cc_popcountll(unsigned long long x)
+{
+	unsigned int acc;
+
+	for (acc = 0; x != 0; x >>= 1)
+		acc += x & 1;
+
+	return acc;
+}
+#endif
+
 
 #ifdef __cplusplus
 #define CK_CPP_CAST(type, arg) static_cast<type>(arg)
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_COUNTER_H
+#define CK_COUNTER_H
+
+/*
+ * Sharded statistical counters. Every updater is assigned a shard, which
+ * occupies its own cache line, so that increments never contend with one
+ * another. A shard that is only ever updated by one thread may use the
+ * non-atomic _local operations, while a shard shared by the threads of
+ * one processor must use the atomic ones.
+ *
+ * Every shard publishes its delta into a global value once it has drifted
+ * by batch from what was last published. ck_counter_read returns that
+ * global value and is off by less than n_shards * batch. ck_counter_sum
+ * adds up every shard and is exact at quiescence.
+ *
+ * Counters may also enforce a limit. Shards then borrow budget from a
+ * global pool in batches and ck_counter_limit_add fails rather than let
+ * the sum exceed the limit. Once the pool runs dry, the budget cached by
+ * every shard is reclaimed before the operation is failed.
+ *
+ * Values are unsigned and wrap, so decrements are additions of the
+ * two's complement of the amount.
+ */
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_md.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+#if defined(CK_F_PR_LOAD_64) && defined(CK_F_PR_STORE_64) && \
+    defined(CK_F_PR_FAA_64) && defined(CK_F_PR_ADD_64) && \
+    defined(CK_F_PR_CAS_64) && defined(CK_F_PR_FAS_64)
+#define CK_F_COUNTER
+
+#define CK_COUNTER_UNLIMITED UINT64_MAX
+
+struct ck_counter_shard {
+	uint64_t value;
+	uint64_t folded;
+	uint64_t budget;
+	char pad[CK_MD_CACHELINE - sizeof(uint64_t) * 3];
+};
+
+struct ck_counter {
+	struct ck_counter_shard *shards;
+	unsigned int n_shards;
+	uint64_t batch;
+	uint64_t limit;
+	struct ck_malloc *m;
+	void *allocation;
+	size_t size;
+	char pad[CK_MD_CACHELINE];
+	uint64_t global;
+	uint64_t pool;
+};
+typedef struct ck_counter ck_counter_t;
+
+bool ck_counter_init(struct ck_counter *, struct ck_malloc *, unsigned int,
+    uint64_t, uint64_t);
+void ck_counter_destroy(struct ck_counter *);
+uint64_t ck_counter_sum(struct ck_counter *);
+bool ck_counter_borrow(struct ck_counter *, unsigned int, uint64_t);
+
+/* Slow paths for ck_counter_{add,add_local,limit_add} */
+void ck_counter_add_local_slow(struct ck_counter *, unsigned int, uint64_t);
+void ck_counter_add_slow(struct ck_counter *, unsigned int, uint64_t,
+    uint64_t);
+bool ck_counter_limit_add_slow(struct ck_counter *, unsigned int, uint64_t);
+
+/*
+ * Whether the wrapped difference between a shard and what it last folded
+ * is at least batch in magnitude, in either direction.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_counter_drifted(const struct ck_counter *counter, uint64_t delta)
+{
+
+	return delta >= counter->batch && -delta >= counter->batch;
+}
+
+/*
+ * Adds delta to a shard that is updated by a single thread.
+ */
+CK_CC_FORCE_INLINE static void
+ck_counter_add_local(struct ck_counter *counter,
+    unsigned int shard,
+    uint64_t delta)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+	uint64_t value = s->value + delta;
+
+	ck_pr_store_64(&s->value, value);
+	if (CK_CC_UNLIKELY(ck_counter_drifted(counter, value - s->folded)))
+		ck_counter_add_local_slow(counter, shard, value);
+
+	return;
+}
+
+/*
+ * Adds delta to a shard that may be updated concurrently, such as one
+ * that belongs to a processor rather than to a thread. The global value
+ * is always the sum of what every shard has folded, even when folds race.
+ */
+CK_CC_FORCE_INLINE static void
+ck_counter_add(struct ck_counter *counter, unsigned int shard, uint64_t delta)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+	uint64_t value = ck_pr_faa_64(&s->value, delta) + delta;
+	uint64_t folded = ck_pr_load_64(&s->folded);
+
+	if (CK_CC_UNLIKELY(ck_counter_drifted(counter, value - folded)))
+		ck_counter_add_slow(counter, shard, value, folded);
+
+	return;
+}
+
+CK_CC_FORCE_INLINE static void
+ck_counter_inc_local(struct ck_counter *counter, unsigned int shard)
+{
+
+	ck_counter_add_local(counter, shard, 1);
+	return;
+}
+
+CK_CC_FORCE_INLINE static void
+ck_counter_inc(struct ck_counter *counter, unsigned int shard)
+{
+
+	ck_counter_add(counter, shard, 1);
+	return;
+}
+
+CK_CC_FORCE_INLINE static void
+ck_counter_dec_local(struct ck_counter *counter, unsigned int shard)
+{
+
+	ck_counter_add_local(counter, shard, (uint64_t)-1);
+	return;
+}
+
+CK_CC_FORCE_INLINE static void
+ck_counter_dec(struct ck_counter *counter, unsigned int shard)
+{
+
+	ck_counter_add(counter, shard, (uint64_t)-1);
+	return;
+}
+
+/*
+ * Returns the approximate value of the counter.
+ */
+CK_CC_INLINE static uint64_t
+ck_counter_read(struct ck_counter *counter)
+{
+
+	return ck_pr_load_64(&counter->global);
+}
+
+/*
+ * Adds delta to a limited counter unless the sum would exceed the limit.
+ * The budget of a shard may be shared by the threads of a processor.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_counter_limit_add(struct ck_counter *counter,
+    unsigned int shard,
+    uint64_t delta)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+	uint64_t budget = ck_pr_load_64(&s->budget);
+
+	if (CK_CC_UNLIKELY(budget < delta) ||
+	    ck_pr_cas_64(&s->budget, budget, budget - delta) == false)
+		return ck_counter_limit_add_slow(counter, shard, delta);
+
+	ck_counter_add(counter, shard, delta);
+	return true;
+}
+
+/*
+ * Returns delta to a limited counter. Budget in excess of twice the batch
+ * is handed back to the global pool.
+ */
+CK_CC_INLINE static void
+ck_counter_limit_sub(struct ck_counter *counter,
+    unsigned int shard,
+    uint64_t delta)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+	uint64_t budget;
+
+	ck_counter_add(counter, shard, -delta);
+	budget = ck_pr_faa_64(&s->budget, delta) + delta;
+
+	if (CK_CC_UNLIKELY(budget > counter->batch * 2) &&
+	    ck_pr_cas_64(&s->budget, budget, counter->batch) == true) {
+		ck_pr_add_64(&counter->pool, budget - counter->batch);
+	}
+
+	return;
+}
+
+#endif /* CK_F_COUNTER */
+#endif /* CK_COUNTER_H */
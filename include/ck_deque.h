@@ -0,0 +1,381 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_DEQUE_H
+#define CK_DEQUE_H
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_md.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_string.h>
+
+/*
+ * A work-stealing deque in the style of Chase and Lev. A single owner
+ * pushes and pops entries at the bottom in LIFO order while any number of
+ * thieves steal from the top in FIFO order. The owner only synchronizes
+ * with thieves when it pops the last entry, thieves contend with each
+ * other through a compare-and-swap on the top counter.
+ *
+ * Entries are stored by value in a circular array that doubles in size
+ * whenever the owner pushes onto a full deque. A thief may still be
+ * reading from an array that has been replaced, so the old array is
+ * released through the allocator with the defer flag set. The allocator
+ * must keep it intact until every steal that may have loaded it has
+ * returned, e.g. by retiring it with ck_epoch_call while thieves steal
+ * within epoch sections. The owner never reads a replaced array, so push
+ * and pop need no such protection. The array never shrinks before
+ * ck_deque_destroy. The array is aligned to CK_MD_CACHELINE, so entries
+ * of any type whose alignment does not exceed a cache line are stored at
+ * their natural alignment.
+ */
+struct ck_deque_array {
+	unsigned int mask;
+	size_t size;
+	void *buffer;
+};
+
+struct ck_deque {
+	unsigned int top;
+	char pad[CK_MD_CACHELINE - sizeof(unsigned int)];
+	unsigned int bottom;
+	unsigned int size;
+	struct ck_deque_array *array;
+	struct ck_malloc *m;
+};
+typedef struct ck_deque ck_deque_t;
+
+/*
+ * Internal functions.
+ */
+bool _ck_deque_init(struct ck_deque *, struct ck_malloc *, unsigned int,
+    unsigned int);
+bool _ck_deque_grow(struct ck_deque *, unsigned int, unsigned int);
+unsigned int _ck_deque_steal_batch(struct ck_deque *, void *, unsigned int,
+    unsigned int);
+
+void ck_deque_destroy(struct ck_deque *);
+
+/*
+ * Returns a snapshot of the number of entries in the deque. The value is
+ * only exact in the absence of concurrent operations.
+ */
+CK_CC_INLINE static unsigned int
+ck_deque_size(const struct ck_deque *deque)
+{
+	unsigned int bottom, top;
+
+	top = ck_pr_load_uint(&deque->top);
+	ck_pr_fence_load();
+	bottom = ck_pr_load_uint(&deque->bottom);
+
+	if ((int)(bottom - top) <= 0)
+		return 0;
+
+	return bottom - top;
+}
+
+/*
+ * Returns the number of entries the deque can hold before it must grow.
+ * This may only be called by the owner.
+ */
+CK_CC_INLINE static unsigned int
+ck_deque_capacity(const struct ck_deque *deque)
+{
+
+	return deque->array->mask + 1;
+}
+
+/*
+ * The _ck_deque_* namespace is internal only and must not used externally.
+ */
+CK_CC_FORCE_INLINE static bool
+_ck_deque_push(struct ck_deque *deque, const void *entry, unsigned int size)
+{
+	struct ck_deque_array *array = deque->array;
+	unsigned int bottom = deque->bottom;
+	unsigned int top;
+
+	/*
+	 * A stale top counter only overestimates the number of entries, in
+	 * which case the array grows early.
+	 */
+	top = ck_pr_load_uint(&deque->top);
+	if (CK_CC_UNLIKELY(bottom - top > array->mask)) {
+		if (_ck_deque_grow(deque, top, bottom) == false)
+			return false;
+
+		array = deque->array;
+	}
+
+	memcpy((char *)array->buffer + size * (bottom & array->mask),
+	    entry, size);
+
+	/* The entry must be visible before thieves may observe it. */
+	ck_pr_fence_store();
+	ck_pr_store_uint(&deque->bottom, bottom + 1);
+	return true;
+}
+
+CK_CC_FORCE_INLINE static bool
+_ck_deque_pop(struct ck_deque *deque, void *data, unsigned int size)
+{
+	struct ck_deque_array *array = deque->array;
+	unsigned int bottom = deque->bottom - 1;
+	unsigned int top;
+	bool r;
+
+	/*
+	 * The entry is reserved by publishing the new bottom counter before
+	 * reading top. Without store-to-load ordering, both the owner and a
+	 * thief could claim the same entry.
+	 */
+	ck_pr_store_uint(&deque->bottom, bottom);
+	ck_pr_fence_store_load();
+	top = ck_pr_load_uint(&deque->top);
+
+	if ((int)(bottom - top) < 0) {
+		ck_pr_store_uint(&deque->bottom, bottom + 1);
+		return false;
+	}
+
+	memcpy(data, (char *)array->buffer + size * (bottom & array->mask),
+	    size);
+	if (bottom != top)
+		return true;
+
+	/* This is the last entry, so race any thieves for it. */
+	r = ck_pr_cas_uint(&deque->top, top, top + 1);
+	ck_pr_store_uint(&deque->bottom, top + 1);
+	return r;
+}
+
+CK_CC_FORCE_INLINE static bool
+_ck_deque_trysteal(struct ck_deque *deque,
+    void *data,
+    unsigned int size,
+    unsigned int *top)
+{
+	struct ck_deque_array *array;
+	unsigned int bottom;
+
+	/*
+	 * The bottom counter must be read after top. On targets that are not
+	 * TSO, this load must be ordered with respect to the owner's store to
+	 * bottom in _ck_deque_pop, which requires a full barrier.
+	 */
+#if defined(CK_MD_TSO)
+	ck_pr_fence_load();
+#else
+	ck_pr_fence_memory();
+#endif
+	bottom = ck_pr_load_uint(&deque->bottom);
+	if ((int)(bottom - *top) <= 0)
+		return false;
+
+	/*
+	 * Any array published after the entry was pushed is a copy that
+	 * includes it.
+	 */
+	ck_pr_fence_load();
+	array = ck_pr_load_ptr(&deque->array);
+	memcpy(data, (char *)array->buffer + size * (*top & array->mask),
+	    size);
+
+	/* Serialize load with respect to top update. */
+	ck_pr_fence_load_atomic();
+	return ck_pr_cas_uint_value(&deque->top, *top, *top + 1, top);
+}
+
+CK_CC_FORCE_INLINE static bool
+_ck_deque_steal(struct ck_deque *deque, void *data, unsigned int size)
+{
+	unsigned int top = ck_pr_load_uint(&deque->top);
+
+	while (_ck_deque_trysteal(deque, data, size, &top) == false) {
+		unsigned int bottom;
+
+		/*
+		 * A failed compare-and-swap has refreshed our snapshot of
+		 * top. Only give up once the deque is observed empty.
+		 */
+		ck_pr_fence_load();
+		bottom = ck_pr_load_uint(&deque->bottom);
+		if ((int)(bottom - top) <= 0)
+			return false;
+
+		ck_pr_stall();
+	}
+
+	return true;
+}
+
+/*
+ * The ck_deque_* namespace is the public interface for a deque of pointers.
+ * Only the owner may call ck_deque_push and ck_deque_pop. The steal
+ * functions may be called by any number of threads concurrently with the
+ * owner.
+ */
+CK_CC_INLINE static bool
+ck_deque_init(struct ck_deque *deque,
+    struct ck_malloc *m,
+    unsigned int capacity)
+{
+
+	return _ck_deque_init(deque, m, capacity, sizeof(void *));
+}
+
+/*
+ * Returns false if the deque is full and a larger array could not be
+ * allocated.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_deque_push(struct ck_deque *deque, const void *entry)
+{
+
+	return _ck_deque_push(deque, &entry, sizeof(entry));
+}
+
+/*
+ * Returns false if the deque is empty or if the last entry was stolen
+ * concurrently.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_deque_pop(struct ck_deque *deque, void *data)
+{
+
+	return _ck_deque_pop(deque, data, sizeof(void *));
+}
+
+/*
+ * Returns false if the deque is empty or if another thief won the race for
+ * the oldest entry.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_deque_trysteal(struct ck_deque *deque, void *data)
+{
+	unsigned int top = ck_pr_load_uint(&deque->top);
+
+	return _ck_deque_trysteal(deque, data, sizeof(void *), &top);
+}
+
+/*
+ * Retries on contention with other thieves and only returns false if the
+ * deque is empty.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_deque_steal(struct ck_deque *deque, void *data)
+{
+
+	return _ck_deque_steal(deque, data, sizeof(void *));
+}
+
+/*
+ * Steals up to half of the entries in the deque, rounded up, but no more
+ * than n. Returns the number of entries stored in FIFO order into buffer.
+ */
+CK_CC_INLINE static unsigned int
+ck_deque_steal_batch(struct ck_deque *deque, void *buffer, unsigned int n)
+{
+
+	return _ck_deque_steal_batch(deque, buffer, n, sizeof(void *));
+}
+
+/*
+ * CK_DEQUE_PROTOTYPE is used to define a type-safe interface for storing
+ * values of a particular type in the deque. A deque must only be accessed
+ * through the interface of the type it was initialized with.
+ */
+#define CK_DEQUE_PROTOTYPE(name, type)				\
+CK_CC_INLINE static bool					\
+ck_deque_init_##name(struct ck_deque *a,			\
+    struct ck_malloc *b,					\
+    unsigned int c)						\
+{								\
+								\
+	return _ck_deque_init(a, b, c, sizeof(struct type));	\
+}								\
+								\
+CK_CC_FORCE_INLINE static bool				\
+ck_deque_push_##name(struct ck_deque *a,			\
+    const struct type *b)					\
+{								\
+								\
+	return _ck_deque_push(a, b, sizeof(struct type));	\
+}								\
+								\
+CK_CC_FORCE_INLINE static bool				\
+ck_deque_pop_##name(struct ck_deque *a,				\
+    struct type *b)						\
+{								\
+								\
+	return _ck_deque_pop(a, b, sizeof(struct type));	\
+}								\
+								\
+CK_CC_FORCE_INLINE static bool				\
+ck_deque_trysteal_##name(struct ck_deque *a,			\
+    struct type *b)						\
+{								\
+	unsigned int top = ck_pr_load_uint(&a->top);		\
+								\
+	return _ck_deque_trysteal(a, b,				\
+	    sizeof(struct type), &top);				\
+}								\
+								\
+CK_CC_FORCE_INLINE static bool				\
+ck_deque_steal_##name(struct ck_deque *a,			\
+    struct type *b)						\
+{								\
+								\
+	return _ck_deque_steal(a, b, sizeof(struct type));	\
+}								\
+								\
+CK_CC_INLINE static unsigned int				\
+ck_deque_steal_batch_##name(struct ck_deque *a,			\
+    struct type *b,						\
+    unsigned int c)						\
+{								\
+								\
+	return _ck_deque_steal_batch(a, b, c,			\
+	    sizeof(struct type));				\
+}
+
+#define CK_DEQUE_INIT(name, a, b, c)				\
+	ck_deque_init_##name(a, b, c)
+#define CK_DEQUE_PUSH(name, a, b)				\
+	ck_deque_push_##name(a, b)
+#define CK_DEQUE_POP(name, a, b)				\
+	ck_deque_pop_##name(a, b)
+#define CK_DEQUE_TRYSTEAL(name, a, b)				\
+	ck_deque_trysteal_##name(a, b)
+#define CK_DEQUE_STEAL(name, a, b)				\
+	ck_deque_steal_##name(a, b)
+#define CK_DEQUE_STEAL_BATCH(name, a, b, c)			\
+	ck_deque_steal_batch_##name(a, b, c)
+
+#endif /* CK_DEQUE_H */
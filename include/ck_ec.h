@@ -102,6 +102,11 @@
  * encapsulated in a struct ck_ec_mode, passed to most ck_ec
  * operations.
  *
+ * On Linux, ck provides ck_ec_linux_ops (CK_F_EC_LINUX), which waits
+ * on private futexes with absolute CLOCK_MONOTONIC deadlines. Modes
+ * for it may be defined with CK_EC_LINUX_MODE_SP and
+ * CK_EC_LINUX_MODE_MP.
+ *
  * ec is a struct ck_ec32 *, or a struct ck_ec64 *.
  *
  * value is an uint32_t for ck_ec32, and an uint64_t for ck_ec64. It
@@ -159,6 +164,37 @@
  * `iteration_deadline` (moving it further in the future is a bad
  * idea).
  *
+ * `void ck_ec32_wait_until(ec, mode, spin, cond, data)`: blocks
+ *  until `cond(data)` returns true. The condition is first polled in
+ *  a spin loop; its length adapts to the history recorded in `*spin`
+ *  (which may be NULL for a fixed budget of `busy_loop_iter`
+ *  iterations). The waiter then sleeps on `ec`, and is woken by
+ *  `ck_ec32_signal` or any other update to `ec`. This function acts
+ *  as a read (acquire) barrier.
+ *
+ * `void ck_ec32_signal(ec, mode)`: to be called after making a
+ *  `ck_ec32_wait_until` condition true. Wakes waiters blocked on `ec`
+ *  only if some thread has marked the event count as requiring an OS
+ *  wakeup, so the uncontended cost is a single load. The update to
+ *  the condition must be ordered before the call with a store-to-load
+ *  fence. Always uses the multiple producer code path, regardless of
+ *  `mode`.
+ *
+ * `int ck_ec32_wait_any(ecs, mode, values, n, deadline)`: waits until
+ *  the counter value of any of the `n` (at most CK_EC_WAIT_ANY_MAX)
+ *  event counts in `ecs` differs from the matching entry in `values`,
+ *  or, if `deadline` is non-NULL, until the current time is after that
+ *  deadline. Returns the index of an event count that has changed, and
+ *  -1 on timeout. This function acts as a read (acquire) barrier. Only
+ *  32 bit event counts are supported, so `ck_ec_wait_any` is always an
+ *  alias for `ck_ec32_wait_any`.
+ *
+ *  A single sleep covers every event count when the ops define
+ *  `wait32_any` (ck_ec_linux_ops uses futex_waitv). Otherwise, or if
+ *  `wait32_any` reports that it is unsupported, the waiter sleeps on a
+ *  process-wide event count that every ck_ec32 wake-up also signals
+ *  while such waiters exist.
+ *
  * Implementation notes
  * ====================
  *
@@ -355,6 +391,19 @@ struct ck_ec_ops {
 	 * to infinity.
 	 */
 	uint32_t wait_shift_count;
+
+	/*
+	 * Optional. Waits until the value at any of the `n` addresses
+	 * differs from the matching `expected` value, or until deadline
+	 * (if non-NULL). May return early for any reason. Returns 0 on
+	 * success, and non-zero if the primitive is unavailable at
+	 * runtime, in which case ck_ec32_wait_any falls back to a
+	 * process-wide event count.
+	 */
+	int (*wait32_any)(const struct ck_ec_wait_state *,
+			  const uint32_t *const *addresses,
+			  const uint32_t *expected, size_t n,
+			  const struct timespec *deadline);
 };
 
 /*
@@ -389,6 +438,25 @@ struct ck_ec_mode {
 	bool single_producer;
 };
 
+#if defined(__linux__) && !defined(__KERNEL__)
+#define CK_F_EC_LINUX
+
+/*
+ * Default operations for Linux user space, defined in ck_ec_linux.c.
+ * Waits use FUTEX_WAIT_BITSET, whose timeout is an absolute
+ * CLOCK_MONOTONIC deadline, and wakes use FUTEX_WAKE. Waits on
+ * several event counts use futex_waitv when the kernel supports it.
+ * All futex operations are process-private, so event counts in memory
+ * shared between processes need their own ops.
+ */
+extern const struct ck_ec_ops ck_ec_linux_ops;
+
+#define CK_EC_LINUX_MODE_SP \
+	{ .ops = &ck_ec_linux_ops, .single_producer = true }
+#define CK_EC_LINUX_MODE_MP \
+	{ .ops = &ck_ec_linux_ops, .single_producer = false }
+#endif /* __linux__ && !__KERNEL__ */
+
 struct ck_ec32 {
 	/* Flag is "sign" bit, value in bits 0:30. */
 	uint32_t counter;
@@ -575,6 +643,28 @@ static int ck_ec32_wait_pred(struct ck_ec32 *ec,
 			     void *data,
 			     const struct timespec *deadline);
 
+/*
+ * Maximum number of event counts for ck_ec32_wait_any; this matches
+ * the limit of Linux futex_waitv.
+ */
+#define CK_EC_WAIT_ANY_MAX 128
+
+/*
+ * Waits until the counter value of any event count in ecs differs
+ * from the matching entry in old_values, or, if deadline is non-NULL,
+ * until CLOCK_MONOTONIC is past the deadline.
+ *
+ * Returns the index of a changed event count, and -1 on timeout or
+ * if n is 0 or greater than CK_EC_WAIT_ANY_MAX.
+ */
+static int ck_ec32_wait_any(struct ck_ec32 *const *ecs,
+			    const struct ck_ec_mode *mode,
+			    const uint32_t *old_values,
+			    size_t n,
+			    const struct timespec *deadline);
+
+#define ck_ec_wait_any ck_ec32_wait_any
+
 #ifndef CK_F_EC64
 #define ck_ec_wait_pred ck_ec32_wait_pred
 #else
@@ -595,6 +685,28 @@ static int ck_ec64_wait_pred(struct ck_ec64 *ec,
 #endif /* __STDC_VERSION__ */
 #endif /* CK_F_EC64 */
 
+/*
+ * Waits until cond(data) returns true, first spinning and then sleeping
+ * on the event count. If spin is non-NULL, it holds a moving average of
+ * recent spin phases that sizes the next one, otherwise the spin phase
+ * is bounded by the busy_loop_iter of the ops. The condition is
+ * observed with acquire semantics.
+ */
+static void ck_ec32_wait_until(struct ck_ec32 *ec,
+			       const struct ck_ec_mode *mode,
+			       uint32_t *spin,
+			       bool (*cond)(void *),
+			       void *data);
+
+/*
+ * Wakes up the waiters of ck_ec32_wait_until after a condition update.
+ * The caller is responsible for ordering the update to the condition
+ * before this call with a store-to-load fence (ck_pr_fence_store_load
+ * or ck_pr_fence_atomic_load). It pairs with the fence in
+ * ck_ec_cond_pred.
+ */
+static void ck_ec32_signal(struct ck_ec32 *ec, const struct ck_ec_mode *mode);
+
 /*
  * Inline implementation details. 32 bit first, then 64 bit
  * conditionally.
@@ -802,6 +914,30 @@ ck_ec32_wait_pred(struct ck_ec32 *ec,
 				      pred, data, deadline);
 }
 
+int ck_ec32_wait_any_slow(struct ck_ec32 *const *ecs,
+			  const struct ck_ec_ops *ops,
+			  const uint32_t *old_values,
+			  size_t n,
+			  const struct timespec *deadline);
+
+CK_CC_FORCE_INLINE int
+ck_ec32_wait_any(struct ck_ec32 *const *ecs,
+		 const struct ck_ec_mode *mode,
+		 const uint32_t *old_values,
+		 size_t n,
+		 const struct timespec *deadline)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		if (ck_ec32_value(ecs[i]) != old_values[i]) {
+			return (int)i;
+		}
+	}
+
+	return ck_ec32_wait_any_slow(ecs, mode->ops, old_values, n, deadline);
+}
+
 #ifdef CK_F_EC64
 CK_CC_FORCE_INLINE void ck_ec64_init(struct ck_ec64 *ec, uint64_t value)
 {
@@ -942,4 +1078,105 @@ ck_ec64_wait_pred(struct ck_ec64 *ec,
 				      pred, data, deadline);
 }
 #endif /* CK_F_EC64 */
+
+/*
+ * Bounds for the adaptive spin phase of ck_ec32_wait_until. The spin
+ * budget is twice the recent average of successful spins, so that
+ * conditions which usually become true quickly are rarely slept on.
+ */
+#define CK_EC_SPIN_MIN 16U
+#define CK_EC_SPIN_MAX 4096U
+
+struct ck_ec_cond {
+	bool (*cond)(void *);
+	void *data;
+};
+
+CK_CC_INLINE static int
+ck_ec_cond_pred(const struct ck_ec_wait_state *state,
+		struct timespec *deadline)
+{
+	const struct ck_ec_cond *c = state->data;
+
+	(void)deadline;
+
+	/*
+	 * The counter has been flagged by now. Order the flag update
+	 * before the condition is observed, a producer that makes the
+	 * condition true after this point will observe the flag in
+	 * ck_ec32_signal.
+	 */
+	ck_pr_fence_memory();
+	return c->cond(c->data) == true;
+}
+
+CK_CC_FORCE_INLINE void
+ck_ec32_wait_until(struct ck_ec32 *ec,
+		   const struct ck_ec_mode *mode,
+		   uint32_t *spin,
+		   bool (*cond)(void *),
+		   void *data)
+{
+	struct ck_ec_cond c = {
+		.cond = cond,
+		.data = data
+	};
+	uint32_t limit, i, snapshot;
+
+	if (spin != NULL) {
+		limit = ck_pr_load_32(spin) * 2 + CK_EC_SPIN_MIN;
+		if (limit > CK_EC_SPIN_MAX)
+			limit = CK_EC_SPIN_MAX;
+	} else {
+		limit = mode->ops->busy_loop_iter != 0 ?
+		    mode->ops->busy_loop_iter : CK_EC_SPIN_MIN;
+	}
+
+	for (i = 0; i < limit; i++) {
+		if (cond(data) == true)
+			break;
+
+		ck_pr_stall();
+	}
+
+	/*
+	 * Racy update of the moving average, approximating the last
+	 * eight spin phases. A spin phase that failed counts as zero, so
+	 * the budget shrinks when the condition is typically satisfied by
+	 * a thread that is not running (e.g., under oversubscription).
+	 */
+	if (spin != NULL) {
+		uint32_t average = ck_pr_load_32(spin);
+		uint32_t sample = (i < limit) ? i : 0;
+
+		ck_pr_store_32(spin, average + (int32_t)(sample - average) / 8);
+	}
+
+	if (i < limit) {
+		ck_pr_fence_acquire();
+		return;
+	}
+
+	for (;;) {
+		snapshot = ck_ec32_value(ec);
+		if (cond(data) == true)
+			break;
+
+		ck_ec32_wait_pred(ec, mode, snapshot, ck_ec_cond_pred, &c,
+		    NULL);
+	}
+
+	ck_pr_fence_acquire();
+	return;
+}
+
+CK_CC_FORCE_INLINE void
+ck_ec32_signal(struct ck_ec32 *ec, const struct ck_ec_mode *mode)
+{
+
+	if (ck_ec32_has_waiters(ec) == true)
+		(void)ck_ec32_add_mp(ec, mode, 1);
+
+	return;
+}
 #endif /* !CK_EC_H */
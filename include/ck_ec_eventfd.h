@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_EC_EVENTFD_H
+#define CK_EC_EVENTFD_H
+
+/*
+ * Bridges ck_ec event counts to a Linux eventfd, so that a thread
+ * sleeping in epoll (or poll, or select) can be woken by producers.
+ *
+ * A bridge wraps a base ck_ec_ops (e.g., ck_ec_linux_ops) with wake
+ * hooks that write to the bridge's eventfd. Producers update their
+ * event counts with a mode built on ck_ec_eventfd_ops(bridge); like
+ * any other ck_ec producer, they only enter the wake slow path, and
+ * thus only make a system call, when a waiter has flagged the counter.
+ * Any number of event counts may share one bridge.
+ *
+ * The consumer adds ck_ec_eventfd_fd(bridge) to its event loop, and,
+ * for each event count, follows this protocol:
+ *
+ *    value = ck_ec_value(ec);
+ *    for (;;) {
+ *	  consume work up to value;
+ *	  if (ck_ec32_eventfd_arm(ec, bridge, value) == false) {
+ *	      value = ck_ec_value(ec);
+ *	      continue;
+ *	  }
+ *
+ *	  epoll_wait(...);
+ *	  ck_ec_eventfd_drain(bridge);
+ *	  value = ck_ec_value(ec);
+ *    }
+ *
+ * Once armed, the next update to the event count writes to the
+ * eventfd, so each idle-to-busy transition costs the producer a single
+ * write(2). Later updates find the flag cleared and stay in user space
+ * until the consumer arms the event count again.
+ *
+ * Wake-ups through a bridge only signal its eventfd: event counts
+ * updated with a bridge's ops must only be awaited through the bridge,
+ * and not with ck_ec_wait. Single producer modes may lose a flag flip
+ * (see the implementation notes in ck_ec.h), so loops that use them
+ * should bound their epoll timeout (e.g., to one second) and re-arm.
+ */
+
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+#ifdef CK_F_EC_LINUX
+#define CK_F_EC_EVENTFD
+
+struct ck_ec_eventfd {
+	struct ck_ec_ops ops;	/* Must be the first member. */
+	int fd;
+};
+typedef struct ck_ec_eventfd ck_ec_eventfd_t;
+
+/*
+ * Creates the bridge's non-blocking eventfd, and derives its ops from
+ * base. Returns 0 on success, and -1 with errno set on failure.
+ */
+int ck_ec_eventfd_init(struct ck_ec_eventfd *, const struct ck_ec_ops *base);
+
+/* Closes the bridge's eventfd. */
+void ck_ec_eventfd_destroy(struct ck_ec_eventfd *);
+
+/* Resets the eventfd after it was reported readable. */
+void ck_ec_eventfd_drain(struct ck_ec_eventfd *);
+
+/*
+ * Flags ec so that its next update signals the bridge. Returns false
+ * if the value of ec already differs from old_value, in which case the
+ * caller should consume the new work instead of sleeping.
+ */
+bool ck_ec32_eventfd_arm(struct ck_ec32 *ec,
+    const struct ck_ec_eventfd *,
+    uint32_t old_value);
+
+#ifdef CK_F_EC64
+bool ck_ec64_eventfd_arm(struct ck_ec64 *ec,
+    const struct ck_ec_eventfd *,
+    uint64_t old_value);
+
+#if __STDC_VERSION__ >= 201112L
+#define ck_ec_eventfd_arm(EC, BRIDGE, OLD_VALUE)			\
+	(_Generic(*(EC),						\
+		  struct ck_ec32 : ck_ec32_eventfd_arm,			\
+		  struct ck_ec64 : ck_ec64_eventfd_arm)((EC), (BRIDGE),	\
+							(OLD_VALUE)))
+#endif /* __STDC_VERSION__ */
+#else
+#define ck_ec_eventfd_arm ck_ec32_eventfd_arm
+#endif /* CK_F_EC64 */
+
+CK_CC_INLINE static int
+ck_ec_eventfd_fd(const struct ck_ec_eventfd *bridge)
+{
+
+	return bridge->fd;
+}
+
+CK_CC_INLINE static const struct ck_ec_ops *
+ck_ec_eventfd_ops(const struct ck_ec_eventfd *bridge)
+{
+
+	return &bridge->ops;
+}
+
+#endif /* CK_F_EC_LINUX */
+#endif /* CK_EC_EVENTFD_H */
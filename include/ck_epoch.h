@@ -174,8 +174,7 @@ CK_CC_FORCE_INLINE static bool
 ck_epoch_end(ck_epoch_record_t *record, ck_epoch_section_t *section)
 {
 
-	ck_pr_fence_release();
-	ck_pr_store_uint(&record->active, record->active - 1);
+	ck_pr_store_release_uint(&record->active, record->active - 1);
 
 	if (section != NULL)
 		return _ck_epoch_delref(record, section);
@@ -0,0 +1,385 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_HBITMAP_H
+#define CK_HBITMAP_H
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+#include <ck_string.h>
+
+#if !defined(CK_F_PR_LOAD_64) || !defined(CK_F_PR_AND_64) || \
+    !defined(CK_F_PR_OR_64) || !defined(CK_F_PR_BTS_64) || \
+    !defined(CK_F_CC_CTZLL)
+#error "ck_hbitmap is not supported on your platform."
+#endif
+
+/*
+ * A hierarchical bitmap. The bits live in an array of 64-bit leaf words
+ * and every level above summarizes the one below it with one bit per
+ * word, until a level fits in a single word. There are two summary
+ * trees: in the set tree a bit is set if the word below it has a set
+ * bit, in the clear tree a bit is set if the word below it has a clear
+ * bit. Searches descend the relevant tree, so they skip empty (or full)
+ * regions of the map in a number of steps proportional to the number of
+ * levels rather than to the distance covered.
+ *
+ * Set and reset operations are atomic with respect to each other and
+ * maintain the summaries with atomic operations. Once all concurrent
+ * updates to a word have completed, its summary bits are exact. A search
+ * racing with the update that empties (or fills) a word may transiently
+ * miss bits set (or cleared) concurrently in that word. Like ck_bitmap
+ * iteration, searches are not linearized.
+ */
+#define CK_HBITMAP_BLOCK	64
+#define CK_HBITMAP_LEVELS	6
+#define CK_HBITMAP_WORDS(n)	(((n) + CK_HBITMAP_BLOCK - 1) / CK_HBITMAP_BLOCK)
+#define CK_HBITMAP_BIT(i)	((uint64_t)1 << ((i) % CK_HBITMAP_BLOCK))
+
+struct ck_hbitmap {
+	unsigned int n_bits;
+	unsigned int n_levels;
+	unsigned int n_entries[CK_HBITMAP_LEVELS];
+	unsigned int offset[CK_HBITMAP_LEVELS];
+	uint64_t map[];
+};
+typedef struct ck_hbitmap ck_hbitmap_t;
+
+/*
+ * Computes the geometry of a bitmap with the specified number of bits,
+ * recording it in hb if it is not NULL. Returns the number of words
+ * required for the leaves and both summary trees.
+ */
+CK_CC_INLINE static unsigned int
+ck_hbitmap_layout(struct ck_hbitmap *hb, unsigned int n_bits)
+{
+	unsigned int level = 0;
+	unsigned int total = 0;
+	unsigned int n = n_bits;
+
+	for (;;) {
+		unsigned int words = CK_HBITMAP_WORDS(n);
+
+		if (hb != NULL) {
+			hb->n_entries[level] = n;
+			hb->offset[level] = total;
+		}
+
+		/* Summary levels hold a word for each of the two trees. */
+		total += level == 0 ? words : words * 2;
+		level++;
+
+		if (words <= 1)
+			break;
+
+		n = words;
+	}
+
+	if (hb != NULL)
+		hb->n_levels = level;
+
+	return total;
+}
+
+/*
+ * Returns the required number of bytes for a ck_hbitmap_t object
+ * supporting the specified number of bits.
+ */
+CK_CC_INLINE static unsigned int
+ck_hbitmap_size(unsigned int n_bits)
+{
+
+	return sizeof(struct ck_hbitmap) +
+	    ck_hbitmap_layout(NULL, n_bits) * sizeof(uint64_t);
+}
+
+/*
+ * Returns total number of bits in specified bitmap.
+ */
+CK_CC_INLINE static unsigned int
+ck_hbitmap_bits(const struct ck_hbitmap *hb)
+{
+
+	return hb->n_bits;
+}
+
+CK_CC_INLINE static uint64_t *
+ck_hbitmap_summary(struct ck_hbitmap *hb, bool clear, unsigned int level,
+    unsigned int i)
+{
+	unsigned int offset = hb->offset[level] + i;
+
+	if (clear == true)
+		offset += CK_HBITMAP_WORDS(hb->n_entries[level]);
+
+	return &hb->map[offset];
+}
+
+/*
+ * Returns word i of the specified level of a tree. Leaf words are
+ * complemented for the clear tree, ignoring the bits past the end of
+ * the bitmap.
+ */
+CK_CC_INLINE static uint64_t
+ck_hbitmap_load(const struct ck_hbitmap *hb, bool clear, unsigned int level,
+    unsigned int i)
+{
+	unsigned int offset = hb->offset[level] + i;
+	uint64_t word;
+
+	if (level > 0) {
+		if (clear == true)
+			offset += CK_HBITMAP_WORDS(hb->n_entries[level]);
+
+		return ck_pr_load_64(&hb->map[offset]);
+	}
+
+	word = ck_pr_load_64(&hb->map[offset]);
+	if (clear == false)
+		return word;
+
+	word = ~word;
+	if (i == hb->n_bits / CK_HBITMAP_BLOCK)
+		word &= CK_HBITMAP_BIT(hb->n_bits) - 1;
+
+	return word;
+}
+
+/*
+ * Maintain the summaries above word i of the specified level of a tree
+ * after it gained a bit (mark) or may have lost its last bit (unmark).
+ */
+void ck_hbitmap_mark(struct ck_hbitmap *, bool, unsigned int, unsigned int);
+void ck_hbitmap_unmark(struct ck_hbitmap *, bool, unsigned int, unsigned int);
+
+/*
+ * Sets the bit at the offset specified in the second argument.
+ */
+CK_CC_INLINE static void
+ck_hbitmap_set(struct ck_hbitmap *hb, unsigned int n)
+{
+	unsigned int i = n / CK_HBITMAP_BLOCK;
+
+	ck_pr_or_64(&hb->map[i], CK_HBITMAP_BIT(n));
+	ck_hbitmap_mark(hb, false, 0, i);
+	ck_hbitmap_unmark(hb, true, 0, i);
+	return;
+}
+
+/*
+ * Performs a test-and-set operation at the offset specified in the
+ * second argument. Returns true if the bit at the specified offset was
+ * already set, false otherwise.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_bts(struct ck_hbitmap *hb, unsigned int n)
+{
+	unsigned int i = n / CK_HBITMAP_BLOCK;
+
+	if (ck_pr_bts_64(&hb->map[i], n % CK_HBITMAP_BLOCK) == true)
+		return true;
+
+	ck_hbitmap_mark(hb, false, 0, i);
+	ck_hbitmap_unmark(hb, true, 0, i);
+	return false;
+}
+
+/*
+ * Resets the bit at the offset specified in the second argument.
+ */
+CK_CC_INLINE static void
+ck_hbitmap_reset(struct ck_hbitmap *hb, unsigned int n)
+{
+	unsigned int i = n / CK_HBITMAP_BLOCK;
+
+	ck_pr_and_64(&hb->map[i], ~CK_HBITMAP_BIT(n));
+	ck_hbitmap_mark(hb, true, 0, i);
+	ck_hbitmap_unmark(hb, false, 0, i);
+	return;
+}
+
+/*
+ * Determines whether the bit at offset specified in the
+ * second argument is set.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_test(const struct ck_hbitmap *hb, unsigned int n)
+{
+
+	return ck_pr_load_64(&hb->map[n / CK_HBITMAP_BLOCK]) &
+	    CK_HBITMAP_BIT(n);
+}
+
+/*
+ * Finds the first entry at or after from at the specified level whose
+ * bit is set in the specified tree. Searches move up the tree while the
+ * remainder of a word is empty and descend towards the first bit of the
+ * first non-empty word they find.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_find(const struct ck_hbitmap *hb, bool clear, unsigned int floor,
+    unsigned int from, unsigned int *entry)
+{
+	unsigned int level = floor;
+	unsigned int position = from;
+
+	for (;;) {
+		uint64_t word;
+
+		if (position >= hb->n_entries[level])
+			return false;
+
+		word = ck_hbitmap_load(hb, clear, level,
+		    position / CK_HBITMAP_BLOCK);
+		word &= ~(uint64_t)0 << (position % CK_HBITMAP_BLOCK);
+		if (word == 0) {
+			if (level + 1 >= hb->n_levels)
+				return false;
+
+			position = position / CK_HBITMAP_BLOCK + 1;
+			level++;
+			continue;
+		}
+
+		position -= position % CK_HBITMAP_BLOCK;
+		position += ck_cc_ctzll(word);
+		if (level == floor)
+			break;
+
+		/*
+		 * If the summary was stale, the word below is empty and
+		 * the search resumes with the entry after it.
+		 */
+		position *= CK_HBITMAP_BLOCK;
+		level--;
+	}
+
+	*entry = position;
+	return true;
+}
+
+/*
+ * Finds the first set bit at or after the offset specified in the
+ * second argument. Returns false if there is no such bit.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_next_set(const struct ck_hbitmap *hb, unsigned int from,
+    unsigned int *bit)
+{
+
+	return ck_hbitmap_find(hb, false, 0, from, bit);
+}
+
+/*
+ * Finds the first clear bit at or after the offset specified in the
+ * second argument. Returns false if there is no such bit.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_next_clear(const struct ck_hbitmap *hb, unsigned int from,
+    unsigned int *bit)
+{
+
+	return ck_hbitmap_find(hb, true, 0, from, bit);
+}
+
+/*
+ * Finds the first set bit in the bitmap. Returns false if the bitmap is
+ * empty.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_first_set(const struct ck_hbitmap *hb, unsigned int *bit)
+{
+
+	return ck_hbitmap_find(hb, false, 0, 0, bit);
+}
+
+/*
+ * Finds the first clear bit in the bitmap. Returns false if the bitmap
+ * is full.
+ */
+CK_CC_INLINE static bool
+ck_hbitmap_first_clear(const struct ck_hbitmap *hb, unsigned int *bit)
+{
+
+	return ck_hbitmap_find(hb, true, 0, 0, bit);
+}
+
+/*
+ * Returns the number of set bits in the bitmap, only visiting the
+ * leaf words that the summaries report as non-empty. This is not a
+ * linearized operation.
+ */
+unsigned int ck_hbitmap_count(const struct ck_hbitmap *);
+
+/*
+ * Initializes a ck_hbitmap pointing to a region of memory with
+ * ck_hbitmap_size(n_bits) bytes. Third argument determines whether
+ * default bit value is 1 (true) or 0 (false). This is not a linearized
+ * operation.
+ */
+CK_CC_INLINE static void
+ck_hbitmap_init(struct ck_hbitmap *hb, unsigned int n_bits, bool set)
+{
+	unsigned int level;
+
+	hb->n_bits = n_bits;
+	ck_hbitmap_layout(hb, n_bits);
+
+	for (level = 0; level < hb->n_levels; level++) {
+		unsigned int n = hb->n_entries[level];
+		unsigned int words = CK_HBITMAP_WORDS(n);
+		uint64_t *leaf = &hb->map[hb->offset[level]];
+		uint64_t *on, *off;
+
+		/*
+		 * At the leaves, the word value is the bit value. Above,
+		 * a full bitmap has every set summary bit set and every
+		 * clear summary bit clear, an empty one the reverse.
+		 */
+		if (level == 0) {
+			on = set == true ? leaf : NULL;
+			off = set == true ? NULL : leaf;
+		} else {
+			on = set == true ? leaf : leaf + words;
+			off = set == true ? leaf + words : leaf;
+		}
+
+		if (off != NULL)
+			memset(off, 0, words * sizeof(uint64_t));
+
+		if (on != NULL && words > 0) {
+			memset(on, 0xFF, words * sizeof(uint64_t));
+			if (n % CK_HBITMAP_BLOCK != 0)
+				on[words - 1] = CK_HBITMAP_BIT(n) - 1;
+		}
+	}
+
+	return;
+}
+
+#endif /* CK_HBITMAP_H */
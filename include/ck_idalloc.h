@@ -0,0 +1,187 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_IDALLOC_H
+#define CK_IDALLOC_H
+
+/*
+ * A lock-free allocator of small integer identifiers, such as connection
+ * identifiers or buffer slots, in the range [0, n). Identifiers are bits
+ * of a ck_hbitmap, so that allocation finds a non-full word through the
+ * clear summary and claims a bit in it with an atomic operation.
+ *
+ * Every allocation path takes a hint, the position at which the search
+ * for a free identifier starts. Threads that keep distinct hints contend
+ * on distinct words of the map. Caches of pre-claimed identifiers
+ * amortize the atomic operations further; a cache must only be used by
+ * one thread at a time, for example by keeping one per thread or CPU.
+ */
+
+#include <ck_cc.h>
+#include <ck_hbitmap.h>
+#include <ck_malloc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+
+#if defined(CK_F_PR_CAS_64_VALUE)
+#define CK_F_IDALLOC
+
+#ifndef CK_IDALLOC_CACHE
+#define CK_IDALLOC_CACHE 64
+#endif
+
+struct ck_idalloc {
+	struct ck_hbitmap *map;
+	struct ck_malloc *m;
+	unsigned int n_ids;
+};
+typedef struct ck_idalloc ck_idalloc_t;
+
+struct ck_idalloc_cache {
+	unsigned int hint;
+	unsigned int n;
+	unsigned int id[CK_IDALLOC_CACHE];
+};
+typedef struct ck_idalloc_cache ck_idalloc_cache_t;
+
+bool ck_idalloc_init(struct ck_idalloc *, struct ck_malloc *, unsigned int);
+void ck_idalloc_destroy(struct ck_idalloc *);
+
+/*
+ * Allocates a single identifier, searching from *hint and wrapping
+ * around. On success, *hint is advanced past the identifier. Returns
+ * false if no free identifier was found. Under concurrent frees, this
+ * may happen while identifiers are being returned.
+ */
+bool ck_idalloc_get(struct ck_idalloc *, unsigned int *, unsigned int *);
+
+/*
+ * Allocates up to n identifiers into the provided array, claiming as
+ * many as possible from each word with one atomic operation. Returns
+ * the number of identifiers allocated.
+ */
+unsigned int ck_idalloc_get_n(struct ck_idalloc *, unsigned int *,
+    unsigned int *, unsigned int);
+
+/*
+ * Returns identifiers to the allocator. ck_idalloc_put_n releases the
+ * identifiers sharing a word with one atomic operation, best when they
+ * are sorted.
+ */
+void ck_idalloc_put(struct ck_idalloc *, unsigned int);
+void ck_idalloc_put_n(struct ck_idalloc *, const unsigned int *, unsigned int);
+
+/*
+ * Returns true if the identifier is allocated.
+ */
+CK_CC_INLINE static bool
+ck_idalloc_allocated(const struct ck_idalloc *ida, unsigned int id)
+{
+
+	return ck_hbitmap_test(ida->map, id);
+}
+
+/*
+ * Returns the number of allocated identifiers, including those held in
+ * caches. This is not a linearized operation.
+ */
+CK_CC_INLINE static unsigned int
+ck_idalloc_count(const struct ck_idalloc *ida)
+{
+
+	return ck_hbitmap_count(ida->map);
+}
+
+/*
+ * Initializes an empty cache whose refills start searching at hint. A
+ * hint of the form thread * (n / threads) spreads threads evenly over
+ * the map.
+ */
+CK_CC_INLINE static void
+ck_idalloc_cache_init(struct ck_idalloc_cache *cache, unsigned int hint)
+{
+
+	cache->hint = hint;
+	cache->n = 0;
+	return;
+}
+
+/*
+ * Allocates an identifier from the cache, refilling it with half of its
+ * capacity from the allocator if it is empty.
+ */
+CK_CC_INLINE static bool
+ck_idalloc_cache_get(struct ck_idalloc *ida, struct ck_idalloc_cache *cache,
+    unsigned int *id)
+{
+
+	if (CK_CC_UNLIKELY(cache->n == 0)) {
+		cache->n = ck_idalloc_get_n(ida, &cache->hint, cache->id,
+		    CK_IDALLOC_CACHE / 2);
+		if (cache->n == 0)
+			return false;
+	}
+
+	*id = cache->id[--cache->n];
+	return true;
+}
+
+/*
+ * Returns an identifier to the cache. If the cache is full, the oldest
+ * half of it is returned to the allocator.
+ */
+CK_CC_INLINE static void
+ck_idalloc_cache_put(struct ck_idalloc *ida, struct ck_idalloc_cache *cache,
+    unsigned int id)
+{
+	unsigned int i;
+
+	if (CK_CC_UNLIKELY(cache->n == CK_IDALLOC_CACHE)) {
+		ck_idalloc_put_n(ida, cache->id, CK_IDALLOC_CACHE / 2);
+		for (i = 0; i < CK_IDALLOC_CACHE / 2; i++)
+			cache->id[i] = cache->id[i + CK_IDALLOC_CACHE / 2];
+
+		cache->n = CK_IDALLOC_CACHE / 2;
+	}
+
+	cache->id[cache->n++] = id;
+	return;
+}
+
+/*
+ * Returns every identifier held by the cache to the allocator.
+ */
+CK_CC_INLINE static void
+ck_idalloc_cache_flush(struct ck_idalloc *ida, struct ck_idalloc_cache *cache)
+{
+
+	ck_idalloc_put_n(ida, cache->id, cache->n);
+	cache->n = 0;
+	return;
+}
+
+#endif /* CK_F_PR_CAS_64_VALUE */
+#endif /* CK_IDALLOC_H */
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_PFLOCK_EC_H
+#define CK_PFLOCK_EC_H
+
+/*
+ * Blocking variant of ck_pflock. Phase-fairness is preserved: readers
+ * arriving during a write phase wait for exactly one writer, and writers
+ * are served in ticket order. Waiters spin adaptively and then sleep on
+ * one of two event counts. Readers are only woken by the end of a write
+ * phase, and writers by the end of a write phase or by the last reader
+ * of a read phase.
+ *
+ * Every operation takes a multiple producer ck_ec_mode, which provides
+ * the operating system's wait and wake primitives.
+ */
+
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_pflock.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+struct ck_pflock_ec {
+	struct ck_pflock pf;
+	struct ck_ec32 readers;
+	struct ck_ec32 writers;
+	uint32_t readers_spin;
+	uint32_t writers_spin;
+};
+typedef struct ck_pflock_ec ck_pflock_ec_t;
+
+#define CK_PFLOCK_EC_INITIALIZER { CK_PFLOCK_INITIALIZER, \
+	CK_EC_INITIALIZER, CK_EC_INITIALIZER, 0, 0 }
+
+struct ck_pflock_ec_wait {
+	struct ck_pflock *pf;
+	uint32_t ticket;
+};
+
+CK_CC_INLINE static void
+ck_pflock_ec_init(struct ck_pflock_ec *lock)
+{
+
+	ck_ec32_init(&lock->readers, 0);
+	ck_ec32_init(&lock->writers, 0);
+	lock->readers_spin = 0;
+	lock->writers_spin = 0;
+	ck_pflock_init(&lock->pf);
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_pflock_ec_writer_turn(void *data)
+{
+	struct ck_pflock_ec_wait *w = data;
+
+	return ck_pr_load_32(&w->pf->wout) == w->ticket;
+}
+
+CK_CC_INLINE static bool
+ck_pflock_ec_readers_flushed(void *data)
+{
+	struct ck_pflock_ec_wait *w = data;
+
+	return ck_pr_load_32(&w->pf->rout) == w->ticket;
+}
+
+CK_CC_INLINE static bool
+ck_pflock_ec_phase_changed(void *data)
+{
+	struct ck_pflock_ec_wait *w = data;
+
+	return (ck_pr_load_32(&w->pf->rin) & CK_PFLOCK_WBITS) != w->ticket;
+}
+
+CK_CC_INLINE static void
+ck_pflock_ec_write_unlock(struct ck_pflock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	ck_pr_fence_unlock();
+
+	/* Migrate from write phase to read phase. */
+	ck_pr_and_32(&lock->pf.rin, CK_PFLOCK_LSB);
+
+	/* Allow other writers to continue. */
+	ck_pr_faa_32(&lock->pf.wout, 1);
+
+	ck_pr_fence_atomic_load();
+	ck_ec32_signal(&lock->readers, mode);
+	ck_ec32_signal(&lock->writers, mode);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_pflock_ec_write_lock(struct ck_pflock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+	struct ck_pflock_ec_wait w = { .pf = &lock->pf };
+
+	/* Acquire ownership of write-phase. */
+	w.ticket = ck_pr_faa_32(&lock->pf.win, 1);
+	if (ck_pr_load_32(&lock->pf.wout) != w.ticket) {
+		ck_ec32_wait_until(&lock->writers, mode, &lock->writers_spin,
+		    ck_pflock_ec_writer_turn, &w);
+	}
+
+	/*
+	 * Acquire ticket on read-side in order to allow them
+	 * to flush. Indicates to any incoming reader that a
+	 * write-phase is pending.
+	 */
+	w.ticket = ck_pr_faa_32(&lock->pf.rin,
+	    (w.ticket & CK_PFLOCK_PHID) | CK_PFLOCK_PRES);
+
+	/* Wait for any pending readers to flush. */
+	if (ck_pr_load_32(&lock->pf.rout) != w.ticket) {
+		ck_ec32_wait_until(&lock->writers, mode, &lock->writers_spin,
+		    ck_pflock_ec_readers_flushed, &w);
+	}
+
+	ck_pr_fence_lock();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_pflock_ec_read_unlock(struct ck_pflock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+	uint32_t rin;
+
+	ck_pr_fence_unlock();
+	ck_pr_faa_32(&lock->pf.rout, CK_PFLOCK_RINC);
+
+	/*
+	 * Only a writer waiting for the read phase to drain may care
+	 * about this update, and it has announced itself in rin.
+	 */
+	ck_pr_fence_atomic_load();
+	rin = ck_pr_load_32(&lock->pf.rin);
+	if (rin & CK_PFLOCK_WBITS)
+		ck_ec32_signal(&lock->writers, mode);
+
+	return;
+}
+
+CK_CC_INLINE static void
+ck_pflock_ec_read_lock(struct ck_pflock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+	struct ck_pflock_ec_wait w = { .pf = &lock->pf };
+
+	/*
+	 * If no writer is present, then the operation has completed
+	 * successfully.
+	 */
+	w.ticket = ck_pr_faa_32(&lock->pf.rin, CK_PFLOCK_RINC) &
+	    CK_PFLOCK_WBITS;
+	if (w.ticket == 0)
+		goto leave;
+
+	/* Wait for current write phase to complete. */
+	ck_ec32_wait_until(&lock->readers, mode, &lock->readers_spin,
+	    ck_pflock_ec_phase_changed, &w);
+
+leave:
+	/* Acquire semantics with respect to readers. */
+	ck_pr_fence_lock();
+	return;
+}
+
+#endif /* CK_PFLOCK_EC_H */
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_POOL_H
+#define CK_POOL_H
+
+#include <ck_cc.h>
+#include <ck_deque.h>
+#include <ck_ec.h>
+#include <ck_epoch.h>
+#include <ck_malloc.h>
+#include <ck_pr.h>
+#include <ck_stack.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+/*
+ * A work-stealing executor. Every worker owns a ck_deque of tasks that it
+ * forks onto and pops from in LIFO order. Idle workers steal in FIFO order
+ * from the other workers, preferring those in their own domain, which
+ * callers typically map to a last-level cache. Threads that are not
+ * workers submit tasks through a shared injector stack.
+ *
+ * ck_pool does not create threads. The caller dedicates one thread to
+ * each worker by calling ck_pool_run, which returns after
+ * ck_pool_shutdown once no work remains. Workers that find no work sleep
+ * on a ck_ec event count.
+ *
+ * A deque releases its old array through the allocator with the defer
+ * flag set when it grows. Thieves steal inside a section of the epoch
+ * passed to ck_pool_init, so the allocator is expected to defer these
+ * frees on that epoch.
+ *
+ * Tasks are provided by the caller and are not copied. A task may be
+ * reused or released as soon as its function has started executing.
+ */
+#ifndef CK_POOL_DEQUE_CAPACITY
+#define CK_POOL_DEQUE_CAPACITY 64U
+#endif
+
+#ifndef CK_POOL_STEAL_BATCH
+#define CK_POOL_STEAL_BATCH 8U
+#endif
+
+struct ck_pool;
+struct ck_pool_worker;
+struct ck_pool_task;
+
+typedef void ck_pool_task_cb_t(struct ck_pool_worker *, struct ck_pool_task *);
+typedef void ck_pool_range_cb_t(struct ck_pool_worker *, unsigned long,
+    unsigned long, void *);
+
+/*
+ * Tracks the completion of a set of tasks. A group typically lives on the
+ * stack of the thread that waits for it, and may go out of scope as soon
+ * as the last task has incremented completed. Tasks therefore never touch
+ * the group after that increment, and waiters sleep on the event count of
+ * the pool rather than on the group.
+ */
+struct ck_pool_group {
+	unsigned int forked;
+	unsigned int completed;
+};
+typedef struct ck_pool_group ck_pool_group_t;
+
+#define CK_POOL_GROUP_INITIALIZER { 0, 0 }
+
+struct ck_pool_task {
+	ck_pool_task_cb_t *function;
+	struct ck_pool_group *group;
+	ck_stack_entry_t injector_entry;
+};
+typedef struct ck_pool_task ck_pool_task_t;
+
+struct ck_pool_worker {
+	struct ck_deque deque;
+	struct ck_pool *pool;
+	ck_epoch_record_t *record;
+	unsigned int *victims;
+	unsigned int n_victims;
+	unsigned int n_local;
+	unsigned int id;
+	unsigned int domain;
+	unsigned int seed;
+	uint32_t spin;
+};
+typedef struct ck_pool_worker ck_pool_worker_t;
+
+struct ck_pool {
+	ck_stack_t injector;
+	ck_ec32_t ec;
+	unsigned int shutdown;
+	struct ck_ec_mode mode;
+	struct ck_malloc *m;
+	ck_epoch_t *epoch;
+	struct ck_pool_worker *workers;
+	unsigned int *victims;
+	unsigned int n_workers;
+};
+typedef struct ck_pool ck_pool_t;
+
+CK_CC_INLINE static void
+ck_pool_group_init(struct ck_pool_group *group)
+{
+
+	group->forked = 0;
+	group->completed = 0;
+	return;
+}
+
+/*
+ * Returns true once every task forked or submitted into the group has
+ * completed. The completion counter is read first, as it never exceeds
+ * the number of forked tasks.
+ */
+CK_CC_INLINE static bool
+ck_pool_group_done(const struct ck_pool_group *group)
+{
+	unsigned int completed = ck_pr_load_uint(&group->completed);
+
+	ck_pr_fence_load();
+	return completed == ck_pr_load_uint(&group->forked);
+}
+
+/*
+ * The _ck_pool_* namespace is internal only and must not used externally.
+ */
+CK_CC_INLINE static void
+_ck_pool_complete(struct ck_pool *pool, struct ck_pool_group *group)
+{
+
+	/* The effects of the task are visible once it is counted. */
+	ck_pr_fence_release();
+	ck_pr_inc_uint(&group->completed);
+
+	/* Pairs with the fence in the condition check of ck_ec32_wait_until. */
+	ck_pr_fence_atomic_load();
+	ck_ec32_signal(&pool->ec, &pool->mode);
+	return;
+}
+
+CK_CC_INLINE static unsigned int
+ck_pool_worker_id(const struct ck_pool_worker *worker)
+{
+
+	return worker->id;
+}
+
+/*
+ * Pushes a task onto the deque of the calling worker. An idle worker is
+ * woken if one is sleeping, but without a store-to-load fence. A missed
+ * wake-up only costs parallelism, as the worker eventually runs its own
+ * tasks.
+ */
+CK_CC_INLINE static void
+ck_pool_fork(struct ck_pool_worker *worker,
+    struct ck_pool_task *task,
+    ck_pool_task_cb_t *function,
+    struct ck_pool_group *group)
+{
+	struct ck_pool *pool = worker->pool;
+
+	task->function = function;
+	task->group = group;
+	if (group != NULL)
+		ck_pr_inc_uint(&group->forked);
+
+	if (CK_CC_UNLIKELY(ck_deque_push(&worker->deque, task) == false)) {
+		/* The deque could not grow, so run the task in place. */
+		function(worker, task);
+		if (group != NULL)
+			_ck_pool_complete(pool, group);
+
+		return;
+	}
+
+	ck_ec32_signal(&pool->ec, &pool->mode);
+	return;
+}
+
+/*
+ * The ec_ops must be safe for use by multiple producers. If domains is
+ * NULL, every worker is in the same domain. Otherwise, workers whose
+ * entries are equal steal from each other before anyone else.
+ */
+bool ck_pool_init(ck_pool_t *, struct ck_malloc *, ck_epoch_t *,
+    const struct ck_ec_ops *, unsigned int, const unsigned int *);
+void ck_pool_destroy(ck_pool_t *);
+void ck_pool_run(ck_pool_t *, unsigned int);
+void ck_pool_shutdown(ck_pool_t *);
+
+/*
+ * May be called from any thread, including workers.
+ */
+void ck_pool_submit(ck_pool_t *, ck_pool_task_t *, ck_pool_task_cb_t *,
+    ck_pool_group_t *);
+
+/*
+ * Waits for a group from a thread that is not a worker.
+ */
+void ck_pool_wait(ck_pool_t *, ck_pool_group_t *);
+
+/*
+ * Waits for a group from a worker, running other tasks in the meantime.
+ */
+void ck_pool_join(ck_pool_worker_t *, ck_pool_group_t *);
+
+/*
+ * Calls the function over disjoint subranges of [begin, end) of at most
+ * grain elements, recursively splitting the range in halves across
+ * workers. ck_pool_for may be called from any thread that is not a
+ * worker, while a running task uses ck_pool_worker_for.
+ */
+void ck_pool_for(ck_pool_t *, unsigned long, unsigned long, unsigned long,
+    ck_pool_range_cb_t *, void *);
+void ck_pool_worker_for(ck_pool_worker_t *, unsigned long, unsigned long,
+    unsigned long, ck_pool_range_cb_t *, void *);
+
+#endif /* CK_POOL_H */
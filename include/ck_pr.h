@@ -1272,4 +1272,226 @@ CK_PR_FAS_S(8, uint8_t)
 #undef CK_PR_FAA
 #undef CK_PR_FAS
 
+/*
+ * Loads with acquire semantics and stores with release semantics. Ports
+ * with dedicated instructions provide ck_pr_md_load_acquire_* and
+ * ck_pr_md_store_release_*. Otherwise, the load is followed by an
+ * acquire fence and the store is preceded by a release fence.
+ */
+#define CK_PR_LOAD_ACQUIRE(S, M, T)				\
+	CK_CC_INLINE static T					\
+	ck_pr_md_load_acquire_##S(const M *target)		\
+	{							\
+		T r = ck_pr_md_load_##S(target);		\
+								\
+		ck_pr_fence_acquire();				\
+		return r;					\
+	}
+
+#define CK_PR_STORE_RELEASE(S, M, T)				\
+	CK_CC_INLINE static void				\
+	ck_pr_md_store_release_##S(M *target, T v)		\
+	{							\
+								\
+		ck_pr_fence_release();				\
+		ck_pr_md_store_##S(target, v);			\
+		return;						\
+	}
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_PTR
+#define CK_F_PR_LOAD_ACQUIRE_PTR
+CK_PR_LOAD_ACQUIRE(ptr, void, void *)
+#endif /* CK_F_PR_LOAD_ACQUIRE_PTR */
+
+#ifndef CK_F_PR_STORE_RELEASE_PTR
+#define CK_F_PR_STORE_RELEASE_PTR
+CK_PR_STORE_RELEASE(ptr, void, const void *)
+#endif /* CK_F_PR_STORE_RELEASE_PTR */
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_CHAR
+#define CK_F_PR_LOAD_ACQUIRE_CHAR
+CK_PR_LOAD_ACQUIRE(char, char, char)
+#endif /* CK_F_PR_LOAD_ACQUIRE_CHAR */
+
+#ifndef CK_F_PR_STORE_RELEASE_CHAR
+#define CK_F_PR_STORE_RELEASE_CHAR
+CK_PR_STORE_RELEASE(char, char, char)
+#endif /* CK_F_PR_STORE_RELEASE_CHAR */
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_UINT
+#define CK_F_PR_LOAD_ACQUIRE_UINT
+CK_PR_LOAD_ACQUIRE(uint, unsigned int, unsigned int)
+#endif /* CK_F_PR_LOAD_ACQUIRE_UINT */
+
+#ifndef CK_F_PR_STORE_RELEASE_UINT
+#define CK_F_PR_STORE_RELEASE_UINT
+CK_PR_STORE_RELEASE(uint, unsigned int, unsigned int)
+#endif /* CK_F_PR_STORE_RELEASE_UINT */
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_INT
+#define CK_F_PR_LOAD_ACQUIRE_INT
+CK_PR_LOAD_ACQUIRE(int, int, int)
+#endif /* CK_F_PR_LOAD_ACQUIRE_INT */
+
+#ifndef CK_F_PR_STORE_RELEASE_INT
+#define CK_F_PR_STORE_RELEASE_INT
+CK_PR_STORE_RELEASE(int, int, int)
+#endif /* CK_F_PR_STORE_RELEASE_INT */
+
+#ifdef CK_F_PR_LOAD_64
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_64
+#define CK_F_PR_LOAD_ACQUIRE_64
+CK_PR_LOAD_ACQUIRE(64, uint64_t, uint64_t)
+#endif /* CK_F_PR_LOAD_ACQUIRE_64 */
+
+#ifndef CK_F_PR_STORE_RELEASE_64
+#define CK_F_PR_STORE_RELEASE_64
+CK_PR_STORE_RELEASE(64, uint64_t, uint64_t)
+#endif /* CK_F_PR_STORE_RELEASE_64 */
+
+#endif /* CK_F_PR_LOAD_64 */
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_32
+#define CK_F_PR_LOAD_ACQUIRE_32
+CK_PR_LOAD_ACQUIRE(32, uint32_t, uint32_t)
+#endif /* CK_F_PR_LOAD_ACQUIRE_32 */
+
+#ifndef CK_F_PR_STORE_RELEASE_32
+#define CK_F_PR_STORE_RELEASE_32
+CK_PR_STORE_RELEASE(32, uint32_t, uint32_t)
+#endif /* CK_F_PR_STORE_RELEASE_32 */
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_16
+#define CK_F_PR_LOAD_ACQUIRE_16
+CK_PR_LOAD_ACQUIRE(16, uint16_t, uint16_t)
+#endif /* CK_F_PR_LOAD_ACQUIRE_16 */
+
+#ifndef CK_F_PR_STORE_RELEASE_16
+#define CK_F_PR_STORE_RELEASE_16
+CK_PR_STORE_RELEASE(16, uint16_t, uint16_t)
+#endif /* CK_F_PR_STORE_RELEASE_16 */
+
+#ifndef CK_F_PR_LOAD_ACQUIRE_8
+#define CK_F_PR_LOAD_ACQUIRE_8
+CK_PR_LOAD_ACQUIRE(8, uint8_t, uint8_t)
+#endif /* CK_F_PR_LOAD_ACQUIRE_8 */
+
+#ifndef CK_F_PR_STORE_RELEASE_8
+#define CK_F_PR_STORE_RELEASE_8
+CK_PR_STORE_RELEASE(8, uint8_t, uint8_t)
+#endif /* CK_F_PR_STORE_RELEASE_8 */
+
+#undef CK_PR_LOAD_ACQUIRE
+#undef CK_PR_STORE_RELEASE
+
+#define CK_PR_STORE_RELEASE_SAFE(DST, VAL, TYPE)		\
+    ck_pr_md_store_release_##TYPE(				\
+        ((void)sizeof(*(DST) = (VAL)), (DST)),			\
+        (VAL))
+
+#define ck_pr_store_release_ptr(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), ptr)
+#define ck_pr_store_release_char(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), char)
+#define ck_pr_store_release_uint(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), uint)
+#define ck_pr_store_release_int(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), int)
+#define ck_pr_store_release_32(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), 32)
+#define ck_pr_store_release_16(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), 16)
+#define ck_pr_store_release_8(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), 8)
+
+#ifdef CK_F_PR_LOAD_64
+#define ck_pr_store_release_64(DST, VAL) CK_PR_STORE_RELEASE_SAFE((DST), (VAL), 64)
+#endif /* CK_F_PR_LOAD_64 */
+
+#define ck_pr_load_acquire_ptr(SRC) \
+    (CK_CC_TYPEOF(*(SRC), (void *)))ck_pr_md_load_acquire_ptr((SRC))
+#define ck_pr_load_acquire_char(SRC) ck_pr_md_load_acquire_char((SRC))
+#define ck_pr_load_acquire_uint(SRC) ck_pr_md_load_acquire_uint((SRC))
+#define ck_pr_load_acquire_int(SRC) ck_pr_md_load_acquire_int((SRC))
+#define ck_pr_load_acquire_32(SRC) ck_pr_md_load_acquire_32((SRC))
+#define ck_pr_load_acquire_16(SRC) ck_pr_md_load_acquire_16((SRC))
+#define ck_pr_load_acquire_8(SRC) ck_pr_md_load_acquire_8((SRC))
+
+#ifdef CK_F_PR_LOAD_64
+#define ck_pr_load_acquire_64(SRC) ck_pr_md_load_acquire_64((SRC))
+#endif /* CK_F_PR_LOAD_64 */
+
+/*
+ * Read-modify-write operations carry no ordering of their own and are
+ * therefore already relaxed. Lock acquisition instead needs an operation
+ * that is ordered before every subsequent access, which ports may provide
+ * natively. Otherwise, the operation is followed by an acquire fence.
+ */
+#define CK_PR_CAS_ACQUIRE(S, M, T)				\
+	CK_CC_INLINE static bool				\
+	ck_pr_cas_acquire_##S(M *target, T compare, T set)	\
+	{							\
+		bool r = ck_pr_cas_##S(target, compare, set);	\
+								\
+		ck_pr_fence_acquire();				\
+		return r;					\
+	}
+
+#define CK_PR_FAS_ACQUIRE(S, M, T)				\
+	CK_CC_INLINE static T					\
+	ck_pr_fas_acquire_##S(M *target, T v)			\
+	{							\
+		T r = ck_pr_fas_##S(target, v);			\
+								\
+		ck_pr_fence_acquire();				\
+		return r;					\
+	}
+
+#if defined(CK_F_PR_CAS_PTR) && !defined(CK_F_PR_CAS_ACQUIRE_PTR)
+#define CK_F_PR_CAS_ACQUIRE_PTR
+CK_PR_CAS_ACQUIRE(ptr, void, void *)
+#endif /* CK_F_PR_CAS_PTR && !CK_F_PR_CAS_ACQUIRE_PTR */
+
+#if defined(CK_F_PR_FAS_PTR) && !defined(CK_F_PR_FAS_ACQUIRE_PTR)
+#define CK_F_PR_FAS_ACQUIRE_PTR
+CK_PR_FAS_ACQUIRE(ptr, void, void *)
+#endif /* CK_F_PR_FAS_PTR && !CK_F_PR_FAS_ACQUIRE_PTR */
+
+#if defined(CK_F_PR_CAS_UINT) && !defined(CK_F_PR_CAS_ACQUIRE_UINT)
+#define CK_F_PR_CAS_ACQUIRE_UINT
+CK_PR_CAS_ACQUIRE(uint, unsigned int, unsigned int)
+#endif /* CK_F_PR_CAS_UINT && !CK_F_PR_CAS_ACQUIRE_UINT */
+
+#if defined(CK_F_PR_FAS_UINT) && !defined(CK_F_PR_FAS_ACQUIRE_UINT)
+#define CK_F_PR_FAS_ACQUIRE_UINT
+CK_PR_FAS_ACQUIRE(uint, unsigned int, unsigned int)
+#endif /* CK_F_PR_FAS_UINT && !CK_F_PR_FAS_ACQUIRE_UINT */
+
+#if defined(CK_F_PR_CAS_INT) && !defined(CK_F_PR_CAS_ACQUIRE_INT)
+#define CK_F_PR_CAS_ACQUIRE_INT
+CK_PR_CAS_ACQUIRE(int, int, int)
+#endif /* CK_F_PR_CAS_INT && !CK_F_PR_CAS_ACQUIRE_INT */
+
+#if defined(CK_F_PR_FAS_INT) && !defined(CK_F_PR_FAS_ACQUIRE_INT)
+#define CK_F_PR_FAS_ACQUIRE_INT
+CK_PR_FAS_ACQUIRE(int, int, int)
+#endif /* CK_F_PR_FAS_INT && !CK_F_PR_FAS_ACQUIRE_INT */
+
+#if defined(CK_F_PR_CAS_64) && !defined(CK_F_PR_CAS_ACQUIRE_64)
+#define CK_F_PR_CAS_ACQUIRE_64
+CK_PR_CAS_ACQUIRE(64, uint64_t, uint64_t)
+#endif /* CK_F_PR_CAS_64 && !CK_F_PR_CAS_ACQUIRE_64 */
+
+#if defined(CK_F_PR_FAS_64) && !defined(CK_F_PR_FAS_ACQUIRE_64)
+#define CK_F_PR_FAS_ACQUIRE_64
+CK_PR_FAS_ACQUIRE(64, uint64_t, uint64_t)
+#endif /* CK_F_PR_FAS_64 && !CK_F_PR_FAS_ACQUIRE_64 */
+
+#if defined(CK_F_PR_CAS_32) && !defined(CK_F_PR_CAS_ACQUIRE_32)
+#define CK_F_PR_CAS_ACQUIRE_32
+CK_PR_CAS_ACQUIRE(32, uint32_t, uint32_t)
+#endif /* CK_F_PR_CAS_32 && !CK_F_PR_CAS_ACQUIRE_32 */
+
+#if defined(CK_F_PR_FAS_32) && !defined(CK_F_PR_FAS_ACQUIRE_32)
+#define CK_F_PR_FAS_ACQUIRE_32
+CK_PR_FAS_ACQUIRE(32, uint32_t, uint32_t)
+#endif /* CK_F_PR_FAS_32 && !CK_F_PR_FAS_ACQUIRE_32 */
+
+#undef CK_PR_CAS_ACQUIRE
+#undef CK_PR_FAS_ACQUIRE
+
 #endif /* CK_PR_H */
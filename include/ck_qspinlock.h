@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_QSPINLOCK_H
+#define CK_QSPINLOCK_H
+
+/*
+ * A compact queued spinlock in the style of the Linux qspinlock. The lock
+ * word is 32 bits wide and encodes a locked byte, a pending bit and the
+ * MCS queue tail. The tail is a (cpu, index) pair referring into a
+ * library-owned array of per-CPU queue nodes, so callers never provide or
+ * track nodes themselves.
+ *
+ * An uncontended acquisition is a single compare-and-swap. A second
+ * contender spins on the lock word after setting the pending bit, and only
+ * third and later contenders allocate a queue node and spin locally.
+ *
+ * The CPU identifier is only a placement hint. Queue nodes are claimed and
+ * released atomically, so a thread migrating while it is queued cannot
+ * alias another thread's node. If every node of a CPU is in use, the
+ * slow path falls back to spinning on the lock word.
+ */
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+#ifndef CK_F_QSPINLOCK
+#define CK_F_QSPINLOCK
+
+/*
+ * Lock word layout:
+ *
+ *  0- 7: locked byte
+ *     8: pending
+ *  9-15: unused
+ * 16-17: tail index (nesting level of the queue node)
+ * 18-31: tail cpu (+1, zero means no tail)
+ */
+#define CK_QSPINLOCK_LOCKED_OFFSET	0
+#define CK_QSPINLOCK_LOCKED_BITS	8
+#define CK_QSPINLOCK_PENDING_OFFSET	8
+#define CK_QSPINLOCK_PENDING_BITS	8
+#define CK_QSPINLOCK_TAIL_IDX_OFFSET	16
+#define CK_QSPINLOCK_TAIL_IDX_BITS	2
+#define CK_QSPINLOCK_TAIL_CPU_OFFSET	18
+#define CK_QSPINLOCK_TAIL_CPU_BITS	14
+
+#define CK_QSPINLOCK_LOCKED		(1U << CK_QSPINLOCK_LOCKED_OFFSET)
+#define CK_QSPINLOCK_PENDING		(1U << CK_QSPINLOCK_PENDING_OFFSET)
+#define CK_QSPINLOCK_LOCKED_MASK	(((1U << CK_QSPINLOCK_LOCKED_BITS) - 1) \
+					    << CK_QSPINLOCK_LOCKED_OFFSET)
+#define CK_QSPINLOCK_PENDING_MASK	(((1U << CK_QSPINLOCK_PENDING_BITS) - 1) \
+					    << CK_QSPINLOCK_PENDING_OFFSET)
+#define CK_QSPINLOCK_TAIL_IDX_MASK	(((1U << CK_QSPINLOCK_TAIL_IDX_BITS) - 1) \
+					    << CK_QSPINLOCK_TAIL_IDX_OFFSET)
+#define CK_QSPINLOCK_TAIL_CPU_MASK	(((1U << CK_QSPINLOCK_TAIL_CPU_BITS) - 1) \
+					    << CK_QSPINLOCK_TAIL_CPU_OFFSET)
+#define CK_QSPINLOCK_TAIL_MASK		(CK_QSPINLOCK_TAIL_IDX_MASK | \
+					    CK_QSPINLOCK_TAIL_CPU_MASK)
+
+/* Number of queue nodes per CPU, bounded by the tail index width. */
+#define CK_QSPINLOCK_NODES		(1U << CK_QSPINLOCK_TAIL_IDX_BITS)
+
+/*
+ * Number of per-CPU node sets owned by the library. CPU identifiers are
+ * folded into this range, it may be lowered to reduce the footprint of
+ * the node pool.
+ */
+#ifndef CK_QSPINLOCK_CPU_MAX
+#define CK_QSPINLOCK_CPU_MAX		512
+#endif
+
+struct ck_qspinlock {
+	uint32_t value;
+};
+typedef struct ck_qspinlock ck_qspinlock_t;
+
+#define CK_QSPINLOCK_INITIALIZER	{ 0 }
+
+void ck_qspinlock_lock_slow(struct ck_qspinlock *, uint32_t);
+
+CK_CC_INLINE static void
+ck_qspinlock_init(struct ck_qspinlock *lock)
+{
+
+	lock->value = 0;
+	ck_pr_barrier();
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_qspinlock_locked(struct ck_qspinlock *lock)
+{
+	bool r;
+
+	r = ck_pr_load_32(&lock->value) != 0;
+	ck_pr_fence_acquire();
+	return r;
+}
+
+CK_CC_INLINE static bool
+ck_qspinlock_trylock(struct ck_qspinlock *lock)
+{
+	uint32_t value;
+
+	value = ck_pr_load_32(&lock->value);
+	if (value != 0)
+		return false;
+
+	if (ck_pr_cas_32(&lock->value, 0, CK_QSPINLOCK_LOCKED) == false)
+		return false;
+
+	ck_pr_fence_lock();
+	return true;
+}
+
+CK_CC_INLINE static void
+ck_qspinlock_lock(struct ck_qspinlock *lock)
+{
+	uint32_t value;
+
+	if (CK_CC_LIKELY(ck_pr_cas_32_value(&lock->value, 0,
+	    CK_QSPINLOCK_LOCKED, &value) == true)) {
+		ck_pr_fence_lock();
+		return;
+	}
+
+	ck_qspinlock_lock_slow(lock, value);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_qspinlock_unlock(struct ck_qspinlock *lock)
+{
+
+	ck_pr_fence_unlock();
+
+	/*
+	 * Only the owner may modify the locked byte, so it is sufficient to
+	 * clear it with a plain store where the byte is addressable.
+	 */
+#if defined(CK_F_PR_STORE_8) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	ck_pr_store_8((uint8_t *)&lock->value, 0);
+#else
+	ck_pr_sub_32(&lock->value, CK_QSPINLOCK_LOCKED);
+#endif
+	return;
+}
+
+#endif /* CK_F_QSPINLOCK */
+#endif /* CK_QSPINLOCK_H */
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_REF_H
+#define CK_REF_H
+
+/*
+ * Scalable reference counts. A live reference count keeps its gets and
+ * puts in the shards of a ck_counter, so that taking and dropping a
+ * reference only touches the cache line of the caller's shard. Puts
+ * cannot observe the final reference in this mode, which is why the
+ * creator holds an initial reference until ck_ref_kill.
+ *
+ * Killing switches the count to a shared atomic word. Every get and put
+ * must therefore execute within a read section of the epoch passed to
+ * ck_ref_kill, as the kill waits for a grace period before it folds the
+ * shards into the shared word. Until then the word carries a bias, so
+ * that puts racing with the switch cannot bring it to zero. Once killed,
+ * the put that drops the last reference returns true.
+ */
+
+#include <ck_cc.h>
+#include <ck_counter.h>
+#include <ck_epoch.h>
+#include <ck_malloc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+#if defined(CK_F_COUNTER)
+#define CK_F_REF
+
+#define CK_REF_LIVE	0U
+#define CK_REF_ATOMIC	1U
+
+/*
+ * Large enough that no number of racing puts reaches zero before the
+ * shards are folded, small enough that no number of gets overflows.
+ */
+#define CK_REF_BIAS	((uint64_t)1 << 62)
+
+struct ck_ref {
+	unsigned int mode;
+	struct ck_counter shards;
+	uint64_t count;
+};
+typedef struct ck_ref ck_ref_t;
+
+bool ck_ref_init(struct ck_ref *, struct ck_malloc *, unsigned int);
+void ck_ref_destroy(struct ck_ref *);
+bool ck_ref_kill(struct ck_ref *, struct ck_epoch_record *);
+
+CK_CC_FORCE_INLINE static bool
+ck_ref_live(const struct ck_ref *ref)
+{
+
+	return ck_pr_load_uint(&ref->mode) == CK_REF_LIVE;
+}
+
+/*
+ * Takes a reference through a shard that may be shared by several threads.
+ */
+CK_CC_FORCE_INLINE static void
+ck_ref_get(struct ck_ref *ref, unsigned int shard)
+{
+
+	if (CK_CC_LIKELY(ck_ref_live(ref) == true)) {
+		ck_counter_inc(&ref->shards, shard);
+	} else {
+		ck_pr_inc_64(&ref->count);
+	}
+
+	return;
+}
+
+/*
+ * Takes a reference through a shard that only the calling thread updates.
+ */
+CK_CC_FORCE_INLINE static void
+ck_ref_get_local(struct ck_ref *ref, unsigned int shard)
+{
+
+	if (CK_CC_LIKELY(ck_ref_live(ref) == true)) {
+		ck_counter_inc_local(&ref->shards, shard);
+	} else {
+		ck_pr_inc_64(&ref->count);
+	}
+
+	return;
+}
+
+/*
+ * Takes a reference only if the count has not been killed, as is needed
+ * by lookups that must not resurrect an object on its way out.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_ref_tryget_live(struct ck_ref *ref, unsigned int shard)
+{
+
+	if (ck_ref_live(ref) == false)
+		return false;
+
+	ck_counter_inc(&ref->shards, shard);
+	return true;
+}
+
+/*
+ * Drops a reference in atomic mode. Accesses to the object by this holder
+ * are ordered before the decrement, and the holder that drops the last
+ * reference observes those of every other holder before it releases the
+ * object.
+ */
+CK_CC_FORCE_INLINE static bool
+_ck_ref_release(struct ck_ref *ref)
+{
+
+	ck_pr_fence_release();
+	if (ck_pr_faa_64(&ref->count, (uint64_t)-1) != 1)
+		return false;
+
+	ck_pr_fence_acquire();
+	return true;
+}
+
+/*
+ * Drops a reference and returns true if it was the last one.
+ */
+CK_CC_FORCE_INLINE static bool
+ck_ref_put(struct ck_ref *ref, unsigned int shard)
+{
+
+	if (CK_CC_LIKELY(ck_ref_live(ref) == true)) {
+		ck_counter_dec(&ref->shards, shard);
+		return false;
+	}
+
+	return _ck_ref_release(ref);
+}
+
+CK_CC_FORCE_INLINE static bool
+ck_ref_put_local(struct ck_ref *ref, unsigned int shard)
+{
+
+	if (CK_CC_LIKELY(ck_ref_live(ref) == true)) {
+		ck_counter_dec_local(&ref->shards, shard);
+		return false;
+	}
+
+	return _ck_ref_release(ref);
+}
+
+#endif /* CK_F_REF */
+#endif /* CK_REF_H */
@@ -165,8 +165,7 @@ CK_CC_FORCE_INLINE static void
 _ck_ring_enqueue_commit_sp(struct ck_ring *ring)
 {
 
-	ck_pr_fence_store();
-	ck_pr_store_uint(&ring->p_tail, ring->p_tail + 1);
+	ck_pr_store_release_uint(&ring->p_tail, ring->p_tail + 1);
 	return;
 }
 
@@ -196,8 +195,7 @@ _ck_ring_enqueue_sp(struct ck_ring *ring,
 	 * Make sure to update slot value before indicating
 	 * that the slot is available for consumption.
 	 */
-	ck_pr_fence_store();
-	ck_pr_store_uint(&ring->p_tail, delta);
+	ck_pr_store_release_uint(&ring->p_tail, delta);
 	return true;
 }
 
@@ -226,16 +224,15 @@ _ck_ring_dequeue_sc(struct ck_ring *ring,
 	unsigned int consumer, producer;
 
 	consumer = ring->c_head;
-	producer = ck_pr_load_uint(&ring->p_tail);
-
-	if (CK_CC_UNLIKELY(consumer == producer))
-		return false;
 
 	/*
 	 * Make sure to serialize with respect to our snapshot
 	 * of the producer counter.
 	 */
-	ck_pr_fence_load();
+	producer = ck_pr_load_acquire_uint(&ring->p_tail);
+
+	if (CK_CC_UNLIKELY(consumer == producer))
+		return false;
 
 	buffer = (const char *)buffer + size * (consumer & mask);
 	memcpy(target, buffer, size);
@@ -244,8 +241,7 @@ _ck_ring_dequeue_sc(struct ck_ring *ring,
 	 * Make sure copy is completed with respect to consumer
 	 * update.
 	 */
-	ck_pr_fence_store();
-	ck_pr_store_uint(&ring->c_head, consumer + 1);
+	ck_pr_store_release_uint(&ring->c_head, consumer + 1);
 	return true;
 }
 
@@ -303,8 +299,7 @@ _ck_ring_enqueue_commit_mp(struct ck_ring *ring, unsigned int producer)
 	while (ck_pr_load_uint(&ring->p_tail) != producer)
 		ck_pr_stall();
 
-	ck_pr_fence_store();
-	ck_pr_store_uint(&ring->p_tail, producer + 1);
+	ck_pr_store_release_uint(&ring->p_tail, producer + 1);
 	return;
 }
 
@@ -384,8 +379,7 @@ _ck_ring_enqueue_mp(struct ck_ring *ring,
 	 * Ensure that copy is completed before updating shared producer
 	 * counter.
 	 */
-	ck_pr_fence_store();
-	ck_pr_store_uint(&ring->p_tail, delta);
+	ck_pr_store_release_uint(&ring->p_tail, delta);
 
 leave:
 	if (size != NULL)
@@ -420,13 +414,11 @@ _ck_ring_trydequeue_mc(struct ck_ring *ring,
 
 	consumer = ck_pr_load_uint(&ring->c_head);
 	ck_pr_fence_load();
-	producer = ck_pr_load_uint(&ring->p_tail);
+	producer = ck_pr_load_acquire_uint(&ring->p_tail);
 
 	if (CK_CC_UNLIKELY(consumer == producer))
 		return false;
 
-	ck_pr_fence_load();
-
 	buffer = (const char *)buffer + size * (consumer & mask);
 	memcpy(data, buffer, size);
 
@@ -453,13 +445,11 @@ _ck_ring_dequeue_mc(struct ck_ring *ring,
 		 * our latest consumer snapshot.
 		 */
 		ck_pr_fence_load();
-		producer = ck_pr_load_uint(&ring->p_tail);
+		producer = ck_pr_load_acquire_uint(&ring->p_tail);
 
 		if (CK_CC_UNLIKELY(consumer == producer))
 			return false;
 
-		ck_pr_fence_load();
-
 		target = (const char *)buffer + ts * (consumer & mask);
 		memcpy(data, target, ts);
 
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_RWCOHORT_SNZI_H
+#define CK_RWCOHORT_SNZI_H
+
+/*
+ * Variants of the writer-preference and reader-preference cohort
+ * reader-writer locks of ck_rwcohort.h whose readers are tracked by a
+ * scalable non-zero indicator (see ck_snzi.h) instead of a single shared
+ * counter. Writers only need to know whether any reader is present, which
+ * is exactly the query an SNZI answers from its root.
+ *
+ * Read-side operations take an additional leaf hint. Using the index of
+ * the caller's cohort (its NUMA node) confines most reader traffic to
+ * node-local cache lines. The neutral variant is not provided, as its
+ * readers are already serialized by the cohort lock.
+ */
+
+#include <ck_cc.h>
+#include <ck_cohort.h>
+#include <ck_pr.h>
+#include <ck_snzi.h>
+#include <ck_stddef.h>
+
+#ifdef CK_F_SNZI
+#define CK_F_RWCOHORT_SNZI
+
+#define CK_RWCOHORT_SNZI_WP_NAME(N) ck_rwcohort_snzi_wp_##N
+#define CK_RWCOHORT_SNZI_WP_INSTANCE(N) struct CK_RWCOHORT_SNZI_WP_NAME(N)
+#define CK_RWCOHORT_SNZI_WP_INIT(N, RW, NODES, L, F, WL)	\
+	ck_rwcohort_snzi_wp_##N##_init(RW, NODES, L, F, WL)
+#define CK_RWCOHORT_SNZI_WP_READ_LOCK(N, RW, C, GC, LC, H)	\
+	ck_rwcohort_snzi_wp_##N##_read_lock(RW, C, GC, LC, H)
+#define CK_RWCOHORT_SNZI_WP_READ_UNLOCK(N, RW, C, GC, LC, H)	\
+	ck_rwcohort_snzi_wp_##N##_read_unlock(RW, H)
+#define CK_RWCOHORT_SNZI_WP_WRITE_LOCK(N, RW, C, GC, LC)	\
+	ck_rwcohort_snzi_wp_##N##_write_lock(RW, C, GC, LC)
+#define CK_RWCOHORT_SNZI_WP_WRITE_UNLOCK(N, RW, C, GC, LC)	\
+	ck_rwcohort_snzi_wp_##N##_write_unlock(RW, C, GC, LC)
+#define CK_RWCOHORT_SNZI_WP_DEFAULT_WAIT_LIMIT 1000
+
+#define CK_RWCOHORT_SNZI_WP_PROTOTYPE(N)						\
+	CK_RWCOHORT_SNZI_WP_INSTANCE(N) {						\
+		struct ck_snzi readers;							\
+		unsigned int write_barrier;						\
+		unsigned int wait_limit;						\
+	};										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_wp_##N##_init(CK_RWCOHORT_SNZI_WP_INSTANCE(N) *rw_cohort,	\
+	    struct ck_snzi_node *nodes, unsigned int n_leaves, unsigned int fanout,	\
+	    unsigned int wait_limit)							\
+	{										\
+											\
+		ck_snzi_init(&rw_cohort->readers, nodes, n_leaves, fanout);		\
+		rw_cohort->write_barrier = 0;						\
+		rw_cohort->wait_limit = wait_limit;					\
+		ck_pr_barrier();							\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_wp_##N##_write_lock(CK_RWCOHORT_SNZI_WP_INSTANCE(N) *rw_cohort,\
+	    CK_COHORT_INSTANCE(N) *cohort, void *global_context,			\
+	    void *local_context)							\
+	{										\
+											\
+		while (ck_pr_load_uint(&rw_cohort->write_barrier) > 0)			\
+			ck_pr_stall();							\
+											\
+		CK_COHORT_LOCK(N, cohort, global_context, local_context);		\
+		ck_pr_fence_atomic_load();						\
+											\
+		while (ck_snzi_query(&rw_cohort->readers) == true)			\
+			ck_pr_stall();							\
+											\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_wp_##N##_write_unlock(CK_RWCOHORT_SNZI_WP_INSTANCE(N) *rw_cohort,\
+	    CK_COHORT_INSTANCE(N) *cohort, void *global_context,			\
+	    void *local_context)							\
+	{										\
+											\
+		(void)rw_cohort;							\
+		CK_COHORT_UNLOCK(N, cohort, global_context, local_context);		\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_wp_##N##_read_lock(CK_RWCOHORT_SNZI_WP_INSTANCE(N) *rw_cohort,	\
+	    CK_COHORT_INSTANCE(N) *cohort, void *global_context,			\
+	    void *local_context, unsigned int hint)					\
+	{										\
+		unsigned int wait_count = 0;						\
+		bool raised = false;							\
+											\
+		for (;;) {								\
+			ck_snzi_arrive(&rw_cohort->readers, hint);			\
+			ck_pr_fence_atomic_load();					\
+			if (CK_COHORT_LOCKED(N, cohort, global_context,			\
+			    local_context) == false)					\
+				break;							\
+											\
+			ck_snzi_depart(&rw_cohort->readers, hint);			\
+			while (CK_COHORT_LOCKED(N, cohort, global_context,		\
+			    local_context) == true) {					\
+				ck_pr_stall();						\
+				if (++wait_count > rw_cohort->wait_limit &&		\
+				    raised == false) {					\
+					ck_pr_inc_uint(&rw_cohort->write_barrier);	\
+					raised = true;					\
+				}							\
+			}								\
+		}									\
+											\
+		if (raised == true)							\
+			ck_pr_dec_uint(&rw_cohort->write_barrier);			\
+											\
+		ck_pr_fence_load();							\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_wp_##N##_read_unlock(CK_RWCOHORT_SNZI_WP_INSTANCE(N) *cohort,	\
+	    unsigned int hint)								\
+	{										\
+											\
+		ck_pr_fence_load_atomic();						\
+		ck_snzi_depart(&cohort->readers, hint);					\
+		return;									\
+	}
+
+#define CK_RWCOHORT_SNZI_WP_INITIALIZER(leaves, n_leaves) {				\
+	.readers = CK_SNZI_INITIALIZER(leaves, n_leaves),				\
+	.write_barrier = 0,								\
+	.wait_limit = 0									\
+}
+
+#define CK_RWCOHORT_SNZI_RP_NAME(N) ck_rwcohort_snzi_rp_##N
+#define CK_RWCOHORT_SNZI_RP_INSTANCE(N) struct CK_RWCOHORT_SNZI_RP_NAME(N)
+#define CK_RWCOHORT_SNZI_RP_INIT(N, RW, NODES, L, F, WL)	\
+	ck_rwcohort_snzi_rp_##N##_init(RW, NODES, L, F, WL)
+#define CK_RWCOHORT_SNZI_RP_READ_LOCK(N, RW, C, GC, LC, H)	\
+	ck_rwcohort_snzi_rp_##N##_read_lock(RW, C, GC, LC, H)
+#define CK_RWCOHORT_SNZI_RP_READ_UNLOCK(N, RW, C, GC, LC, H)	\
+	ck_rwcohort_snzi_rp_##N##_read_unlock(RW, H)
+#define CK_RWCOHORT_SNZI_RP_WRITE_LOCK(N, RW, C, GC, LC)	\
+	ck_rwcohort_snzi_rp_##N##_write_lock(RW, C, GC, LC)
+#define CK_RWCOHORT_SNZI_RP_WRITE_UNLOCK(N, RW, C, GC, LC)	\
+	ck_rwcohort_snzi_rp_##N##_write_unlock(RW, C, GC, LC)
+#define CK_RWCOHORT_SNZI_RP_DEFAULT_WAIT_LIMIT 1000
+
+#define CK_RWCOHORT_SNZI_RP_PROTOTYPE(N)						\
+	CK_RWCOHORT_SNZI_RP_INSTANCE(N) {						\
+		struct ck_snzi readers;							\
+		unsigned int read_barrier;						\
+		unsigned int wait_limit;						\
+	};										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_rp_##N##_init(CK_RWCOHORT_SNZI_RP_INSTANCE(N) *rw_cohort,	\
+	    struct ck_snzi_node *nodes, unsigned int n_leaves, unsigned int fanout,	\
+	    unsigned int wait_limit)							\
+	{										\
+											\
+		ck_snzi_init(&rw_cohort->readers, nodes, n_leaves, fanout);		\
+		rw_cohort->read_barrier = 0;						\
+		rw_cohort->wait_limit = wait_limit;					\
+		ck_pr_barrier();							\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_rp_##N##_write_lock(CK_RWCOHORT_SNZI_RP_INSTANCE(N) *rw_cohort,\
+	    CK_COHORT_INSTANCE(N) *cohort, void *global_context,			\
+	    void *local_context)							\
+	{										\
+		unsigned int wait_count = 0;						\
+		bool raised = false;							\
+											\
+		for (;;) {								\
+			CK_COHORT_LOCK(N, cohort, global_context, local_context);	\
+			ck_pr_fence_atomic_load();					\
+			if (ck_snzi_query(&rw_cohort->readers) == false)		\
+				break;							\
+											\
+			CK_COHORT_UNLOCK(N, cohort, global_context, local_context);	\
+			while (ck_snzi_query(&rw_cohort->readers) == true) {		\
+				ck_pr_stall();						\
+				if (++wait_count > rw_cohort->wait_limit &&		\
+				    raised == false) {					\
+					ck_pr_inc_uint(&rw_cohort->read_barrier);	\
+					raised = true;					\
+				}							\
+			}								\
+		}									\
+											\
+		if (raised == true)							\
+			ck_pr_dec_uint(&rw_cohort->read_barrier);			\
+											\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_rp_##N##_write_unlock(CK_RWCOHORT_SNZI_RP_INSTANCE(N) *rw_cohort,\
+	    CK_COHORT_INSTANCE(N) *cohort, void *global_context, void *local_context)	\
+	{										\
+											\
+		(void)rw_cohort;							\
+		CK_COHORT_UNLOCK(N, cohort, global_context, local_context);		\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_rp_##N##_read_lock(CK_RWCOHORT_SNZI_RP_INSTANCE(N) *rw_cohort,	\
+	    CK_COHORT_INSTANCE(N) *cohort, void *global_context,			\
+	    void *local_context, unsigned int hint)					\
+	{										\
+											\
+		while (ck_pr_load_uint(&rw_cohort->read_barrier) > 0)			\
+			ck_pr_stall();							\
+											\
+		ck_snzi_arrive(&rw_cohort->readers, hint);				\
+		ck_pr_fence_atomic_load();						\
+											\
+		while (CK_COHORT_LOCKED(N, cohort, global_context,			\
+		    local_context) == true)						\
+			ck_pr_stall();							\
+											\
+		return;									\
+	}										\
+	CK_CC_INLINE static void							\
+	ck_rwcohort_snzi_rp_##N##_read_unlock(CK_RWCOHORT_SNZI_RP_INSTANCE(N) *cohort,	\
+	    unsigned int hint)								\
+	{										\
+											\
+		ck_pr_fence_load_atomic();						\
+		ck_snzi_depart(&cohort->readers, hint);					\
+		return;									\
+	}
+
+#define CK_RWCOHORT_SNZI_RP_INITIALIZER(leaves, n_leaves) {				\
+	.readers = CK_SNZI_INITIALIZER(leaves, n_leaves),				\
+	.read_barrier = 0,								\
+	.wait_limit = 0									\
+}
+
+#endif /* CK_F_SNZI */
+#endif /* CK_RWCOHORT_SNZI_H */
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_RWLOCK_EC_H
+#define CK_RWLOCK_EC_H
+
+/*
+ * Blocking variant of ck_rwlock. The lock word and its writer preference
+ * policy are those of ck_rwlock, but waiters sleep on event counts after
+ * an adaptive spin phase rather than busy-waiting indefinitely. Readers
+ * and writers wait on separate event counts so that an unlock operation
+ * only wakes the class of waiters that may make progress.
+ *
+ * Every operation takes a multiple producer ck_ec_mode, which provides
+ * the operating system's wait and wake primitives.
+ */
+
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_pr.h>
+#include <ck_rwlock.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+struct ck_rwlock_ec {
+	struct ck_rwlock rw;
+	struct ck_ec32 readers;
+	struct ck_ec32 writers;
+	uint32_t readers_spin;
+	uint32_t writers_spin;
+};
+typedef struct ck_rwlock_ec ck_rwlock_ec_t;
+
+#define CK_RWLOCK_EC_INITIALIZER { CK_RWLOCK_INITIALIZER, \
+	CK_EC_INITIALIZER, CK_EC_INITIALIZER, 0, 0 }
+
+CK_CC_INLINE static void
+ck_rwlock_ec_init(struct ck_rwlock_ec *lock)
+{
+
+	ck_ec32_init(&lock->readers, 0);
+	ck_ec32_init(&lock->writers, 0);
+	lock->readers_spin = 0;
+	lock->writers_spin = 0;
+	ck_rwlock_init(&lock->rw);
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_ec_writer_idle(void *data)
+{
+	struct ck_rwlock *rw = data;
+
+	return ck_pr_load_uint(&rw->writer) == 0;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_ec_readers_idle(void *data)
+{
+	struct ck_rwlock *rw = data;
+
+	return ck_pr_load_uint(&rw->n_readers) == 0;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_ec_locked(struct ck_rwlock_ec *lock)
+{
+
+	return ck_rwlock_locked(&lock->rw);
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_ec_write_trylock(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	if (ck_pr_fas_uint(&lock->rw.writer, 1) != 0)
+		return false;
+
+	ck_pr_fence_atomic_load();
+
+	if (ck_pr_load_uint(&lock->rw.n_readers) != 0) {
+		ck_pr_fence_unlock();
+		ck_pr_store_uint(&lock->rw.writer, 0);
+
+		/*
+		 * Other threads may have observed the writer bit and
+		 * blocked in the meantime.
+		 */
+		ck_pr_fence_store_load();
+		ck_ec32_signal(&lock->writers, mode);
+		ck_ec32_signal(&lock->readers, mode);
+		return false;
+	}
+
+	ck_pr_fence_lock();
+	return true;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_ec_write_lock(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	while (ck_pr_fas_uint(&lock->rw.writer, 1) != 0) {
+		ck_ec32_wait_until(&lock->writers, mode, &lock->writers_spin,
+		    ck_rwlock_ec_writer_idle, &lock->rw);
+	}
+
+	ck_pr_fence_atomic_load();
+
+	if (ck_pr_load_uint(&lock->rw.n_readers) != 0) {
+		ck_ec32_wait_until(&lock->writers, mode, &lock->writers_spin,
+		    ck_rwlock_ec_readers_idle, &lock->rw);
+	}
+
+	ck_pr_fence_lock();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_ec_write_unlock(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	ck_pr_fence_unlock();
+	ck_pr_store_uint(&lock->rw.writer, 0);
+
+	/*
+	 * Writers have preference. Readers are only woken up once there
+	 * is no writer left to hand the lock to, the last writer to
+	 * release the lock is responsible for waking them.
+	 */
+	ck_pr_fence_store_load();
+	if (ck_ec32_has_waiters(&lock->writers) == true) {
+		ck_ec32_signal(&lock->writers, mode);
+		return;
+	}
+
+	ck_ec32_signal(&lock->readers, mode);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_ec_write_downgrade(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	ck_pr_inc_uint(&lock->rw.n_readers);
+	ck_pr_fence_unlock();
+	ck_pr_store_uint(&lock->rw.writer, 0);
+	ck_pr_fence_store_load();
+	ck_ec32_signal(&lock->writers, mode);
+	ck_ec32_signal(&lock->readers, mode);
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_ec_read_trylock(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	if (ck_pr_load_uint(&lock->rw.writer) != 0)
+		return false;
+
+	ck_pr_inc_uint(&lock->rw.n_readers);
+	ck_pr_fence_atomic_load();
+
+	if (ck_pr_load_uint(&lock->rw.writer) == 0) {
+		ck_pr_fence_lock();
+		return true;
+	}
+
+	ck_pr_dec_uint(&lock->rw.n_readers);
+	ck_pr_fence_atomic_load();
+	ck_ec32_signal(&lock->writers, mode);
+	return false;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_ec_read_lock(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	for (;;) {
+		if (ck_pr_load_uint(&lock->rw.writer) != 0) {
+			ck_ec32_wait_until(&lock->readers, mode,
+			    &lock->readers_spin, ck_rwlock_ec_writer_idle,
+			    &lock->rw);
+		}
+
+		ck_pr_inc_uint(&lock->rw.n_readers);
+
+		/*
+		 * Serialize with respect to concurrent write
+		 * lock operation.
+		 */
+		ck_pr_fence_atomic_load();
+
+		if (ck_pr_load_uint(&lock->rw.writer) == 0)
+			break;
+
+		/*
+		 * A writer may be waiting for the reader count to drain,
+		 * and our increment may have been the last thing it saw.
+		 */
+		ck_pr_dec_uint(&lock->rw.n_readers);
+		ck_pr_fence_atomic_load();
+		ck_ec32_signal(&lock->writers, mode);
+	}
+
+	ck_pr_fence_load();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_ec_read_unlock(struct ck_rwlock_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	ck_pr_fence_load_atomic();
+	if (ck_pr_faa_uint(&lock->rw.n_readers, -1U) == 1) {
+		ck_pr_fence_atomic_load();
+		ck_ec32_signal(&lock->writers, mode);
+	}
+
+	return;
+}
+
+#endif /* CK_RWLOCK_EC_H */
@@ -0,0 +1,205 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_RWLOCK_SNZI_H
+#define CK_RWLOCK_SNZI_H
+
+/*
+ * Writer-preference reader-writer lock with the same protocol as
+ * ck_rwlock, but readers announce themselves through a scalable non-zero
+ * indicator (see ck_snzi.h) rather than a single shared counter. Read
+ * acquisitions directed at different leaves do not write to a common
+ * cache line unless a leaf's surplus changes between zero and non-zero,
+ * so read-mostly workloads scale with the number of leaves. Writers only
+ * poll the SNZI root indicator.
+ *
+ * Read-side operations take a leaf hint, typically the NUMA node or core
+ * of the caller. An unlock must use the hint of the matching lock.
+ */
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_snzi.h>
+#include <ck_stdbool.h>
+
+#ifdef CK_F_SNZI
+#define CK_F_RWLOCK_SNZI
+
+struct ck_rwlock_snzi {
+	unsigned int writer;
+	struct ck_snzi readers;
+};
+typedef struct ck_rwlock_snzi ck_rwlock_snzi_t;
+
+#define CK_RWLOCK_SNZI_INITIALIZER(leaves, n_leaves) \
+	{ 0, CK_SNZI_INITIALIZER(leaves, n_leaves) }
+
+CK_CC_INLINE static void
+ck_rwlock_snzi_init(struct ck_rwlock_snzi *rw, struct ck_snzi_node *nodes,
+    unsigned int n_leaves, unsigned int fanout)
+{
+
+	rw->writer = 0;
+	ck_snzi_init(&rw->readers, nodes, n_leaves, fanout);
+	ck_pr_barrier();
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_snzi_locked(struct ck_rwlock_snzi *rw)
+{
+	bool l;
+
+	l = ck_pr_load_uint(&rw->writer) != 0 ||
+	    ck_snzi_query(&rw->readers) == true;
+	ck_pr_fence_acquire();
+	return l;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_snzi_locked_writer(struct ck_rwlock_snzi *rw)
+{
+	bool r;
+
+	r = ck_pr_load_uint(&rw->writer);
+	ck_pr_fence_acquire();
+	return r;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_snzi_write_unlock(struct ck_rwlock_snzi *rw)
+{
+
+	ck_pr_fence_unlock();
+	ck_pr_store_uint(&rw->writer, 0);
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_snzi_write_trylock(struct ck_rwlock_snzi *rw)
+{
+
+	if (ck_pr_fas_uint(&rw->writer, 1) != 0)
+		return false;
+
+	ck_pr_fence_atomic_load();
+
+	if (ck_snzi_query(&rw->readers) == true) {
+		ck_rwlock_snzi_write_unlock(rw);
+		return false;
+	}
+
+	ck_pr_fence_lock();
+	return true;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_snzi_write_lock(struct ck_rwlock_snzi *rw)
+{
+
+	while (ck_pr_fas_uint(&rw->writer, 1) != 0)
+		ck_pr_stall();
+
+	ck_pr_fence_atomic_load();
+
+	while (ck_snzi_query(&rw->readers) == true)
+		ck_pr_stall();
+
+	ck_pr_fence_lock();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_snzi_write_downgrade(struct ck_rwlock_snzi *rw, unsigned int hint)
+{
+
+	ck_snzi_arrive(&rw->readers, hint);
+	ck_rwlock_snzi_write_unlock(rw);
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_rwlock_snzi_read_trylock(struct ck_rwlock_snzi *rw, unsigned int hint)
+{
+
+	if (ck_pr_load_uint(&rw->writer) != 0)
+		return false;
+
+	ck_snzi_arrive(&rw->readers, hint);
+
+	/*
+	 * Serialize with respect to concurrent write
+	 * lock operation.
+	 */
+	ck_pr_fence_atomic_load();
+
+	if (ck_pr_load_uint(&rw->writer) == 0) {
+		ck_pr_fence_lock();
+		return true;
+	}
+
+	ck_snzi_depart(&rw->readers, hint);
+	return false;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_snzi_read_lock(struct ck_rwlock_snzi *rw, unsigned int hint)
+{
+
+	for (;;) {
+		while (ck_pr_load_uint(&rw->writer) != 0)
+			ck_pr_stall();
+
+		ck_snzi_arrive(&rw->readers, hint);
+
+		/*
+		 * Serialize with respect to concurrent write
+		 * lock operation.
+		 */
+		ck_pr_fence_atomic_load();
+
+		if (ck_pr_load_uint(&rw->writer) == 0)
+			break;
+
+		ck_snzi_depart(&rw->readers, hint);
+	}
+
+	/* Acquire semantics are necessary. */
+	ck_pr_fence_load();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_rwlock_snzi_read_unlock(struct ck_rwlock_snzi *rw, unsigned int hint)
+{
+
+	ck_pr_fence_load_atomic();
+	ck_snzi_depart(&rw->readers, hint);
+	return;
+}
+
+#endif /* CK_F_SNZI */
+#endif /* CK_RWLOCK_SNZI_H */
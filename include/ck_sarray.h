@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_SARRAY_H
+#define CK_SARRAY_H
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+
+/*
+ * A segmented variant of ck_array. Values live in fixed-size segments
+ * reached through a directory, so growth appends a segment rather than
+ * copying existing values. Every put returns a stable handle that is
+ * used for O(1) removal: the last value is moved into the vacated slot.
+ * Readers see consistent snapshots exactly as with ck_array, but a
+ * removal only copies the one segment that readers may still observe
+ * rather than the whole buffer. Replaced segments and directories are
+ * released through the allocator with the defer flag set.
+ */
+#ifndef CK_SARRAY_SEGMENT
+#define CK_SARRAY_SEGMENT 256U
+#endif
+
+struct _ck_sarray {
+	unsigned int n_committed;
+	unsigned int n_segments;
+	void **segments[];
+};
+
+/*
+ * Writer-private bookkeeping for each segment. A slot may only be written
+ * in place if no published snapshot referencing the segment ever exposed
+ * it, otherwise the segment is first copied into the transaction.
+ */
+struct _ck_sarray_segment {
+	unsigned int exposed;
+	unsigned int owned;
+};
+
+struct ck_sarray {
+	struct ck_malloc *allocator;
+	struct _ck_sarray *active;
+	struct _ck_sarray *transaction;
+	unsigned int n_entries;
+	unsigned int n_allocated;
+	unsigned int n_map;
+	unsigned int n_handles;
+	unsigned int free_handle;
+	unsigned int *slots;
+	unsigned int *handles;
+	struct _ck_sarray_segment *state;
+};
+typedef struct ck_sarray ck_sarray_t;
+
+struct ck_sarray_iterator {
+	struct _ck_sarray *snapshot;
+};
+typedef struct ck_sarray_iterator ck_sarray_iterator_t;
+
+#define CK_SARRAY_MODE_SPMC 0U
+
+bool ck_sarray_init(ck_sarray_t *, unsigned int, struct ck_malloc *, unsigned int);
+bool ck_sarray_commit(ck_sarray_t *);
+bool ck_sarray_put(ck_sarray_t *, void *, unsigned int *);
+bool ck_sarray_remove(ck_sarray_t *, unsigned int);
+void *ck_sarray_get(ck_sarray_t *, unsigned int);
+void ck_sarray_deinit(ck_sarray_t *, bool);
+
+CK_CC_INLINE static unsigned int
+ck_sarray_length(struct ck_sarray *array)
+{
+	struct _ck_sarray *a = ck_pr_load_ptr(&array->active);
+
+	ck_pr_fence_load();
+	return ck_pr_load_uint(&a->n_committed);
+}
+
+CK_CC_INLINE static bool
+ck_sarray_initialized(struct ck_sarray *array)
+{
+
+	return ck_pr_load_ptr(&array->active) != NULL;
+}
+
+#define CK_SARRAY_FOREACH(a, i, b)					\
+	(i)->snapshot = ck_pr_load_ptr(&(a)->active);			\
+	ck_pr_fence_load();						\
+	for (unsigned int _ck_i = 0;					\
+	    _ck_i < (i)->snapshot->n_committed &&			\
+	    ((*b) = ck_pr_load_ptr(&(i)->snapshot->segments		\
+	    [_ck_i / CK_SARRAY_SEGMENT][_ck_i % CK_SARRAY_SEGMENT]), 1);\
+	    _ck_i++)
+
+#endif /* CK_SARRAY_H */
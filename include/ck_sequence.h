@@ -30,6 +30,10 @@
 #include <ck_cc.h>
 #include <ck_pr.h>
 #include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_string.h>
+
+#include "spinlock/ticket.h"
 
 struct ck_sequence {
 	unsigned int sequence;
@@ -122,4 +126,131 @@ ck_sequence_write_end(struct ck_sequence *sq)
 	return;
 }
 
+/*
+ * Copies len bytes from src to dst so that the copy is consistent with
+ * respect to writers of sq. The copy itself is a plain memcpy and may
+ * observe a torn object; it is simply repeated until it is validated by an
+ * unchanged, even sequence. dst must be private to the caller and must
+ * not overlap src.
+ *
+ * Returns the number of failed attempts, which may be used to monitor
+ * read-side contention.
+ */
+CK_CC_INLINE static unsigned int
+ck_sequence_snapshot(const struct ck_sequence *sq, void *dst,
+    const void *src, size_t len)
+{
+	unsigned int retries = 0;
+	unsigned int version;
+
+	for (;;) {
+		version = ck_pr_load_uint(&sq->sequence);
+		if (CK_CC_LIKELY((version & 1) == 0)) {
+			ck_pr_fence_load();
+			memcpy(dst, src, len);
+			if (ck_sequence_read_retry(sq, version) == false)
+				break;
+		}
+
+		retries++;
+		ck_pr_stall();
+	}
+
+	return retries;
+}
+
+/*
+ * A sequence counter for multiple writers. Writers are serialized by an
+ * embedded ticket lock. Readers normally proceed optimistically, but a
+ * snapshot that fails to validate a number of times acquires the ticket
+ * lock itself, so long objects under frequent updates cannot starve
+ * readers.
+ */
+struct ck_sequence_mw {
+	struct ck_sequence sequence;
+	struct ck_spinlock_ticket lock;
+};
+typedef struct ck_sequence_mw ck_sequence_mw_t;
+
+#define CK_SEQUENCE_MW_INITIALIZER {			\
+	.sequence = CK_SEQUENCE_INITIALIZER,		\
+	.lock = CK_SPINLOCK_TICKET_INITIALIZER		\
+}
+
+#ifndef CK_SEQUENCE_MW_RETRY
+#define CK_SEQUENCE_MW_RETRY 8
+#endif
+
+CK_CC_INLINE static void
+ck_sequence_mw_init(struct ck_sequence_mw *sq)
+{
+
+	ck_spinlock_ticket_init(&sq->lock);
+	ck_sequence_init(&sq->sequence);
+	return;
+}
+
+CK_CC_INLINE static unsigned int
+ck_sequence_mw_read_begin(const struct ck_sequence_mw *sq)
+{
+
+	return ck_sequence_read_begin(&sq->sequence);
+}
+
+CK_CC_INLINE static bool
+ck_sequence_mw_read_retry(const struct ck_sequence_mw *sq, unsigned int version)
+{
+
+	return ck_sequence_read_retry(&sq->sequence, version);
+}
+
+CK_CC_INLINE static void
+ck_sequence_mw_write_begin(struct ck_sequence_mw *sq)
+{
+
+	ck_spinlock_ticket_lock(&sq->lock);
+	ck_sequence_write_begin(&sq->sequence);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_sequence_mw_write_end(struct ck_sequence_mw *sq)
+{
+
+	ck_sequence_write_end(&sq->sequence);
+	ck_spinlock_ticket_unlock(&sq->lock);
+	return;
+}
+
+/*
+ * Identical to ck_sequence_snapshot, except that after retry failed
+ * attempts the copy is made with the writer lock held. The return value
+ * is the number of failed optimistic attempts; if it is equal to retry,
+ * the snapshot was taken in locked mode.
+ */
+CK_CC_INLINE static unsigned int
+ck_sequence_mw_snapshot(struct ck_sequence_mw *sq, void *dst,
+    const void *src, size_t len, unsigned int retry)
+{
+	unsigned int retries;
+	unsigned int version;
+
+	for (retries = 0; retries < retry; retries++) {
+		version = ck_pr_load_uint(&sq->sequence.sequence);
+		if (CK_CC_LIKELY((version & 1) == 0)) {
+			ck_pr_fence_load();
+			memcpy(dst, src, len);
+			if (ck_sequence_read_retry(&sq->sequence, version) == false)
+				return retries;
+		}
+
+		ck_pr_stall();
+	}
+
+	ck_spinlock_ticket_lock(&sq->lock);
+	memcpy(dst, src, len);
+	ck_spinlock_ticket_unlock(&sq->lock);
+	return retries;
+}
+
 #endif /* CK_SEQUENCE_H */
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_SKIPLIST_H
+#define CK_SKIPLIST_H
+
+#include <ck_cc.h>
+#include <ck_malloc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+
+/*
+ * An ordered set of entries implemented as a skip list. Readers are
+ * lock-free and never write to shared memory. Every node is a single
+ * allocation whose tower is sized to the height of the node.
+ *
+ * A node is unlinked one level at a time, from the top of its tower down,
+ * so a reader may still be descending through it after it has left every
+ * level, and an iterator keeps a cursor on the node it last returned.
+ * Removed nodes are released through the allocator with the defer flag
+ * set. The allocator must keep such a node intact until every operation
+ * and every iteration that started before the removal has finished, e.g.
+ * by retiring it with ck_epoch_call and running each of them, from the
+ * first call to the last use of the cursor, in one epoch section.
+ */
+#ifndef CK_SKIPLIST_HEIGHT
+#define CK_SKIPLIST_HEIGHT 16U
+#endif
+
+/*
+ * Indicates a single-writer many-reader workload. Mutually exclusive with
+ * CK_SKIPLIST_MODE_MPMC.
+ */
+#define CK_SKIPLIST_MODE_SPMC 0U
+
+/*
+ * Indicates that put and remove may be called concurrently. Writers are
+ * lock-free and logically delete nodes by marking their towers.
+ */
+#define CK_SKIPLIST_MODE_MPMC 1U
+
+/*
+ * Returns a negative value, zero or a positive value if the entry in the
+ * first argument orders before, with or after the key in the second. The
+ * key is either a search key or an entry being inserted.
+ */
+typedef int ck_skiplist_compare_cb_t(const void *, const void *);
+
+struct ck_skiplist_node {
+	const void *entry;
+	unsigned int height;
+	unsigned int references;
+	struct ck_skiplist_node *next[];
+};
+
+struct ck_skiplist {
+	struct ck_malloc *m;
+	ck_skiplist_compare_cb_t *compare;
+	unsigned int mode;
+	unsigned int height;
+	unsigned int n_entries;
+	unsigned int sequence;
+	unsigned long seed;
+	struct ck_skiplist_node *head;
+};
+typedef struct ck_skiplist ck_skiplist_t;
+
+struct ck_skiplist_iterator {
+	struct ck_skiplist_node *cursor;
+};
+typedef struct ck_skiplist_iterator ck_skiplist_iterator_t;
+
+#define CK_SKIPLIST_ITERATOR_INITIALIZER { NULL }
+
+bool ck_skiplist_init(ck_skiplist_t *, unsigned int,
+    ck_skiplist_compare_cb_t *, struct ck_malloc *, unsigned long);
+void ck_skiplist_destroy(ck_skiplist_t *);
+void *ck_skiplist_get(ck_skiplist_t *, const void *);
+bool ck_skiplist_put(ck_skiplist_t *, const void *);
+void *ck_skiplist_remove(ck_skiplist_t *, const void *);
+unsigned int ck_skiplist_count(ck_skiplist_t *);
+void ck_skiplist_iterator_init(ck_skiplist_t *, ck_skiplist_iterator_t *);
+void ck_skiplist_lower_bound(ck_skiplist_t *, ck_skiplist_iterator_t *,
+    const void *);
+bool ck_skiplist_next(ck_skiplist_t *, ck_skiplist_iterator_t *, void **);
+
+#endif /* CK_SKIPLIST_H */
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_SNZI_H
+#define CK_SNZI_H
+
+/*
+ * This is an implementation of the hierarchical scalable non-zero
+ * indicator as described in:
+ *     Ellen, F.; Lev, Y.; Luchangco, V.; and Moir, M. 2007.
+ *     SNZI: Scalable NonZero Indicators
+ *
+ * An SNZI answers one question, "is the surplus of arrivals over
+ * departures non-zero?", without requiring every arrival to modify a
+ * single shared word. Arrivals and departures are directed at a leaf of a
+ * tree of counters, and a node only propagates to its parent when its own
+ * surplus changes between zero and non-zero. Writers of a reader-writer
+ * lock only ever need this answer, so readers that are spread across
+ * leaves (for example, one leaf per NUMA node or per core) no longer
+ * contend on a single reader counter.
+ *
+ * The caller provides the tree storage. ck_snzi_size returns the number of
+ * nodes required for a given number of leaves and fan-out. The first
+ * n_leaves entries of the node array are the leaves. A tree whose leaves
+ * all report directly to the root (n_leaves <= fanout) has no other
+ * interior nodes, and its zeroed storage may be set up statically with
+ * CK_SNZI_INITIALIZER.
+ */
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+#if defined(CK_F_PR_CAS_64) && defined(CK_F_PR_LOAD_64)
+#define CK_F_SNZI
+
+/*
+ * Node state layout. The surplus is kept in units of one half, as the
+ * algorithm requires an intermediate 1/2 state while a 0 to 1 transition
+ * is being propagated to the parent.
+ *
+ *  0-31: surplus (x2)
+ * 32-63: version
+ */
+#define CK_SNZI_HALF			1ULL
+#define CK_SNZI_ONE			2ULL
+#define CK_SNZI_COUNT(x)		((x) & 0xffffffffULL)
+#define CK_SNZI_VERSION(x)		((x) >> 32)
+#define CK_SNZI_STATE(c, v)		(((uint64_t)(v) << 32) | (c))
+
+/*
+ * Root state layout.
+ *
+ *  0-30: surplus
+ *    31: announce
+ * 32-63: version
+ *
+ * The indicator word carries the query result in bit 0 and is versioned
+ * in the remaining bits so that a stale departure cannot clear it.
+ */
+#define CK_SNZI_ROOT_ANNOUNCE		(1ULL << 31)
+#define CK_SNZI_ROOT_COUNT(x)		((x) & (CK_SNZI_ROOT_ANNOUNCE - 1))
+#define CK_SNZI_INDICATOR		1ULL
+
+struct ck_snzi_node {
+	uint64_t state;
+	struct ck_snzi_node *parent;
+} CK_CC_CACHELINE;
+typedef struct ck_snzi_node ck_snzi_node_t;
+
+struct ck_snzi {
+	uint64_t root;
+	uint64_t indicator;
+	struct ck_snzi_node *leaves;
+	unsigned int n_leaves;
+};
+typedef struct ck_snzi ck_snzi_t;
+
+#define CK_SNZI_INITIALIZER(leaves, n_leaves) { 0, 0, (leaves), (n_leaves) }
+
+void ck_snzi_init(struct ck_snzi *, struct ck_snzi_node *, unsigned int,
+    unsigned int);
+void ck_snzi_arrive_slow(struct ck_snzi *, struct ck_snzi_node *);
+void ck_snzi_depart_slow(struct ck_snzi *, struct ck_snzi_node *);
+
+/*
+ * Returns the number of nodes needed for a tree with the specified number
+ * of leaves and fan-out. The fan-out must be at least 2.
+ */
+CK_CC_INLINE static unsigned int
+ck_snzi_size(unsigned int n_leaves, unsigned int fanout)
+{
+	unsigned int n = 0;
+
+	for (;;) {
+		n += n_leaves;
+		if (n_leaves <= fanout)
+			break;
+
+		n_leaves = (n_leaves + fanout - 1) / fanout;
+	}
+
+	return n;
+}
+
+/*
+ * Returns true if there is at least one arrival without a matching
+ * departure. This only reads the root indicator.
+ */
+CK_CC_INLINE static bool
+ck_snzi_query(const struct ck_snzi *snzi)
+{
+
+	return (ck_pr_load_64(&snzi->indicator) & CK_SNZI_INDICATOR) != 0;
+}
+
+/*
+ * Arrive at the leaf selected by hint. If the leaf already has a non-zero
+ * surplus, this is a single compare-and-swap on that leaf. The caller must
+ * depart with the same hint.
+ */
+CK_CC_INLINE static void
+ck_snzi_arrive(struct ck_snzi *snzi, unsigned int hint)
+{
+	struct ck_snzi_node *leaf = snzi->leaves + hint % snzi->n_leaves;
+	uint64_t x;
+
+	x = ck_pr_load_64(&leaf->state);
+	if (CK_SNZI_COUNT(x) >= CK_SNZI_ONE &&
+	    ck_pr_cas_64(&leaf->state, x, x + CK_SNZI_ONE) == true)
+		return;
+
+	ck_snzi_arrive_slow(snzi, leaf);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_snzi_depart(struct ck_snzi *snzi, unsigned int hint)
+{
+	struct ck_snzi_node *leaf = snzi->leaves + hint % snzi->n_leaves;
+	uint64_t x;
+
+	x = ck_pr_load_64(&leaf->state);
+	if (CK_SNZI_COUNT(x) > CK_SNZI_ONE &&
+	    ck_pr_cas_64(&leaf->state, x, x - CK_SNZI_ONE) == true)
+		return;
+
+	ck_snzi_depart_slow(snzi, leaf);
+	return;
+}
+
+#endif /* CK_F_PR_CAS_64 && CK_F_PR_LOAD_64 */
+#endif /* CK_SNZI_H */
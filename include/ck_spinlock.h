@@ -47,6 +47,7 @@
 #define ck_spinlock_init(x)	ck_spinlock_fas_init(x)
 #define ck_spinlock_lock(x)	ck_spinlock_fas_lock(x)
 #define ck_spinlock_lock_eb(x)	ck_spinlock_fas_lock_eb(x)
+#define ck_spinlock_lock_ab(x, s)	ck_spinlock_fas_lock_ab(x, s)
 #define ck_spinlock_unlock(x)	ck_spinlock_fas_unlock(x)
 #define ck_spinlock_locked(x)	ck_spinlock_fas_locked(x)
 #define ck_spinlock_trylock(x)	ck_spinlock_fas_trylock(x)
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_TFLOCK_EC_H
+#define CK_TFLOCK_EC_H
+
+/*
+ * Blocking variant of ck_tflock_ticket. Requests are still served in
+ * strict arrival (task-fair) order. Waiters spin adaptively and then
+ * sleep on one of two event counts. Readers only wait for preceding
+ * writers, so they are only woken by a write unlock. Writers wait for
+ * every preceding request and are woken by either unlock operation.
+ *
+ * Every operation takes a multiple producer ck_ec_mode, which provides
+ * the operating system's wait and wake primitives.
+ */
+
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+#include <ck_tflock.h>
+
+struct ck_tflock_ticket_ec {
+	struct ck_tflock_ticket lock;
+	struct ck_ec32 readers;
+	struct ck_ec32 writers;
+	uint32_t readers_spin;
+	uint32_t writers_spin;
+};
+typedef struct ck_tflock_ticket_ec ck_tflock_ticket_ec_t;
+
+#define CK_TFLOCK_TICKET_EC_INITIALIZER { CK_TFLOCK_TICKET_INITIALIZER, \
+	CK_EC_INITIALIZER, CK_EC_INITIALIZER, 0, 0 }
+
+struct ck_tflock_ticket_ec_wait {
+	struct ck_tflock_ticket *lock;
+	uint32_t ticket;
+};
+
+CK_CC_INLINE static void
+ck_tflock_ticket_ec_init(struct ck_tflock_ticket_ec *lock)
+{
+
+	ck_ec32_init(&lock->readers, 0);
+	ck_ec32_init(&lock->writers, 0);
+	lock->readers_spin = 0;
+	lock->writers_spin = 0;
+	ck_tflock_ticket_init(&lock->lock);
+	return;
+}
+
+CK_CC_INLINE static bool
+ck_tflock_ticket_ec_write_turn(void *data)
+{
+	struct ck_tflock_ticket_ec_wait *w = data;
+
+	return ck_pr_load_32(&w->lock->completion) == w->ticket;
+}
+
+CK_CC_INLINE static bool
+ck_tflock_ticket_ec_read_turn(void *data)
+{
+	struct ck_tflock_ticket_ec_wait *w = data;
+
+	return (ck_pr_load_32(&w->lock->completion) &
+	    CK_TFLOCK_TICKET_W_MASK) == w->ticket;
+}
+
+CK_CC_INLINE static void
+ck_tflock_ticket_ec_write_lock(struct ck_tflock_ticket_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+	struct ck_tflock_ticket_ec_wait w = { .lock = &lock->lock };
+
+	w.ticket = ck_tflock_ticket_fca_32(&lock->lock.request,
+	    CK_TFLOCK_TICKET_WC_TOPMSK, CK_TFLOCK_TICKET_WC_INCR);
+	ck_pr_fence_atomic_load();
+
+	if (ck_pr_load_32(&lock->lock.completion) != w.ticket) {
+		ck_ec32_wait_until(&lock->writers, mode, &lock->writers_spin,
+		    ck_tflock_ticket_ec_write_turn, &w);
+	}
+
+	ck_pr_fence_lock();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_tflock_ticket_ec_write_unlock(struct ck_tflock_ticket_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	ck_pr_fence_unlock();
+	ck_tflock_ticket_fca_32(&lock->lock.completion,
+	    CK_TFLOCK_TICKET_WC_TOPMSK, CK_TFLOCK_TICKET_WC_INCR);
+
+	ck_pr_fence_atomic_load();
+	ck_ec32_signal(&lock->readers, mode);
+	ck_ec32_signal(&lock->writers, mode);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_tflock_ticket_ec_read_lock(struct ck_tflock_ticket_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+	struct ck_tflock_ticket_ec_wait w = { .lock = &lock->lock };
+
+	w.ticket = ck_tflock_ticket_fca_32(&lock->lock.request,
+	    CK_TFLOCK_TICKET_RC_TOPMSK, CK_TFLOCK_TICKET_RC_INCR) &
+	    CK_TFLOCK_TICKET_W_MASK;
+
+	ck_pr_fence_atomic_load();
+
+	if ((ck_pr_load_32(&lock->lock.completion) &
+	    CK_TFLOCK_TICKET_W_MASK) != w.ticket) {
+		ck_ec32_wait_until(&lock->readers, mode, &lock->readers_spin,
+		    ck_tflock_ticket_ec_read_turn, &w);
+	}
+
+	ck_pr_fence_lock();
+	return;
+}
+
+CK_CC_INLINE static void
+ck_tflock_ticket_ec_read_unlock(struct ck_tflock_ticket_ec *lock,
+    const struct ck_ec_mode *mode)
+{
+
+	ck_pr_fence_unlock();
+	ck_tflock_ticket_fca_32(&lock->lock.completion,
+	    CK_TFLOCK_TICKET_RC_TOPMSK, CK_TFLOCK_TICKET_RC_INCR);
+
+	/* Readers never wait on other readers. */
+	ck_pr_fence_atomic_load();
+	ck_ec32_signal(&lock->writers, mode);
+	return;
+}
+
+#endif /* CK_TFLOCK_EC_H */
@@ -146,5 +146,33 @@ ck_cc_popcount(unsigned int x)
 
 	return __builtin_popcount(x);
 }
+
+#define CK_F_CC_CTZLL
+CK_CC_INLINE static int
+ck_cc_ctzll(unsigned long long x)
+{
+
+	return __builtin_ctzll(x);
+}
+
+#define CK_F_CC_POPCOUNTLL
+CK_CC_INLINE static int
+ck_cc_popcountll(unsigned long long x)
+{
+
+	return __builtin_popcountll(x);
+}
+
+/*
+ * Prefetches the cache line containing p for reading.
+ */
+#define CK_F_CC_PREFETCH
+CK_CC_INLINE static void
+ck_cc_prefetch(const void *p)
+{
+
+	__builtin_prefetch(p);
+	return;
+}
 #endif /* CK_MD_CC_BUILTIN_DISABLE */
 #endif /* CK_GCC_CC_H */
@@ -207,6 +207,92 @@ CK_PR_CAS_O(8,  uint8_t)
 
 #undef CK_PR_CAS_O
 
+#ifdef __ATOMIC_ACQUIRE
+/*
+ * Acquire loads, release stores and acquire compare-and-swap operations
+ * map to one-way barriers where the compiler supports them.
+ */
+#define CK_PR_LOAD_ACQUIRE(S, M, T)					\
+	CK_CC_INLINE static T						\
+	ck_pr_md_load_acquire_##S(const M *target)			\
+	{								\
+		return __atomic_load_n((const T *)target,		\
+		    __ATOMIC_ACQUIRE);					\
+	}								\
+	CK_CC_INLINE static void					\
+	ck_pr_md_store_release_##S(M *target, T v)			\
+	{								\
+		__atomic_store_n((T *)target, v, __ATOMIC_RELEASE);	\
+		return;							\
+	}
+
+CK_CC_INLINE static void *
+ck_pr_md_load_acquire_ptr(const void *target)
+{
+
+	return __atomic_load_n((void *const *)target, __ATOMIC_ACQUIRE);
+}
+
+CK_CC_INLINE static void
+ck_pr_md_store_release_ptr(void *target, const void *v)
+{
+
+	__atomic_store_n((void **)target, CK_CC_DECONST_PTR(v),
+	    __ATOMIC_RELEASE);
+	return;
+}
+
+#define CK_F_PR_LOAD_ACQUIRE_PTR
+#define CK_F_PR_STORE_RELEASE_PTR
+#define CK_F_PR_LOAD_ACQUIRE_CHAR
+#define CK_F_PR_STORE_RELEASE_CHAR
+#define CK_F_PR_LOAD_ACQUIRE_UINT
+#define CK_F_PR_STORE_RELEASE_UINT
+#define CK_F_PR_LOAD_ACQUIRE_INT
+#define CK_F_PR_STORE_RELEASE_INT
+#define CK_F_PR_LOAD_ACQUIRE_64
+#define CK_F_PR_STORE_RELEASE_64
+#define CK_F_PR_LOAD_ACQUIRE_32
+#define CK_F_PR_STORE_RELEASE_32
+#define CK_F_PR_LOAD_ACQUIRE_16
+#define CK_F_PR_STORE_RELEASE_16
+#define CK_F_PR_LOAD_ACQUIRE_8
+#define CK_F_PR_STORE_RELEASE_8
+
+CK_PR_LOAD_ACQUIRE(char, char, char)
+CK_PR_LOAD_ACQUIRE(uint, unsigned int, unsigned int)
+CK_PR_LOAD_ACQUIRE(int, int, int)
+CK_PR_LOAD_ACQUIRE(64, uint64_t, uint64_t)
+CK_PR_LOAD_ACQUIRE(32, uint32_t, uint32_t)
+CK_PR_LOAD_ACQUIRE(16, uint16_t, uint16_t)
+CK_PR_LOAD_ACQUIRE(8, uint8_t, uint8_t)
+
+#undef CK_PR_LOAD_ACQUIRE
+
+#define CK_PR_CAS_ACQUIRE(S, M, T)					\
+	CK_CC_INLINE static bool					\
+	ck_pr_cas_acquire_##S(M *target, T compare, T set)		\
+	{								\
+		return __atomic_compare_exchange_n((T *)target,		\
+		    &compare, set, false, __ATOMIC_ACQUIRE,		\
+		    __ATOMIC_ACQUIRE);					\
+	}
+
+#define CK_F_PR_CAS_ACQUIRE_PTR
+#define CK_F_PR_CAS_ACQUIRE_UINT
+#define CK_F_PR_CAS_ACQUIRE_INT
+#define CK_F_PR_CAS_ACQUIRE_64
+#define CK_F_PR_CAS_ACQUIRE_32
+
+CK_PR_CAS_ACQUIRE(ptr, void, void *)
+CK_PR_CAS_ACQUIRE(uint, unsigned int, unsigned int)
+CK_PR_CAS_ACQUIRE(int, int, int)
+CK_PR_CAS_ACQUIRE(64, uint64_t, uint64_t)
+CK_PR_CAS_ACQUIRE(32, uint32_t, uint32_t)
+
+#undef CK_PR_CAS_ACQUIRE
+#endif /* __ATOMIC_ACQUIRE */
+
 /*
  * Atomic fetch-and-add operations.
  */
@@ -609,5 +609,74 @@ CK_PR_GENERATE(btr)
 #undef CK_PR_GENERATE
 #undef CK_PR_BT
 
+/*
+ * Loads and stores are ordered under TSO and locked instructions are full
+ * barriers, so acquire and release variants need no further ordering.
+ */
+#define CK_F_PR_LOAD_ACQUIRE_PTR
+#define ck_pr_md_load_acquire_ptr ck_pr_md_load_ptr
+#define CK_F_PR_STORE_RELEASE_PTR
+#define ck_pr_md_store_release_ptr ck_pr_md_store_ptr
+
+#define CK_F_PR_LOAD_ACQUIRE_CHAR
+#define ck_pr_md_load_acquire_char ck_pr_md_load_char
+#define CK_F_PR_STORE_RELEASE_CHAR
+#define ck_pr_md_store_release_char ck_pr_md_store_char
+
+#define CK_F_PR_LOAD_ACQUIRE_UINT
+#define ck_pr_md_load_acquire_uint ck_pr_md_load_uint
+#define CK_F_PR_STORE_RELEASE_UINT
+#define ck_pr_md_store_release_uint ck_pr_md_store_uint
+
+#define CK_F_PR_LOAD_ACQUIRE_INT
+#define ck_pr_md_load_acquire_int ck_pr_md_load_int
+#define CK_F_PR_STORE_RELEASE_INT
+#define ck_pr_md_store_release_int ck_pr_md_store_int
+
+#define CK_F_PR_LOAD_ACQUIRE_64
+#define ck_pr_md_load_acquire_64 ck_pr_md_load_64
+#define CK_F_PR_STORE_RELEASE_64
+#define ck_pr_md_store_release_64 ck_pr_md_store_64
+
+#define CK_F_PR_LOAD_ACQUIRE_32
+#define ck_pr_md_load_acquire_32 ck_pr_md_load_32
+#define CK_F_PR_STORE_RELEASE_32
+#define ck_pr_md_store_release_32 ck_pr_md_store_32
+
+#define CK_F_PR_LOAD_ACQUIRE_16
+#define ck_pr_md_load_acquire_16 ck_pr_md_load_16
+#define CK_F_PR_STORE_RELEASE_16
+#define ck_pr_md_store_release_16 ck_pr_md_store_16
+
+#define CK_F_PR_LOAD_ACQUIRE_8
+#define ck_pr_md_load_acquire_8 ck_pr_md_load_8
+#define CK_F_PR_STORE_RELEASE_8
+#define ck_pr_md_store_release_8 ck_pr_md_store_8
+
+#define CK_F_PR_CAS_ACQUIRE_PTR
+#define ck_pr_cas_acquire_ptr ck_pr_cas_ptr
+#define CK_F_PR_FAS_ACQUIRE_PTR
+#define ck_pr_fas_acquire_ptr ck_pr_fas_ptr
+
+#define CK_F_PR_CAS_ACQUIRE_UINT
+#define ck_pr_cas_acquire_uint ck_pr_cas_uint
+#define CK_F_PR_FAS_ACQUIRE_UINT
+#define ck_pr_fas_acquire_uint ck_pr_fas_uint
+
+#define CK_F_PR_CAS_ACQUIRE_INT
+#define ck_pr_cas_acquire_int ck_pr_cas_int
+#define CK_F_PR_FAS_ACQUIRE_INT
+#define ck_pr_fas_acquire_int ck_pr_fas_int
+
+#define CK_F_PR_CAS_ACQUIRE_64
+#define ck_pr_cas_acquire_64 ck_pr_cas_64
+#define CK_F_PR_FAS_ACQUIRE_64
+#define ck_pr_fas_acquire_64 ck_pr_fas_64
+
+#define CK_F_PR_CAS_ACQUIRE_32
+#define ck_pr_cas_acquire_32 ck_pr_cas_32
+#define CK_F_PR_FAS_ACQUIRE_32
+#define ck_pr_fas_acquire_32 ck_pr_fas_32
+
 #endif /* CK_PR_X86_64_H */
 
@@ -67,9 +67,8 @@ ck_spinlock_cas_trylock(struct ck_spinlock_cas *lock)
 CK_CC_INLINE static bool
 ck_spinlock_cas_locked(struct ck_spinlock_cas *lock)
 {
-	bool r = ck_pr_load_uint(&lock->value);
+	bool r = ck_pr_load_acquire_uint(&lock->value);
 
-	ck_pr_fence_acquire();
 	return r;
 }
 
@@ -98,13 +97,27 @@ ck_spinlock_cas_lock_eb(struct ck_spinlock_cas *lock)
 	return;
 }
 
+CK_CC_INLINE static void
+ck_spinlock_cas_lock_ab(struct ck_spinlock_cas *lock,
+    struct ck_backoff_site *site)
+{
+	struct ck_backoff_ns backoff;
+
+	ck_backoff_ns_init(&backoff, site);
+	while (ck_pr_cas_uint(&lock->value, false, true) == false)
+		ck_backoff_ns(&backoff);
+
+	ck_backoff_ns_done(&backoff, site);
+	ck_pr_fence_lock();
+	return;
+}
+
 CK_CC_INLINE static void
 ck_spinlock_cas_unlock(struct ck_spinlock_cas *lock)
 {
 
 	/* Set lock state to unlocked. */
-	ck_pr_fence_unlock();
-	ck_pr_store_uint(&lock->value, false);
+	ck_pr_store_release_uint(&lock->value, false);
 	return;
 }
 
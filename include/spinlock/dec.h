@@ -119,6 +119,28 @@ ck_spinlock_dec_lock_eb(struct ck_spinlock_dec *lock)
 	return;
 }
 
+CK_CC_INLINE static void
+ck_spinlock_dec_lock_ab(struct ck_spinlock_dec *lock,
+    struct ck_backoff_site *site)
+{
+	struct ck_backoff_ns backoff;
+	bool r;
+
+	ck_backoff_ns_init(&backoff, site);
+	for (;;) {
+		ck_pr_dec_uint_zero(&lock->value, &r);
+		if (r == true)
+			break;
+
+		while (ck_pr_load_uint(&lock->value) != 1)
+			ck_backoff_ns(&backoff);
+	}
+
+	ck_backoff_ns_done(&backoff, site);
+	ck_pr_fence_lock();
+	return;
+}
+
 CK_CC_INLINE static void
 ck_spinlock_dec_unlock(struct ck_spinlock_dec *lock)
 {
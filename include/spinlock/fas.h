@@ -68,8 +68,7 @@ ck_spinlock_fas_locked(struct ck_spinlock_fas *lock)
 {
 	bool r;
 
-	r = ck_pr_load_uint(&lock->value);
-	ck_pr_fence_acquire();
+	r = ck_pr_load_acquire_uint(&lock->value);
 	return r;
 }
 
@@ -99,12 +98,26 @@ ck_spinlock_fas_lock_eb(struct ck_spinlock_fas *lock)
 	return;
 }
 
+CK_CC_INLINE static void
+ck_spinlock_fas_lock_ab(struct ck_spinlock_fas *lock,
+    struct ck_backoff_site *site)
+{
+	struct ck_backoff_ns backoff;
+
+	ck_backoff_ns_init(&backoff, site);
+	while (ck_pr_fas_uint(&lock->value, true) == true)
+		ck_backoff_ns(&backoff);
+
+	ck_backoff_ns_done(&backoff, site);
+	ck_pr_fence_lock();
+	return;
+}
+
 CK_CC_INLINE static void
 ck_spinlock_fas_unlock(struct ck_spinlock_fas *lock)
 {
 
-	ck_pr_fence_unlock();
-	ck_pr_store_uint(&lock->value, false);
+	ck_pr_store_release_uint(&lock->value, false);
 	return;
 }
 
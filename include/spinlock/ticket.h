@@ -272,15 +272,13 @@ ck_spinlock_ticket_unlock(struct ck_spinlock_ticket *ticket)
 {
 	unsigned int update;
 
-	ck_pr_fence_unlock();
-
 	/*
 	 * Update current ticket value so next lock request can proceed.
 	 * Overflow behavior is assumed to be roll-over, in which case,
 	 * it is only an issue if there are 2^32 pending lock requests.
 	 */
 	update = ck_pr_load_uint(&ticket->position);
-	ck_pr_store_uint(&ticket->position, update + 1);
+	ck_pr_store_release_uint(&ticket->position, update + 1);
 	return;
 }
 #endif /* !CK_F_SPINLOCK_TICKET_TRYLOCK */
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <ck_pr.h>
+
+#include "common.h"
+#include "ec_ops.h"
+
+/*
+ * Measures acquisition latency of the spinning and blocking variants of
+ * a reader-writer lock when there are more threads than cores. Every
+ * WRITE_RATIO-th acquisition is a write, and critical sections are padded
+ * with WORK stall iterations. The including file defines LOCK_NAME and
+ * the SPIN_* and EC_* lock operations on spin_lock and ec_lock.
+ */
+
+#ifndef DURATION
+#define DURATION 5
+#endif
+
+#ifndef WRITE_RATIO
+#define WRITE_RATIO 8
+#endif
+
+#ifndef WORK
+#define WORK 64
+#endif
+
+#ifndef SAMPLES
+#define SAMPLES 65536
+#endif
+
+struct sample {
+	uint64_t *read;
+	uint64_t *write;
+	unsigned int n_read;
+	unsigned int n_write;
+	uint64_t ops;
+};
+
+static int barrier;
+static int threads;
+static unsigned int flag CK_CC_CACHELINE;
+static struct affinity affinity;
+SPIN_LOCK_DEFINE;
+EC_LOCK_DEFINE;
+
+static void
+work(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < WORK; i++)
+		ck_pr_stall();
+
+	return;
+}
+
+#define LATENCY_THREAD(N, READ_LOCK, READ_UNLOCK, WRITE_LOCK, WRITE_UNLOCK)	\
+static void *									\
+thread_##N(void *pun)								\
+{										\
+	struct sample *s = pun;							\
+	uint64_t s_b, e_b;							\
+										\
+	if (aff_iterate(&affinity) != 0)					\
+		perror("WARNING: Could not affine thread");			\
+										\
+	ck_pr_inc_int(&barrier);						\
+	while (ck_pr_load_int(&barrier) != threads)				\
+		ck_pr_stall();							\
+										\
+	while (ck_pr_load_uint(&flag) == 0) {					\
+		if ((s->ops++ % WRITE_RATIO) == 0) {				\
+			s_b = rdtsc();						\
+			WRITE_LOCK;						\
+			e_b = rdtsc();						\
+			work();							\
+			WRITE_UNLOCK;						\
+			s->write[s->n_write++ % SAMPLES] = e_b - s_b;		\
+		} else {							\
+			s_b = rdtsc();						\
+			READ_LOCK;						\
+			e_b = rdtsc();						\
+			work();							\
+			READ_UNLOCK;						\
+			s->read[s->n_read++ % SAMPLES] = e_b - s_b;		\
+		}								\
+	}									\
+										\
+	return NULL;								\
+}
+
+LATENCY_THREAD(spin, SPIN_READ_LOCK, SPIN_READ_UNLOCK, SPIN_WRITE_LOCK,
+    SPIN_WRITE_UNLOCK)
+LATENCY_THREAD(ec, EC_READ_LOCK, EC_READ_UNLOCK, EC_WRITE_LOCK, EC_WRITE_UNLOCK)
+
+static int
+cmp(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void
+report(const char *label, struct sample *s, bool write)
+{
+	uint64_t *all;
+	size_t n = 0;
+	int t;
+
+	all = malloc(sizeof(uint64_t) * SAMPLES * threads);
+	if (all == NULL)
+		ck_error("ERROR: Failed to allocate sample buffer.\n");
+
+	for (t = 0; t < threads; t++) {
+		unsigned int c = write ? s[t].n_write : s[t].n_read;
+		uint64_t *v = write ? s[t].write : s[t].read;
+
+		if (c > SAMPLES)
+			c = SAMPLES;
+
+		for (unsigned int i = 0; i < c; i++)
+			all[n++] = v[i];
+	}
+
+	if (n == 0) {
+		printf("%10s %6s %15s\n", label, write ? "WRITE" : "READ",
+		    "(no samples)");
+		free(all);
+		return;
+	}
+
+	qsort(all, n, sizeof(uint64_t), cmp);
+	printf("%10s %6s %15" PRIu64 " %15" PRIu64 " %15" PRIu64
+	    " %15" PRIu64 "\n", label, write ? "WRITE" : "READ",
+	    all[n / 2], all[n * 99 / 100], all[n * 999 / 1000], all[n - 1]);
+	free(all);
+	return;
+}
+
+static void
+run(const char *label, void *(*f)(void *), struct sample *s, pthread_t *p)
+{
+	struct rusage before, after;
+	uint64_t ops = 0;
+	double cpu;
+	int t;
+
+	ck_pr_store_int(&barrier, 0);
+	ck_pr_store_uint(&flag, 0);
+	for (t = 0; t < threads; t++) {
+		s[t].n_read = s[t].n_write = 0;
+		s[t].ops = 0;
+	}
+
+	getrusage(RUSAGE_SELF, &before);
+	for (t = 0; t < threads; t++) {
+		if (pthread_create(&p[t], NULL, f, s + t) != 0)
+			ck_error("ERROR: Could not create thread %d\n", t);
+	}
+
+	common_sleep(DURATION);
+	ck_pr_store_uint(&flag, 1);
+
+	for (t = 0; t < threads; t++) {
+		pthread_join(p[t], NULL);
+		ops += s[t].ops;
+	}
+	getrusage(RUSAGE_SELF, &after);
+
+	cpu = (after.ru_utime.tv_sec - before.ru_utime.tv_sec) +
+	    (after.ru_stime.tv_sec - before.ru_stime.tv_sec) +
+	    ((after.ru_utime.tv_usec - before.ru_utime.tv_usec) +
+	    (after.ru_stime.tv_usec - before.ru_stime.tv_usec)) / 1e6;
+
+	report(label, s, false);
+	report(label, s, true);
+	printf("%10s %6s %15" PRIu64 " ops, %.2f CPU seconds\n\n", label,
+	    "TOTAL", ops, cpu);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	struct sample *s;
+	pthread_t *p;
+	int t;
+
+	if (argc != 3) {
+		ck_error("Usage: " LOCK_NAME " <delta> <threads>\n");
+	}
+
+	threads = atoi(argv[2]);
+	if (threads <= 0) {
+		ck_error("ERROR: Threads must be a value > 0.\n");
+	}
+
+	p = malloc(sizeof(pthread_t) * threads);
+	s = malloc(sizeof(struct sample) * threads);
+	if (p == NULL || s == NULL) {
+		ck_error("ERROR: Failed to initialize thread state.\n");
+	}
+
+	for (t = 0; t < threads; t++) {
+		s[t].read = malloc(sizeof(uint64_t) * SAMPLES);
+		s[t].write = malloc(sizeof(uint64_t) * SAMPLES);
+		if (s[t].read == NULL || s[t].write == NULL)
+			ck_error("ERROR: Failed to allocate samples.\n");
+	}
+
+	affinity.delta = atoi(argv[1]);
+	affinity.request = 0;
+
+	printf("%10s %6s %15s %15s %15s %15s\n", "", "", "p50", "p99",
+	    "p99.9", "max");
+	run("spin", thread_spin, s, p);
+	run("blocking", thread_ec, s, p);
+	return 0;
+}
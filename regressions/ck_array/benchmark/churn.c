@@ -0,0 +1,166 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_array.h>
+#include <ck_sarray.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ENTRIES
+#define ENTRIES (1U << 16)
+#endif
+
+#ifndef OPERATIONS
+#define OPERATIONS (1U << 14)
+#endif
+
+static void *
+test_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void *
+test_realloc(void *p, size_t a, size_t b, bool r)
+{
+
+	(void)a;
+	(void)r;
+	return realloc(p, b);
+}
+
+static void
+test_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.realloc = test_realloc,
+	.free = test_free
+};
+
+static unsigned int victim[OPERATIONS];
+
+/*
+ * Both arrays are filled and then churned by removing a random entry,
+ * adding a fresh one and committing after every pair of operations.
+ */
+static void
+churn_array(void)
+{
+	static uintptr_t value[ENTRIES];
+	ck_array_t array;
+	unsigned int i, j;
+	uint64_t s, e;
+
+	if (ck_array_init(&array, CK_ARRAY_MODE_SPMC, &allocator, 1) == false)
+		ck_error("ERROR: ck_array_init\n");
+
+	s = rdtsc();
+	for (i = 0; i < ENTRIES; i++) {
+		value[i] = i + 1;
+		ck_array_put(&array, (void *)value[i]);
+	}
+	ck_array_commit(&array);
+	e = rdtsc();
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_array_put", (e - s) / ENTRIES);
+
+	s = rdtsc();
+	for (i = 0; i < OPERATIONS; i++) {
+		j = victim[i];
+		if (ck_array_remove(&array, (void *)value[j]) == false)
+			ck_error("ERROR: ck_array_remove\n");
+
+		value[j] = ENTRIES + i + 1;
+		ck_array_put(&array, (void *)value[j]);
+		ck_array_commit(&array);
+	}
+	e = rdtsc();
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_array churn",
+	    (e - s) / OPERATIONS);
+
+	ck_array_deinit(&array, false);
+	return;
+}
+
+static void
+churn_sarray(void)
+{
+	static unsigned int handle[ENTRIES];
+	ck_sarray_t array;
+	unsigned int i, j;
+	uint64_t s, e;
+
+	if (ck_sarray_init(&array, CK_SARRAY_MODE_SPMC, &allocator, 1) == false)
+		ck_error("ERROR: ck_sarray_init\n");
+
+	s = rdtsc();
+	for (i = 0; i < ENTRIES; i++)
+		ck_sarray_put(&array, (void *)(uintptr_t)(i + 1), &handle[i]);
+	ck_sarray_commit(&array);
+	e = rdtsc();
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_sarray_put", (e - s) / ENTRIES);
+
+	s = rdtsc();
+	for (i = 0; i < OPERATIONS; i++) {
+		j = victim[i];
+		if (ck_sarray_remove(&array, handle[j]) == false)
+			ck_error("ERROR: ck_sarray_remove\n");
+
+		ck_sarray_put(&array, (void *)(uintptr_t)(ENTRIES + i + 1), &handle[j]);
+		ck_sarray_commit(&array);
+	}
+	e = rdtsc();
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_sarray churn",
+	    (e - s) / OPERATIONS);
+
+	ck_sarray_deinit(&array, false);
+	return;
+}
+
+int
+main(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < OPERATIONS; i++)
+		victim[i] = common_rand() % ENTRIES;
+
+	churn_array();
+	churn_sarray();
+	return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_array.h>
+#include <ck_pr.h>
+#include <ck_spinlock.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ENTRIES
+#define ENTRIES 1024
+#endif
+
+#ifndef OPERATIONS
+#define OPERATIONS 20000
+#endif
+
+static void *
+test_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void *
+test_realloc(void *p, size_t a, size_t b, bool r)
+{
+
+	(void)a;
+	(void)r;
+	return realloc(p, b);
+}
+
+static void
+test_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.realloc = test_realloc,
+	.free = test_free
+};
+
+static ck_array_t array;
+static ck_spinlock_t lock = CK_SPINLOCK_INITIALIZER;
+static unsigned int nthr;
+static struct affinity a;
+
+/*
+ * Every thread replaces one of its own values per operation. The baseline
+ * serializes writers of an SPMC array with a lock, so every removal of a
+ * committed value copies the array; the multi-writer mode combines
+ * concurrently committed logs into one copy.
+ */
+static void *
+locked(void *arg)
+{
+	uintptr_t v = (uintptr_t)arg;
+	unsigned int i;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	for (i = 0; i < OPERATIONS; i++) {
+		ck_spinlock_lock(&lock);
+		ck_array_remove(&array, (void *)v);
+		ck_array_put(&array, (void *)v);
+		ck_array_commit(&array);
+		ck_spinlock_unlock(&lock);
+	}
+
+	return NULL;
+}
+
+static void *
+combined(void *arg)
+{
+	uintptr_t v = (uintptr_t)arg;
+	ck_array_record_t record;
+	unsigned int i;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_array_register(&array, &record);
+	for (i = 0; i < OPERATIONS; i++) {
+		ck_array_record_remove(&array, &record, (void *)v);
+		ck_array_record_put(&array, &record, (void *)v);
+		ck_array_record_commit(&array, &record);
+	}
+
+	return NULL;
+}
+
+static void
+run(const char *label, unsigned int mode, void *(*f)(void *))
+{
+	ck_array_record_t record;
+	pthread_t *threads;
+	unsigned int i;
+	uint64_t s, e;
+
+	if (ck_array_init(&array, mode, &allocator, ENTRIES) == false)
+		ck_error("ERROR: ck_array_init\n");
+
+	/* Populate the array, including one value per thread. */
+	if (mode == CK_ARRAY_MODE_MPMC) {
+		ck_array_register(&array, &record);
+		for (i = 0; i < ENTRIES; i++) {
+			if (ck_array_record_put(&array, &record,
+			    (void *)(uintptr_t)(i + 1)) == false) {
+				ck_array_record_commit(&array, &record);
+				ck_array_record_put(&array, &record,
+				    (void *)(uintptr_t)(i + 1));
+			}
+		}
+
+		ck_array_record_commit(&array, &record);
+	} else {
+		for (i = 0; i < ENTRIES; i++)
+			ck_array_put(&array, (void *)(uintptr_t)(i + 1));
+
+		ck_array_commit(&array);
+	}
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	s = rdtsc();
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, f, (void *)(uintptr_t)(i + 1));
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+	e = rdtsc();
+
+	printf("%24s: %8" PRIu64 " ticks/op\n", label,
+	    (e - s) / (OPERATIONS * nthr));
+
+	ck_array_deinit(&array, false);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: combining <number of writers> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	a.delta = atoi(argv[2]);
+
+	run("spinlock", CK_ARRAY_MODE_SPMC, locked);
+	a.request = 0;
+	run("combining", CK_ARRAY_MODE_MPMC, combined);
+	return 0;
+}
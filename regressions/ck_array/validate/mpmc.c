@@ -0,0 +1,289 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_array.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 2000
+#endif
+
+#define VALUES 16
+
+static bool fail_malloc;
+
+static void *
+test_malloc(size_t r)
+{
+
+	if (fail_malloc == true)
+		return NULL;
+
+	return malloc(r);
+}
+
+static void *
+test_realloc(void *p, size_t a, size_t b, bool r)
+{
+
+	(void)a;
+	(void)r;
+	return realloc(p, b);
+}
+
+/* Retired arrays may still be read by concurrent readers. */
+static void
+test_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+
+	if (r == false)
+		free(p);
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.realloc = test_realloc,
+	.free = test_free
+};
+
+static ck_array_t array;
+static unsigned int n_writers;
+static unsigned int barrier;
+static unsigned int done;
+static struct affinity a;
+
+static uintptr_t
+value(unsigned int writer, unsigned int i)
+{
+
+	return (uintptr_t)(writer * VALUES + i + 1);
+}
+
+static void *
+writer(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	ck_array_record_t *record;
+	unsigned int i, j;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Failed to allocate record\n");
+
+	ck_array_register(&array, record);
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < n_writers)
+		ck_pr_stall();
+
+	/*
+	 * Every writer owns a disjoint range of values, so each of its
+	 * removals must find the value it put before.
+	 */
+	for (i = 0; i < ITERATIONS; i++) {
+		for (j = 0; j < VALUES; j++) {
+			if (ck_array_record_put(&array, record, (void *)value(id, j)) == false)
+				ck_error("ERROR: ck_array_record_put\n");
+		}
+
+		if (ck_array_record_commit(&array, record) == false)
+			ck_error("ERROR: Failed to commit puts\n");
+
+		for (j = 0; j < VALUES; j++) {
+			if (ck_array_record_remove(&array, record, (void *)value(id, j)) == false)
+				ck_error("ERROR: ck_array_record_remove\n");
+		}
+
+		if (ck_array_record_commit(&array, record) == false)
+			ck_error("ERROR: Failed to commit removals\n");
+	}
+
+	/* Leave a single value behind for the final check. */
+	ck_array_record_put(&array, record, (void *)value(id, 0));
+	if (ck_array_record_commit(&array, record) == false)
+		ck_error("ERROR: Failed to commit final put\n");
+
+	return NULL;
+}
+
+static void *
+reader(void *unused)
+{
+	ck_array_iterator_t iterator;
+	unsigned char *seen;
+	unsigned int n = 0;
+	uintptr_t v;
+	void *r;
+
+	(void)unused;
+
+	seen = malloc(n_writers * VALUES + 1);
+	if (seen == NULL)
+		ck_error("ERROR: Failed to allocate reader state\n");
+
+	while (ck_pr_load_uint(&done) == 0) {
+		memset(seen, 0, n_writers * VALUES + 1);
+
+		CK_ARRAY_FOREACH(&array, &iterator, &r) {
+			v = (uintptr_t)r;
+			if (v == 0 || v > n_writers * VALUES)
+				ck_error("ERROR: Reader observed invalid value %p\n", r);
+
+			if (seen[v] != 0)
+				ck_error("ERROR: Reader observed %p twice\n", r);
+
+			seen[v] = 1;
+		}
+
+		n++;
+	}
+
+	free(seen);
+	fprintf(stderr, "%u snapshots\n", n);
+	return NULL;
+}
+
+static void
+serial(void)
+{
+	ck_array_record_t record;
+	unsigned int i;
+
+	if (ck_array_init(&array, CK_ARRAY_MODE_MPMC, &allocator, 1) == false)
+		ck_error("ERROR: ck_array_init\n");
+
+	if (ck_array_put(&array, (void *)1) == true)
+		ck_error("ERROR: ck_array_put succeeded on a multi-writer array\n");
+
+	ck_array_register(&array, &record);
+	for (i = 0; i < CK_ARRAY_LOG; i++) {
+		if (ck_array_record_put(&array, &record, (void *)(uintptr_t)(i + 1)) == false)
+			ck_error("ERROR: ck_array_record_put %u\n", i);
+	}
+
+	if (ck_array_record_put(&array, &record, (void *)1) == true)
+		ck_error("ERROR: Staged into a full log\n");
+
+	if (ck_array_length(&array) != 0)
+		ck_error("ERROR: Staged operations are visible before commit\n");
+
+	if (ck_array_record_commit(&array, &record) == false)
+		ck_error("ERROR: ck_array_record_commit\n");
+
+	if (ck_array_length(&array) != CK_ARRAY_LOG)
+		ck_error("ERROR: Expected %u entries\n", CK_ARRAY_LOG);
+
+	ck_array_record_remove(&array, &record, (void *)1);
+	ck_array_record_remove(&array, &record, (void *)1);
+	if (ck_array_record_commit(&array, &record) == true)
+		ck_error("ERROR: Removal of a missing value succeeded\n");
+
+	if (ck_array_length(&array) != CK_ARRAY_LOG - 1)
+		ck_error("ERROR: Expected %u entries\n", CK_ARRAY_LOG - 1);
+
+	/* Operations remain staged if the array cannot be grown. */
+	ck_array_record_put(&array, &record, (void *)1);
+	fail_malloc = true;
+	if (ck_array_record_commit(&array, &record) == true)
+		ck_error("ERROR: Commit succeeded without memory\n");
+
+	fail_malloc = false;
+	if (ck_array_length(&array) != CK_ARRAY_LOG - 1)
+		ck_error("ERROR: Failed commit modified the array\n");
+
+	if (ck_array_record_commit(&array, &record) == false)
+		ck_error("ERROR: Retried commit failed\n");
+
+	if (ck_array_length(&array) != CK_ARRAY_LOG)
+		ck_error("ERROR: Expected %u entries\n", CK_ARRAY_LOG);
+
+	ck_array_deinit(&array, false);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	ck_array_iterator_t iterator;
+	pthread_t *threads;
+	unsigned int i, n;
+	void *r;
+
+	if (argc != 3) {
+		ck_error("Usage: mpmc <number of writers> <affinity delta>\n");
+	}
+
+	n_writers = atoi(argv[1]);
+	if (n_writers < 2)
+		n_writers = 2;
+
+	a.delta = atoi(argv[2]);
+	serial();
+
+	if (ck_array_init(&array, CK_ARRAY_MODE_MPMC, &allocator, 1) == false)
+		ck_error("ERROR: ck_array_init\n");
+
+	threads = malloc(sizeof(pthread_t) * (n_writers + 1));
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	pthread_create(&threads[n_writers], NULL, reader, NULL);
+	for (i = 0; i < n_writers; i++)
+		pthread_create(&threads[i], NULL, writer, (void *)(uintptr_t)i);
+
+	for (i = 0; i < n_writers; i++)
+		pthread_join(threads[i], NULL);
+
+	ck_pr_store_uint(&done, 1);
+	pthread_join(threads[n_writers], NULL);
+
+	n = 0;
+	CK_ARRAY_FOREACH(&array, &iterator, &r) {
+		if ((uintptr_t)r % VALUES != 1)
+			ck_error("ERROR: Unexpected value %p left behind\n", r);
+
+		n++;
+	}
+
+	if (n != n_writers)
+		ck_error("ERROR: Expected %u values, found %u\n", n_writers, n);
+
+	free(threads);
+	return 0;
+}
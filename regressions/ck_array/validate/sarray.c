@@ -0,0 +1,370 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_pr.h>
+#include <ck_sarray.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 20000
+#endif
+
+#define KEYS 4096
+#define ROUND 64
+
+/*
+ * Deferred frees are held until the end of a round, which stands in for a
+ * grace period: no snapshot taken before the round is read afterwards.
+ */
+static void **limbo;
+static unsigned int n_limbo;
+static unsigned int c_limbo;
+
+static void *
+test_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void *
+test_realloc(void *p, size_t a, size_t b, bool r)
+{
+
+	(void)a;
+	(void)r;
+	return realloc(p, b);
+}
+
+static void
+test_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+
+	if (r == false) {
+		free(p);
+		return;
+	}
+
+	if (n_limbo == c_limbo) {
+		c_limbo = c_limbo ? c_limbo << 1 : 64;
+		limbo = realloc(limbo, sizeof(void *) * c_limbo);
+		if (limbo == NULL)
+			ck_error("ERROR: Failed to grow limbo list\n");
+	}
+
+	limbo[n_limbo++] = p;
+	return;
+}
+
+static void
+test_reclaim(void)
+{
+
+	while (n_limbo > 0)
+		free(limbo[--n_limbo]);
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.realloc = test_realloc,
+	.free = test_free
+};
+
+static ck_sarray_t array;
+static unsigned int handle[KEYS];
+static bool live[KEYS];
+static unsigned int n_live;
+static void *saved[KEYS];
+static unsigned int n_saved;
+
+static unsigned int
+snapshot_read(struct _ck_sarray *snapshot, void **values)
+{
+	unsigned int i;
+
+	for (i = 0; i < snapshot->n_committed; i++) {
+		values[i] = snapshot->segments[i / CK_SARRAY_SEGMENT]
+		    [i % CK_SARRAY_SEGMENT];
+	}
+
+	return i;
+}
+
+static void
+snapshot_check(struct _ck_sarray *snapshot)
+{
+	void *values[KEYS];
+	unsigned int i, n;
+
+	/*
+	 * As with ck_array, commits that need no copy update the length of
+	 * the active snapshot in place, but values are never overwritten.
+	 */
+	n = snapshot_read(snapshot, values);
+	if (n > n_saved)
+		n = n_saved;
+
+	for (i = 0; i < n; i++) {
+		if (values[i] != saved[i]) {
+			ck_error("ERROR: Snapshot slot %u changed from %p to %p\n",
+			    i, saved[i], values[i]);
+		}
+	}
+
+	return;
+}
+
+static void
+committed_check(void)
+{
+	ck_sarray_iterator_t iterator;
+	bool seen[KEYS];
+	unsigned int n = 0;
+	uintptr_t key;
+	void *value;
+
+	memset(seen, 0, sizeof seen);
+	CK_SARRAY_FOREACH(&array, &iterator, &value) {
+		key = (uintptr_t)value - 1;
+		if (key >= KEYS || live[key] == false)
+			ck_error("ERROR: Unexpected value %p\n", value);
+
+		if (seen[key] == true)
+			ck_error("ERROR: Duplicate value %p\n", value);
+
+		seen[key] = true;
+		n++;
+	}
+
+	if (n != n_live || ck_sarray_length(&array) != n_live)
+		ck_error("ERROR: Expected %u entries, found %u\n", n_live, n);
+
+	return;
+}
+
+static void
+serial(void)
+{
+	ck_sarray_iterator_t iterator;
+	unsigned int i, j, key, h;
+	void *value;
+
+	if (ck_sarray_init(&array, CK_SARRAY_MODE_SPMC, &allocator, 1) == false)
+		ck_error("ERROR: ck_sarray_init\n");
+
+	if (ck_sarray_remove(&array, 0) == true)
+		ck_error("ERROR: Removed a handle from an empty array\n");
+
+	for (i = 0; i < ITERATIONS / ROUND; i++) {
+		/* Record a snapshot that must survive the whole round. */
+		CK_SARRAY_FOREACH(&array, &iterator, &value)
+			(void)value;
+
+		n_saved = snapshot_read(iterator.snapshot, saved);
+
+		for (j = 0; j < ROUND; j++) {
+			key = common_rand() % KEYS;
+
+			if (live[key] == false) {
+				if (ck_sarray_put(&array, (void *)(uintptr_t)(key + 1), &h) == false)
+					ck_error("ERROR: ck_sarray_put\n");
+
+				handle[key] = h;
+				live[key] = true;
+				n_live++;
+			} else {
+				if (ck_sarray_remove(&array, handle[key]) == false)
+					ck_error("ERROR: ck_sarray_remove %u\n", key);
+
+				if (ck_sarray_remove(&array, handle[key]) == true)
+					ck_error("ERROR: Removed handle %u twice\n", handle[key]);
+
+				live[key] = false;
+				n_live--;
+			}
+
+			if (j % 16 == 15)
+				ck_sarray_commit(&array);
+
+			snapshot_check(iterator.snapshot);
+		}
+
+		for (key = 0; key < KEYS; key++) {
+			if (live[key] == false)
+				continue;
+
+			value = ck_sarray_get(&array, handle[key]);
+			if (value != (void *)(uintptr_t)(key + 1))
+				ck_error("ERROR: Handle %u maps to %p\n", handle[key], value);
+		}
+
+		ck_sarray_commit(&array);
+		snapshot_check(iterator.snapshot);
+		committed_check();
+		test_reclaim();
+	}
+
+	/* Drain the array completely and refill it. */
+	for (key = 0; key < KEYS; key++) {
+		if (live[key] == true && ck_sarray_remove(&array, handle[key]) == false)
+			ck_error("ERROR: ck_sarray_remove %u\n", key);
+
+		live[key] = false;
+	}
+
+	n_live = 0;
+	ck_sarray_commit(&array);
+	committed_check();
+
+	for (key = 0; key < KEYS; key++) {
+		if (ck_sarray_put(&array, (void *)(uintptr_t)(key + 1), &handle[key]) == false)
+			ck_error("ERROR: ck_sarray_put\n");
+
+		live[key] = true;
+	}
+
+	n_live = KEYS;
+	ck_sarray_commit(&array);
+	committed_check();
+
+	ck_sarray_deinit(&array, false);
+	test_reclaim();
+	return;
+}
+
+/*
+ * A single writer churns the array while readers verify that every
+ * snapshot they observe contains each value at most once. Retired memory
+ * is not reclaimed until all readers have exited.
+ */
+static unsigned int done;
+static unsigned int nthr;
+static struct affinity a;
+
+static void *
+reader(void *unused)
+{
+	ck_sarray_iterator_t iterator;
+	unsigned char seen[KEYS];
+	unsigned int n = 0;
+	uintptr_t key;
+	void *value;
+
+	(void)unused;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	while (ck_pr_load_uint(&done) == 0) {
+		memset(seen, 0, sizeof seen);
+
+		CK_SARRAY_FOREACH(&array, &iterator, &value) {
+			key = (uintptr_t)value - 1;
+			if (key >= KEYS)
+				ck_error("ERROR: Reader observed invalid value %p\n", value);
+
+			if (seen[key] != 0)
+				ck_error("ERROR: Reader observed %p twice\n", value);
+
+			seen[key] = 1;
+		}
+
+		n++;
+	}
+
+	fprintf(stderr, "%u snapshots ", n);
+	return NULL;
+}
+
+static void
+concurrent(void)
+{
+	pthread_t *threads;
+	unsigned int i, key;
+
+	memset(live, 0, sizeof live);
+	if (ck_sarray_init(&array, CK_SARRAY_MODE_SPMC, &allocator, KEYS) == false)
+		ck_error("ERROR: ck_sarray_init\n");
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, reader, NULL);
+
+	for (i = 0; i < ITERATIONS; i++) {
+		key = common_rand() % KEYS;
+
+		if (live[key] == false) {
+			if (ck_sarray_put(&array, (void *)(uintptr_t)(key + 1), &handle[key]) == false)
+				ck_error("ERROR: ck_sarray_put\n");
+		} else if (ck_sarray_remove(&array, handle[key]) == false) {
+			ck_error("ERROR: ck_sarray_remove\n");
+		}
+
+		live[key] = !live[key];
+		if (i % 8 == 7)
+			ck_sarray_commit(&array);
+	}
+
+	ck_pr_store_uint(&done, 1);
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	fprintf(stderr, "\n");
+	ck_sarray_deinit(&array, false);
+	test_reclaim();
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: sarray <number of readers> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	a.delta = atoi(argv[2]);
+	a.request = 0;
+
+	serial();
+	concurrent();
+	return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_art.h>
+#include <ck_ht.h>
+#include <ck_malloc.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+/*
+ * Compares point lookups in ck_art against ck_ht in direct mode on dense
+ * integer keys, and reports the cost of the prefix scans that the hash
+ * table cannot provide.
+ */
+static ck_art_t art;
+static ck_ht_t ht;
+static uint64_t *keys;
+static size_t keys_length;
+
+static void *
+bench_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void
+bench_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc my_allocator = {
+	.malloc = bench_malloc,
+	.free = bench_free
+};
+
+static void *
+art_lookup(uint64_t key)
+{
+	unsigned char k[8];
+
+	ck_art_key_64(k, key);
+	return ck_art_get(&art, k, sizeof k);
+}
+
+static void *
+ht_lookup(uint64_t key)
+{
+	ck_ht_entry_t entry;
+	ck_ht_hash_t h;
+
+	ck_ht_hash_direct(&h, &ht, key);
+	ck_ht_entry_key_set_direct(&entry, key);
+	if (ck_ht_get_spmc(&ht, h, &entry) == false)
+		return NULL;
+
+	return (void *)(uintptr_t)ck_ht_entry_value_direct(&entry);
+}
+
+static void
+keys_shuffle(uint64_t *k)
+{
+	size_t i, j;
+	uint64_t t;
+
+	for (i = keys_length; i > 1; i--) {
+		j = common_rand() % i;
+		t = k[i - 1];
+		k[i - 1] = k[j];
+		k[j] = t;
+	}
+
+	return;
+}
+
+static void
+measure(size_t r, void *(*lookup)(uint64_t), uint64_t offset)
+{
+	size_t i, j;
+	uint64_t s, a = 0;
+
+	for (j = 0; j < r; j++) {
+		s = rdtsc();
+		for (i = 0; i < keys_length; i++) {
+			if ((lookup(keys[i] + offset) == NULL) != (offset != 0))
+				ck_error("ERROR: Unexpected lookup result.\n");
+		}
+		a += rdtsc() - s;
+	}
+
+	printf(" %10" PRIu64, a / (r * keys_length));
+	return;
+}
+
+static void
+run(const char *name, size_t r, void *(*lookup)(uint64_t))
+{
+	size_t i;
+
+	for (i = 0; i < keys_length; i++)
+		keys[i] = i + 1;
+
+	printf("%-6s", name);
+	measure(r, lookup, 0);
+	keys_shuffle(keys);
+	measure(r, lookup, 0);
+	measure(r, lookup, keys_length);
+	printf("\n");
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	ck_art_iterator_t iterator;
+	unsigned char k[8];
+	ck_ht_entry_t entry;
+	ck_ht_hash_t h;
+	size_t i, j, n, r = 16;
+	uint64_t s, a;
+	void *value;
+
+	if (argc < 2 || argc > 3) {
+		ck_error("Usage: lookup <number of entries> [repetitions]\n");
+	}
+
+	keys_length = strtoul(argv[1], NULL, 10);
+	if (keys_length == 0)
+		ck_error("ERROR: Number of entries must be greater than 0\n");
+
+	if (argc == 3)
+		r = strtoul(argv[2], NULL, 10);
+
+	keys = malloc(sizeof(uint64_t) * keys_length);
+	if (keys == NULL)
+		ck_error("ERROR: Could not allocate keys\n");
+
+	if (ck_art_init(&art, &my_allocator) == false)
+		ck_error("ERROR: ck_art_init\n");
+
+	if (ck_ht_init(&ht, CK_HT_MODE_DIRECT, NULL, &my_allocator,
+	    keys_length, 6602834) == false)
+		ck_error("ERROR: ck_ht_init\n");
+
+	/* Keys are dense, and zero is reserved by ck_ht. */
+	for (i = 1; i <= keys_length; i++) {
+		ck_art_key_64(k, i);
+		if (ck_art_put(&art, k, sizeof k, (void *)(uintptr_t)i) == false)
+			ck_error("ERROR: Failed to insert into ck_art\n");
+
+		ck_ht_hash_direct(&h, &ht, i);
+		ck_ht_entry_set_direct(&entry, h, i, i);
+		if (ck_ht_put_spmc(&ht, h, &entry) == false)
+			ck_error("ERROR: Failed to insert into ck_ht\n");
+	}
+
+	fprintf(stderr, "# %u entries\n", ck_art_count(&art));
+	printf("%-6s %10s %10s %10s\n", "#", "ordered", "random", "negative");
+	run("ck_art", r, art_lookup);
+	run("ck_ht", r, ht_lookup);
+
+	/* Every key sharing all but its last byte, in key order. */
+	a = n = 0;
+	for (j = 0; j < r; j++) {
+		s = rdtsc();
+		for (i = 0; i <= keys_length; i += 256) {
+			ck_art_key_64(k, i);
+			ck_art_prefix(&art, &iterator, k, sizeof k - 1);
+			while (ck_art_next(&art, &iterator, &value) == true)
+				n++;
+		}
+		a += rdtsc() - s;
+	}
+
+	if (n != r * keys_length)
+		ck_error("ERROR: Prefix scans returned %zu entries\n", n);
+
+	printf("# ck_art prefix scan: %" PRIu64 " ticks per entry\n", a / n);
+
+	ck_art_destroy(&art);
+	ck_ht_destroy(&ht);
+	free(keys);
+	return 0;
+}
@@ -0,0 +1,545 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_art.h>
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 200000
+#endif
+
+#define UNIVERSE 10000
+#define SPAN 64
+
+/*
+ * Every entry points at its key. Keys are generated by one of several
+ * encodings of an integer, chosen to exercise wide fan-out, path
+ * compression and keys that are prefixes of other keys.
+ */
+struct key {
+	unsigned char bytes[8];
+	unsigned int length;
+};
+
+struct node_header {
+	ck_epoch_entry_t epoch_entry;
+	size_t size;
+};
+
+static ck_epoch_t epoch;
+static ck_epoch_record_t epoch_wr;
+static ck_art_t art;
+static struct key keys[UNIVERSE];
+static struct key *sorted[UNIVERSE];
+static unsigned int n_sorted;
+static bool present[UNIVERSE];
+static unsigned int nthr;
+static unsigned int barrier;
+static unsigned int finished;
+static struct affinity a;
+
+static void *
+art_malloc(size_t r)
+{
+	struct node_header *h;
+
+	h = malloc(sizeof(*h) + r);
+	if (h == NULL)
+		return NULL;
+
+	h->size = r;
+	return h + 1;
+}
+
+static void
+art_destroy(ck_epoch_entry_t *e)
+{
+	struct node_header *h = (struct node_header *)e;
+
+	/* A reader that still holds the node or leaf finds garbage. */
+	memset(h + 1, 0xa5, h->size);
+	free(h);
+	return;
+}
+
+/*
+ * The tree derives the size of a node from its type and prefix length, and
+ * that of a leaf from its key length. Neither may change after the node is
+ * published, so the released size must match the allocation.
+ */
+static void
+art_free(void *p, size_t b, bool r)
+{
+	struct node_header *h = (struct node_header *)p - 1;
+
+	if (b != h->size)
+		ck_error("ERROR: Released %zu bytes of a %zu byte node\n",
+		    b, h->size);
+
+	if (r == true) {
+		ck_epoch_call_strict(&epoch_wr, &h->epoch_entry, art_destroy);
+	} else {
+		free(h);
+	}
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = art_malloc,
+	.free = art_free
+};
+
+static void
+encode_decimal(struct key *key, unsigned int k)
+{
+
+	key->length = (unsigned int)sprintf((char *)key->bytes, "%u", k);
+	return;
+}
+
+static void
+encode_binary(struct key *key, unsigned int k)
+{
+
+	/* Two bytes, so the second level is dense. */
+	key->bytes[0] = (unsigned char)(k >> 8);
+	key->bytes[1] = (unsigned char)k;
+	key->length = 2;
+	return;
+}
+
+static void
+encode_sparse(struct key *key, unsigned int k)
+{
+
+	/* Eight bytes with long shared runs, so paths are compressed. */
+	ck_art_key_64(key->bytes, (uint64_t)k << 37 | (uint64_t)(k & 7) << 3);
+	key->length = 8;
+	return;
+}
+
+static int
+key_compare(const struct key *x, const struct key *y)
+{
+	unsigned int n = x->length < y->length ? x->length : y->length;
+	int r;
+
+	r = memcmp(x->bytes, y->bytes, n);
+	if (r != 0)
+		return r;
+
+	return (x->length > y->length) - (x->length < y->length);
+}
+
+static int
+sorted_compare(const void *x, const void *y)
+{
+
+	return key_compare(*(struct key *const *)x, *(struct key *const *)y);
+}
+
+static bool
+has_prefix(const struct key *key, const struct key *prefix, unsigned int length)
+{
+
+	return key->length >= length && memcmp(key->bytes, prefix->bytes, length) == 0;
+}
+
+/*
+ * Sorts the keys selected by the filter, which lets a scan be checked
+ * against the expected sequence of keys.
+ */
+static void
+sort_keys(bool (*filter)(unsigned int))
+{
+	unsigned int k;
+
+	n_sorted = 0;
+	for (k = 0; k < UNIVERSE; k++) {
+		if (filter(k) == true)
+			sorted[n_sorted++] = &keys[k];
+	}
+
+	qsort(sorted, n_sorted, sizeof(struct key *), sorted_compare);
+	return;
+}
+
+static unsigned int
+sorted_lower_bound(const struct key *key)
+{
+	unsigned int low = 0, high = n_sorted, middle;
+
+	while (low < high) {
+		middle = (low + high) / 2;
+		if (key_compare(sorted[middle], key) < 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+static bool
+filter_present(unsigned int k)
+{
+
+	return present[k];
+}
+
+static bool
+filter_persistent(unsigned int k)
+{
+
+	return (k & 3) == 0;
+}
+
+/* Compares a full scan, a range scan and a prefix scan with the model. */
+static void
+verify(unsigned int universe)
+{
+	ck_art_iterator_t iterator = CK_ART_ITERATOR_INITIALIZER;
+	const struct key *bound;
+	unsigned int i, j, n, length;
+	void *entry;
+
+	sort_keys(filter_present);
+	if (ck_art_count(&art) != n_sorted)
+		ck_error("ERROR: Count %u != %u\n", ck_art_count(&art), n_sorted);
+
+	for (n = 0; ck_art_next(&art, &iterator, &entry) == true; n++) {
+		if (n >= n_sorted || entry != sorted[n])
+			ck_error("ERROR: Iteration diverges at %u\n", n);
+	}
+
+	if (n != n_sorted)
+		ck_error("ERROR: Iteration returned %u of %u entries\n", n, n_sorted);
+
+	bound = &keys[common_rand() % universe];
+	i = sorted_lower_bound(bound);
+	ck_art_lower_bound(&art, &iterator, bound->bytes, bound->length);
+	while (ck_art_next(&art, &iterator, &entry) == true) {
+		if (i >= n_sorted || entry != sorted[i])
+			ck_error("ERROR: Range scan diverges at %u\n", i);
+
+		i++;
+	}
+
+	if (i != n_sorted)
+		ck_error("ERROR: Range scan ended at %u of %u\n", i, n_sorted);
+
+	length = common_rand() % (bound->length + 1);
+	for (i = 0; i < n_sorted && has_prefix(sorted[i], bound, length) == false; i++);
+	for (j = i; j < n_sorted && has_prefix(sorted[j], bound, length) == true; j++);
+
+	ck_art_prefix(&art, &iterator, bound->bytes, length);
+	while (ck_art_next(&art, &iterator, &entry) == true) {
+		if (i >= j || entry != sorted[i])
+			ck_error("ERROR: Prefix scan diverges at %u\n", i);
+
+		i++;
+	}
+
+	if (i != j)
+		ck_error("ERROR: Prefix scan ended at %u of %u\n", i, j);
+
+	return;
+}
+
+/*
+ * Applies random operations and checks every result against a model. The
+ * insertion bias alternates, so nodes repeatedly grow to their largest
+ * type and shrink back.
+ */
+static void
+serial(void (*encode)(struct key *, unsigned int), unsigned int universe)
+{
+	unsigned int i, k, bias = 3;
+	void *previous;
+	struct key *entry;
+
+	for (k = 0; k < universe; k++) {
+		encode(&keys[k], k);
+		present[k] = false;
+	}
+
+	if (ck_art_init(&art, &allocator) == false)
+		ck_error("ERROR: ck_art_init\n");
+
+	for (i = 0; i < ITERATIONS; i++) {
+		if ((i % (ITERATIONS / 8)) == 0)
+			bias = 4 - bias;
+
+		k = common_rand() % universe;
+		switch (common_rand() % 5) {
+		case 0:
+		case 1:
+		case 2:
+			if ((unsigned int)common_rand() % 4 >= bias) {
+				if (ck_art_remove(&art, keys[k].bytes, keys[k].length) !=
+				    (present[k] ? &keys[k] : NULL))
+					ck_error("ERROR: Remove of %u disagrees\n", k);
+
+				present[k] = false;
+				break;
+			}
+
+			if (ck_art_put(&art, keys[k].bytes, keys[k].length, &keys[k]) ==
+			    present[k])
+				ck_error("ERROR: Put of %u disagrees\n", k);
+
+			present[k] = true;
+			break;
+		case 3:
+			if (ck_art_set(&art, keys[k].bytes, keys[k].length, &keys[k],
+			    &previous) == false)
+				ck_error("ERROR: Set of %u failed\n", k);
+
+			if (previous != (present[k] ? &keys[k] : NULL))
+				ck_error("ERROR: Set of %u disagrees\n", k);
+
+			present[k] = true;
+			break;
+		case 4:
+			entry = ck_art_get(&art, keys[k].bytes, keys[k].length);
+			if (entry != (present[k] ? &keys[k] : NULL))
+				ck_error("ERROR: Get of %u disagrees\n", k);
+
+			break;
+		}
+
+		if ((i & 4095) == 0) {
+			verify(universe);
+			ck_epoch_barrier(&epoch_wr);
+		}
+	}
+
+	verify(universe);
+
+	/* Drain the tree, which must end empty. */
+	for (k = 0; k < universe; k++) {
+		if (present[k] == true &&
+		    ck_art_remove(&art, keys[k].bytes, keys[k].length) != &keys[k])
+			ck_error("ERROR: Failed to remove %u\n", k);
+
+		present[k] = false;
+	}
+
+	if (ck_art_count(&art) != 0 || art.root != NULL)
+		ck_error("ERROR: Tree is not empty after removing every key\n");
+
+	ck_art_destroy(&art);
+	ck_epoch_barrier(&epoch_wr);
+	return;
+}
+
+/*
+ * Readers check that persistent keys are always found and that scans are
+ * in order and never step over a persistent key.
+ */
+static void
+reader(ck_epoch_record_t *record)
+{
+	ck_art_iterator_t iterator;
+	const struct key *key, *previous;
+	unsigned int k, n, j;
+	void *entry;
+
+	k = (common_rand() % UNIVERSE) & ~3U;
+
+	ck_epoch_begin(record, NULL);
+	if (ck_art_get(&art, keys[k].bytes, keys[k].length) != &keys[k])
+		ck_error("ERROR: Persistent key %u not found\n", k);
+
+	if (common_rand() & 1) {
+		ck_art_lower_bound(&art, &iterator, keys[k].bytes, keys[k].length);
+	} else {
+		ck_art_prefix(&art, &iterator, keys[k].bytes, keys[k].length - 1);
+	}
+
+	/* Persistent keys sharing the prefix may order before the key. */
+	j = sorted_lower_bound(&keys[k]);
+	if (iterator.prefix != NULL) {
+		while (j > 0 && has_prefix(sorted[j - 1], &keys[k],
+		    iterator.prefix_length) == true)
+			j--;
+	}
+
+	previous = NULL;
+	for (n = 0; n < SPAN; n++) {
+		if (ck_art_next(&art, &iterator, &entry) == false)
+			break;
+
+		key = entry;
+		if (key < keys || key >= keys + UNIVERSE)
+			ck_error("ERROR: Scan returned an invalid entry\n");
+
+		if (previous != NULL && key_compare(previous, key) >= 0)
+			ck_error("ERROR: Scan is out of order\n");
+
+		if (j < n_sorted && key_compare(sorted[j], key) < 0)
+			ck_error("ERROR: Scan skipped persistent key %u\n",
+			    (unsigned int)(sorted[j] - keys));
+
+		if (j < n_sorted && sorted[j] == key)
+			j++;
+
+		previous = key;
+	}
+
+	ck_epoch_end(record, NULL);
+	return;
+}
+
+static void *
+concurrent_reader(void *unused)
+{
+	ck_epoch_record_t *record;
+
+	(void)unused;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Could not allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+
+	while (ck_pr_load_uint(&finished) == 0)
+		reader(record);
+
+	return NULL;
+}
+
+static void
+concurrent(void (*encode)(struct key *, unsigned int))
+{
+	pthread_t *threads;
+	unsigned int i, k;
+
+	if (ck_art_init(&art, &allocator) == false)
+		ck_error("ERROR: ck_art_init\n");
+
+	for (k = 0; k < UNIVERSE; k++) {
+		encode(&keys[k], k);
+		present[k] = filter_persistent(k);
+		if (present[k] == true &&
+		    ck_art_put(&art, keys[k].bytes, keys[k].length, &keys[k]) == false)
+			ck_error("ERROR: Failed to insert %u\n", k);
+	}
+
+	sort_keys(filter_persistent);
+	ck_pr_store_uint(&barrier, 0);
+	ck_pr_store_uint(&finished, 0);
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Could not allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, concurrent_reader, NULL);
+
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		k = common_rand() % UNIVERSE;
+		if (filter_persistent(k) == true)
+			k++;
+
+		if (present[k] == true) {
+			if (ck_art_remove(&art, keys[k].bytes, keys[k].length) != &keys[k])
+				ck_error("ERROR: Failed to remove %u\n", k);
+		} else {
+			if (ck_art_put(&art, keys[k].bytes, keys[k].length, &keys[k]) == false)
+				ck_error("ERROR: Failed to insert %u\n", k);
+		}
+
+		present[k] = !present[k];
+		if ((i & 1023) == 0)
+			ck_epoch_poll(&epoch_wr);
+	}
+
+	ck_pr_store_uint(&finished, 1);
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	ck_art_destroy(&art);
+	ck_epoch_barrier(&epoch_wr);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	static const struct {
+		const char *name;
+		void (*encode)(struct key *, unsigned int);
+		unsigned int universe;
+	} encodings[] = {
+		{ "decimal", encode_decimal, 2000 },
+		{ "binary", encode_binary, UNIVERSE },
+		{ "sparse", encode_sparse, UNIVERSE }
+	};
+	unsigned int i;
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &epoch_wr, NULL);
+
+	for (i = 0; i < sizeof(encodings) / sizeof(*encodings); i++) {
+		fprintf(stderr, "Serial (%s)...", encodings[i].name);
+		serial(encodings[i].encode, encodings[i].universe);
+		fprintf(stderr, "done\nSingle writer, %u readers (%s)...",
+		    nthr, encodings[i].name);
+		concurrent(encodings[i].encode);
+		fprintf(stderr, "done\n");
+	}
+
+	return 0;
+}
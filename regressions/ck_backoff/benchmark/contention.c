@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ck_backoff.h>
+#include <ck_pr.h>
+
+#include "../../common.h"
+
+#ifndef DURATION
+#define DURATION 5
+#endif
+
+/*
+ * Throughput of a contended CAS increment loop without back-off, with
+ * ck_backoff_eb and with the calibrated adaptive back-off.
+ */
+enum mode {
+	MODE_NONE,
+	MODE_EB,
+	MODE_NS
+};
+
+static const char *labels[] = { "none", "eb", "ns" };
+
+static int barrier;
+static int threads;
+static unsigned int flag CK_CC_CACHELINE;
+static unsigned int counter CK_CC_CACHELINE;
+static ck_backoff_site_t site CK_CC_CACHELINE = CK_BACKOFF_SITE_INITIALIZER;
+static enum mode mode;
+static struct affinity affinity;
+
+static void *
+thread(void *pun)
+{
+	uint64_t *value = pun;
+	uint64_t n = 0;
+	unsigned int snapshot;
+	ck_backoff_t eb;
+	ck_backoff_ns_t ns;
+
+	if (aff_iterate(&affinity) != 0) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	ck_pr_inc_int(&barrier);
+	while (ck_pr_load_int(&barrier) != threads)
+		ck_pr_stall();
+
+	while (ck_pr_load_uint(&flag) == 0) {
+		snapshot = ck_pr_load_uint(&counter);
+
+		switch (mode) {
+		case MODE_NONE:
+			while (ck_pr_cas_uint_value(&counter, snapshot,
+			    snapshot + 1, &snapshot) == false)
+				ck_pr_stall();
+			break;
+		case MODE_EB:
+			eb = CK_BACKOFF_INITIALIZER;
+			while (ck_pr_cas_uint_value(&counter, snapshot,
+			    snapshot + 1, &snapshot) == false)
+				ck_backoff_eb(&eb);
+			break;
+		case MODE_NS:
+			ck_backoff_ns_init(&ns, &site);
+			while (ck_pr_cas_uint_value(&counter, snapshot,
+			    snapshot + 1, &snapshot) == false)
+				ck_backoff_ns(&ns);
+			ck_backoff_ns_done(&ns, &site);
+			break;
+		}
+
+		n++;
+	}
+
+	*value = n;
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	uint64_t *count, total;
+	pthread_t *p;
+	int t, m;
+
+	if (argc != 3) {
+		ck_error("Usage: contention <delta> <threads>\n");
+	}
+
+	threads = atoi(argv[2]);
+	if (threads <= 0) {
+		ck_error("ERROR: Threads must be a value > 0.\n");
+	}
+
+	p = malloc(sizeof(pthread_t) * threads);
+	count = malloc(sizeof(uint64_t) * threads);
+	if (p == NULL || count == NULL) {
+		ck_error("ERROR: Failed to allocate thread state.\n");
+	}
+
+	affinity.delta = atoi(argv[1]);
+
+	if (ck_backoff_ns_calibrate() == false) {
+		ck_error("ERROR: Could not calibrate back-off.\n");
+	}
+
+	fprintf(stderr, "Calibrated scale: %u stalls per us\n", ck_backoff_ns_scale);
+
+	for (m = MODE_NONE; m <= MODE_NS; m++) {
+		mode = m;
+		affinity.request = 0;
+		ck_pr_store_int(&barrier, 0);
+		ck_pr_store_uint(&flag, 0);
+
+		for (t = 0; t < threads; t++) {
+			if (pthread_create(&p[t], NULL, thread, count + t) != 0) {
+				ck_error("ERROR: Could not create thread %d\n", t);
+			}
+		}
+
+		common_sleep(DURATION);
+		ck_pr_store_uint(&flag, 1);
+
+		total = 0;
+		for (t = 0; t < threads; t++) {
+			pthread_join(p[t], NULL);
+			total += count[t];
+		}
+
+		printf("%6s %20" PRIu64 " ops/s", labels[m], total / DURATION);
+		if (m == MODE_NS)
+			printf(" (ceiling %uns)", ck_pr_load_uint(&site.ceiling));
+
+		printf("\n");
+	}
+
+	return 0;
+}
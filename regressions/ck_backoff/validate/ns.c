@@ -0,0 +1,242 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <ck_backoff.h>
+#include <ck_pr.h>
+#include <ck_spinlock.h>
+
+#include "../../common.h"
+
+#ifndef ITERATE
+#define ITERATE 100000
+#endif
+
+static struct affinity a;
+static int nthr;
+static unsigned int locked[3];
+static unsigned int counter;
+static ck_spinlock_fas_t fas = CK_SPINLOCK_FAS_INITIALIZER;
+static ck_spinlock_cas_t cas = CK_SPINLOCK_CAS_INITIALIZER;
+static ck_spinlock_dec_t dec = CK_SPINLOCK_DEC_INITIALIZER;
+static ck_backoff_site_t site_fas = CK_BACKOFF_SITE_INITIALIZER;
+static ck_backoff_site_t site_cas = CK_BACKOFF_SITE_INITIALIZER;
+static ck_backoff_site_t site_dec = CK_BACKOFF_SITE_INITIALIZER;
+static ck_backoff_site_t site_inc = CK_BACKOFF_SITE_INITIALIZER;
+
+static uint64_t
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void
+check_sequential(void)
+{
+	ck_backoff_site_t site = CK_BACKOFF_SITE_INITIALIZER;
+	ck_backoff_ns_t backoff;
+	unsigned int i, previous;
+	uint64_t s, e;
+
+	ck_backoff_ns_init(&backoff, &site);
+	for (i = 0; i < 32; i++) {
+		previous = backoff.delay;
+		ck_backoff_ns(&backoff);
+
+		if (previous < CK_BACKOFF_NS_CEILING && backoff.delay != previous << 1)
+			ck_error("ERROR: expected delay %u, got %u\n", previous << 1, backoff.delay);
+
+		if (backoff.delay > CK_BACKOFF_NS_CEILING)
+			ck_error("ERROR: delay %u exceeds ceiling\n", backoff.delay);
+	}
+
+	if (backoff.rounds != 32)
+		ck_error("ERROR: expected 32 rounds, got %u\n", backoff.rounds);
+
+	/* Success at the ceiling raises the ceiling. */
+	ck_backoff_ns_done(&backoff, &site);
+	if (site.ceiling <= CK_BACKOFF_NS_CEILING)
+		ck_error("ERROR: ceiling did not grow (%u)\n", site.ceiling);
+
+	/* Early success lowers it, down to the minimum. */
+	for (i = 0; i < 256; i++) {
+		ck_backoff_ns_init(&backoff, &site);
+		ck_backoff_ns(&backoff);
+		ck_backoff_ns_done(&backoff, &site);
+	}
+
+	if (site.ceiling > CK_BACKOFF_NS_MIN * 4)
+		ck_error("ERROR: ceiling did not shrink (%u)\n", site.ceiling);
+
+	/* The delay is clamped to a ceiling that is not a power of two. */
+	site.ceiling = CK_BACKOFF_NS_MIN * 3;
+	ck_backoff_ns_init(&backoff, &site);
+	for (i = 0; i < 4; i++)
+		ck_backoff_ns(&backoff);
+
+	if (backoff.delay != CK_BACKOFF_NS_MIN * 3)
+		ck_error("ERROR: delay %u not clamped to ceiling %u\n",
+		    backoff.delay, CK_BACKOFF_NS_MIN * 3);
+
+	/* Uncontended operations leave the site untouched. */
+	previous = site.ceiling;
+	ck_backoff_ns_init(&backoff, &site);
+	ck_backoff_ns_done(&backoff, &site);
+	if (site.ceiling != previous)
+		ck_error("ERROR: uncontended operation updated site\n");
+
+	/*
+	 * A 1ms delay waits between 0.5ms and 1ms. Only the lower bound is
+	 * checked, as preemption may extend any wait.
+	 */
+	ck_backoff_site_init(&site);
+	site.ceiling = 1000000;
+	ck_backoff_ns_init(&backoff, &site);
+	backoff.delay = 1000000;
+	s = now();
+	ck_backoff_ns(&backoff);
+	e = now();
+
+	fprintf(stderr, "Scale: %u stalls per us, 1ms back-off took %lluns\n",
+	    ck_backoff_ns_scale, (unsigned long long)(e - s));
+	if (e - s < 250000)
+		ck_error("ERROR: 1ms back-off took %lluns\n", (unsigned long long)(e - s));
+
+	return;
+}
+
+static void
+critical(unsigned int *c)
+{
+	unsigned int l;
+
+	l = ck_pr_load_uint(c);
+	if (l != 0)
+		ck_error("ERROR [%d]: %u != 0\n", __LINE__, l);
+
+	ck_pr_inc_uint(c);
+	ck_pr_inc_uint(c);
+
+	l = ck_pr_load_uint(c);
+	if (l != 2)
+		ck_error("ERROR [%d]: %u != 2\n", __LINE__, l);
+
+	ck_pr_dec_uint(c);
+	ck_pr_dec_uint(c);
+	return;
+}
+
+static void *
+thread(void *null CK_CC_UNUSED)
+{
+	ck_backoff_ns_t backoff;
+	unsigned int snapshot;
+	int i = ITERATE;
+
+	if (aff_iterate(&a)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	while (i--) {
+		ck_spinlock_fas_lock_ab(&fas, &site_fas);
+		critical(&locked[0]);
+		ck_spinlock_fas_unlock(&fas);
+
+		ck_spinlock_cas_lock_ab(&cas, &site_cas);
+		critical(&locked[1]);
+		ck_spinlock_cas_unlock(&cas);
+
+		ck_spinlock_dec_lock_ab(&dec, &site_dec);
+		critical(&locked[2]);
+		ck_spinlock_dec_unlock(&dec);
+
+		ck_backoff_ns_init(&backoff, &site_inc);
+		snapshot = ck_pr_load_uint(&counter);
+		while (ck_pr_cas_uint_value(&counter, snapshot, snapshot + 1,
+		    &snapshot) == false)
+			ck_backoff_ns(&backoff);
+		ck_backoff_ns_done(&backoff, &site_inc);
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	int i;
+
+	if (argc != 3) {
+		ck_error("Usage: ns <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr <= 0) {
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+	}
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL) {
+		ck_error("ERROR: Could not allocate thread structures\n");
+	}
+
+	a.delta = atoi(argv[2]);
+
+	if (ck_backoff_ns_calibrate() == false)
+		ck_error("ERROR: Could not calibrate back-off\n");
+
+	fprintf(stderr, "Sequential regression...");
+	check_sequential();
+	fprintf(stderr, "done\n");
+
+	fprintf(stderr, "Creating threads (mutual exclusion)...");
+	for (i = 0; i < nthr; i++) {
+		if (pthread_create(&threads[i], NULL, thread, NULL)) {
+			ck_error("ERROR: Could not create thread %d\n", i);
+		}
+	}
+	fprintf(stderr, "done\n");
+
+	fprintf(stderr, "Waiting for threads to finish correctness regression...");
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	if (ck_pr_load_uint(&counter) != (unsigned int)nthr * ITERATE)
+		ck_error("ERROR: counter is %u, expected %u\n",
+		    counter, (unsigned int)nthr * ITERATE);
+
+	fprintf(stderr, "done (passed)\n");
+	return 0;
+}
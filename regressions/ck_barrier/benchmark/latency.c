@@ -0,0 +1,175 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <ck_pr.h>
+#include <ck_barrier_adaptive.h>
+
+#include "../../common.h"
+#include "../../ec_ops.h"
+
+#ifndef EPISODES
+#define EPISODES 1000000
+#endif
+
+static const char *names[] = {
+	"centralized",
+	"combining",
+	"dissemination",
+	"tournament",
+	"mcs",
+	"blocking",
+	"adaptive"
+};
+
+static struct affinity a;
+static unsigned int nthr;
+static unsigned int barrier_wait;
+static ck_barrier_adaptive_t barrier;
+
+static void *
+test_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void
+test_free(void *p, size_t b CK_CC_UNUSED, bool r CK_CC_UNUSED)
+{
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.free = test_free
+};
+
+static void *
+thread(void *null CK_CC_UNUSED)
+{
+	ck_barrier_adaptive_state_t state;
+	unsigned int i;
+
+	aff_iterate(&a);
+	ck_barrier_adaptive_subscribe(&barrier, &state);
+
+	ck_pr_inc_uint(&barrier_wait);
+	while (ck_pr_load_uint(&barrier_wait) != nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < EPISODES; i++)
+		ck_barrier_adaptive(&barrier, &state);
+
+	return NULL;
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int
+main(int argc, char *argv[])
+{
+	unsigned int algorithm, cluster, n_cpus, i;
+	pthread_t *threads;
+	double begin, end;
+
+	if (argc < 3) {
+		ck_error("Usage: latency <number of threads> <affinity delta> "
+		    "[threads per cache domain] [number of cores]\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr == 0) {
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+	}
+
+	a.delta = atoi(argv[2]);
+	cluster = argc > 3 ? (unsigned int)atoi(argv[3]) : 0;
+	n_cpus = argc > 4 ? (unsigned int)atoi(argv[4]) : nthr;
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL) {
+		ck_error("ERROR: Could not allocate thread structures\n");
+	}
+
+	printf("%u threads, %u per domain, %u cores\n", nthr, cluster, n_cpus);
+	for (algorithm = 0; algorithm <= CK_BARRIER_ADAPTIVE_AUTO; algorithm++) {
+		if (ck_barrier_adaptive_init(&barrier, &allocator, nthr,
+		    n_cpus, cluster, &ec_mode) == false) {
+			ck_error("ERROR: Could not initialize barrier\n");
+		}
+
+		/*
+		 * The pin applies from the second episode on, the first
+		 * one runs the initial choice.
+		 */
+		if (ck_barrier_adaptive_set(&barrier, algorithm) == false) {
+			ck_barrier_adaptive_destroy(&barrier);
+			continue;
+		}
+
+		ck_pr_store_uint(&barrier_wait, 0);
+		a.request = 0;
+
+		begin = now();
+		for (i = 0; i < nthr; i++) {
+			if (pthread_create(&threads[i], NULL, thread, NULL)) {
+				ck_error("ERROR: Could not create thread %u\n", i);
+			}
+		}
+
+		for (i = 0; i < nthr; i++)
+			pthread_join(threads[i], NULL);
+		end = now();
+
+		if (algorithm == CK_BARRIER_ADAPTIVE_AUTO) {
+			printf("%16s %12.2f ns/episode (settled on %s)\n",
+			    names[algorithm], (end - begin) / EPISODES,
+			    names[ck_barrier_adaptive_algorithm(&barrier)]);
+		} else {
+			printf("%16s %12.2f ns/episode\n", names[algorithm],
+			    (end - begin) / EPISODES);
+		}
+
+		ck_barrier_adaptive_destroy(&barrier);
+	}
+
+	return (0);
+}
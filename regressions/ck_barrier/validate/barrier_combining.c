@@ -38,6 +38,7 @@
 
 #include <ck_pr.h>
 #include <ck_barrier.h>
+#include <ck_barrier_reduce.h>
 
 #include "../../common.h"
 
@@ -49,12 +50,20 @@
 #define ENTRIES 512
 #endif
 
+#ifndef REDUCE
+#define REDUCE 100000
+#endif
+
 static struct affinity a;
 static int nthr;
 static int ngroups;
 static int counters[ENTRIES];
 static ck_barrier_combining_t barrier;
 static int barrier_wait;
+static unsigned int tid;
+#ifdef CK_F_BARRIER_REDUCE
+static const ck_barrier_reduce_t reduce_sum = CK_BARRIER_REDUCE_SUM;
+#endif
 
 static void *
 thread(void *group)
@@ -62,6 +71,11 @@ thread(void *group)
 	ck_barrier_combining_state_t state = CK_BARRIER_COMBINING_STATE_INITIALIZER;
 	int j, counter;
 	int i = 0;
+#ifdef CK_F_BARRIER_REDUCE
+	uint64_t n = (uint64_t)nthr * ngroups;
+	uint64_t id = ck_pr_faa_uint(&tid, 1);
+	uint64_t sum;
+#endif
 
 	aff_iterate(&a);
 
@@ -79,6 +93,17 @@ thread(void *group)
 		}
 	}
 
+#ifdef CK_F_BARRIER_REDUCE
+	for (j = 0; j < REDUCE; j++) {
+		sum = ck_barrier_combining_reduce(&barrier, group, &state,
+		    j * n + id + 1);
+		if (sum != j * n * n + n * (n + 1) / 2) {
+			ck_error("FAILED [%d]: sum %" PRIu64 " != %" PRIu64 "\n",
+			    j, sum, j * n * n + n * (n + 1) / 2);
+		}
+	}
+#endif
+
 	return (NULL);
 }
 
@@ -125,6 +150,10 @@ main(int argc, char *argv[])
 	for (i = 0; i < ngroups; i++)
 		ck_barrier_combining_group_init(&barrier, groupings + i, nthr);
 
+#ifdef CK_F_BARRIER_REDUCE
+	ck_barrier_combining_reduce_init(&barrier, &reduce_sum);
+#endif
+
 	fprintf(stderr, "Creating threads (barrier)...");
 	for (i = 0; i < (nthr * ngroups); i++) {
 		if (pthread_create(&threads[i], NULL, thread, groupings + (i % ngroups))) {
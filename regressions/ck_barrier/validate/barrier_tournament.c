@@ -38,6 +38,7 @@
 
 #include <ck_pr.h>
 #include <ck_barrier.h>
+#include <ck_barrier_reduce.h>
 
 #include "../../common.h"
 
@@ -49,11 +50,22 @@
 #define ENTRIES 512
 #endif
 
+#ifndef REDUCE
+#define REDUCE 100000
+#endif
+
 static struct affinity a;
 static int nthr;
 static int counters[ENTRIES];
 static int barrier_wait;
 static ck_barrier_tournament_t barrier;
+#ifdef CK_F_BARRIER_REDUCE
+static const ck_barrier_reduce_t reduce[3] = {
+	CK_BARRIER_REDUCE_SUM,
+	CK_BARRIER_REDUCE_MIN,
+	CK_BARRIER_REDUCE_MAX
+};
+#endif
 
 static void *
 thread(CK_CC_UNUSED void *unused)
@@ -61,6 +73,9 @@ thread(CK_CC_UNUSED void *unused)
 	ck_barrier_tournament_state_t state;
 	int j, counter;
 	int i = 0;
+#ifdef CK_F_BARRIER_REDUCE
+	uint64_t n = nthr, id, r, expected;
+#endif
 
 	aff_iterate(&a);
 	ck_barrier_tournament_subscribe(&barrier, &state);
@@ -79,6 +94,32 @@ thread(CK_CC_UNUSED void *unused)
 		}
 	}
 
+#ifdef CK_F_BARRIER_REDUCE
+	/* Every thread contributes j * n + vpid + 1, cycling through ops. */
+	id = state.vpid;
+	for (j = 0; j < REDUCE; j++) {
+		r = ck_barrier_tournament_reduce(&barrier, &state,
+		    j * n + id + 1, &reduce[j % 3]);
+
+		switch (j % 3) {
+		case 0:
+			expected = j * n * n + n * (n + 1) / 2;
+			break;
+		case 1:
+			expected = j * n + 1;
+			break;
+		default:
+			expected = j * n + n;
+			break;
+		}
+
+		if (r != expected) {
+			ck_error("FAILED [%d]: reduction %" PRIu64 " != %" PRIu64 "\n",
+			    j, r, expected);
+		}
+	}
+#endif
+
 	ck_pr_inc_int(&barrier_wait);
 	while (ck_pr_load_int(&barrier_wait) != nthr * 2)
 		ck_pr_stall();
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_bitmap.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef BITS
+#define BITS (1U << 24)
+#endif
+
+#ifndef ITERATIONS
+#define ITERATIONS 64
+#endif
+
+static ck_bitmap_t *
+bitmap_random(void)
+{
+	ck_bitmap_t *bitmap;
+	unsigned int i;
+
+	bitmap = malloc(ck_bitmap_size(BITS));
+	if (bitmap == NULL)
+		ck_error("ERROR: Failed to allocate bitmap\n");
+
+	ck_bitmap_init(bitmap, BITS, false);
+	for (i = 0; i < BITS; i++) {
+		if (common_rand() & 1)
+			ck_bitmap_set(bitmap, i);
+	}
+
+	return bitmap;
+}
+
+#define BENCHMARK(label, expression) do {				\
+		uint64_t s, e;						\
+		unsigned int j;						\
+									\
+		s = rdtsc();						\
+		for (j = 0; j < ITERATIONS; j++)			\
+			sink += (expression);				\
+		e = rdtsc();						\
+		printf("%36s: %10" PRIu64 " ticks/op %8.3f ticks/block\n",	\
+		    label, (e - s) / ITERATIONS,			\
+		    (double)(e - s) / ITERATIONS / CK_BITMAP_BLOCKS(BITS));	\
+	} while (0)
+
+int
+main(void)
+{
+	ck_bitmap_t *x, *y;
+	unsigned long sink = 0;
+
+	x = bitmap_random();
+	y = bitmap_random();
+
+	printf("%u bits, %zu-bit blocks\n", BITS, CK_BITMAP_BLOCK);
+
+	BENCHMARK("ck_bitmap_union",
+	    (ck_bitmap_union(x, y), 0));
+	BENCHMARK("ck_bitmap_union_serial",
+	    (ck_bitmap_union_serial(x, y), 0));
+	BENCHMARK("ck_bitmap_intersection",
+	    (ck_bitmap_intersection(x, y), 0));
+	BENCHMARK("ck_bitmap_intersection_serial",
+	    (ck_bitmap_intersection_serial(x, y), 0));
+	BENCHMARK("ck_bitmap_intersection_negate",
+	    (ck_bitmap_intersection_negate(x, y), 0));
+	BENCHMARK("ck_bitmap_intersection_negate_serial",
+	    (ck_bitmap_intersection_negate_serial(x, y), 0));
+
+	free(x);
+	x = bitmap_random();
+
+	BENCHMARK("ck_bitmap_count",
+	    ck_bitmap_count(x, BITS));
+	BENCHMARK("ck_bitmap_count_serial",
+	    ck_bitmap_count_serial(x, BITS));
+	BENCHMARK("ck_bitmap_count_intersect",
+	    ck_bitmap_count_intersect(x, y, BITS));
+	BENCHMARK("ck_bitmap_count_intersect_serial",
+	    ck_bitmap_count_intersect_serial(x, y, BITS));
+
+	fprintf(stderr, "%lu\n", sink);
+	free(x);
+	free(y);
+	return 0;
+}
@@ -246,6 +246,18 @@ test_counts(const ck_bitmap_t *x, const ck_bitmap_t *y)
 			    i, r, count_intersect);
 		}
 
+		r = ck_bitmap_count_serial(x, i);
+		if (r != count) {
+			ck_error("ck_bitmap_count_serial(%u): got %u expected %u\n",
+			    i, r, count);
+		}
+
+		r = ck_bitmap_count_intersect_serial(x, y, i);
+		if (r != count_intersect) {
+			ck_error("ck_bitmap_count_intersect_serial(%u): got %u expected %u\n",
+			    i, r, count_intersect);
+		}
+
 		if (i < length) {
 			count += ck_bitmap_test(x, i);
 			count_intersect += ck_bitmap_test(x, i) & ck_bitmap_test(y, i);
@@ -287,11 +299,14 @@ random_test(unsigned int seed)
 
 #define OR(x, y) (x | y)
 #define AND(x, y) (x & y)
-#define ANDC2(x, y) (x & (~y))
+#define ANDC2(x, y) (x & !y)
 
 	TEST(ck_bitmap_union, OR);
 	TEST(ck_bitmap_intersection, AND);
 	TEST(ck_bitmap_intersection_negate, ANDC2);
+	TEST(ck_bitmap_union_serial, OR);
+	TEST(ck_bitmap_intersection_serial, AND);
+	TEST(ck_bitmap_intersection_negate_serial, ANDC2);
 
 #undef ANDC2
 #undef AND
@@ -368,5 +383,13 @@ main(int argc, char *argv[])
 		}
 	}
 
+	/*
+	 * Long enough for the vectorized serial kernels, with a scalar tail.
+	 */
+	for (i = 1000; i < 1040; i++) {
+		length = i;
+		random_test(i);
+	}
+
 	return 0;
 }
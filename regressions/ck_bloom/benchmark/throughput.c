@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_bloom.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef KEYS
+#define KEYS (1U << 24)
+#endif
+
+#ifndef QUERIES
+#define QUERIES (1U << 22)
+#endif
+
+#define BATCH 64
+
+static void
+bloom_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = bloom_free
+};
+
+static uint64_t
+hash(uint64_t x)
+{
+
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+static void
+run(const char *label, unsigned int mode)
+{
+	static uint64_t hashes[QUERIES];
+	static bool results[QUERIES];
+	ck_bloom_t bloom;
+	unsigned int i, hits = 0;
+	uint64_t s, e;
+
+	if (ck_bloom_init(&bloom, mode, &allocator, KEYS, 0.01) == false)
+		ck_error("ERROR: Failed to initialize filter\n");
+
+	s = rdtsc();
+	for (i = 0; i < KEYS; i++)
+		ck_bloom_insert(&bloom, hash(i));
+	e = rdtsc();
+	printf("%s (%zu bytes)\n", label, ck_bloom_size(&bloom));
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_bloom_insert",
+	    (e - s) / KEYS);
+
+	/* Half of the queries are for keys that were inserted. */
+	for (i = 0; i < QUERIES; i++)
+		hashes[i] = hash(i * 2);
+
+	s = rdtsc();
+	for (i = 0; i < QUERIES; i++)
+		hits += ck_bloom_query(&bloom, hashes[i]);
+	e = rdtsc();
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_bloom_query",
+	    (e - s) / QUERIES);
+
+	s = rdtsc();
+	for (i = 0; i < QUERIES; i += BATCH)
+		ck_bloom_query_n(&bloom, hashes + i, results + i, BATCH);
+	e = rdtsc();
+	printf("%24s: %8" PRIu64 " ticks/op\n", "ck_bloom_query_n",
+	    (e - s) / QUERIES);
+
+	for (i = 0; i < QUERIES; i++)
+		hits -= results[i];
+
+	if (hits != 0)
+		ck_error("ERROR: Batch and single queries disagree\n");
+
+	ck_bloom_destroy(&bloom);
+	return;
+}
+
+int
+main(void)
+{
+
+	run("bits", 0);
+	run("counting", CK_BLOOM_MODE_COUNTING);
+	return 0;
+}
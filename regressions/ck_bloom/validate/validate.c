@@ -0,0 +1,232 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_bloom.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef KEYS
+#define KEYS 200000
+#endif
+
+static unsigned int nthr;
+static struct affinity a;
+static ck_bloom_t bloom;
+
+static void
+bloom_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+
+	/* A filter is never resized, so its table is only freed on destroy. */
+	if (r == true)
+		ck_error("ERROR: ck_bloom deferred the release of its table\n");
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = bloom_free
+};
+
+static uint64_t
+hash(uint64_t x)
+{
+
+	x += 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+/*
+ * Measures the false positive rate over keys that were never inserted
+ * and checks it against the target, with some tolerance.
+ */
+static void
+false_positives(double rate)
+{
+	unsigned int i, hits = 0;
+
+	for (i = 0; i < KEYS; i++)
+		hits += ck_bloom_query(&bloom, hash(KEYS + i));
+
+	if ((double)hits / KEYS > rate * 2) {
+		ck_error("ERROR: False positive rate %f exceeds target %f\n",
+		    (double)hits / KEYS, rate);
+	}
+
+	fprintf(stderr, "  mode %u, target %f, observed %f, %zu bytes\n",
+	    bloom.mode, rate, (double)hits / KEYS, ck_bloom_size(&bloom));
+	return;
+}
+
+static void
+serial(unsigned int mode, double rate)
+{
+	uint64_t hashes[64];
+	bool results[64];
+	unsigned int i, j;
+
+	if (ck_bloom_init(&bloom, mode, &allocator, KEYS, rate) == false)
+		ck_error("ERROR: Failed to initialize filter\n");
+
+	for (i = 0; i < KEYS; i++)
+		ck_bloom_insert(&bloom, hash(i));
+
+	for (i = 0; i < KEYS; i++) {
+		if (ck_bloom_query(&bloom, hash(i)) == false)
+			ck_error("ERROR: False negative for key %u\n", i);
+	}
+
+	false_positives(rate);
+
+	for (i = 0; i < KEYS; i += 64) {
+		for (j = 0; j < 64; j++)
+			hashes[j] = hash(i + j * 31);
+
+		ck_bloom_query_n(&bloom, hashes, results, 64);
+		for (j = 0; j < 64; j++) {
+			if (results[j] != ck_bloom_query(&bloom, hashes[j]))
+				ck_error("ERROR: Batch query disagrees\n");
+		}
+	}
+
+	if (mode & CK_BLOOM_MODE_COUNTING) {
+		/* Remove the even keys, the odd ones must remain. */
+		for (i = 0; i < KEYS; i += 2) {
+			if (ck_bloom_remove(&bloom, hash(i)) == false)
+				ck_error("ERROR: Failed to remove key %u\n", i);
+		}
+
+		for (i = 1; i < KEYS; i += 2) {
+			if (ck_bloom_query(&bloom, hash(i)) == false)
+				ck_error("ERROR: False negative for key %u\n", i);
+		}
+
+		for (i = 1; i < KEYS; i += 2)
+			ck_bloom_remove(&bloom, hash(i));
+
+		for (i = 0, j = 0; i < KEYS; i++)
+			j += ck_bloom_query(&bloom, hash(i));
+
+		if (j != 0)
+			ck_error("ERROR: %u keys remain after removal\n", j);
+	} else if (ck_bloom_remove(&bloom, hash(0)) == true) {
+		ck_error("ERROR: Removal from a non-counting filter\n");
+	}
+
+	ck_bloom_clear(&bloom);
+	if (ck_bloom_query(&bloom, hash(1)) == true)
+		ck_error("ERROR: Key present after clear\n");
+
+	ck_bloom_destroy(&bloom);
+	return;
+}
+
+static void *
+thread(void *arg)
+{
+	unsigned int tid = (unsigned int)(uintptr_t)arg;
+	unsigned int i;
+
+	if (aff_iterate(&a)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = tid; i < KEYS; i += nthr)
+		ck_bloom_insert(&bloom, hash(i));
+
+	return NULL;
+}
+
+static void
+concurrent(unsigned int mode)
+{
+	pthread_t *threads;
+	unsigned int i;
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	if (ck_bloom_init(&bloom, mode, &allocator, KEYS, 0.01) == false)
+		ck_error("ERROR: Failed to initialize filter\n");
+
+	for (i = 0; i < nthr; i++) {
+		if (pthread_create(&threads[i], NULL, thread,
+		    (void *)(uintptr_t)i) != 0)
+			ck_error("ERROR: Failed to create thread %u\n", i);
+	}
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	for (i = 0; i < KEYS; i++) {
+		if (ck_bloom_query(&bloom, hash(i)) == false)
+			ck_error("ERROR: Concurrent insert of %u lost\n", i);
+	}
+
+	ck_bloom_destroy(&bloom);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr == 0)
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+
+	a.delta = atoi(argv[2]);
+
+	if (ck_bloom_init(&bloom, 0, &allocator, 0, 0.01) == true ||
+	    ck_bloom_init(&bloom, 0, &allocator, 1, 1.0) == true)
+		ck_error("ERROR: Accepted an invalid configuration\n");
+
+	serial(0, 0.1);
+	serial(0, 0.01);
+	serial(0, 0.001);
+	serial(CK_BLOOM_MODE_COUNTING, 0.01);
+
+	concurrent(0);
+	concurrent(CK_BLOOM_MODE_COUNTING);
+	return 0;
+}
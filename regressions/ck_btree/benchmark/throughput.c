@@ -0,0 +1,235 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_btree.h>
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 1000000
+#endif
+
+#define SPAN 64
+
+/*
+ * Measures aggregate throughput of concurrent lookups, updates and range
+ * scans. Keys are drawn from twice the initial number of entries, so
+ * about half of all lookups miss and updates keep the tree at its size.
+ */
+struct node_header {
+	ck_epoch_entry_t epoch_entry;
+};
+
+static ck_epoch_t epoch;
+static ck_epoch_record_t epoch_wr;
+static ck_btree_t tree;
+static unsigned int nthr;
+static unsigned int barrier;
+static unsigned int range;
+static unsigned int lookups;
+static struct affinity a;
+
+enum {
+	TEST_MIX,
+	TEST_SCAN
+};
+
+static unsigned int test;
+
+static void *
+test_malloc(size_t r)
+{
+	struct node_header *h;
+
+	h = malloc(sizeof(*h) + r);
+	if (h == NULL)
+		return NULL;
+
+	return h + 1;
+}
+
+static void
+test_destroy(ck_epoch_entry_t *e)
+{
+
+	free(e);
+	return;
+}
+
+/*
+ * Deferred frees are collected on a record that is only reclaimed once
+ * every thread is done, which keeps reclamation out of the measurement.
+ */
+static void
+test_free(void *p, size_t b, bool r)
+{
+	struct node_header *h = p;
+
+	(void)b;
+	h--;
+
+	if (r == true) {
+		ck_epoch_call_strict(&epoch_wr, &h->epoch_entry, test_destroy);
+	} else {
+		free(h);
+	}
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.free = test_free
+};
+
+static uint64_t
+key_of(unsigned int k)
+{
+
+	return (uint64_t)k * 0x9e3779b97f4a7c15ULL >> 8 << 8 | k % 251;
+}
+
+static void *
+thread(void *unused)
+{
+	ck_btree_iterator_t iterator;
+	ck_epoch_record_t *record;
+	unsigned int i, n, op;
+	uint64_t key;
+	void *value;
+
+	(void)unused;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Could not allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		key = key_of(common_rand() % range);
+		op = common_rand() % 100;
+
+		ck_epoch_begin(record, NULL);
+		if (test == TEST_SCAN) {
+			ck_btree_lower_bound(&tree, &iterator, key);
+			for (n = 0; n < SPAN; n++) {
+				if (ck_btree_next(&tree, &iterator, &key, &value) == false)
+					break;
+			}
+		} else if (op < lookups) {
+			ck_btree_get(&tree, key);
+		} else if (op & 1) {
+			ck_btree_put(&tree, key, &tree);
+		} else {
+			ck_btree_remove(&tree, key);
+		}
+		ck_epoch_end(record, NULL);
+	}
+
+	return NULL;
+}
+
+static void
+run(const char *label, unsigned int t, unsigned int percent)
+{
+	pthread_t *threads;
+	unsigned int i;
+	uint64_t s, e;
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	test = t;
+	lookups = percent;
+	barrier = 0;
+	a.request = 0;
+
+	s = rdtsc();
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, thread, NULL);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+	e = rdtsc();
+
+	printf("%24s: %8.2f ticks/op\n", label,
+	    (double)(e - s) / ((uint64_t)ITERATIONS * nthr));
+
+	ck_epoch_barrier(&epoch_wr);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	unsigned int i, entries;
+
+	if (argc != 4) {
+		ck_error("Usage: throughput <number of threads> <affinity delta> "
+		    "<number of entries>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	a.delta = atoi(argv[2]);
+	entries = atoi(argv[3]);
+	if (nthr == 0 || entries == 0)
+		ck_error("ERROR: Number of threads and entries must be positive\n");
+
+	range = entries * 2;
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &epoch_wr, NULL);
+	if (ck_btree_init(&tree, &allocator) == false)
+		ck_error("ERROR: ck_btree_init\n");
+
+	for (i = 0; i < range; i += 2)
+		ck_btree_put(&tree, key_of(i), &tree);
+
+	run("lookup", TEST_MIX, 100);
+	run("95% lookup, 5% update", TEST_MIX, 95);
+	run("50% lookup, 50% update", TEST_MIX, 50);
+	run("update", TEST_MIX, 0);
+	run("range scan", TEST_SCAN, 0);
+
+	ck_btree_destroy(&tree);
+	ck_epoch_barrier(&epoch_wr);
+	return 0;
+}
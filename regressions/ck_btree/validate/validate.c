@@ -0,0 +1,434 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_btree.h>
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 400000
+#endif
+
+/*
+ * Keys are spread evenly over the key space, so the smallest and largest
+ * keys are exercised. Values point at a per-key slot that identifies the
+ * key they were stored under.
+ */
+#define UNIVERSE 65536
+#define CONCURRENT 16384
+#define STEP (UINT64_MAX / (UNIVERSE - 1))
+#define KEY(k) ((uint64_t)(k) * STEP)
+#define VALUE(k) ((void *)&slots[(k)])
+#define PERSISTENT(k) (((k) & 3) == 0)
+#define SPAN 64
+
+/*
+ * Nodes are cache line aligned, which is the layout ck_btree is designed
+ * for. The header sits in front of each node.
+ */
+struct node_header {
+	ck_epoch_entry_t epoch_entry;
+	void *base;
+	size_t size;
+};
+
+static ck_epoch_t epoch;
+static ck_epoch_record_t epoch_wr;
+static ck_btree_t tree;
+static char slots[UNIVERSE];
+static bool present[UNIVERSE];
+static long *balance;
+static unsigned int nthr;
+static unsigned int barrier;
+static struct affinity a;
+
+static void *
+btree_malloc(size_t r)
+{
+	struct node_header *h;
+	uintptr_t p;
+	char *base;
+
+	base = malloc(sizeof(*h) + r + CK_MD_CACHELINE - 1);
+	if (base == NULL)
+		return NULL;
+
+	p = ((uintptr_t)(base + sizeof(*h)) + CK_MD_CACHELINE - 1) &
+	    ~(uintptr_t)(CK_MD_CACHELINE - 1);
+	h = (struct node_header *)p - 1;
+	h->base = base;
+	return (void *)p;
+}
+
+static void
+btree_destroy(ck_epoch_entry_t *e)
+{
+	struct node_header *h = (struct node_header *)e;
+
+	/*
+	 * The pattern is even, so the sequence counter of a poisoned node
+	 * does not look latched. A reader that still holds the node fails
+	 * validation or follows a garbage child instead of spinning.
+	 */
+	memset(h + 1, 0x5a, h->size);
+	free(h->base);
+	return;
+}
+
+/* The tree passes the size of the node, which depends on its kind. */
+static void
+btree_free(void *p, size_t b, bool r)
+{
+	struct node_header *h = (struct node_header *)p - 1;
+
+	if (r == true) {
+		h->size = b;
+		ck_epoch_call_strict(&epoch_wr, &h->epoch_entry, btree_destroy);
+	} else {
+		free(h->base);
+	}
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = btree_malloc,
+	.free = btree_free
+};
+
+static unsigned int
+index_of(uint64_t key)
+{
+
+	if (key % STEP != 0 || key / STEP >= UNIVERSE)
+		ck_error("ERROR: Unexpected key %#llx\n", (unsigned long long)key);
+
+	return (unsigned int)(key / STEP);
+}
+
+/* Compares a full scan and a range scan with the model. */
+static void
+verify(void)
+{
+	ck_btree_iterator_t iterator;
+	unsigned int k, start;
+	uint64_t key;
+	void *value;
+
+	k = 0;
+	ck_btree_iterator_init(&tree, &iterator);
+	while (ck_btree_next(&tree, &iterator, &key, &value) == true) {
+		while (k < UNIVERSE && present[k] == false)
+			k++;
+
+		if (k == UNIVERSE || key != KEY(k) || value != VALUE(k))
+			ck_error("ERROR: Iteration diverges at %#llx\n",
+			    (unsigned long long)key);
+
+		k++;
+	}
+
+	while (k < UNIVERSE && present[k] == false)
+		k++;
+
+	if (k != UNIVERSE)
+		ck_error("ERROR: Iteration ended before %u\n", k);
+
+	/* Bounds between keys must start at the next key. */
+	start = common_rand() % UNIVERSE;
+	ck_btree_lower_bound(&tree, &iterator, KEY(start) - (start > 0));
+	for (k = start; ck_btree_next(&tree, &iterator, &key, &value) == true; k++) {
+		while (k < UNIVERSE && present[k] == false)
+			k++;
+
+		if (k == UNIVERSE || key != KEY(k))
+			ck_error("ERROR: Range scan from %u diverges at %#llx\n",
+			    start, (unsigned long long)key);
+	}
+
+	return;
+}
+
+/*
+ * Applies random operations and checks every result against a model. The
+ * insertion bias alternates, so leaves are repeatedly split and merged.
+ */
+static void
+serial(void)
+{
+	unsigned int i, k, bias = 3;
+	void *previous;
+
+	memset(present, 0, sizeof present);
+	if (ck_btree_init(&tree, &allocator) == false)
+		ck_error("ERROR: ck_btree_init\n");
+
+	for (i = 0; i < ITERATIONS; i++) {
+		if ((i % (ITERATIONS / 8)) == 0)
+			bias = 4 - bias;
+
+		k = common_rand() % UNIVERSE;
+		if (i & 1)
+			k = (i & 2) ? UNIVERSE - 1 - (k & 255) : (k & 255);
+
+		switch (common_rand() % 5) {
+		case 0:
+		case 1:
+		case 2:
+			if ((unsigned int)common_rand() % 4 >= bias) {
+				if (ck_btree_remove(&tree, KEY(k)) !=
+				    (present[k] ? VALUE(k) : NULL))
+					ck_error("ERROR: Remove of %u disagrees\n", k);
+
+				present[k] = false;
+				break;
+			}
+
+			if (ck_btree_put(&tree, KEY(k), VALUE(k)) == present[k])
+				ck_error("ERROR: Put of %u disagrees\n", k);
+
+			present[k] = true;
+			break;
+		case 3:
+			if (ck_btree_set(&tree, KEY(k), VALUE(k), &previous) == false)
+				ck_error("ERROR: Set of %u failed\n", k);
+
+			if (previous != (present[k] ? VALUE(k) : NULL))
+				ck_error("ERROR: Set of %u disagrees\n", k);
+
+			present[k] = true;
+			break;
+		case 4:
+			if (ck_btree_get(&tree, KEY(k)) != (present[k] ? VALUE(k) : NULL))
+				ck_error("ERROR: Get of %u disagrees\n", k);
+
+			break;
+		}
+
+		if ((i & 16383) == 0) {
+			verify();
+			ck_epoch_barrier(&epoch_wr);
+		}
+	}
+
+	verify();
+	ck_btree_destroy(&tree);
+	ck_epoch_barrier(&epoch_wr);
+	return;
+}
+
+/*
+ * Readers check that persistent keys are always found and that a scan is
+ * in order and never steps over a persistent key.
+ */
+static void
+reader(ck_epoch_record_t *record)
+{
+	ck_btree_iterator_t iterator;
+	unsigned int k, n, previous, current;
+	uint64_t key;
+	void *value;
+
+	k = (common_rand() % CONCURRENT) & ~3U;
+
+	ck_epoch_begin(record, NULL);
+	if (ck_btree_get(&tree, KEY(k)) != VALUE(k))
+		ck_error("ERROR: Persistent key %u not found\n", k);
+
+	previous = k;
+	ck_btree_lower_bound(&tree, &iterator, KEY(k));
+	for (n = 0; n < SPAN; n++) {
+		if (ck_btree_next(&tree, &iterator, &key, &value) == false)
+			break;
+
+		current = index_of(key);
+		if (value != VALUE(current))
+			ck_error("ERROR: Key %u has the wrong value\n", current);
+
+		if ((n == 0 && current != k) || (n > 0 && current <= previous))
+			ck_error("ERROR: Scan returned %u after %u\n", current, previous);
+
+		if (((previous + 4) & ~3U) < current && ((previous + 4) & ~3U) < CONCURRENT)
+			ck_error("ERROR: Scan skipped a persistent key after %u\n",
+			    previous);
+
+		previous = current;
+	}
+
+	ck_epoch_end(record, NULL);
+	return;
+}
+
+/*
+ * Every writer records the net effect of its successful operations on
+ * each key. Once all writers are done, the sum for a key must match its
+ * presence in the tree. Writers favor insertion for the first half of the
+ * run and removal for the second, so leaves fill, split, drain and merge
+ * under contention.
+ */
+static void *
+writer(void *arg)
+{
+	long *local = arg;
+	ck_epoch_record_t *record;
+	unsigned int i, k, insert;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Could not allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		k = common_rand() % CONCURRENT;
+		if (PERSISTENT(k))
+			k++;
+
+		insert = (unsigned int)common_rand() % 4;
+		if (i >= ITERATIONS / 2)
+			insert = insert == 0;
+		else
+			insert = insert != 0;
+
+		ck_epoch_begin(record, NULL);
+		if (insert != 0) {
+			if (ck_btree_put(&tree, KEY(k), VALUE(k)) == true)
+				local[k]++;
+		} else {
+			if (ck_btree_remove(&tree, KEY(k)) == VALUE(k))
+				local[k]--;
+		}
+		ck_epoch_end(record, NULL);
+
+		if ((i & 7) == 0)
+			reader(record);
+	}
+
+	return NULL;
+}
+
+static void
+concurrent(void)
+{
+	ck_btree_iterator_t iterator;
+	pthread_t *threads;
+	unsigned int i, k, n, previous;
+	uint64_t key;
+	void *value;
+	long sum;
+
+	if (ck_btree_init(&tree, &allocator) == false)
+		ck_error("ERROR: ck_btree_init\n");
+
+	for (k = 0; k < CONCURRENT; k += 4) {
+		if (ck_btree_put(&tree, KEY(k), VALUE(k)) == false)
+			ck_error("ERROR: Failed to insert %u\n", k);
+	}
+
+	ck_pr_store_uint(&barrier, 0);
+	threads = malloc(sizeof(pthread_t) * nthr);
+	balance = calloc((size_t)nthr * CONCURRENT, sizeof(long));
+	if (threads == NULL || balance == NULL)
+		ck_error("ERROR: Could not allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, writer, balance + i * CONCURRENT);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	n = 0;
+	for (k = 0; k < CONCURRENT; k++) {
+		sum = PERSISTENT(k) ? 1 : 0;
+		for (i = 0; i < nthr; i++)
+			sum += balance[i * CONCURRENT + k];
+
+		if (sum != 0 && sum != 1)
+			ck_error("ERROR: Key %u has balance %ld\n", k, sum);
+
+		if ((ck_btree_get(&tree, KEY(k)) != NULL) != (sum == 1))
+			ck_error("ERROR: Key %u presence does not match %ld\n", k, sum);
+
+		n += (unsigned int)sum;
+	}
+
+	k = 0;
+	previous = 0;
+	ck_btree_iterator_init(&tree, &iterator);
+	while (ck_btree_next(&tree, &iterator, &key, &value) == true) {
+		if (k > 0 && index_of(key) <= previous)
+			ck_error("ERROR: Iteration is out of order\n");
+
+		previous = index_of(key);
+		k++;
+	}
+
+	if (k != n)
+		ck_error("ERROR: Iteration returned %u entries, expected %u\n", k, n);
+
+	ck_btree_destroy(&tree);
+	ck_epoch_barrier(&epoch_wr);
+	free(balance);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &epoch_wr, NULL);
+
+	fprintf(stderr, "Serial...");
+	serial();
+	fprintf(stderr, "done\n%u writers...", nthr);
+	concurrent();
+	fprintf(stderr, "done\n");
+	return 0;
+}
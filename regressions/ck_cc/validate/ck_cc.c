@@ -33,5 +33,13 @@ main(void)
 	if (ck_cc_popcount(x) != 3)
 		ck_error("popcount = %d\n", ck_cc_popcount(x));
 
+	if (ck_cc_ctzll((unsigned long long)x << 40) != 44)
+		ck_error("ctzll = %d\n", ck_cc_ctzll((unsigned long long)x << 40));
+
+	if (ck_cc_popcountll(((unsigned long long)x << 40) | x) != 6) {
+		ck_error("popcountll = %d\n",
+		    ck_cc_popcountll(((unsigned long long)x << 40) | x));
+	}
+
 	return 0;
 }
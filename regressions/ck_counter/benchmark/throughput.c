@@ -0,0 +1,161 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_counter.h>
+#include <ck_pr.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 10000000
+#endif
+
+#define BATCH 1024
+
+static void
+counter_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = counter_free
+};
+
+static ck_counter_t counter;
+static uint64_t word CK_CC_CACHELINE;
+static unsigned int nthr;
+static unsigned int barrier;
+static struct affinity a;
+
+enum {
+	TEST_FAA,
+	TEST_ATOMIC,
+	TEST_LOCAL,
+	TEST_LIMIT
+};
+
+static unsigned int test;
+
+static void *
+thread(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	unsigned int i;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	switch (test) {
+	case TEST_FAA:
+		for (i = 0; i < ITERATIONS; i++)
+			ck_pr_faa_64(&word, 1);
+		break;
+	case TEST_ATOMIC:
+		for (i = 0; i < ITERATIONS; i++)
+			ck_counter_inc(&counter, id);
+		break;
+	case TEST_LOCAL:
+		for (i = 0; i < ITERATIONS; i++)
+			ck_counter_inc_local(&counter, id);
+		break;
+	case TEST_LIMIT:
+		for (i = 0; i < ITERATIONS; i++) {
+			ck_counter_limit_add(&counter, id, 1);
+			ck_counter_limit_sub(&counter, id, 1);
+		}
+		break;
+	}
+
+	return NULL;
+}
+
+static void
+run(const char *label, unsigned int t)
+{
+	pthread_t *threads;
+	unsigned int i;
+	uint64_t s, e;
+
+	if (ck_counter_init(&counter, &allocator, nthr, BATCH, UINT32_MAX) == false)
+		ck_error("ERROR: ck_counter_init\n");
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	test = t;
+	barrier = 0;
+	a.request = 0;
+
+	s = rdtsc();
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, thread, (void *)(uintptr_t)i);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+	e = rdtsc();
+
+	printf("%24s: %8.2f ticks/op (read %" PRIu64 ", sum %" PRIu64 ")\n",
+	    label, (double)(e - s) / ((uint64_t)ITERATIONS * nthr),
+	    ck_counter_read(&counter), ck_counter_sum(&counter));
+
+	ck_counter_destroy(&counter);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: throughput <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	a.delta = atoi(argv[2]);
+
+	run("ck_pr_faa_64", TEST_FAA);
+	run("ck_counter_inc", TEST_ATOMIC);
+	run("ck_counter_inc_local", TEST_LOCAL);
+	run("ck_counter_limit_add/sub", TEST_LIMIT);
+	return 0;
+}
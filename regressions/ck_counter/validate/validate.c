@@ -0,0 +1,241 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_counter.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 100000
+#endif
+
+#define BATCH 32
+#define LIMIT 1000
+
+static ck_counter_t local;
+static ck_counter_t shared;
+static ck_counter_t limited;
+static unsigned int nthr;
+static unsigned int barrier;
+static uint64_t in_use;
+static struct affinity a;
+
+static void
+counter_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+
+	/* Shards are allocated once and released only by ck_counter_destroy. */
+	if (r == true)
+		ck_error("ERROR: ck_counter deferred the release of its shards\n");
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = counter_free
+};
+
+static void
+check_drift(ck_counter_t *counter, uint64_t expected)
+{
+	uint64_t read = ck_counter_read(counter);
+	uint64_t bound = (uint64_t)counter->n_shards * BATCH;
+
+	if (ck_counter_sum(counter) != expected) {
+		ck_error("ERROR: Sum is %ju, expected %ju\n",
+		    (uintmax_t)ck_counter_sum(counter), (uintmax_t)expected);
+	}
+
+	if (read - expected >= bound && expected - read >= bound) {
+		ck_error("ERROR: Read %ju is more than %ju away from %ju\n",
+		    (uintmax_t)read, (uintmax_t)bound, (uintmax_t)expected);
+	}
+
+	return;
+}
+
+static void
+serial(void)
+{
+	ck_counter_t counter;
+	uint64_t expected = 0;
+	unsigned int i, shard;
+	uint64_t delta;
+
+	if (ck_counter_init(&counter, &allocator, 0, BATCH, CK_COUNTER_UNLIMITED) == true)
+		ck_error("ERROR: Initialized a counter without shards\n");
+
+	if (ck_counter_init(&counter, &allocator, 4, BATCH, CK_COUNTER_UNLIMITED) == false)
+		ck_error("ERROR: ck_counter_init\n");
+
+	if (((uintptr_t)counter.shards & (CK_MD_CACHELINE - 1)) != 0)
+		ck_error("ERROR: Shards are not cache line aligned\n");
+
+	for (i = 0; i < ITERATIONS; i++) {
+		shard = common_rand() % 4;
+		delta = common_rand() % 8;
+
+		/* Decrements are as frequent as increments. */
+		if (common_rand() & 1) {
+			ck_counter_add_local(&counter, shard, -delta);
+			expected -= delta;
+		} else {
+			ck_counter_add(&counter, shard, delta);
+			expected += delta;
+		}
+
+		check_drift(&counter, expected);
+	}
+
+	ck_counter_inc_local(&counter, 0);
+	ck_counter_inc(&counter, 1);
+	ck_counter_dec_local(&counter, 2);
+	ck_counter_dec(&counter, 3);
+	check_drift(&counter, expected);
+	ck_counter_destroy(&counter);
+
+	/* A limited counter never exceeds its limit, even across shards. */
+	if (ck_counter_init(&counter, &allocator, 4, BATCH, LIMIT) == false)
+		ck_error("ERROR: ck_counter_init\n");
+
+	for (i = 0; i < LIMIT; i++) {
+		if (ck_counter_limit_add(&counter, i % 4, 1) == false)
+			ck_error("ERROR: Limit reached at %u\n", i);
+	}
+
+	if (ck_counter_limit_add(&counter, 0, 1) == true)
+		ck_error("ERROR: Exceeded the limit\n");
+
+	ck_counter_limit_sub(&counter, 1, 10);
+	if (ck_counter_limit_add(&counter, 2, 10) == false)
+		ck_error("ERROR: Returned budget is not available to other shards\n");
+
+	if (ck_counter_limit_add(&counter, 3, 1) == true)
+		ck_error("ERROR: Exceeded the limit\n");
+
+	if (ck_counter_sum(&counter) != LIMIT)
+		ck_error("ERROR: Sum is %ju\n", (uintmax_t)ck_counter_sum(&counter));
+
+	ck_counter_destroy(&counter);
+	return;
+}
+
+static void *
+thread(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	unsigned int i, held = 0;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		ck_counter_inc_local(&local, id);
+		ck_counter_add(&shared, i % 2, 3);
+
+		if (held > 0 && (common_rand() % 4) == 0) {
+			ck_pr_dec_64(&in_use);
+			ck_counter_limit_sub(&limited, id % 2, 1);
+			held--;
+		} else if (ck_counter_limit_add(&limited, id % 2, 1) == true) {
+			if (ck_pr_faa_64(&in_use, 1) >= LIMIT)
+				ck_error("ERROR: More than %u units in use\n", LIMIT);
+
+			held++;
+		}
+	}
+
+	while (held-- > 0) {
+		ck_pr_dec_64(&in_use);
+		ck_counter_limit_sub(&limited, id % 2, 1);
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	unsigned int i;
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	serial();
+
+	if (ck_counter_init(&local, &allocator, nthr, BATCH, CK_COUNTER_UNLIMITED) == false ||
+	    ck_counter_init(&shared, &allocator, 2, BATCH, CK_COUNTER_UNLIMITED) == false ||
+	    ck_counter_init(&limited, &allocator, 2, BATCH, LIMIT) == false)
+		ck_error("ERROR: ck_counter_init\n");
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, thread, (void *)(uintptr_t)i);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	check_drift(&local, (uint64_t)nthr * ITERATIONS);
+	check_drift(&shared, (uint64_t)nthr * ITERATIONS * 3);
+
+	if (ck_counter_sum(&limited) != 0)
+		ck_error("ERROR: Limited counter did not return to zero\n");
+
+	/* All of the budget must be recoverable. */
+	for (i = 0; i < LIMIT; i++) {
+		if (ck_counter_limit_add(&limited, 0, 1) == false)
+			ck_error("ERROR: Only %u of %u units available\n", i, LIMIT);
+	}
+
+	ck_counter_destroy(&local);
+	ck_counter_destroy(&shared);
+	ck_counter_destroy(&limited);
+	free(threads);
+	return 0;
+}
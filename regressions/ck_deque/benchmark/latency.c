@@ -0,0 +1,244 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_deque.h>
+#include <ck_spinlock.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS (128000)
+#endif
+
+#define BATCH 32
+
+/*
+ * A deque protected by a spinlock, the usual alternative to a work-stealing
+ * deque. It does not grow.
+ */
+struct locked {
+	ck_spinlock_fas_t lock;
+	unsigned int top;
+	unsigned int bottom;
+	unsigned int mask;
+	void **buffer;
+};
+
+static void *
+bench_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void
+bench_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = bench_malloc,
+	.free = bench_free
+};
+
+static void
+locked_push(struct locked *d, void *entry)
+{
+
+	ck_spinlock_fas_lock(&d->lock);
+	d->buffer[d->bottom++ & d->mask] = entry;
+	ck_spinlock_fas_unlock(&d->lock);
+	return;
+}
+
+static bool
+locked_pop(struct locked *d, void **entry)
+{
+	bool r = false;
+
+	ck_spinlock_fas_lock(&d->lock);
+	if (d->bottom != d->top) {
+		*entry = d->buffer[--d->bottom & d->mask];
+		r = true;
+	}
+	ck_spinlock_fas_unlock(&d->lock);
+	return r;
+}
+
+static bool
+locked_steal(struct locked *d, void **entry)
+{
+	bool r = false;
+
+	ck_spinlock_fas_lock(&d->lock);
+	if (d->bottom != d->top) {
+		*entry = d->buffer[d->top++ & d->mask];
+		r = true;
+	}
+	ck_spinlock_fas_unlock(&d->lock);
+	return r;
+}
+
+int
+main(int argc, char *argv[])
+{
+	void *batch[BATCH];
+	void *entry = NULL;
+	uint64_t s, e, p_a, o_a, t_a, b_a;
+	struct locked locked;
+	ck_deque_t deque;
+	int i, r, size;
+	unsigned int n;
+
+	if (argc != 2) {
+		ck_error("Usage: latency <size>\n");
+	}
+
+	size = atoi(argv[1]);
+	if (size <= 4 || (size & (size - 1))) {
+		ck_error("ERROR: Size must be a power of 2 greater than 4.\n");
+	}
+
+	/* The deque is sized up front so that no growth is measured. */
+	if (ck_deque_init(&deque, &allocator, size) == false) {
+		ck_error("ERROR: Failed to initialize deque\n");
+	}
+
+	locked.buffer = malloc(sizeof(void *) * size);
+	if (locked.buffer == NULL) {
+		ck_error("ERROR: Failed to allocate buffer\n");
+	}
+
+	ck_spinlock_fas_init(&locked.lock);
+	locked.top = locked.bottom = 0;
+	locked.mask = size - 1;
+
+	printf("%-8s %10s %16s %16s %16s %16s\n", "", "size", "push", "pop",
+	    "steal", "steal batch");
+
+	p_a = o_a = t_a = b_a = s = e = 0;
+	for (r = 0; r < ITERATIONS; r++) {
+		for (i = 0; i < size / 4; i += 4) {
+			s = rdtsc();
+			ck_deque_push(&deque, entry);
+			ck_deque_push(&deque, entry);
+			ck_deque_push(&deque, entry);
+			ck_deque_push(&deque, entry);
+			e = rdtsc();
+		}
+		p_a += (e - s) / 4;
+
+		for (i = 0; i < size / 4; i += 4) {
+			s = rdtsc();
+			ck_deque_pop(&deque, &entry);
+			ck_deque_pop(&deque, &entry);
+			ck_deque_pop(&deque, &entry);
+			ck_deque_pop(&deque, &entry);
+			e = rdtsc();
+		}
+		o_a += (e - s) / 4;
+
+		for (i = 0; i < size / 4; i++)
+			ck_deque_push(&deque, entry);
+
+		for (i = 0; i < size / 4; i += 4) {
+			s = rdtsc();
+			ck_deque_steal(&deque, &entry);
+			ck_deque_steal(&deque, &entry);
+			ck_deque_steal(&deque, &entry);
+			ck_deque_steal(&deque, &entry);
+			e = rdtsc();
+		}
+		t_a += (e - s) / 4;
+
+		for (i = 0; i < size; i++)
+			ck_deque_push(&deque, entry);
+
+		s = rdtsc();
+		n = ck_deque_steal_batch(&deque, batch, BATCH);
+		e = rdtsc();
+		b_a += (e - s) / n;
+
+		while (ck_deque_pop(&deque, &entry) == true);
+	}
+
+	printf("%-8s %10d %16" PRIu64 " %16" PRIu64 " %16" PRIu64 " %16" PRIu64
+	    "\n", "ck_deque", size, p_a / ITERATIONS, o_a / ITERATIONS,
+	    t_a / ITERATIONS, b_a / ITERATIONS);
+
+	p_a = o_a = t_a = s = e = 0;
+	for (r = 0; r < ITERATIONS; r++) {
+		for (i = 0; i < size / 4; i += 4) {
+			s = rdtsc();
+			locked_push(&locked, entry);
+			locked_push(&locked, entry);
+			locked_push(&locked, entry);
+			locked_push(&locked, entry);
+			e = rdtsc();
+		}
+		p_a += (e - s) / 4;
+
+		for (i = 0; i < size / 4; i += 4) {
+			s = rdtsc();
+			locked_pop(&locked, &entry);
+			locked_pop(&locked, &entry);
+			locked_pop(&locked, &entry);
+			locked_pop(&locked, &entry);
+			e = rdtsc();
+		}
+		o_a += (e - s) / 4;
+
+		for (i = 0; i < size / 4; i++)
+			locked_push(&locked, entry);
+
+		for (i = 0; i < size / 4; i += 4) {
+			s = rdtsc();
+			locked_steal(&locked, &entry);
+			locked_steal(&locked, &entry);
+			locked_steal(&locked, &entry);
+			locked_steal(&locked, &entry);
+			e = rdtsc();
+		}
+		t_a += (e - s) / 4;
+	}
+
+	printf("%-8s %10d %16" PRIu64 " %16" PRIu64 " %16" PRIu64 " %16s\n",
+	    "locked", size, p_a / ITERATIONS, o_a / ITERATIONS,
+	    t_a / ITERATIONS, "-");
+
+	ck_deque_destroy(&deque);
+	free(locked.buffer);
+	return (0);
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_deque.h>
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITEMS
+#define ITEMS 1000000
+#endif
+
+#define ROUNDS 4
+#define BATCH 16
+
+/*
+ * Entries span several words, so a torn copy out of the array is caught
+ * by comparing the fields with each other.
+ */
+struct entry {
+	unsigned int id;
+	unsigned int check;
+	uint64_t tag;
+};
+CK_DEQUE_PROTOTYPE(entry, entry)
+
+#define CHECK(id) (~(id) * 2654435761U)
+#define TAG(id) ((uint64_t)(id) * 0x9e3779b97f4a7c15ULL)
+
+struct array_header {
+	ck_epoch_entry_t epoch_entry;
+	size_t size;
+};
+
+static ck_epoch_t epoch;
+static ck_epoch_record_t epoch_wr;
+static ck_deque_t deque;
+static unsigned int *seen;
+static unsigned int stolen;
+static unsigned int done;
+static unsigned int nthr;
+static unsigned int barrier;
+static struct affinity a;
+static unsigned int retired;
+
+static void *
+deque_malloc(size_t r)
+{
+	struct array_header *h;
+
+	h = malloc(sizeof(*h) + r);
+	if (h == NULL)
+		return NULL;
+
+	return h + 1;
+}
+
+static void
+deque_destroy(ck_epoch_entry_t *e)
+{
+	struct array_header *h = (struct array_header *)e;
+
+	/* A thief that copies out of a released array fails claim. */
+	memset(h + 1, 0xa5, h->size);
+	free(h);
+	return;
+}
+
+/*
+ * Only the owner releases arrays. It defers the release of an array that
+ * a larger one has replaced, which thieves may still be reading.
+ */
+static void
+deque_free(void *p, size_t b, bool r)
+{
+	struct array_header *h = (struct array_header *)p - 1;
+
+	if (r == false) {
+		free(h);
+		return;
+	}
+
+	retired++;
+	h->size = b;
+	ck_epoch_call_strict(&epoch_wr, &h->epoch_entry, deque_destroy);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = deque_malloc,
+	.free = deque_free
+};
+
+static void
+entry_set(struct entry *e, unsigned int id)
+{
+
+	e->id = id;
+	e->check = CHECK(id);
+	e->tag = TAG(id);
+	return;
+}
+
+static void
+claim(const struct entry *e)
+{
+
+	if (e->id >= ITEMS || e->check != CHECK(e->id) || e->tag != TAG(e->id))
+		ck_error("ERROR: Corrupt entry %u\n", e->id);
+
+	if (ck_pr_faa_uint(&seen[e->id], 1) != 0)
+		ck_error("ERROR: Entry %u was claimed twice\n", e->id);
+
+	return;
+}
+
+/* Checks ordering, batching and growth without concurrency. */
+static void
+serial(void)
+{
+	struct entry e, batch[BATCH];
+	void *value = NULL;
+	uintptr_t i;
+	unsigned int n;
+
+	if (ck_deque_init(&deque, &allocator, 0) == false)
+		ck_error("ERROR: ck_deque_init\n");
+
+	if (ck_deque_pop(&deque, &value) == true ||
+	    ck_deque_steal(&deque, &value) == true ||
+	    ck_deque_trysteal(&deque, &value) == true)
+		ck_error("ERROR: Empty deque returned an entry\n");
+
+	for (i = 1; i <= 1000; i++) {
+		if (ck_deque_push(&deque, (void *)i) == false)
+			ck_error("ERROR: ck_deque_push\n");
+	}
+
+	if (ck_deque_size(&deque) != 1000 || ck_deque_capacity(&deque) != 1024)
+		ck_error("ERROR: Size %u, capacity %u\n",
+		    ck_deque_size(&deque), ck_deque_capacity(&deque));
+
+	/* Every array from a capacity of 2 to 512 has been replaced. */
+	if (retired != 9)
+		ck_error("ERROR: Retired %u arrays, expected 9\n", retired);
+
+	/* The owner pops in LIFO order and thieves steal in FIFO order. */
+	for (i = 1; i <= 500; i++) {
+		if (ck_deque_steal(&deque, &value) == false || value != (void *)i)
+			ck_error("ERROR: Steal returned %p, expected %p\n",
+			    value, (void *)i);
+
+		if (ck_deque_pop(&deque, &value) == false ||
+		    value != (void *)(1001 - i))
+			ck_error("ERROR: Pop returned %p, expected %p\n",
+			    value, (void *)(1001 - i));
+	}
+
+	if (ck_deque_size(&deque) != 0 || ck_deque_pop(&deque, &value) == true)
+		ck_error("ERROR: Deque is not empty\n");
+
+	ck_deque_destroy(&deque);
+
+	if (CK_DEQUE_INIT(entry, &deque, &allocator, 4) == false)
+		ck_error("ERROR: ck_deque_init_entry\n");
+
+	/* Wrap around the array several times before it grows. */
+	for (n = 0; n < 64; n++) {
+		entry_set(&e, n);
+		CK_DEQUE_PUSH(entry, &deque, &e);
+		if (CK_DEQUE_TRYSTEAL(entry, &deque, &e) == false || e.id != n)
+			ck_error("ERROR: Trysteal returned %u, expected %u\n", e.id, n);
+	}
+
+	if (ck_deque_capacity(&deque) != 4)
+		ck_error("ERROR: Deque grew to %u\n", ck_deque_capacity(&deque));
+
+	for (n = 0; n < 37; n++) {
+		entry_set(&e, n);
+		if (CK_DEQUE_PUSH(entry, &deque, &e) == false)
+			ck_error("ERROR: ck_deque_push_entry\n");
+	}
+
+	/* A batch takes half of the entries, rounded up, in FIFO order. */
+	n = CK_DEQUE_STEAL_BATCH(entry, &deque, batch, BATCH);
+	if (n != BATCH)
+		ck_error("ERROR: Batch returned %u entries\n", n);
+
+	n = CK_DEQUE_STEAL_BATCH(entry, &deque, batch, BATCH);
+	if (n != 11)
+		ck_error("ERROR: Batch returned %u entries, expected 11\n", n);
+
+	for (n = 0; n < 11; n++) {
+		if (batch[n].id != BATCH + n || batch[n].tag != TAG(BATCH + n))
+			ck_error("ERROR: Batch entry %u is %u\n", n, batch[n].id);
+	}
+
+	n = 0;
+	while (CK_DEQUE_POP(entry, &deque, &e) == true) {
+		if (e.id != 36 - n)
+			ck_error("ERROR: Pop returned %u, expected %u\n", e.id, 36 - n);
+
+		n++;
+	}
+
+	if (n != 10)
+		ck_error("ERROR: Popped %u entries, expected 10\n", n);
+
+	ck_deque_destroy(&deque);
+	ck_epoch_barrier(&epoch_wr);
+	return;
+}
+
+static void *
+thief(void *arg)
+{
+	struct entry batch[BATCH];
+	ck_epoch_record_t *record;
+	unsigned int i, n;
+	uintptr_t mode = (uintptr_t)arg;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Could not allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (;;) {
+		/* The owner only finishes once the deque is drained. */
+		bool last = ck_pr_load_uint(&done) != 0;
+
+		ck_epoch_begin(record, NULL);
+		switch (mode % 3) {
+		case 0:
+			n = CK_DEQUE_TRYSTEAL(entry, &deque, &batch[0]);
+			break;
+		case 1:
+			n = CK_DEQUE_STEAL(entry, &deque, &batch[0]);
+			break;
+		default:
+			n = CK_DEQUE_STEAL_BATCH(entry, &deque, batch, BATCH);
+			break;
+		}
+		ck_epoch_end(record, NULL);
+
+		for (i = 0; i < n; i++)
+			claim(&batch[i]);
+
+		ck_pr_add_uint(&stolen, n);
+		if (n == 0 && last == true)
+			break;
+	}
+
+	ck_epoch_unregister(record);
+	return NULL;
+}
+
+/*
+ * The owner pushes bursts of entries and pops some of them back while
+ * thieves drain the deque from the other end. The deque starts small, so
+ * it grows while thieves are reading from it.
+ */
+static void
+owner(void)
+{
+	struct entry e;
+	unsigned int id, i, burst;
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (id = 0; id < ITEMS;) {
+		burst = common_rand() % 256;
+		for (i = 0; i < burst && id < ITEMS; i++, id++) {
+			entry_set(&e, id);
+			if (CK_DEQUE_PUSH(entry, &deque, &e) == false)
+				ck_error("ERROR: ck_deque_push_entry\n");
+		}
+
+		burst = common_rand() % 192;
+		for (i = 0; i < burst; i++) {
+			if (CK_DEQUE_POP(entry, &deque, &e) == false)
+				break;
+
+			claim(&e);
+		}
+
+		ck_epoch_poll(&epoch_wr);
+	}
+
+	while (CK_DEQUE_POP(entry, &deque, &e) == true)
+		claim(&e);
+
+	ck_pr_store_uint(&done, 1);
+	return;
+}
+
+static void
+concurrent(void)
+{
+	pthread_t *threads;
+	unsigned int i, round;
+	uintptr_t mode;
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	seen = malloc(sizeof(unsigned int) * ITEMS);
+	if (threads == NULL || seen == NULL)
+		ck_error("ERROR: Could not allocate threads\n");
+
+	for (round = 0; round < ROUNDS; round++) {
+		if (CK_DEQUE_INIT(entry, &deque, &allocator, 2) == false)
+			ck_error("ERROR: ck_deque_init_entry\n");
+
+		memset(seen, 0, sizeof(unsigned int) * ITEMS);
+		ck_pr_store_uint(&stolen, 0);
+		ck_pr_store_uint(&done, 0);
+		ck_pr_store_uint(&barrier, 0);
+
+		for (i = 1; i < nthr; i++) {
+			mode = i + round;
+			pthread_create(&threads[i], NULL, thief, (void *)mode);
+		}
+
+		owner();
+
+		for (i = 1; i < nthr; i++)
+			pthread_join(threads[i], NULL);
+
+		for (i = 0; i < ITEMS; i++) {
+			if (seen[i] != 1)
+				ck_error("ERROR: Entry %u was claimed %u times\n",
+				    i, seen[i]);
+		}
+
+		fprintf(stderr, "[%u: %u stolen, capacity %u]", round, stolen,
+		    ck_deque_capacity(&deque));
+
+		ck_deque_destroy(&deque);
+		ck_epoch_barrier(&epoch_wr);
+	}
+
+	free(seen);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &epoch_wr, NULL);
+
+	fprintf(stderr, "Serial...");
+	serial();
+	fprintf(stderr, "done\n%u threads...", nthr);
+	concurrent();
+	fprintf(stderr, "done\n");
+	return 0;
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_pr.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../common.h"
+
+/*
+ * Wake-up latency and throughput of the shipped Linux ck_ec_ops.
+ *
+ * The latency test ping-pongs between two threads through a pair of
+ * event counts and reports the distribution of one-way hand-off times,
+ * once with the default busy-wait and once with the busy-wait disabled,
+ * so that every hand-off goes through FUTEX_WAKE.
+ *
+ * The throughput test has one producer incrementing an event count
+ * while the consumers wait for every change, and reports increments and
+ * wake-ups per second.
+ */
+
+#ifndef ROUNDS
+#define ROUNDS 100000
+#endif
+
+#ifndef DURATION
+#define DURATION 5
+#endif
+
+#ifdef CK_F_EC_LINUX
+static struct ck_ec_ops sleep_ops;
+static const struct ck_ec_mode default_mode = CK_EC_LINUX_MODE_SP;
+static struct ck_ec_mode sleep_mode = { .ops = &sleep_ops, .single_producer = true };
+static const struct ck_ec_mode *mode;
+
+static ck_ec32_t ping CK_CC_CACHELINE = CK_EC_INITIALIZER;
+static ck_ec32_t pong CK_CC_CACHELINE = CK_EC_INITIALIZER;
+static uint64_t *samples;
+
+static unsigned int flag CK_CC_CACHELINE;
+static ck_ec32_t counter CK_CC_CACHELINE = CK_EC_INITIALIZER;
+static uint64_t *wakeups;
+
+static uint64_t
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int
+cmp(const void *a, const void *b)
+{
+	const uint64_t *x = a;
+	const uint64_t *y = b;
+
+	return (*x > *y) - (*x < *y);
+}
+
+static void *
+ponger(void *unused CK_CC_UNUSED)
+{
+	uint32_t i;
+
+	for (i = 0; i < ROUNDS; i++) {
+		ck_ec32_wait(&ping, mode, i, NULL);
+		ck_ec32_inc(&pong, mode);
+	}
+
+	return NULL;
+}
+
+static void
+latency(const char *label, const struct ck_ec_mode *m)
+{
+	pthread_t thread;
+	uint64_t s;
+	uint32_t i;
+
+	mode = m;
+	ck_ec32_init(&ping, 0);
+	ck_ec32_init(&pong, 0);
+
+	if (pthread_create(&thread, NULL, ponger, NULL) != 0)
+		ck_error("ERROR: Could not create thread\n");
+
+	for (i = 0; i < ROUNDS; i++) {
+		s = now();
+		ck_ec32_inc(&ping, mode);
+		ck_ec32_wait(&pong, mode, i, NULL);
+		samples[i] = (now() - s) / 2;
+	}
+
+	pthread_join(thread, NULL);
+
+	qsort(samples, ROUNDS, sizeof(uint64_t), cmp);
+	printf("%12s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+	    label, samples[ROUNDS / 2], samples[ROUNDS * 99 / 100],
+	    samples[ROUNDS * 999 / 1000], samples[ROUNDS - 1]);
+	return;
+}
+
+static void *
+consumer(void *pun)
+{
+	uint64_t *n = pun;
+	uint32_t v;
+
+	while (ck_pr_load_uint(&flag) == 0) {
+		v = ck_ec32_value(&counter);
+		ck_ec32_wait(&counter, &default_mode, v, NULL);
+		(*n)++;
+	}
+
+	return NULL;
+}
+
+static void
+throughput(int consumers)
+{
+	pthread_t *threads;
+	uint64_t increments = 0, total = 0;
+	uint64_t start;
+	int i;
+
+	threads = malloc(sizeof(pthread_t) * consumers);
+	wakeups = calloc(consumers, sizeof(uint64_t));
+	if (threads == NULL || wakeups == NULL)
+		ck_error("ERROR: Could not allocate thread state\n");
+
+	for (i = 0; i < consumers; i++) {
+		if (pthread_create(&threads[i], NULL, consumer, wakeups + i) != 0)
+			ck_error("ERROR: Could not create thread %d\n", i);
+	}
+
+	start = now();
+	while (now() - start < DURATION * 1000000000ULL) {
+		ck_ec32_inc(&counter, &default_mode);
+		increments++;
+	}
+
+	ck_pr_store_uint(&flag, 1);
+	ck_ec32_inc(&counter, &default_mode);
+
+	for (i = 0; i < consumers; i++) {
+		pthread_join(threads[i], NULL);
+		total += wakeups[i];
+	}
+
+	printf("%12d %16" PRIu64 " %16" PRIu64 "\n", consumers,
+	    increments / DURATION, total / DURATION);
+
+	free(threads);
+	free(wakeups);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	int consumers;
+
+	if (argc != 2) {
+		ck_error("Usage: wake <number of consumers>\n");
+	}
+
+	consumers = atoi(argv[1]);
+	if (consumers <= 0) {
+		ck_error("ERROR: Number of consumers must be greater than 0\n");
+	}
+
+	samples = malloc(sizeof(uint64_t) * ROUNDS);
+	if (samples == NULL) {
+		ck_error("ERROR: Could not allocate samples\n");
+	}
+
+	sleep_ops = ck_ec_linux_ops;
+	sleep_ops.busy_loop_iter = 1;
+
+	printf("%12s %12s %12s %12s %12s\n", "LATENCY(ns)", "p50", "p99",
+	    "p99.9", "max");
+	latency("spin+futex", &default_mode);
+	latency("futex", &sleep_mode);
+
+	printf("\n%12s %16s %16s\n", "CONSUMERS", "INCREMENTS/s", "WAKEUPS/s");
+	throughput(consumers);
+	return 0;
+}
+#else
+int
+main(void)
+{
+
+	fprintf(stderr, "Unsupported.\n");
+	return 0;
+}
+#endif /* CK_F_EC_LINUX */
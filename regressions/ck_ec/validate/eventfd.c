@@ -0,0 +1,183 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ec.h>
+#include <ck_ec_eventfd.h>
+#include <ck_pr.h>
+#include <ck_ring.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../common.h"
+
+#ifdef CK_F_EC_EVENTFD
+#include <sys/epoll.h>
+
+#ifndef ITEMS
+#define ITEMS 100000
+#endif
+
+#define RING_SIZE 1024
+
+static struct ck_ec_eventfd bridge;
+static struct ck_ec_mode mode;
+static struct ck_ec32 ec = CK_EC_INITIALIZER;
+static struct ck_ring ring;
+static ck_ring_buffer_t buffer[RING_SIZE];
+
+static void *
+producer(void *arg)
+{
+	struct timespec pause = { 0, 100000 };
+	uintptr_t i;
+
+	(void)arg;
+	for (i = 1; i <= ITEMS; i++) {
+		while (ck_ring_enqueue_spsc(&ring, buffer, (void *)i) == false)
+			ck_pr_stall();
+
+		ck_ec32_inc(&ec, &mode);
+
+		/* Let the consumer go idle from time to time. */
+		if ((i % 4096) == 0)
+			nanosleep(&pause, NULL);
+	}
+
+	return NULL;
+}
+
+static void
+test_arm(void)
+{
+	struct ck_ec32 ec32 = CK_EC_INITIALIZER;
+#ifdef CK_F_EC64
+	struct ck_ec64 ec64 = CK_EC_INITIALIZER;
+#endif
+
+	if (ck_ec32_eventfd_arm(&ec32, &bridge, 1) == true)
+		ck_error("ck_ec32_eventfd_arm succeeded on a stale value\n");
+
+	if (ck_ec32_eventfd_arm(&ec32, &bridge, 0) == false ||
+	    ck_ec32_has_waiters(&ec32) == false)
+		ck_error("ck_ec32_eventfd_arm did not flag the event count\n");
+
+	ck_ec32_inc(&ec32, &mode);
+	if (ck_ec32_has_waiters(&ec32) == true || ck_ec32_value(&ec32) != 1)
+		ck_error("ck_ec32_inc did not clear the flag\n");
+
+#ifdef CK_F_EC64
+	if (ck_ec64_eventfd_arm(&ec64, &bridge, 0) == false ||
+	    ck_ec64_has_waiters(&ec64) == false)
+		ck_error("ck_ec64_eventfd_arm did not flag the event count\n");
+
+	ck_ec64_inc(&ec64, &mode);
+	if (ck_ec64_has_waiters(&ec64) == true || ck_ec64_value(&ec64) != 1)
+		ck_error("ck_ec64_inc did not clear the flag\n");
+
+	if (ck_ec64_eventfd_arm(&ec64, &bridge, 0) == true)
+		ck_error("ck_ec64_eventfd_arm succeeded on a stale value\n");
+#endif
+
+	ck_ec_eventfd_drain(&bridge);
+	return;
+}
+
+int
+main(void)
+{
+	struct epoll_event event = { .events = EPOLLIN };
+	unsigned long wakeups = 0;
+	uintptr_t expected = 1;
+	pthread_t thread;
+	uint32_t value;
+	int epfd;
+
+	if (ck_ec_eventfd_init(&bridge, &ck_ec_linux_ops) != 0)
+		ck_error("ck_ec_eventfd_init failed\n");
+
+	mode.ops = ck_ec_eventfd_ops(&bridge);
+	mode.single_producer = false;
+	test_arm();
+
+	epfd = epoll_create1(0);
+	if (epfd == -1 || epoll_ctl(epfd, EPOLL_CTL_ADD,
+	    ck_ec_eventfd_fd(&bridge), &event) != 0)
+		ck_error("epoll setup failed\n");
+
+	ck_ring_init(&ring, RING_SIZE);
+	if (pthread_create(&thread, NULL, producer, NULL) != 0)
+		ck_error("pthread_create failed\n");
+
+	value = ck_ec32_value(&ec);
+	while (expected <= ITEMS) {
+		void *item;
+
+		while (ck_ring_dequeue_spsc(&ring, buffer, &item) == true) {
+			if ((uintptr_t)item != expected)
+				ck_error("dequeued %p, expected %lu\n",
+				    item, (unsigned long)expected);
+
+			expected++;
+		}
+
+		if (expected > ITEMS)
+			break;
+
+		if (ck_ec32_eventfd_arm(&ec, &bridge, value) == false) {
+			value = ck_ec32_value(&ec);
+			continue;
+		}
+
+		/* Armed event counts must be signalled, so never time out. */
+		if (epoll_wait(epfd, &event, 1, 10000) != 1)
+			ck_error("lost wake-up at item %lu\n",
+			    (unsigned long)expected);
+
+		ck_ec_eventfd_drain(&bridge);
+		value = ck_ec32_value(&ec);
+		wakeups++;
+	}
+
+	pthread_join(thread, NULL);
+	if (wakeups > ITEMS)
+		ck_error("%lu wake-ups for %d items\n", wakeups, ITEMS);
+
+	close(epfd);
+	ck_ec_eventfd_destroy(&bridge);
+	return 0;
+}
+#else
+int
+main(void)
+{
+
+	fprintf(stderr, "Unsupported.\n");
+	return 0;
+}
+#endif /* CK_F_EC_EVENTFD */
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ec.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../common.h"
+#include "../../ec_ops.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 64
+#endif
+
+#define N_EC 8
+
+static struct ck_ec32 ecs[N_EC];
+static struct ck_ec32 *ec_pointers[N_EC];
+static struct ck_ec_mode mode;
+static unsigned int ready;
+
+static int
+unsupported_wait32_any(const struct ck_ec_wait_state *state CK_CC_UNUSED,
+    const uint32_t *const *addresses CK_CC_UNUSED,
+    const uint32_t *expected CK_CC_UNUSED, size_t n CK_CC_UNUSED,
+    const struct timespec *deadline CK_CC_UNUSED)
+{
+
+	return -1;
+}
+
+static void *
+waiter(void *arg)
+{
+	uint32_t values[N_EC];
+	int *result = arg;
+	size_t i;
+
+	for (i = 0; i < N_EC; i++)
+		values[i] = ck_ec32_value(&ecs[i]);
+
+	ck_pr_store_uint(&ready, 1);
+	*result = ck_ec_wait_any(ec_pointers, &mode, values, N_EC, NULL);
+	return NULL;
+}
+
+static void
+test(const char *name)
+{
+	uint32_t values[N_EC];
+	struct timespec deadline;
+	struct timespec timeout = { 0, 1000000 };
+	pthread_t thread;
+	size_t i;
+	int j, r;
+
+	for (i = 0; i < N_EC; i++) {
+		ck_ec32_init(&ecs[i], 0);
+		ec_pointers[i] = &ecs[i];
+		values[i] = 0;
+	}
+
+	r = ck_ec_wait_any(ec_pointers, &mode, values, N_EC,
+	    &(struct timespec){ 0, 0 });
+	if (r != -1)
+		ck_error("%s: wait with past deadline returned %d\n", name, r);
+
+	if (ck_ec_deadline(&deadline, &mode, &timeout) != 0)
+		ck_error("%s: ck_ec_deadline failed\n", name);
+
+	r = ck_ec_wait_any(ec_pointers, &mode, values, N_EC, &deadline);
+	if (r != -1)
+		ck_error("%s: wait without update returned %d\n", name, r);
+
+	for (i = 0; i < N_EC; i++) {
+		if (ck_ec32_has_waiters(&ecs[i]) == false)
+			ck_error("%s: ec %zu was not flagged\n", name, i);
+	}
+
+	ck_ec32_inc(&ecs[5], &mode);
+	r = ck_ec_wait_any(ec_pointers, &mode, values, N_EC, NULL);
+	if (r != 5)
+		ck_error("%s: wait after update returned %d\n", name, r);
+
+	for (j = 0; j < ITERATIONS; j++) {
+		unsigned int target = (unsigned int)j % N_EC;
+		int result = -2;
+
+		ck_pr_store_uint(&ready, 0);
+		if (pthread_create(&thread, NULL, waiter, &result) != 0)
+			ck_error("%s: pthread_create failed\n", name);
+
+		while (ck_pr_load_uint(&ready) == 0)
+			ck_pr_stall();
+
+		/* Give the waiter a chance to go to sleep. */
+		if ((j & 7) == 0)
+			nanosleep(&timeout, NULL);
+
+		ck_ec32_inc(&ecs[target], &mode);
+		if (pthread_join(thread, NULL) != 0)
+			ck_error("%s: pthread_join failed\n", name);
+
+		if (result != (int)target)
+			ck_error("%s: woke up on %d, expected %u\n",
+			    name, result, target);
+	}
+
+	return;
+}
+
+int
+main(void)
+{
+	struct ck_ec_ops shared_ops = *ec_mode.ops;
+	struct ck_ec_ops unsupported_ops = *ec_mode.ops;
+
+	mode = ec_mode;
+	test("default");
+
+	shared_ops.wait32_any = NULL;
+	mode.ops = &shared_ops;
+	test("shared");
+
+	unsupported_ops.wait32_any = unsupported_wait32_any;
+	mode.ops = &unsupported_ops;
+	test("unsupported");
+
+	return 0;
+}
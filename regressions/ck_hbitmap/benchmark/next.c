@@ -0,0 +1,118 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_bitmap.h>
+#include <ck_hbitmap.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef BITS
+#define BITS (100U * 1000 * 1000)
+#endif
+
+#ifndef SPACING
+#define SPACING (1U << 20)
+#endif
+
+/*
+ * Iterates over a sparse map, one set bit every SPACING bits, with a
+ * flat ck_bitmap and with ck_hbitmap.
+ */
+int
+main(void)
+{
+	ck_bitmap_iterator_t iterator;
+	ck_bitmap_t *flat;
+	ck_hbitmap_t *hb;
+	unsigned int bit, n, i;
+	uint64_t s, e;
+
+	flat = malloc(ck_bitmap_size(BITS));
+	hb = malloc(ck_hbitmap_size(BITS));
+	if (flat == NULL || hb == NULL)
+		ck_error("ERROR: Failed to allocate bitmaps\n");
+
+	ck_bitmap_init(flat, BITS, false);
+	ck_hbitmap_init(hb, BITS, false);
+	for (i = SPACING / 2; i < BITS; i += SPACING) {
+		ck_bitmap_set(flat, i);
+		ck_hbitmap_set(hb, i);
+	}
+
+	printf("%u bits, %u levels, one set bit every %u bits\n",
+	    BITS, hb->n_levels, SPACING);
+
+	s = rdtsc();
+	ck_bitmap_iterator_init(&iterator, flat);
+	for (n = 0; ck_bitmap_next(flat, &iterator, &bit) == true; n++);
+	e = rdtsc();
+	printf("%24s: %16" PRIu64 " ticks (%u bits)\n",
+	    "ck_bitmap_next", e - s, n);
+
+	s = rdtsc();
+	for (n = 0, bit = 0; ck_hbitmap_next_set(hb, bit, &bit) == true;
+	    n++, bit++);
+	e = rdtsc();
+	printf("%24s: %16" PRIu64 " ticks (%u bits)\n",
+	    "ck_hbitmap_next_set", e - s, n);
+
+	s = rdtsc();
+	n = ck_bitmap_count(flat, BITS);
+	e = rdtsc();
+	printf("%24s: %16" PRIu64 " ticks (%u bits)\n",
+	    "ck_bitmap_count", e - s, n);
+
+	s = rdtsc();
+	n = ck_hbitmap_count(hb);
+	e = rdtsc();
+	printf("%24s: %16" PRIu64 " ticks (%u bits)\n",
+	    "ck_hbitmap_count", e - s, n);
+
+	s = rdtsc();
+	for (i = 0; i < BITS; i += SPACING) {
+		ck_hbitmap_set(hb, i);
+		ck_hbitmap_reset(hb, i);
+	}
+	e = rdtsc();
+	printf("%24s: %16" PRIu64 " ticks/op\n",
+	    "ck_hbitmap_set+reset", (e - s) / (BITS / SPACING));
+
+	s = rdtsc();
+	for (i = 0; i < BITS; i += SPACING) {
+		ck_bitmap_set(flat, i);
+		ck_bitmap_reset(flat, i);
+	}
+	e = rdtsc();
+	printf("%24s: %16" PRIu64 " ticks/op\n",
+	    "ck_bitmap_set+reset", (e - s) / (BITS / SPACING));
+
+	free(hb);
+	free(flat);
+	return 0;
+}
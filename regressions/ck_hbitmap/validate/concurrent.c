@@ -0,0 +1,144 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_hbitmap.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 1000000
+#endif
+
+/*
+ * Threads own interleaved bits in a region a few summary words wide, so
+ * that the same leaf and summary words are updated concurrently. Each
+ * thread repeatedly fills and drains its bits; once all threads are done
+ * the summaries must agree exactly with the leaves.
+ */
+#define LENGTH (4096 * 3 + 17)
+
+static ck_hbitmap_t *hb;
+static bool model[LENGTH];
+static unsigned int nthr;
+
+static void *
+thread(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	unsigned int seed = id;
+	unsigned int i;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned int b = common_rand_r(&seed) % LENGTH;
+
+		b -= b % nthr;
+		b += id;
+		if (b >= LENGTH)
+			continue;
+
+		if (common_rand_r(&seed) & 1) {
+			ck_hbitmap_set(hb, b);
+			model[b] = true;
+		} else {
+			ck_hbitmap_reset(hb, b);
+			model[b] = false;
+		}
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	unsigned int i, bit = 0, count = 0;
+
+	if (argc != 2) {
+		ck_error("Usage: concurrent <number of threads>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr == 0)
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	hb = malloc(ck_hbitmap_size(LENGTH));
+	if (threads == NULL || hb == NULL)
+		ck_error("ERROR: Failed to allocate\n");
+
+	ck_hbitmap_init(hb, LENGTH, false);
+
+	for (i = 0; i < nthr; i++) {
+		if (pthread_create(&threads[i], NULL, thread,
+		    (void *)(uintptr_t)i) != 0)
+			ck_error("ERROR: Failed to create thread %u\n", i);
+	}
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	for (i = 0; i < LENGTH; i++) {
+		if (ck_hbitmap_test(hb, i) != model[i])
+			ck_error("ERROR: Bit %u disagrees with model\n", i);
+
+		count += model[i];
+	}
+
+	if (ck_hbitmap_count(hb) != count) {
+		ck_error("ERROR: Expected count %u, got %u\n", count,
+		    ck_hbitmap_count(hb));
+	}
+
+	for (i = 0; i < LENGTH; i++) {
+		bool r = ck_hbitmap_next_set(hb, i, &bit);
+		unsigned int expected = i;
+
+		while (expected < LENGTH && model[expected] == false)
+			expected++;
+
+		if (r != (expected < LENGTH) || (r == true && bit != expected))
+			ck_error("ERROR: next_set(%u) got %u, expected %u\n",
+			    i, bit, expected);
+
+		r = ck_hbitmap_next_clear(hb, i, &bit);
+		expected = i;
+		while (expected < LENGTH && model[expected] == true)
+			expected++;
+
+		if (r != (expected < LENGTH) || (r == true && bit != expected))
+			ck_error("ERROR: next_clear(%u) got %u, expected %u\n",
+			    i, bit, expected);
+	}
+
+	free(hb);
+	free(threads);
+	return 0;
+}
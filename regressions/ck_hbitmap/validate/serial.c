@@ -0,0 +1,195 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_hbitmap.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+static const unsigned int lengths[] = {
+	0, 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145, 300001
+};
+
+static void
+check_search(const ck_hbitmap_t *hb, const bool *model, unsigned int length,
+    unsigned int from)
+{
+	unsigned int expected, bit = 0;
+	bool r;
+
+	for (expected = from; expected < length; expected++) {
+		if (model[expected] == true)
+			break;
+	}
+
+	r = ck_hbitmap_next_set(hb, from, &bit);
+	if (r != (expected < length) || (r == true && bit != expected)) {
+		ck_error("ERROR: next_set(%u) of %u: got %d/%u, expected %u\n",
+		    from, length, r, bit, expected);
+	}
+
+	for (expected = from; expected < length; expected++) {
+		if (model[expected] == false)
+			break;
+	}
+
+	r = ck_hbitmap_next_clear(hb, from, &bit);
+	if (r != (expected < length) || (r == true && bit != expected)) {
+		ck_error("ERROR: next_clear(%u) of %u: got %d/%u, expected %u\n",
+		    from, length, r, bit, expected);
+	}
+
+	return;
+}
+
+static void
+check(const ck_hbitmap_t *hb, const bool *model, unsigned int length)
+{
+	unsigned int i, count = 0;
+	unsigned int bit = 0;
+
+	for (i = 0; i < length; i++)
+		count += model[i];
+
+	if (ck_hbitmap_count(hb) != count) {
+		ck_error("ERROR: count of %u: got %u, expected %u\n",
+		    length, ck_hbitmap_count(hb), count);
+	}
+
+	check_search(hb, model, length, 0);
+	for (i = 0; i < 16; i++)
+		check_search(hb, model, length, common_rand() % (length + 1));
+
+	if (ck_hbitmap_first_set(hb, &bit) !=
+	    ck_hbitmap_next_set(hb, 0, &i) || (count > 0 && bit != i))
+		ck_error("ERROR: first_set disagrees with next_set\n");
+
+	if (ck_hbitmap_first_clear(hb, &bit) !=
+	    ck_hbitmap_next_clear(hb, 0, &i) || (count < length && bit != i))
+		ck_error("ERROR: first_clear disagrees with next_clear\n");
+
+	return;
+}
+
+static void
+test(unsigned int length, bool set)
+{
+	ck_hbitmap_t *hb;
+	bool *model;
+	unsigned int i, j, n;
+
+	hb = malloc(ck_hbitmap_size(length));
+	model = malloc(length + 1);
+	if (hb == NULL || model == NULL)
+		ck_error("ERROR: Failed to allocate bitmap\n");
+
+	memset(hb, common_rand(), ck_hbitmap_size(length));
+	ck_hbitmap_init(hb, length, set);
+	memset(model, set, length);
+
+	if (ck_hbitmap_bits(hb) != length) {
+		ck_error("ERROR: Expected length %u got %u\n",
+		    length, ck_hbitmap_bits(hb));
+	}
+
+	check(hb, model, length);
+	if (length == 0)
+		goto leave;
+
+	/*
+	 * Alternate between sparse and dense phases so that words and
+	 * whole summaries both fill up and drain.
+	 */
+	for (i = 0; i < 16; i++) {
+		unsigned int base = common_rand() % length;
+		unsigned int span = 1 + common_rand() % 8192;
+
+		n = 1 + common_rand() % 1024;
+		for (j = 0; j < n; j++) {
+			unsigned int b = (base + common_rand() % span) % length;
+			bool r;
+
+			switch (common_rand() % 3) {
+			case 0:
+				ck_hbitmap_set(hb, b);
+				model[b] = true;
+				break;
+			case 1:
+				r = ck_hbitmap_bts(hb, b);
+				if (r != model[b]) {
+					ck_error("ERROR: bts(%u) returned %d\n",
+					    b, r);
+				}
+
+				model[b] = true;
+				break;
+			default:
+				ck_hbitmap_reset(hb, b);
+				model[b] = false;
+				break;
+			}
+
+			if (ck_hbitmap_test(hb, b) != model[b])
+				ck_error("ERROR: test(%u) disagrees\n", b);
+		}
+
+		check(hb, model, length);
+
+		/* Fill or drain a contiguous range. */
+		for (j = 0; j < span && base + j < length; j++) {
+			if (i & 1) {
+				ck_hbitmap_set(hb, base + j);
+				model[base + j] = true;
+			} else {
+				ck_hbitmap_reset(hb, base + j);
+				model[base + j] = false;
+			}
+		}
+
+		check(hb, model, length);
+	}
+
+leave:
+	free(model);
+	free(hb);
+	return;
+}
+
+int
+main(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < sizeof(lengths) / sizeof(*lengths); i++) {
+		common_srand(i);
+		test(lengths[i], false);
+		test(lengths[i], true);
+	}
+
+	return 0;
+}
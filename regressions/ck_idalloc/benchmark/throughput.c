@@ -0,0 +1,239 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_bitmap.h>
+#include <ck_idalloc.h>
+#include <ck_pr.h>
+#include <ck_spinlock.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 1000000
+#endif
+
+#ifndef IDS
+#define IDS 65536
+#endif
+
+/* Identifiers each thread keeps allocated, to keep the map populated. */
+#define HOLD 256
+
+enum mode {
+	MODE_SPINLOCK,
+	MODE_IDALLOC,
+	MODE_IDALLOC_HINT,
+	MODE_IDALLOC_CACHE,
+	MODE_COUNT
+};
+
+static const char *names[] = {
+	"spinlock + ck_bitmap",
+	"ck_idalloc_get",
+	"ck_idalloc_get + hint",
+	"ck_idalloc_cache_get"
+};
+
+static struct affinity a;
+static unsigned int nthr;
+static unsigned int barrier;
+static enum mode mode;
+static uint64_t ticks;
+
+static ck_spinlock_fas_t lock = CK_SPINLOCK_FAS_INITIALIZER;
+static ck_bitmap_t *bitmap;
+static ck_idalloc_t ida;
+
+static void
+idalloc_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = idalloc_free
+};
+
+/*
+ * The baseline: a linear search for the first clear bit, under a lock.
+ */
+static bool
+locked_get(unsigned int *id)
+{
+	unsigned int *map = ck_bitmap_buffer(bitmap);
+	unsigned int i, n = CK_BITMAP_BLOCKS(IDS);
+	bool r = false;
+
+	ck_spinlock_fas_lock(&lock);
+	for (i = 0; i < n; i++) {
+		unsigned int word = ck_pr_load_uint(&map[i]);
+
+		if (word != ~0U) {
+			*id = i * CK_BITMAP_BLOCK + ck_cc_ctz(~word);
+			ck_bitmap_set(bitmap, *id);
+			r = true;
+			break;
+		}
+	}
+	ck_spinlock_fas_unlock(&lock);
+	return r;
+}
+
+static void
+locked_put(unsigned int id)
+{
+
+	ck_spinlock_fas_lock(&lock);
+	ck_bitmap_reset(bitmap, id);
+	ck_spinlock_fas_unlock(&lock);
+	return;
+}
+
+static void *
+thread(void *arg)
+{
+	unsigned int tid = (unsigned int)(uintptr_t)arg;
+	unsigned int hint = tid * (IDS / nthr);
+	unsigned int held[HOLD];
+	ck_idalloc_cache_t cache;
+	unsigned int i, id = 0;
+	uint64_t s, e;
+	bool r = false;
+
+	if (aff_iterate(&a)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	ck_idalloc_cache_init(&cache, hint);
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) != nthr)
+		ck_pr_stall();
+
+	s = rdtsc();
+	for (i = 0; i < ITERATIONS + HOLD; i++) {
+		if (i >= HOLD) {
+			unsigned int victim = held[i % HOLD];
+
+			switch (mode) {
+			case MODE_SPINLOCK:
+				locked_put(victim);
+				break;
+			case MODE_IDALLOC_CACHE:
+				ck_idalloc_cache_put(&ida, &cache, victim);
+				break;
+			default:
+				ck_idalloc_put(&ida, victim);
+				break;
+			}
+		}
+
+		switch (mode) {
+		case MODE_SPINLOCK:
+			r = locked_get(&id);
+			break;
+		case MODE_IDALLOC:
+			r = ck_idalloc_get(&ida, NULL, &id);
+			break;
+		case MODE_IDALLOC_HINT:
+			r = ck_idalloc_get(&ida, &hint, &id);
+			break;
+		case MODE_IDALLOC_CACHE:
+			r = ck_idalloc_cache_get(&ida, &cache, &id);
+			break;
+		default:
+			break;
+		}
+
+		if (r == false)
+			ck_error("ERROR: Allocation failed\n");
+
+		held[i % HOLD] = id;
+	}
+	e = rdtsc();
+
+	ck_pr_add_64(&ticks, e - s);
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	unsigned int i;
+
+	if (argc != 3) {
+		ck_error("Usage: throughput <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr == 0 || nthr * HOLD > IDS)
+		ck_error("ERROR: Invalid number of threads\n");
+
+	a.delta = atoi(argv[2]);
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	bitmap = malloc(ck_bitmap_size(IDS));
+	if (threads == NULL || bitmap == NULL)
+		ck_error("ERROR: Failed to allocate\n");
+
+	for (mode = 0; mode < MODE_COUNT; mode++) {
+		ck_bitmap_init(bitmap, IDS, false);
+		if (ck_idalloc_init(&ida, &allocator, IDS) == false)
+			ck_error("ERROR: Failed to initialize allocator\n");
+
+		a.request = 0;
+		barrier = 0;
+		ticks = 0;
+
+		for (i = 0; i < nthr; i++) {
+			if (pthread_create(&threads[i], NULL, thread,
+			    (void *)(uintptr_t)i) != 0)
+				ck_error("ERROR: Failed to create thread %u\n", i);
+		}
+
+		for (i = 0; i < nthr; i++)
+			pthread_join(threads[i], NULL);
+
+		printf("%24s: %10" PRIu64 " ticks/get+put\n", names[mode],
+		    ticks / nthr / (ITERATIONS + HOLD));
+		ck_idalloc_destroy(&ida);
+	}
+
+	free(bitmap);
+	free(threads);
+	return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_idalloc.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 200000
+#endif
+
+#define IDS 1000
+#define BATCH 16
+
+static ck_idalloc_t ida;
+static unsigned int owner[IDS];
+static unsigned int nthr;
+static struct affinity a;
+
+static void
+idalloc_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+
+	/* The bitmap never grows, it is released once by ck_idalloc_destroy. */
+	if (r == true)
+		ck_error("ERROR: ck_idalloc deferred the release of its bitmap\n");
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = idalloc_free
+};
+
+static void
+acquired(unsigned int id)
+{
+
+	if (id >= IDS)
+		ck_error("ERROR: Identifier %u out of range\n", id);
+
+	if (ck_pr_faa_uint(&owner[id], 1) != 0)
+		ck_error("ERROR: Identifier %u allocated twice\n", id);
+
+	if (ck_idalloc_allocated(&ida, id) == false)
+		ck_error("ERROR: Identifier %u is not marked\n", id);
+
+	return;
+}
+
+static void
+released(unsigned int id)
+{
+
+	ck_pr_dec_uint(&owner[id]);
+	return;
+}
+
+static void
+serial(void)
+{
+	ck_idalloc_cache_t cache;
+	unsigned int ids[IDS];
+	unsigned int hint = 0;
+	unsigned int i, id, n;
+
+	for (i = 0; i < IDS; i++) {
+		if (ck_idalloc_get(&ida, &hint, &id) == false)
+			ck_error("ERROR: Allocation %u failed\n", i);
+
+		if (id != i)
+			ck_error("ERROR: Expected identifier %u, got %u\n", i, id);
+	}
+
+	if (ck_idalloc_get(&ida, &hint, &id) == true)
+		ck_error("ERROR: Allocated %u from a full allocator\n", id);
+
+	ck_idalloc_put(&ida, IDS / 2);
+	if (ck_idalloc_get(&ida, &hint, &id) == false || id != IDS / 2)
+		ck_error("ERROR: Expected to reuse identifier %u\n", IDS / 2);
+
+	for (i = 0; i < IDS; i++)
+		ids[i] = i;
+
+	ck_idalloc_put_n(&ida, ids, IDS);
+	if (ck_idalloc_count(&ida) != 0)
+		ck_error("ERROR: Expected empty allocator\n");
+
+	hint = IDS - 10;
+	n = ck_idalloc_get_n(&ida, &hint, ids, IDS);
+	if (n != IDS)
+		ck_error("ERROR: Bulk allocation returned %u\n", n);
+
+	memset(owner, 0, sizeof owner);
+	for (i = 0; i < n; i++)
+		acquired(ids[i]);
+
+	if (ck_idalloc_get_n(&ida, &hint, ids, 1) != 0)
+		ck_error("ERROR: Bulk allocation from a full allocator\n");
+
+	for (i = 0; i < n; i++) {
+		released(ids[i]);
+		ck_idalloc_put(&ida, ids[i]);
+	}
+
+	ck_idalloc_cache_init(&cache, 0);
+	for (i = 0; i < IDS; i++) {
+		if (ck_idalloc_cache_get(&ida, &cache, &id) == false)
+			ck_error("ERROR: Cached allocation %u failed\n", i);
+
+		acquired(id);
+	}
+
+	if (ck_idalloc_cache_get(&ida, &cache, &id) == true)
+		ck_error("ERROR: Cached allocation from a full allocator\n");
+
+	for (i = 0; i < IDS; i++) {
+		released(i);
+		ck_idalloc_cache_put(&ida, &cache, i);
+	}
+
+	ck_idalloc_cache_flush(&ida, &cache);
+	if (ck_idalloc_count(&ida) != 0)
+		ck_error("ERROR: Expected empty allocator after flush\n");
+
+	return;
+}
+
+static void *
+thread(void *arg)
+{
+	unsigned int tid = (unsigned int)(uintptr_t)arg;
+	unsigned int hint = tid * (IDS / nthr);
+	unsigned int seed = tid;
+	unsigned int ids[BATCH];
+	ck_idalloc_cache_t cache;
+	unsigned int i, j, n, id;
+
+	if (aff_iterate(&a)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	ck_idalloc_cache_init(&cache, hint);
+	for (i = 0; i < ITERATIONS; i++) {
+		switch (common_rand_r(&seed) % 3) {
+		case 0:
+			if (ck_idalloc_get(&ida, &hint, &id) == false)
+				break;
+
+			acquired(id);
+			released(id);
+			ck_idalloc_put(&ida, id);
+			break;
+		case 1:
+			n = ck_idalloc_get_n(&ida, &hint, ids, BATCH);
+			for (j = 0; j < n; j++)
+				acquired(ids[j]);
+
+			for (j = 0; j < n; j++)
+				released(ids[j]);
+
+			ck_idalloc_put_n(&ida, ids, n);
+			break;
+		default:
+			if (ck_idalloc_cache_get(&ida, &cache, &id) == false)
+				break;
+
+			acquired(id);
+			released(id);
+			ck_idalloc_cache_put(&ida, &cache, id);
+			break;
+		}
+	}
+
+	ck_idalloc_cache_flush(&ida, &cache);
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	unsigned int i;
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr == 0)
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+
+	a.delta = atoi(argv[2]);
+	a.request = 0;
+
+	if (ck_idalloc_init(&ida, &allocator, IDS) == false)
+		ck_error("ERROR: Failed to initialize allocator\n");
+
+	serial();
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	for (i = 0; i < nthr; i++) {
+		if (pthread_create(&threads[i], NULL, thread,
+		    (void *)(uintptr_t)i) != 0)
+			ck_error("ERROR: Failed to create thread %u\n", i);
+	}
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	if (ck_idalloc_count(&ida) != 0) {
+		ck_error("ERROR: %u identifiers leaked\n",
+		    ck_idalloc_count(&ida));
+	}
+
+	ck_idalloc_destroy(&ida);
+	free(threads);
+	return 0;
+}
@@ -0,0 +1,14 @@
+#include <ck_pflock.h>
+#include <ck_pflock_ec.h>
+
+#define LOCK_NAME "ck_pflock"
+#define SPIN_LOCK_DEFINE static ck_pflock_t spin_lock = CK_PFLOCK_INITIALIZER
+#define SPIN_READ_LOCK ck_pflock_read_lock(&spin_lock)
+#define SPIN_READ_UNLOCK ck_pflock_read_unlock(&spin_lock)
+#define SPIN_WRITE_LOCK ck_pflock_write_lock(&spin_lock)
+#define SPIN_WRITE_UNLOCK ck_pflock_write_unlock(&spin_lock)
+#define EC_LOCK_DEFINE static ck_pflock_ec_t ec_lock = CK_PFLOCK_EC_INITIALIZER
+#define EC_READ_LOCK ck_pflock_ec_read_lock(&ec_lock, &ec_mode)
+#define EC_READ_UNLOCK ck_pflock_ec_read_unlock(&ec_lock, &ec_mode)
+#define EC_WRITE_LOCK ck_pflock_ec_write_lock(&ec_lock, &ec_mode)
+#define EC_WRITE_UNLOCK ck_pflock_ec_write_unlock(&ec_lock, &ec_mode)
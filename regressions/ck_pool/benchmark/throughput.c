@@ -0,0 +1,247 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ec.h>
+#include <ck_epoch.h>
+#include <ck_pool.h>
+#include <ck_pr.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 8
+#endif
+
+#define FIB 27
+#define RANGE (1UL << 22)
+#define TASKS 65536
+
+struct fib {
+	ck_pool_task_t task;
+	unsigned int n;
+	unsigned long result;
+};
+
+static ck_epoch_t epoch;
+static ck_pool_t pool;
+static ck_pool_task_t tasks[TASKS];
+static uint64_t *data;
+static uint64_t sum;
+static struct affinity a;
+
+static void *
+bench_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+/*
+ * Arrays replaced by a growing deque are leaked rather than reclaimed
+ * through ck_epoch. Each deque only grows a few times.
+ */
+static void
+bench_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	if (r == false)
+		free(p);
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = bench_malloc,
+	.free = bench_free
+};
+
+static void *
+worker(void *arg)
+{
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_pool_run(&pool, (unsigned int)(uintptr_t)arg);
+	return NULL;
+}
+
+static unsigned long
+fib_serial(unsigned int n)
+{
+
+	return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+static void
+fib(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+	struct fib *f = (struct fib *)(void *)task;
+	struct fib left, right;
+	ck_pool_group_t group;
+
+	if (f->n < 2) {
+		f->result = f->n;
+		return;
+	}
+
+	left.n = f->n - 1;
+	right.n = f->n - 2;
+	ck_pool_group_init(&group);
+	ck_pool_fork(w, &left.task, fib, &group);
+	fib(w, &right.task);
+	ck_pool_join(w, &group);
+	f->result = left.result + right.result;
+	return;
+}
+
+static void
+reduce(ck_pool_worker_t *w, unsigned long begin, unsigned long end, void *arg)
+{
+	uint64_t local = 0;
+	unsigned long i;
+
+	(void)w;
+	(void)arg;
+	for (i = begin; i < end; i++)
+		local += data[i];
+
+	ck_pr_add_64(&sum, local);
+	return;
+}
+
+static void
+empty(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+
+	(void)w;
+	(void)task;
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	ck_pool_group_t group;
+	pthread_t *threads;
+	unsigned int i, r, n;
+	unsigned long grain;
+	uint64_t s, serial, parallel;
+	struct fib f;
+
+	if (argc != 3) {
+		ck_error("Usage: throughput <number of workers> <affinity delta>\n");
+	}
+
+	n = atoi(argv[1]);
+	if (n == 0)
+		ck_error("ERROR: At least one worker is required\n");
+
+	a.delta = atoi(argv[2]);
+	threads = malloc(sizeof(pthread_t) * n);
+	data = malloc(sizeof(uint64_t) * RANGE);
+	if (threads == NULL || data == NULL)
+		ck_error("ERROR: Could not allocate memory\n");
+
+	for (i = 0; i < RANGE; i++)
+		data[i] = i;
+
+	ck_epoch_init(&epoch);
+	if (ck_pool_init(&pool, &allocator, &epoch, &ck_ec_linux_ops, n,
+	    NULL) == false)
+		ck_error("ERROR: ck_pool_init\n");
+
+	for (i = 0; i < n; i++)
+		pthread_create(&threads[i], NULL, worker, (void *)(uintptr_t)i);
+
+	printf("%-24s %16s %16s\n", "", "serial", "pool");
+
+	serial = parallel = 0;
+	for (r = 0; r < ITERATIONS; r++) {
+		s = rdtsc();
+		f.result = fib_serial(FIB);
+		serial += rdtsc() - s;
+
+		f.n = FIB;
+		ck_pool_group_init(&group);
+		s = rdtsc();
+		ck_pool_submit(&pool, &f.task, fib, &group);
+		ck_pool_wait(&pool, &group);
+		parallel += rdtsc() - s;
+	}
+
+	printf("fib(%u) %17s %16" PRIu64 " %16" PRIu64 "\n", FIB, "",
+	    serial / ITERATIONS, parallel / ITERATIONS);
+
+	for (grain = 1024; grain <= RANGE / 4; grain <<= 4) {
+		serial = parallel = 0;
+		for (r = 0; r < ITERATIONS; r++) {
+			sum = 0;
+			s = rdtsc();
+			reduce(NULL, 0, RANGE, NULL);
+			serial += rdtsc() - s;
+
+			sum = 0;
+			s = rdtsc();
+			ck_pool_for(&pool, 0, RANGE, grain, reduce, NULL);
+			parallel += rdtsc() - s;
+			if (sum != (uint64_t)RANGE * (RANGE - 1) / 2)
+				ck_error("ERROR: Sum is %" PRIu64 "\n", sum);
+		}
+
+		printf("for, grain %-13lu %16" PRIu64 " %16" PRIu64 "\n", grain,
+		    serial / ITERATIONS, parallel / ITERATIONS);
+	}
+
+	parallel = 0;
+	for (r = 0; r < ITERATIONS; r++) {
+		ck_pool_group_init(&group);
+		s = rdtsc();
+		for (i = 0; i < TASKS; i++)
+			ck_pool_submit(&pool, &tasks[i], empty, &group);
+
+		ck_pool_wait(&pool, &group);
+		parallel += rdtsc() - s;
+	}
+
+	printf("%-24s %16s %16" PRIu64 "\n", "submit (per task)", "-",
+	    parallel / ITERATIONS / TASKS);
+
+	ck_pool_shutdown(&pool);
+	for (i = 0; i < n; i++)
+		pthread_join(threads[i], NULL);
+
+	ck_pool_destroy(&pool);
+	free(data);
+	free(threads);
+	return 0;
+}
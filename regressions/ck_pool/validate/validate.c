@@ -0,0 +1,449 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ec.h>
+#include <ck_epoch.h>
+#include <ck_pool.h>
+#include <ck_pr.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ROUNDS
+#define ROUNDS 16
+#endif
+
+#define TASKS 4096
+#define WIDE 20000
+#define RANGE 100003UL
+#define FIB 22
+#define JOINS 1024
+
+struct array_header {
+	ck_epoch_entry_t epoch_entry;
+};
+
+struct counted {
+	ck_pool_task_t task;
+	unsigned int id;
+};
+
+struct fib {
+	ck_pool_task_t task;
+	unsigned int n;
+	unsigned long result;
+};
+
+/* A stack group whose memory is reused as soon as it has been joined. */
+union scratch {
+	ck_pool_group_t group;
+	unsigned char bytes[sizeof(ck_pool_group_t)];
+};
+
+static ck_epoch_t epoch;
+static ck_epoch_record_t epoch_wr;
+static ck_pool_t pool;
+static unsigned int hits[WIDE > RANGE ? WIDE : RANGE];
+static struct counted tasks[WIDE];
+static unsigned int nthr;
+static struct affinity a;
+
+static void *
+pool_malloc(size_t r)
+{
+	struct array_header *h;
+
+	h = malloc(sizeof(*h) + r);
+	if (h == NULL)
+		return NULL;
+
+	return h + 1;
+}
+
+static void
+pool_destroy(ck_epoch_entry_t *e)
+{
+
+	free(e);
+	return;
+}
+
+/*
+ * Deque arrays that a thief may still be reading are retired on the epoch
+ * the pool was created with.
+ */
+static void
+pool_free(void *p, size_t b, bool r)
+{
+	struct array_header *h = p;
+
+	(void)b;
+	h--;
+
+	if (r == true) {
+		ck_epoch_call_strict(&epoch_wr, &h->epoch_entry, pool_destroy);
+	} else {
+		free(h);
+	}
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = pool_malloc,
+	.free = pool_free
+};
+
+static void *
+worker(void *arg)
+{
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_pool_run(&pool, (unsigned int)(uintptr_t)arg);
+	return NULL;
+}
+
+static void
+check_hits(unsigned int n, const char *test)
+{
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		if (hits[i] != 1)
+			ck_error("ERROR: %s: %u was visited %u times\n",
+			    test, i, hits[i]);
+	}
+
+	memset(hits, 0, sizeof hits);
+	return;
+}
+
+static void
+count(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+	struct counted *c = (struct counted *)(void *)task;
+
+	if (ck_pool_worker_id(w) >= nthr)
+		ck_error("ERROR: Unexpected worker %u\n", ck_pool_worker_id(w));
+
+	ck_pr_inc_uint(&hits[c->id]);
+	return;
+}
+
+static unsigned long
+fib_serial(unsigned int n)
+{
+
+	return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+static void
+fib(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+	struct fib *f = (struct fib *)(void *)task;
+	struct fib left, right;
+	ck_pool_group_t group;
+
+	if (f->n < 2) {
+		f->result = f->n;
+		return;
+	}
+
+	left.n = f->n - 1;
+	right.n = f->n - 2;
+	ck_pool_group_init(&group);
+	ck_pool_fork(w, &left.task, fib, &group);
+	fib(w, &right.task);
+	ck_pool_join(w, &group);
+	f->result = left.result + right.result;
+	return;
+}
+
+/* A single task forks many children, so its deque grows while thieves run. */
+static void
+wide(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+	ck_pool_group_t group = CK_POOL_GROUP_INITIALIZER;
+	unsigned int i;
+
+	(void)task;
+	for (i = 0; i < WIDE; i++) {
+		tasks[i].id = i;
+		ck_pool_fork(w, &tasks[i].task, count, &group);
+	}
+
+	ck_pool_join(w, &group);
+	return;
+}
+
+static void
+nop(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+
+	(void)w;
+	(void)task;
+	return;
+}
+
+/*
+ * Overwrites a group that has just been joined and checks that no task
+ * that completed into it writes to it afterwards.
+ */
+static void
+scribble(union scratch *s)
+{
+	unsigned int i;
+
+	memset(s->bytes, 0x5a, sizeof s->bytes);
+	for (i = 0; i < 64; i++)
+		ck_pr_stall();
+
+	for (i = 0; i < sizeof s->bytes; i++) {
+		if (s->bytes[i] != 0x5a)
+			ck_error("ERROR: Group written after its join\n");
+	}
+
+	return;
+}
+
+static void
+joins(ck_pool_worker_t *w, ck_pool_task_t *task)
+{
+	ck_pool_task_t children[2];
+	union scratch s;
+	unsigned int i;
+
+	(void)task;
+	for (i = 0; i < JOINS; i++) {
+		ck_pool_group_init(&s.group);
+		ck_pool_fork(w, &children[0], nop, &s.group);
+		ck_pool_fork(w, &children[1], nop, &s.group);
+		ck_pool_join(w, &s.group);
+		scribble(&s);
+	}
+
+	return;
+}
+
+/*
+ * Every worker joins many short-lived groups while this thread waits on
+ * others of its own.
+ */
+static void
+short_groups(void)
+{
+	ck_pool_group_t group;
+	ck_pool_task_t children[2];
+	union scratch s;
+	unsigned int i;
+
+	ck_pool_group_init(&group);
+	for (i = 0; i < nthr; i++)
+		ck_pool_submit(&pool, &tasks[i].task, joins, &group);
+
+	for (i = 0; i < JOINS; i++) {
+		ck_pool_group_init(&s.group);
+		ck_pool_submit(&pool, &children[0], nop, &s.group);
+		ck_pool_submit(&pool, &children[1], nop, &s.group);
+		ck_pool_wait(&pool, &s.group);
+		scribble(&s);
+	}
+
+	ck_pool_wait(&pool, &group);
+	return;
+}
+
+static void
+range(ck_pool_worker_t *w, unsigned long begin, unsigned long end, void *arg)
+{
+	unsigned long i;
+
+	(void)w;
+	if (arg != &pool)
+		ck_error("ERROR: Unexpected argument %p\n", arg);
+
+	if (begin >= end || end > RANGE + 7)
+		ck_error("ERROR: Invalid range [%lu, %lu)\n", begin, end);
+
+	for (i = begin; i < end; i++)
+		ck_pr_inc_uint(&hits[i - 7]);
+
+	return;
+}
+
+static void
+inner(ck_pool_worker_t *w, unsigned long begin, unsigned long end, void *arg)
+{
+	unsigned long row = (unsigned long)(uintptr_t)arg;
+	unsigned long i;
+
+	(void)w;
+	for (i = begin; i < end; i++)
+		ck_pr_inc_uint(&hits[row * 256 + i]);
+
+	return;
+}
+
+/* Each row of the outer range runs a nested parallel loop over columns. */
+static void
+outer(ck_pool_worker_t *w, unsigned long begin, unsigned long end, void *arg)
+{
+	unsigned long row;
+
+	(void)arg;
+	for (row = begin; row < end; row++)
+		ck_pool_worker_for(w, 0, 256, 16, inner, (void *)(uintptr_t)row);
+
+	return;
+}
+
+static void
+domains(void)
+{
+	unsigned int d[8] = { 0, 1, 0, 1, 0, 1, 2, 2 };
+	ck_pool_worker_t *w;
+	unsigned int i, j;
+
+	if (ck_pool_init(&pool, &allocator, &epoch, &ck_ec_linux_ops,
+	    8, d) == false)
+		ck_error("ERROR: ck_pool_init\n");
+
+	for (i = 0; i < 8; i++) {
+		w = &pool.workers[i];
+		if (w->n_victims != 7 || w->n_local != (d[i] == 2 ? 1U : 2U))
+			ck_error("ERROR: Worker %u has %u victims, %u local\n",
+			    i, w->n_victims, w->n_local);
+
+		for (j = 0; j < w->n_victims; j++) {
+			if (w->victims[j] == i ||
+			    (j < w->n_local) != (d[w->victims[j]] == d[i]))
+				ck_error("ERROR: Worker %u victim %u is %u\n",
+				    i, j, w->victims[j]);
+		}
+	}
+
+	ck_pool_destroy(&pool);
+	return;
+}
+
+static void
+run(void)
+{
+	unsigned int d[2] = { 0, 1 };
+	ck_pool_group_t group;
+	ck_pool_task_t root;
+	pthread_t *threads;
+	unsigned int i, r;
+	struct fib f;
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Could not allocate threads\n");
+
+	/* With two workers, place them in different domains. */
+	if (ck_pool_init(&pool, &allocator, &epoch, &ck_ec_linux_ops, nthr,
+	    nthr == 2 ? d : NULL) == false)
+		ck_error("ERROR: ck_pool_init\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, worker, (void *)(uintptr_t)i);
+
+	for (r = 0; r < ROUNDS; r++) {
+		ck_pool_group_init(&group);
+		for (i = 0; i < TASKS; i++) {
+			tasks[i].id = i;
+			ck_pool_submit(&pool, &tasks[i].task, count, &group);
+		}
+
+		ck_pool_wait(&pool, &group);
+		check_hits(TASKS, "submit");
+
+		f.n = FIB;
+		ck_pool_group_init(&group);
+		ck_pool_submit(&pool, &f.task, fib, &group);
+		ck_pool_wait(&pool, &group);
+		if (f.result != fib_serial(FIB))
+			ck_error("ERROR: fib(%u) is %lu\n", FIB, f.result);
+
+		ck_pool_group_init(&group);
+		ck_pool_submit(&pool, &root, wide, &group);
+		ck_pool_wait(&pool, &group);
+		check_hits(WIDE, "fork");
+
+		ck_pool_for(&pool, 7, RANGE + 7, 1 + r * 97, range, &pool);
+		check_hits(RANGE, "for");
+
+		ck_pool_for(&pool, 0, 256, 1, outer, NULL);
+		check_hits(256 * 256, "nested for");
+
+		ck_pool_for(&pool, 5, 5, 1, range, &pool);
+		short_groups();
+		ck_epoch_barrier(&epoch_wr);
+	}
+
+	ck_pool_shutdown(&pool);
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	ck_pool_destroy(&pool);
+	ck_epoch_barrier(&epoch_wr);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &epoch_wr, NULL);
+
+	fprintf(stderr, "Domains...");
+	domains();
+	fprintf(stderr, "done\n%u workers...", nthr);
+	run();
+
+	/* A second pool recycles the epoch records of the first. */
+	fprintf(stderr, "done\nRecycled...");
+	run();
+	fprintf(stderr, "done\n");
+	return 0;
+}
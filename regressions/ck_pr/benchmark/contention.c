@@ -0,0 +1,478 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Measures ck_pr read-modify-write operations and fences under contention.
+ * Every thread issues the same operation in batches against a target whose
+ * placement is selected by the layout argument:
+ *
+ *   shared  - all threads operate on the same word.
+ *   false   - every thread has its own word, packed next to its neighbours
+ *             so that they share cache lines.
+ *   private - every thread has its own cache line.
+ *
+ * SMT and cross-socket placement are selected with the affinity delta, as
+ * with the other benchmarks. Fences are issued after a store to the target
+ * so that they have outstanding work to order.
+ */
+
+#include <ck_cc.h>
+#include <ck_md.h>
+#include <ck_pr.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../common.h"
+
+#ifdef CK_F_PR_LOAD_64
+
+#ifndef BATCH
+#define BATCH 256
+#endif
+
+#ifndef SAMPLES
+#define SAMPLES 65536
+#endif
+
+enum {
+	LAYOUT_SHARED,
+	LAYOUT_FALSE,
+	LAYOUT_PRIVATE
+};
+
+struct operation {
+	const char *name;
+	uint64_t (*run)(uint64_t *, unsigned int);
+};
+
+struct context {
+	pthread_t thread;
+	uint64_t *target;
+	uint64_t n_ops;
+	uint64_t ns;
+	uint64_t sink;
+	unsigned int n_samples;
+	uint64_t *samples;
+} CK_CC_CACHELINE;
+
+static struct affinity a;
+static const struct operation *operation;
+static struct context *contexts;
+static unsigned int nthr;
+static unsigned int barrier;
+static unsigned int done;
+
+#define OPERATION(N, E)							\
+	static uint64_t							\
+	run_##N(uint64_t *target, unsigned int n)			\
+	{								\
+		uint64_t r = 0, v;					\
+									\
+		(void)v;						\
+		while (n-- > 0) {					\
+			E;						\
+		}							\
+									\
+		return r;						\
+	}
+
+#define FENCE(N)							\
+	OPERATION(fence_##N,						\
+	    ck_pr_store_64(target, n); ck_pr_fence_##N())
+
+OPERATION(load, r += ck_pr_load_64(target))
+OPERATION(store, ck_pr_store_64(target, n))
+
+#ifdef CK_F_PR_LOAD_ACQUIRE_64
+OPERATION(load_acquire, r += ck_pr_load_acquire_64(target))
+#endif
+
+#ifdef CK_F_PR_STORE_RELEASE_64
+OPERATION(store_release, ck_pr_store_release_64(target, n))
+#endif
+
+#ifdef CK_F_PR_FAA_64
+OPERATION(faa, r += ck_pr_faa_64(target, 1))
+#endif
+
+#ifdef CK_F_PR_FAS_64
+OPERATION(fas, r += ck_pr_fas_64(target, n))
+#endif
+
+#ifdef CK_F_PR_FAS_ACQUIRE_64
+OPERATION(fas_acquire, r += ck_pr_fas_acquire_64(target, n))
+#endif
+
+/*
+ * Compare-and-swap is measured as an increment loop, so that it may be
+ * compared directly with fetch-and-add.
+ */
+#ifdef CK_F_PR_CAS_64
+OPERATION(cas,
+    do { v = ck_pr_load_64(target); }
+    while (ck_pr_cas_64(target, v, v + 1) == false))
+#endif
+
+#ifdef CK_F_PR_CAS_ACQUIRE_64
+OPERATION(cas_acquire,
+    do { v = ck_pr_load_64(target); }
+    while (ck_pr_cas_acquire_64(target, v, v + 1) == false))
+#endif
+
+#ifdef CK_F_PR_CAS_64_VALUE
+OPERATION(cas_value,
+    v = ck_pr_load_64(target);
+    while (ck_pr_cas_64_value(target, v, v + 1, &v) == false))
+#endif
+
+#ifdef CK_F_PR_ADD_64
+OPERATION(add, ck_pr_add_64(target, 1))
+#endif
+
+#ifdef CK_F_PR_INC_64
+OPERATION(inc, ck_pr_inc_64(target))
+#endif
+
+#ifdef CK_F_PR_AND_64
+OPERATION(and, ck_pr_and_64(target, ~(uint64_t)0))
+#endif
+
+#ifdef CK_F_PR_OR_64
+OPERATION(or, ck_pr_or_64(target, 1))
+#endif
+
+#ifdef CK_F_PR_XOR_64
+OPERATION(xor, ck_pr_xor_64(target, 1))
+#endif
+
+#ifdef CK_F_PR_BTS_64
+OPERATION(bts, r += ck_pr_bts_64(target, n & 63))
+#endif
+
+#ifdef CK_F_PR_BTC_64
+OPERATION(btc, r += ck_pr_btc_64(target, n & 63))
+#endif
+
+FENCE(memory)
+FENCE(store_load)
+FENCE(store)
+FENCE(load)
+FENCE(acquire)
+FENCE(release)
+FENCE(lock)
+FENCE(unlock)
+
+#undef FENCE
+#undef OPERATION
+
+#define OPERATION(N) { #N, run_##N }
+
+static const struct operation operations[] = {
+	OPERATION(load),
+	OPERATION(store),
+#ifdef CK_F_PR_LOAD_ACQUIRE_64
+	OPERATION(load_acquire),
+#endif
+#ifdef CK_F_PR_STORE_RELEASE_64
+	OPERATION(store_release),
+#endif
+#ifdef CK_F_PR_FAA_64
+	OPERATION(faa),
+#endif
+#ifdef CK_F_PR_FAS_64
+	OPERATION(fas),
+#endif
+#ifdef CK_F_PR_FAS_ACQUIRE_64
+	OPERATION(fas_acquire),
+#endif
+#ifdef CK_F_PR_CAS_64
+	OPERATION(cas),
+#endif
+#ifdef CK_F_PR_CAS_ACQUIRE_64
+	OPERATION(cas_acquire),
+#endif
+#ifdef CK_F_PR_CAS_64_VALUE
+	OPERATION(cas_value),
+#endif
+#ifdef CK_F_PR_ADD_64
+	OPERATION(add),
+#endif
+#ifdef CK_F_PR_INC_64
+	OPERATION(inc),
+#endif
+#ifdef CK_F_PR_AND_64
+	OPERATION(and),
+#endif
+#ifdef CK_F_PR_OR_64
+	OPERATION(or),
+#endif
+#ifdef CK_F_PR_XOR_64
+	OPERATION(xor),
+#endif
+#ifdef CK_F_PR_BTS_64
+	OPERATION(bts),
+#endif
+#ifdef CK_F_PR_BTC_64
+	OPERATION(btc),
+#endif
+	OPERATION(fence_memory),
+	OPERATION(fence_store_load),
+	OPERATION(fence_store),
+	OPERATION(fence_load),
+	OPERATION(fence_acquire),
+	OPERATION(fence_release),
+	OPERATION(fence_lock),
+	OPERATION(fence_unlock)
+};
+
+#undef OPERATION
+
+static uint64_t
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int
+compare(const void *a_, const void *b_)
+{
+	const uint64_t *x = a_;
+	const uint64_t *y = b_;
+
+	return (*x > *y) - (*x < *y);
+}
+
+static uint64_t
+percentile(const uint64_t *v, size_t n, double p)
+{
+	size_t i = (size_t)(p * (double)(n - 1) + 0.5);
+
+	return v[i];
+}
+
+static void *
+thread(void *arg)
+{
+	struct context *context = arg;
+	uint64_t *target = context->target;
+	uint64_t s, e;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr + 1)
+		ck_pr_stall();
+
+	while (ck_pr_load_uint(&done) == 0) {
+		s = now();
+		context->sink += operation->run(target, BATCH);
+		e = now();
+
+		/* Samples are per-batch latencies, scaled to picoseconds. */
+		if (context->n_samples < SAMPLES)
+			context->samples[context->n_samples++] =
+			    (e - s) * 1000 / BATCH;
+
+		context->n_ops += BATCH;
+		context->ns += e - s;
+	}
+
+	return NULL;
+}
+
+static void
+run(unsigned int duration)
+{
+	uint64_t *samples, *throughput;
+	uint64_t n_ops = 0, ns = 0, elapsed;
+	size_t n = 0;
+	unsigned int i;
+
+	ck_pr_store_uint(&barrier, 0);
+	ck_pr_store_uint(&done, 0);
+	a.request = 0;
+
+	for (i = 0; i < nthr; i++) {
+		contexts[i].n_ops = 0;
+		contexts[i].ns = 0;
+		contexts[i].n_samples = 0;
+		if (pthread_create(&contexts[i].thread, NULL, thread,
+		    contexts + i) != 0)
+			ck_error("ERROR: Could not create thread %u\n", i);
+	}
+
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	elapsed = now();
+	ck_pr_inc_uint(&barrier);
+	common_sleep(duration);
+	ck_pr_store_uint(&done, 1);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(contexts[i].thread, NULL);
+
+	elapsed = now() - elapsed;
+
+	samples = malloc(sizeof(uint64_t) * SAMPLES * nthr);
+	throughput = malloc(sizeof(uint64_t) * nthr);
+	if (samples == NULL || throughput == NULL)
+		ck_error("ERROR: Could not allocate samples\n");
+
+	for (i = 0; i < nthr; i++) {
+		memcpy(samples + n, contexts[i].samples,
+		    sizeof(uint64_t) * contexts[i].n_samples);
+		n += contexts[i].n_samples;
+		n_ops += contexts[i].n_ops;
+		ns += contexts[i].ns;
+
+		/* Per-thread throughput in thousands of operations per second. */
+		throughput[i] = contexts[i].n_ops * 1000000 / elapsed;
+	}
+
+	if (n == 0)
+		ck_error("ERROR: No samples were collected\n");
+
+	qsort(samples, n, sizeof(uint64_t), compare);
+	qsort(throughput, nthr, sizeof(uint64_t), compare);
+
+	printf("%-18s %8.2f %8.2f %8.2f %8.2f %8.2f %10.2f %9.2f %9.2f %9.2f\n",
+	    operation->name,
+	    (double)ns / (double)n_ops,
+	    percentile(samples, n, 0.50) / 1000.0,
+	    percentile(samples, n, 0.90) / 1000.0,
+	    percentile(samples, n, 0.99) / 1000.0,
+	    percentile(samples, n, 0.999) / 1000.0,
+	    (double)n_ops * 1000.0 / (double)elapsed,
+	    throughput[0] / 1000.0,
+	    percentile(throughput, nthr, 0.50) / 1000.0,
+	    throughput[nthr - 1] / 1000.0);
+
+	free(throughput);
+	free(samples);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+	const char *layouts[] = { "shared", "false", "private" };
+	const char *name = NULL;
+	unsigned int duration = 1;
+	unsigned int layout, stride, i;
+	uint64_t *words;
+	void *allocation;
+	bool found = false;
+
+	if (argc < 4 || argc > 6) {
+		ck_error("Usage: contention <threads> <affinity delta> "
+		    "<shared | false | private> [operation | all] [seconds]\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr == 0)
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+
+	a.delta = atoi(argv[2]);
+
+	for (layout = 0; layout < sizeof layouts / sizeof *layouts; layout++) {
+		if (strcmp(argv[3], layouts[layout]) == 0)
+			break;
+	}
+
+	if (layout == sizeof layouts / sizeof *layouts)
+		ck_error("ERROR: Unknown layout %s\n", argv[3]);
+
+	if (argc >= 5 && strcmp(argv[4], "all") != 0)
+		name = argv[4];
+
+	if (argc == 6) {
+		duration = atoi(argv[5]);
+		if (duration == 0)
+			ck_error("ERROR: Duration must be greater than 0\n");
+	}
+
+	stride = layout == LAYOUT_PRIVATE ?
+	    CK_MD_CACHELINE / sizeof(uint64_t) : 1;
+
+	allocation = malloc(sizeof(uint64_t) * stride * nthr + CK_MD_CACHELINE);
+	contexts = malloc(sizeof(struct context) * nthr + CK_MD_CACHELINE);
+	if (allocation == NULL || contexts == NULL)
+		ck_error("ERROR: Could not allocate targets\n");
+
+	words = (uint64_t *)(((uintptr_t)allocation + CK_MD_CACHELINE - 1) &
+	    ~(uintptr_t)(CK_MD_CACHELINE - 1));
+	memset(words, 0, sizeof(uint64_t) * stride * nthr);
+
+	contexts = (struct context *)(((uintptr_t)contexts + CK_MD_CACHELINE - 1) &
+	    ~(uintptr_t)(CK_MD_CACHELINE - 1));
+	for (i = 0; i < nthr; i++) {
+		contexts[i].target = layout == LAYOUT_SHARED ?
+		    words : words + i * stride;
+		contexts[i].samples = malloc(sizeof(uint64_t) * SAMPLES);
+		if (contexts[i].samples == NULL)
+			ck_error("ERROR: Could not allocate samples\n");
+	}
+
+	printf("# threads: %u, delta: %u, layout: %s, batch: %u, duration: %u s\n",
+	    nthr, a.delta, layouts[layout], BATCH, duration);
+	printf("# %-16s %8s %8s %8s %8s %8s %10s %9s %9s %9s\n",
+	    "operation", "ns/op", "p50", "p90", "p99", "p99.9",
+	    "Mops/s", "t-min", "t-p50", "t-max");
+
+	for (i = 0; i < sizeof operations / sizeof *operations; i++) {
+		if (name != NULL && strcmp(name, operations[i].name) != 0)
+			continue;
+
+		operation = &operations[i];
+		found = true;
+		run(duration);
+	}
+
+	if (found == false)
+		ck_error("ERROR: Unknown operation %s\n", name);
+
+	return 0;
+}
+#else
+#warning Did not find LOAD_64 implementation.
+#include <stdlib.h>
+
+int
+main(void)
+{
+	exit(EXIT_FAILURE);
+}
+#endif /* CK_F_PR_LOAD_64 */
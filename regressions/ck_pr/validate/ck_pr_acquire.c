@@ -0,0 +1,128 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <ck_pr.h>
+
+#include "../../common.h"
+#ifndef R_REPEAT
+#define R_REPEAT 200000
+#endif
+
+#define CK_PR_LOAD_STORE_B(w)							\
+	{									\
+		uint##w##_t t = 0, v;						\
+		unsigned int i;							\
+		printf("ck_pr_load_acquire_" #w ": ");				\
+		if (w < 10)							\
+			printf(" ");						\
+		for (i = 0; i < R_REPEAT; i++) {				\
+			v = (uint##w##_t)common_rand();				\
+			ck_pr_store_release_##w(&t, v);				\
+			if (t != v || ck_pr_load_acquire_##w(&t) != v) {	\
+				printf("FAIL [%#" PRIx##w " != %#" PRIx##w "]\n", t, v);\
+				exit(EXIT_FAILURE);				\
+			}							\
+		}								\
+		printf(" SUCCESS\n");						\
+	}
+
+#define CK_PR_RMW_B(w)								\
+	{									\
+		uint##w##_t t = 0, v, r;					\
+		unsigned int i;							\
+		printf("ck_pr_rmw_acquire_" #w ": ");				\
+		if (w < 10)							\
+			printf(" ");						\
+		for (i = 0; i < R_REPEAT; i++) {				\
+			v = (uint##w##_t)common_rand();				\
+			r = t;							\
+			if (ck_pr_cas_acquire_##w(&t, r + 1, v) == true) {	\
+				printf("FAIL [CAS succeeded on mismatch]\n");	\
+				exit(EXIT_FAILURE);				\
+			}							\
+			if (ck_pr_cas_acquire_##w(&t, r, v) == false ||	\
+			    t != v) {						\
+				printf("FAIL [CAS %#" PRIx##w " != %#" PRIx##w "]\n", t, v);\
+				exit(EXIT_FAILURE);				\
+			}							\
+			r = ck_pr_fas_acquire_##w(&t, (uint##w##_t)i);		\
+			if (r != v || t != (uint##w##_t)i) {			\
+				printf("FAIL [FAS %#" PRIx##w " != %#" PRIx##w "]\n", r, v);\
+				exit(EXIT_FAILURE);				\
+			}							\
+		}								\
+		printf(" SUCCESS\n");						\
+	}
+
+int
+main(void)
+{
+	void *ptr = NULL, *p = &ptr;
+	unsigned int u = 0;
+
+	common_srand((unsigned int)getpid());
+
+#ifdef CK_F_PR_LOAD_64
+	CK_PR_LOAD_STORE_B(64);
+#endif
+	CK_PR_LOAD_STORE_B(32);
+	CK_PR_LOAD_STORE_B(16);
+	CK_PR_LOAD_STORE_B(8);
+
+#if defined(CK_F_PR_CAS_ACQUIRE_64) && defined(CK_F_PR_FAS_ACQUIRE_64)
+	CK_PR_RMW_B(64);
+#endif
+#if defined(CK_F_PR_CAS_ACQUIRE_32) && defined(CK_F_PR_FAS_ACQUIRE_32)
+	CK_PR_RMW_B(32);
+#endif
+
+	printf("ck_pr_load_acquire_ptr: ");
+	ck_pr_store_release_ptr(&ptr, p);
+	if (ck_pr_load_acquire_ptr(&ptr) != p) {
+		printf("FAIL [%p != %p]\n", ck_pr_load_acquire_ptr(&ptr), p);
+		exit(EXIT_FAILURE);
+	}
+	printf("SUCCESS\n");
+
+	printf("ck_pr_rmw_acquire_uint: ");
+	if (ck_pr_cas_acquire_uint(&u, 1, 2) == true ||
+	    ck_pr_cas_acquire_uint(&u, 0, 2) == false ||
+	    ck_pr_fas_acquire_uint(&u, 3) != 2 ||
+	    ck_pr_load_acquire_uint(&u) != 3) {
+		printf("FAIL [%u]\n", u);
+		exit(EXIT_FAILURE);
+	}
+	printf("SUCCESS\n");
+
+	return (0);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_pr.h>
+#include <ck_ref.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 10000000
+#endif
+
+static void
+ref_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = ref_free
+};
+
+static ck_ref_t ref;
+static uint64_t word CK_CC_CACHELINE;
+static unsigned int nthr;
+static unsigned int barrier;
+static unsigned int test;
+static struct affinity a;
+
+enum {
+	TEST_SHARED,
+	TEST_REF,
+	TEST_REF_LOCAL
+};
+
+/*
+ * Callers of ck_ref are expected to already be within an epoch read
+ * section, for instance that of the lookup that found the object, so the
+ * cost of the section is not measured.
+ */
+static void *
+thread(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	unsigned int i;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	switch (test) {
+	case TEST_SHARED:
+		for (i = 0; i < ITERATIONS; i++) {
+			ck_pr_inc_64(&word);
+			if (ck_pr_faa_64(&word, (uint64_t)-1) == 1)
+				ck_error("ERROR: Dropped the last reference\n");
+		}
+		break;
+	case TEST_REF:
+		for (i = 0; i < ITERATIONS; i++) {
+			ck_ref_get(&ref, id);
+			if (ck_ref_put(&ref, id) == true)
+				ck_error("ERROR: Dropped the last reference\n");
+		}
+		break;
+	case TEST_REF_LOCAL:
+		for (i = 0; i < ITERATIONS; i++) {
+			ck_ref_get_local(&ref, id);
+			if (ck_ref_put_local(&ref, id) == true)
+				ck_error("ERROR: Dropped the last reference\n");
+		}
+		break;
+	}
+
+	return NULL;
+}
+
+static void
+run(const char *label, unsigned int t)
+{
+	pthread_t *threads;
+	unsigned int i;
+	uint64_t s, e;
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	test = t;
+	barrier = 0;
+	a.request = 0;
+	word = 1;
+
+	s = rdtsc();
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, thread, (void *)(uintptr_t)i);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+	e = rdtsc();
+
+	printf("%24s: %8.2f ticks/get+put\n", label,
+	    (double)(e - s) / ((uint64_t)ITERATIONS * nthr));
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: throughput <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	a.delta = atoi(argv[2]);
+
+	if (ck_ref_init(&ref, &allocator, nthr) == false)
+		ck_error("ERROR: ck_ref_init\n");
+
+	run("ck_pr_inc/faa", TEST_SHARED);
+	run("ck_ref_get/put", TEST_REF);
+	run("ck_ref_get/put_local", TEST_REF_LOCAL);
+	ck_ref_destroy(&ref);
+	return 0;
+}
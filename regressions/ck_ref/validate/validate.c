@@ -0,0 +1,227 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <ck_ref.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 100000
+#endif
+
+static ck_epoch_t epoch;
+static ck_ref_t ref;
+static unsigned int nthr;
+static unsigned int barrier;
+static unsigned int killed;
+static unsigned int last;
+static struct affinity a;
+
+/* Epoch records are never unlinked, so the main thread owns one for good. */
+static ck_epoch_record_t main_record;
+
+static void
+ref_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+
+	/* The shards belong to the embedded counter and go with ck_ref_destroy. */
+	if (r == true)
+		ck_error("ERROR: ck_ref deferred the release of its shards\n");
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = malloc,
+	.free = ref_free
+};
+
+static void
+serial(void)
+{
+	unsigned int i;
+
+	if (ck_ref_init(&ref, &allocator, 4) == false)
+		ck_error("ERROR: ck_ref_init\n");
+
+	/* References may be dropped through a different shard. */
+	for (i = 0; i < 64; i++)
+		ck_ref_get(&ref, i % 4);
+
+	for (i = 0; i < 64; i++) {
+		if (ck_ref_put_local(&ref, (i + 1) % 4) == true)
+			ck_error("ERROR: Live put returned the last reference\n");
+	}
+
+	if (ck_ref_kill(&ref, &main_record) == false)
+		ck_error("ERROR: Kill did not drop the last reference\n");
+
+	ck_ref_destroy(&ref);
+
+	if (ck_ref_init(&ref, &allocator, 4) == false)
+		ck_error("ERROR: ck_ref_init\n");
+
+	ck_ref_get_local(&ref, 0);
+	ck_ref_get(&ref, 1);
+	if (ck_ref_kill(&ref, &main_record) == true)
+		ck_error("ERROR: Kill dropped a reference that is still held\n");
+
+	if (ck_ref_live(&ref) == true || ck_ref_tryget_live(&ref, 0) == true)
+		ck_error("ERROR: Killed reference count is still live\n");
+
+	ck_ref_get(&ref, 2);
+	if (ck_ref_put(&ref, 3) == true || ck_ref_put(&ref, 3) == true)
+		ck_error("ERROR: Put returned the last reference too early\n");
+
+	if (ck_ref_put(&ref, 0) == false)
+		ck_error("ERROR: Put did not return the last reference\n");
+
+	ck_ref_destroy(&ref);
+	return;
+}
+
+/*
+ * Workers take and drop references while the count is killed beneath
+ * them. Exactly one operation, kill or put, may see the last reference.
+ * Other workers drop references through every shard, so a worker takes
+ * references through its own shard with the atomic ck_ref_get. A worker
+ * that holds no reference may only take one while the count is live, as
+ * a lookup would.
+ */
+static void *
+thread(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	ck_epoch_record_t *record;
+	unsigned int i, held = 0;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Failed to allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr + 1)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS || ck_pr_load_uint(&killed) == 0; i++) {
+		ck_epoch_begin(record, NULL);
+
+		if (held == 0) {
+			if (ck_ref_tryget_live(&ref, id) == false) {
+				ck_epoch_end(record, NULL);
+				break;
+			}
+
+			held++;
+		} else if (common_rand() % 2 == 0) {
+			ck_ref_get(&ref, id);
+			held++;
+		} else {
+			if (ck_ref_put(&ref, common_rand() % nthr) == true) {
+				if (held > 1) {
+					ck_error("ERROR: Last reference dropped "
+					    "while held\n");
+				}
+
+				ck_pr_inc_uint(&last);
+			}
+
+			held--;
+		}
+
+		ck_epoch_end(record, NULL);
+	}
+
+	while (held-- > 0) {
+		ck_epoch_begin(record, NULL);
+		if (ck_ref_put(&ref, id) == true)
+			ck_pr_inc_uint(&last);
+		ck_epoch_end(record, NULL);
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	unsigned int i;
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &main_record, NULL);
+	serial();
+
+	if (ck_ref_init(&ref, &allocator, nthr) == false)
+		ck_error("ERROR: ck_ref_init\n");
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Failed to allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, thread, (void *)(uintptr_t)i);
+
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr + 1)
+		ck_pr_stall();
+
+	if (ck_ref_kill(&ref, &main_record) == true)
+		ck_pr_inc_uint(&last);
+
+	ck_pr_store_uint(&killed, 1);
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	if (last != 1)
+		ck_error("ERROR: The last reference was dropped %u times\n", last);
+
+	ck_ref_destroy(&ref);
+	free(threads);
+	return 0;
+}
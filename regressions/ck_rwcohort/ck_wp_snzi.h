@@ -0,0 +1,17 @@
+#include <ck_rwcohort_snzi.h>
+
+/*
+ * Readers arrive at the SNZI leaf of their cohort. This relies on the
+ * cohorts array of the validation program.
+ */
+#define SNZI_LEAVES 8
+static ck_snzi_node_t snzi_leaves[SNZI_LEAVES];
+
+#define LOCK_PROTOTYPE CK_RWCOHORT_SNZI_WP_PROTOTYPE
+#define LOCK_INSTANCE CK_RWCOHORT_SNZI_WP_INSTANCE
+#define LOCK_INITIALIZER CK_RWCOHORT_SNZI_WP_INITIALIZER(snzi_leaves, SNZI_LEAVES)
+#define LOCK_INIT(N, RW, WL) CK_RWCOHORT_SNZI_WP_INIT(N, RW, snzi_leaves, SNZI_LEAVES, SNZI_LEAVES, WL)
+#define READ_LOCK(N, RW, C, GC, LC) CK_RWCOHORT_SNZI_WP_READ_LOCK(N, RW, C, GC, LC, (unsigned int)((C) - cohorts))
+#define READ_UNLOCK(N, RW, C, GC, LC) CK_RWCOHORT_SNZI_WP_READ_UNLOCK(N, RW, C, GC, LC, (unsigned int)((C) - cohorts))
+#define WRITE_LOCK CK_RWCOHORT_SNZI_WP_WRITE_LOCK
+#define WRITE_UNLOCK CK_RWCOHORT_SNZI_WP_WRITE_UNLOCK
@@ -0,0 +1,2 @@
+#include "../ck_rp_snzi.h"
+#include "validate.h"
@@ -0,0 +1,2 @@
+#include "../ck_wp_snzi.h"
+#include "validate.h"
@@ -25,6 +25,7 @@
  */
 
 #include <ck_rwlock.h>
+#include <ck_rwlock_snzi.h>
 #include <inttypes.h>
 #include <pthread.h>
 #include <stdio.h>
@@ -38,6 +39,10 @@
 #define STEPS 1000000
 #endif
 
+#ifndef LEAVES
+#define LEAVES 64
+#endif
+
 static int barrier;
 static int threads;
 static unsigned int flag CK_CC_CACHELINE;
@@ -49,6 +54,16 @@ static struct {
 
 static struct affinity affinity;
 
+#ifdef CK_F_RWLOCK_SNZI
+static unsigned int next_leaf;
+static ck_snzi_node_t leaves[LEAVES];
+static struct {
+	ck_rwlock_snzi_t lock;
+} rw_snzi CK_CC_CACHELINE = {
+	.lock = CK_RWLOCK_SNZI_INITIALIZER(leaves, LEAVES)
+};
+#endif /* CK_F_RWLOCK_SNZI */
+
 #ifdef CK_F_PR_RTM
 static void *
 thread_lock_rtm(void *pun)
@@ -181,6 +196,76 @@ thread_lock(void *pun)
 	return NULL;
 }
 
+#ifdef CK_F_RWLOCK_SNZI
+static void *
+thread_lock_snzi(void *pun)
+{
+	uint64_t s_b, e_b, a, i;
+	uint64_t *value = pun;
+	unsigned int leaf;
+
+	if (aff_iterate(&affinity) != 0) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	leaf = ck_pr_faa_uint(&next_leaf, 1);
+
+	ck_pr_inc_int(&barrier);
+	while (ck_pr_load_int(&barrier) != threads)
+		ck_pr_stall();
+
+	for (i = 1, a = 0;; i++) {
+		s_b = rdtsc();
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_lock(&rw_snzi.lock, leaf);
+		ck_rwlock_snzi_read_unlock(&rw_snzi.lock, leaf);
+		e_b = rdtsc();
+
+		a += (e_b - s_b) >> 4;
+
+		if (ck_pr_load_uint(&flag) == 1)
+			break;
+	}
+
+	ck_pr_inc_int(&barrier);
+	while (ck_pr_load_int(&barrier) != threads * 2)
+		ck_pr_stall();
+
+	*value = (a / i);
+	return NULL;
+}
+#endif /* CK_F_RWLOCK_SNZI */
+
 static void
 rwlock_test(pthread_t *p, int d, uint64_t *latency, void *(*f)(void *), const char *label)
 {
@@ -245,6 +330,10 @@ main(int argc, char *argv[])
 	d = atoi(argv[1]);
 	rwlock_test(p, d, latency, thread_lock, "rwlock");
 
+#ifdef CK_F_RWLOCK_SNZI
+	rwlock_test(p, d, latency, thread_lock_snzi, "rwlock, snzi");
+#endif /* CK_F_RWLOCK_SNZI */
+
 #ifdef CK_F_PR_RTM
 	rwlock_test(p, d, latency, thread_lock_rtm, "rwlock, rtm");
 #endif /* CK_F_PR_RTM */
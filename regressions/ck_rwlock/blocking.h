@@ -0,0 +1,17 @@
+#include <ck_rwlock.h>
+#include <ck_rwlock_ec.h>
+
+#define LOCK_NAME "ck_rwlock"
+#define SPIN_LOCK_DEFINE static ck_rwlock_t spin_lock = CK_RWLOCK_INITIALIZER
+#define SPIN_READ_LOCK ck_rwlock_read_lock(&spin_lock)
+#define SPIN_READ_UNLOCK ck_rwlock_read_unlock(&spin_lock)
+#define SPIN_WRITE_LOCK ck_rwlock_write_lock(&spin_lock)
+#define SPIN_WRITE_UNLOCK ck_rwlock_write_unlock(&spin_lock)
+#define EC_LOCK_DEFINE static ck_rwlock_ec_t ec_lock = CK_RWLOCK_EC_INITIALIZER
+#define EC_READ_LOCK ck_rwlock_ec_read_lock(&ec_lock, &ec_mode)
+#define EC_READ_TRYLOCK ck_rwlock_ec_read_trylock(&ec_lock, &ec_mode)
+#define EC_READ_UNLOCK ck_rwlock_ec_read_unlock(&ec_lock, &ec_mode)
+#define EC_WRITE_LOCK ck_rwlock_ec_write_lock(&ec_lock, &ec_mode)
+#define EC_WRITE_TRYLOCK ck_rwlock_ec_write_trylock(&ec_lock, &ec_mode)
+#define EC_WRITE_DOWNGRADE ck_rwlock_ec_write_downgrade(&ec_lock, &ec_mode)
+#define EC_WRITE_UNLOCK ck_rwlock_ec_write_unlock(&ec_lock, &ec_mode)
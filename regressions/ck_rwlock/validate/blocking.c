@@ -0,0 +1,2 @@
+#include "../blocking.h"
+#include "../../blocking_validate.h"
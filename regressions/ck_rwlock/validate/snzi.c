@@ -0,0 +1,174 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <ck_pr.h>
+#include <ck_rwlock_snzi.h>
+
+#include "../../common.h"
+
+#ifndef ITERATE
+#define ITERATE 1000000
+#endif
+
+#ifndef LEAVES
+#define LEAVES 8
+#endif
+
+static struct affinity a;
+static unsigned int locked;
+static int nthr;
+static unsigned int next_leaf;
+static ck_snzi_node_t leaves[LEAVES];
+static ck_rwlock_snzi_t lock = CK_RWLOCK_SNZI_INITIALIZER(leaves, LEAVES);
+
+static void
+check_write(void)
+{
+	unsigned int l;
+
+	l = ck_pr_load_uint(&locked);
+	if (l != 0)
+		ck_error("ERROR [WR:%d]: %u != 0\n", __LINE__, l);
+
+	ck_pr_inc_uint(&locked);
+	ck_pr_inc_uint(&locked);
+	ck_pr_inc_uint(&locked);
+	ck_pr_inc_uint(&locked);
+
+	l = ck_pr_load_uint(&locked);
+	if (l != 4)
+		ck_error("ERROR [WR:%d]: %u != 4\n", __LINE__, l);
+
+	ck_pr_dec_uint(&locked);
+	ck_pr_dec_uint(&locked);
+	ck_pr_dec_uint(&locked);
+	ck_pr_dec_uint(&locked);
+
+	l = ck_pr_load_uint(&locked);
+	if (l != 0)
+		ck_error("ERROR [WR:%d]: %u != 0\n", __LINE__, l);
+
+	return;
+}
+
+static void
+check_read(void)
+{
+	unsigned int l;
+
+	l = ck_pr_load_uint(&locked);
+	if (l != 0)
+		ck_error("ERROR [RD:%d]: %u != 0\n", __LINE__, l);
+
+	return;
+}
+
+static void *
+thread(void *null CK_CC_UNUSED)
+{
+	unsigned int leaf;
+	int i = ITERATE;
+
+	if (aff_iterate(&a)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	leaf = ck_pr_faa_uint(&next_leaf, 1);
+
+	while (i--) {
+		ck_rwlock_snzi_write_lock(&lock);
+		check_write();
+		ck_rwlock_snzi_write_unlock(&lock);
+
+		ck_rwlock_snzi_read_lock(&lock, leaf);
+		check_read();
+		ck_rwlock_snzi_read_unlock(&lock, leaf);
+
+		if (ck_rwlock_snzi_write_trylock(&lock) == true) {
+			check_write();
+			ck_rwlock_snzi_write_downgrade(&lock, leaf);
+			check_read();
+			ck_rwlock_snzi_read_unlock(&lock, leaf);
+		}
+
+		if (ck_rwlock_snzi_read_trylock(&lock, leaf) == true) {
+			check_read();
+			ck_rwlock_snzi_read_unlock(&lock, leaf);
+		}
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	int i;
+
+	if (argc != 3) {
+		ck_error("Usage: snzi <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr <= 0) {
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+	}
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL) {
+		ck_error("ERROR: Could not allocate thread structures\n");
+	}
+
+	a.delta = atoi(argv[2]);
+
+	fprintf(stderr, "Creating threads (mutual exclusion)...");
+	for (i = 0; i < nthr; i++) {
+		if (pthread_create(&threads[i], NULL, thread, NULL)) {
+			ck_error("ERROR: Could not create thread %d\n", i);
+		}
+	}
+	fprintf(stderr, "done\n");
+
+	fprintf(stderr, "Waiting for threads to finish correctness regression...");
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	if (ck_rwlock_snzi_locked(&lock) == true)
+		ck_error("ERROR: Lock is held after all threads exited\n");
+
+	fprintf(stderr, "done (passed)\n");
+
+	return 0;
+}
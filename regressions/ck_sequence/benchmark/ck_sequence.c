@@ -39,6 +39,9 @@
 #endif
 
 static ck_sequence_t seqlock CK_CC_CACHELINE = CK_SEQUENCE_INITIALIZER;
+static ck_sequence_mw_t seqlock_mw CK_CC_CACHELINE = CK_SEQUENCE_MW_INITIALIZER;
+static char object[256] CK_CC_CACHELINE;
+static char copy[256] CK_CC_CACHELINE;
 
 int
 main(void)
@@ -70,6 +73,32 @@ main(void)
 	}
 	printf("READ %" PRIu64 "\n", a / STEPS);
 
+	a = 0;
+	for (i = 0; i < STEPS / 4; i++) {
+		s = rdtsc();
+		ck_sequence_snapshot(&seqlock, copy, object, sizeof copy);
+		ck_sequence_snapshot(&seqlock, copy, object, sizeof copy);
+		ck_sequence_snapshot(&seqlock, copy, object, sizeof copy);
+		ck_sequence_snapshot(&seqlock, copy, object, sizeof copy);
+		a += rdtsc() - s;
+	}
+	printf("snapshot: %" PRIu64 "\n", a / STEPS);
+
+	a = 0;
+	for (i = 0; i < STEPS / 4; i++) {
+		s = rdtsc();
+		ck_sequence_mw_snapshot(&seqlock_mw, copy, object, sizeof copy,
+		    CK_SEQUENCE_MW_RETRY);
+		ck_sequence_mw_snapshot(&seqlock_mw, copy, object, sizeof copy,
+		    CK_SEQUENCE_MW_RETRY);
+		ck_sequence_mw_snapshot(&seqlock_mw, copy, object, sizeof copy,
+		    CK_SEQUENCE_MW_RETRY);
+		ck_sequence_mw_snapshot(&seqlock_mw, copy, object, sizeof copy,
+		    CK_SEQUENCE_MW_RETRY);
+		a += rdtsc() - s;
+	}
+	printf("snapshot (mw): %" PRIu64 "\n", a / STEPS);
+
 	/* Write-side latency. */
 	a = 0;
 	for (i = 0; i < STEPS / 4; i++) {
@@ -86,6 +115,21 @@ main(void)
 	}
 	printf("write: %" PRIu64 "\n", a / STEPS);
 
+	a = 0;
+	for (i = 0; i < STEPS / 4; i++) {
+		s = rdtsc();
+		ck_sequence_mw_write_begin(&seqlock_mw);
+		ck_sequence_mw_write_end(&seqlock_mw);
+		ck_sequence_mw_write_begin(&seqlock_mw);
+		ck_sequence_mw_write_end(&seqlock_mw);
+		ck_sequence_mw_write_begin(&seqlock_mw);
+		ck_sequence_mw_write_end(&seqlock_mw);
+		ck_sequence_mw_write_begin(&seqlock_mw);
+		ck_sequence_mw_write_end(&seqlock_mw);
+		a += rdtsc() - s;
+	}
+	printf("write (mw): %" PRIu64 "\n", a / STEPS);
+
         return 0;
 }
 
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_sequence.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+
+#ifndef STEPS
+#define STEPS 1000000
+#endif
+
+#ifndef WORDS
+#define WORDS 64
+#endif
+
+#ifndef WRITERS
+#define WRITERS 2
+#endif
+
+struct example {
+	unsigned int value[WORDS];
+};
+
+static struct example global CK_CC_CACHELINE;
+static ck_sequence_t seqlock CK_CC_CACHELINE = CK_SEQUENCE_INITIALIZER;
+static ck_sequence_mw_t seqlock_mw CK_CC_CACHELINE = CK_SEQUENCE_MW_INITIALIZER;
+static unsigned int readers;
+static unsigned int done;
+static unsigned int barrier;
+static struct affinity affinerator;
+
+static void
+validate(const struct example *copy)
+{
+	unsigned int i;
+
+	for (i = 1; i < WORDS; i++) {
+		if (copy->value[i] != copy->value[0]) {
+			ck_error("ERROR: Torn snapshot: value[%u] (%u != %u)\n",
+			    i, copy->value[i], copy->value[0]);
+		}
+	}
+
+	return;
+}
+
+static void
+update(unsigned int v)
+{
+	unsigned int i;
+
+	for (i = 0; i < WORDS; i++)
+		ck_pr_store_uint(&global.value[i], v);
+
+	return;
+}
+
+static void *
+consumer(void *unused CK_CC_UNUSED)
+{
+	struct example copy;
+	unsigned long retries = 0;
+	unsigned int i;
+
+	if (aff_iterate(&affinerator)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	while (ck_pr_load_uint(&barrier) == 0)
+		ck_pr_stall();
+
+	for (i = 0; i < STEPS; i++) {
+		retries += ck_sequence_snapshot(&seqlock, &copy, &global,
+		    sizeof copy);
+		validate(&copy);
+	}
+
+	fprintf(stderr, "%lu retries.\n", retries);
+	ck_pr_dec_uint(&barrier);
+	return NULL;
+}
+
+static void *
+consumer_mw(void *unused CK_CC_UNUSED)
+{
+	struct example copy;
+	unsigned long retries = 0, locked = 0;
+	unsigned int i, r;
+
+	if (aff_iterate(&affinerator)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < STEPS; i++) {
+		r = ck_sequence_mw_snapshot(&seqlock_mw, &copy, &global,
+		    sizeof copy, 2);
+		validate(&copy);
+
+		retries += r;
+		locked += r == 2;
+	}
+
+	fprintf(stderr, "%lu retries, %lu locked snapshots.\n", retries, locked);
+	ck_pr_inc_uint(&done);
+	return NULL;
+}
+
+static void *
+producer_mw(void *unused CK_CC_UNUSED)
+{
+	unsigned int counter = 0;
+
+	while (ck_pr_load_uint(&done) != readers) {
+		ck_sequence_mw_write_begin(&seqlock_mw);
+		update(counter++);
+		ck_sequence_mw_write_end(&seqlock_mw);
+		ck_pr_stall();
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	pthread_t *threads;
+	unsigned int counter = 0;
+	unsigned int i;
+
+	if (argc != 3) {
+		ck_error("Usage: snapshot <number of threads> <affinity delta>\n");
+	}
+
+	readers = atoi(argv[1]);
+	if (readers == 0) {
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+	}
+
+	threads = malloc(sizeof(pthread_t) * (readers + WRITERS));
+	if (threads == NULL) {
+		ck_error("ERROR: Could not allocate memory for threads\n");
+	}
+
+	affinerator.delta = atoi(argv[2]);
+	affinerator.request = 0;
+
+	fprintf(stderr, "Single writer snapshots...\n");
+	for (i = 0; i < readers; i++) {
+		if (pthread_create(&threads[i], NULL, consumer, NULL)) {
+			ck_error("ERROR: Failed to create thread %u\n", i);
+		}
+	}
+
+	ck_pr_store_uint(&barrier, readers);
+	while (ck_pr_load_uint(&barrier) != 0) {
+		ck_sequence_write_begin(&seqlock);
+		update(counter++);
+		ck_sequence_write_end(&seqlock);
+		ck_pr_stall();
+	}
+
+	for (i = 0; i < readers; i++)
+		pthread_join(threads[i], NULL);
+
+	fprintf(stderr, "Multiple writer snapshots...\n");
+	for (i = 0; i < WRITERS; i++) {
+		if (pthread_create(&threads[readers + i], NULL, producer_mw, NULL)) {
+			ck_error("ERROR: Failed to create thread %u\n", i);
+		}
+	}
+
+	for (i = 0; i < readers; i++) {
+		if (pthread_create(&threads[i], NULL, consumer_mw, NULL)) {
+			ck_error("ERROR: Failed to create thread %u\n", i);
+		}
+	}
+
+	for (i = 0; i < readers + WRITERS; i++)
+		pthread_join(threads[i], NULL);
+
+	fprintf(stderr, "done (passed)\n");
+	return 0;
+}
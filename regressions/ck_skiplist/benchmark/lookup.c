@@ -0,0 +1,216 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_malloc.h>
+#include <ck_rhs.h>
+#include <ck_skiplist.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../common.h"
+#include "../../../src/ck_ht_hash.h"
+
+#ifndef SPAN
+#define SPAN 64
+#endif
+
+/*
+ * Compares point lookups in ck_skiplist against ck_rhs on the same set of
+ * integer entries, and reports the cost of a short ordered range scan,
+ * which the hash set cannot provide.
+ */
+static ck_skiplist_t sl;
+static ck_rhs_t hs;
+static uintptr_t *keys;
+static size_t keys_length;
+
+static void *
+bench_malloc(size_t r)
+{
+
+	return malloc(r);
+}
+
+static void
+bench_free(void *p, size_t b, bool r)
+{
+
+	(void)b;
+	(void)r;
+
+	free(p);
+	return;
+}
+
+static struct ck_malloc my_allocator = {
+	.malloc = bench_malloc,
+	.free = bench_free
+};
+
+static int
+sl_compare(const void *a, const void *b)
+{
+	uintptr_t x = (uintptr_t)a;
+	uintptr_t y = (uintptr_t)b;
+
+	return (x > y) - (x < y);
+}
+
+static unsigned long
+hs_hash(const void *object, unsigned long seed)
+{
+
+	return (unsigned long)MurmurHash64A(&object, sizeof(object), seed);
+}
+
+static void
+keys_shuffle(uintptr_t *k)
+{
+	size_t i, j;
+	uintptr_t t;
+
+	for (i = keys_length; i > 1; i--) {
+		j = common_rand() % i;
+		t = k[i - 1];
+		k[i - 1] = k[j];
+		k[j] = t;
+	}
+
+	return;
+}
+
+static int
+keys_compare(const void *a, const void *b)
+{
+
+	return sl_compare((const void *)*(const uintptr_t *)a,
+	    (const void *)*(const uintptr_t *)b);
+}
+
+#define SL_LOOKUP(K)	ck_skiplist_get(&sl, (const void *)(K))
+#define HS_LOOKUP(K)	ck_rhs_get(&hs, CK_RHS_HASH(&hs, hs_hash, (const void *)(K)), (const void *)(K))
+
+#define MEASURE(R, GET, OFFSET)						\
+	do {								\
+		size_t _i, _j;						\
+		uint64_t _s, _a = 0;					\
+									\
+		for (_j = 0; _j < (R); _j++) {				\
+			_s = rdtsc();					\
+			for (_i = 0; _i < keys_length; _i++) {		\
+				if ((GET(keys[_i] + (OFFSET)) == NULL) != \
+				    ((OFFSET) != 0))			\
+					ck_error("ERROR: Unexpected lookup result.\n"); \
+			}						\
+			_a += rdtsc() - _s;				\
+		}							\
+									\
+		printf(" %10" PRIu64, _a / ((R) * keys_length));	\
+	} while (0)
+
+int
+main(int argc, char *argv[])
+{
+	ck_skiplist_iterator_t iterator;
+	size_t i, j, r = 16;
+	uint64_t s, a;
+	void *entry;
+
+	if (argc < 2 || argc > 3) {
+		ck_error("Usage: lookup <number of entries> [repetitions]\n");
+	}
+
+	keys_length = strtoul(argv[1], NULL, 10);
+	if (keys_length == 0)
+		ck_error("ERROR: Number of entries must be greater than 0\n");
+
+	if (argc == 3)
+		r = strtoul(argv[2], NULL, 10);
+
+	keys = malloc(sizeof(uintptr_t) * keys_length);
+	if (keys == NULL)
+		ck_error("ERROR: Could not allocate keys\n");
+
+	if (ck_skiplist_init(&sl, CK_SKIPLIST_MODE_SPMC, sl_compare,
+	    &my_allocator, 6602834) == false)
+		ck_error("ERROR: ck_skiplist_init\n");
+
+	if (ck_rhs_init(&hs, CK_RHS_MODE_SPMC | CK_RHS_MODE_DIRECT, hs_hash,
+	    NULL, &my_allocator, keys_length, 6602834) == false)
+		ck_error("ERROR: ck_rhs_init\n");
+
+	/* Keys are even so that odd keys make for negative lookups. */
+	for (i = 0; i < keys_length; i++) {
+		do {
+			keys[i] = (((uintptr_t)common_rand() << 16 ^ i) + 1) << 1;
+		} while (ck_skiplist_put(&sl, (const void *)keys[i]) == false);
+
+		ck_rhs_put(&hs, CK_RHS_HASH(&hs, hs_hash, (const void *)keys[i]),
+		    (const void *)keys[i]);
+	}
+
+	fprintf(stderr, "# %u entries\n", ck_skiplist_count(&sl));
+	printf("%-11s %10s %10s %10s\n", "#", "ordered", "random", "negative");
+
+	qsort(keys, keys_length, sizeof(uintptr_t), keys_compare);
+	printf("%-11s", "ck_skiplist");
+	MEASURE(r, SL_LOOKUP, 0);
+	keys_shuffle(keys);
+	MEASURE(r, SL_LOOKUP, 0);
+	MEASURE(r, SL_LOOKUP, 1);
+	printf("\n");
+
+	qsort(keys, keys_length, sizeof(uintptr_t), keys_compare);
+	printf("%-11s", "ck_rhs");
+	MEASURE(r, HS_LOOKUP, 0);
+	keys_shuffle(keys);
+	MEASURE(r, HS_LOOKUP, 0);
+	MEASURE(r, HS_LOOKUP, 1);
+	printf("\n");
+
+	a = 0;
+	for (j = 0; j < r; j++) {
+		s = rdtsc();
+		for (i = 0; i < keys_length; i++) {
+			size_t n = 0;
+
+			ck_skiplist_lower_bound(&sl, &iterator, (const void *)keys[i]);
+			while (n++ < SPAN &&
+			    ck_skiplist_next(&sl, &iterator, &entry) == true);
+		}
+		a += rdtsc() - s;
+	}
+
+	printf("# ck_skiplist range scan of %d entries: %" PRIu64 " ticks\n",
+	    SPAN, a / (r * keys_length));
+
+	ck_skiplist_destroy(&sl);
+	ck_rhs_destroy(&hs);
+	free(keys);
+	return 0;
+}
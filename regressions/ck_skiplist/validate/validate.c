@@ -0,0 +1,481 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <ck_skiplist.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../common.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS 100000
+#endif
+
+#define SERIAL 10000
+#define KEYS 4096
+#define SPAN 64
+
+/*
+ * Entries are encoded keys rather than pointers to objects. Keys that are
+ * multiples of four are inserted up front and never removed, so every
+ * reader must find them, and an ordered scan must never step over one.
+ */
+#define ENTRY(k) ((void *)(uintptr_t)((k) + 1))
+#define KEY(e) ((uintptr_t)(e) - 1)
+#define PERSISTENT(k) (((k) & 3) == 0)
+
+struct node_header {
+	ck_epoch_entry_t epoch_entry;
+	size_t size;
+};
+
+static ck_epoch_t epoch;
+static ck_epoch_record_t epoch_wr;
+static ck_skiplist_t sl;
+static unsigned int nthr;
+static unsigned int barrier;
+static unsigned int finished;
+static long *balance;
+static struct affinity a;
+
+static void *
+test_malloc(size_t r)
+{
+	struct node_header *h;
+
+	h = malloc(sizeof(*h) + r);
+	if (h == NULL)
+		return NULL;
+
+	h->size = r;
+	return h + 1;
+}
+
+static void
+test_destroy(ck_epoch_entry_t *e)
+{
+	struct node_header *h = (struct node_header *)e;
+
+	/* Poison the node so that a premature release is noticed. */
+	memset(h + 1, 0xa5, h->size);
+	free(h);
+	return;
+}
+
+static void
+test_free(void *p, size_t b, bool r)
+{
+	struct node_header *h = p;
+
+	(void)b;
+	h--;
+
+	if (r == true) {
+		ck_epoch_call_strict(&epoch_wr, &h->epoch_entry, test_destroy);
+	} else {
+		free(h);
+	}
+
+	return;
+}
+
+static struct ck_malloc allocator = {
+	.malloc = test_malloc,
+	.free = test_free
+};
+
+static int
+test_compare(const void *a_, const void *b_)
+{
+	uintptr_t x = (uintptr_t)a_;
+	uintptr_t y = (uintptr_t)b_;
+
+	return (x > y) - (x < y);
+}
+
+static void
+serial(unsigned int mode)
+{
+	ck_skiplist_iterator_t iterator;
+	unsigned int *keys, i, j, t, n;
+	void *entry;
+
+	keys = malloc(sizeof(unsigned int) * SERIAL);
+	if (keys == NULL)
+		ck_error("ERROR: Could not allocate keys\n");
+
+	if (ck_skiplist_init(&sl, mode, test_compare, &allocator, 6602834) == false)
+		ck_error("ERROR: ck_skiplist_init\n");
+
+	/* Only even keys are inserted, in random order. */
+	for (i = 0; i < SERIAL; i++)
+		keys[i] = i * 2;
+
+	for (i = SERIAL; i > 1; i--) {
+		j = common_rand() % i;
+		t = keys[i - 1];
+		keys[i - 1] = keys[j];
+		keys[j] = t;
+	}
+
+	for (i = 0; i < SERIAL; i++) {
+		if (ck_skiplist_put(&sl, ENTRY(keys[i])) == false)
+			ck_error("ERROR: Failed to insert %u\n", keys[i]);
+	}
+
+	if (ck_skiplist_put(&sl, ENTRY(keys[0])) == true)
+		ck_error("ERROR: Inserted duplicate %u\n", keys[0]);
+
+	if (ck_skiplist_count(&sl) != SERIAL)
+		ck_error("ERROR: Count %u != %u\n", ck_skiplist_count(&sl), SERIAL);
+
+	for (i = 0; i < SERIAL * 2; i++) {
+		entry = ck_skiplist_get(&sl, ENTRY(i));
+		if ((i & 1) == 0 && entry != ENTRY(i))
+			ck_error("ERROR: Failed to find %u\n", i);
+
+		if ((i & 1) == 1 && entry != NULL)
+			ck_error("ERROR: Found missing key %u\n", i);
+	}
+
+	n = 0;
+	ck_skiplist_iterator_init(&sl, &iterator);
+	while (ck_skiplist_next(&sl, &iterator, &entry) == true) {
+		if (KEY(entry) != n * 2)
+			ck_error("ERROR: Iteration returned %lu, expected %u\n",
+			    (unsigned long)KEY(entry), n * 2);
+		n++;
+	}
+
+	if (n != SERIAL)
+		ck_error("ERROR: Iteration returned %u entries\n", n);
+
+	/* Every key, present or not, bounds at the next even key. */
+	for (i = 0; i < SERIAL * 2; i++) {
+		ck_skiplist_lower_bound(&sl, &iterator, ENTRY(i));
+		if (i == SERIAL * 2 - 1) {
+			if (ck_skiplist_next(&sl, &iterator, &entry) == true)
+				ck_error("ERROR: Lower bound past the end\n");
+
+			continue;
+		}
+
+		if (ck_skiplist_next(&sl, &iterator, &entry) == false ||
+		    KEY(entry) != ((i + 1) & ~1U))
+			ck_error("ERROR: Lower bound of %u is wrong\n", i);
+	}
+
+	/* Remove every other entry. */
+	for (i = 0; i < SERIAL; i++) {
+		if ((keys[i] & 2) == 0)
+			continue;
+
+		if (ck_skiplist_remove(&sl, ENTRY(keys[i])) != ENTRY(keys[i]))
+			ck_error("ERROR: Failed to remove %u\n", keys[i]);
+
+		if (ck_skiplist_remove(&sl, ENTRY(keys[i])) != NULL)
+			ck_error("ERROR: Removed %u twice\n", keys[i]);
+	}
+
+	if (ck_skiplist_count(&sl) != SERIAL / 2)
+		ck_error("ERROR: Count %u != %u\n", ck_skiplist_count(&sl), SERIAL / 2);
+
+	n = 0;
+	ck_skiplist_iterator_init(&sl, &iterator);
+	while (ck_skiplist_next(&sl, &iterator, &entry) == true) {
+		if (KEY(entry) != n * 4)
+			ck_error("ERROR: Iteration returned %lu, expected %u\n",
+			    (unsigned long)KEY(entry), n * 4);
+		n++;
+	}
+
+	if (n != SERIAL / 2)
+		ck_error("ERROR: Iteration returned %u entries\n", n);
+
+	ck_skiplist_destroy(&sl);
+	ck_epoch_barrier(&epoch_wr);
+	free(keys);
+	return;
+}
+
+/*
+ * Readers verify that persistent keys are always found and that a short
+ * ordered scan is strictly increasing and never skips a persistent key.
+ */
+static void
+reader(ck_epoch_record_t *record)
+{
+	ck_skiplist_iterator_t iterator;
+	unsigned int k, n;
+	uintptr_t previous, key;
+	void *entry;
+
+	k = (common_rand() % KEYS) & ~3U;
+
+	ck_epoch_begin(record, NULL);
+	if (ck_skiplist_get(&sl, ENTRY(k)) != ENTRY(k))
+		ck_error("ERROR: Persistent key %u not found\n", k);
+
+	previous = k;
+	ck_skiplist_lower_bound(&sl, &iterator, ENTRY(k));
+	for (n = 0; n < SPAN; n++) {
+		if (ck_skiplist_next(&sl, &iterator, &entry) == false)
+			break;
+
+		key = KEY(entry);
+		if (key >= KEYS || (n > 0 && key <= previous) ||
+		    (n == 0 && key != k))
+			ck_error("ERROR: Scan returned %lu after %lu\n",
+			    (unsigned long)key, (unsigned long)previous);
+
+		if (((previous + 4) & ~(uintptr_t)3) < key)
+			ck_error("ERROR: Scan skipped a persistent key after %lu\n",
+			    (unsigned long)previous);
+
+		previous = key;
+	}
+
+	ck_epoch_end(record, NULL);
+	return;
+}
+
+static void *
+spmc_reader(void *unused)
+{
+	ck_epoch_record_t *record;
+
+	(void)unused;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Could not allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+
+	while (ck_pr_load_uint(&finished) == 0)
+		reader(record);
+
+	return NULL;
+}
+
+static void
+populate(unsigned int mode)
+{
+	unsigned int i;
+
+	if (ck_skiplist_init(&sl, mode, test_compare, &allocator, 7) == false)
+		ck_error("ERROR: ck_skiplist_init\n");
+
+	for (i = 0; i < KEYS; i += 4) {
+		if (ck_skiplist_put(&sl, ENTRY(i)) == false)
+			ck_error("ERROR: Failed to insert %u\n", i);
+	}
+
+	return;
+}
+
+static void
+spmc(void)
+{
+	pthread_t *threads;
+	unsigned int i, k;
+
+	populate(CK_SKIPLIST_MODE_SPMC);
+	ck_pr_store_uint(&barrier, 0);
+	ck_pr_store_uint(&finished, 0);
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL)
+		ck_error("ERROR: Could not allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, spmc_reader, NULL);
+
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		k = common_rand() % KEYS;
+		if (PERSISTENT(k))
+			k++;
+
+		if (ck_skiplist_put(&sl, ENTRY(k)) == false &&
+		    ck_skiplist_remove(&sl, ENTRY(k)) != ENTRY(k))
+			ck_error("ERROR: Failed to remove %u\n", k);
+
+		if ((i & 1023) == 0)
+			ck_epoch_poll(&epoch_wr);
+	}
+
+	ck_pr_store_uint(&finished, 1);
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	ck_epoch_barrier(&epoch_wr);
+	ck_skiplist_destroy(&sl);
+	free(threads);
+	return;
+}
+
+/*
+ * Every writer records the net effect of its successful operations on
+ * each key. Once all writers are done, the sum for a key must match its
+ * presence in the set.
+ */
+static void *
+mpmc_writer(void *arg)
+{
+	long *local = arg;
+	ck_epoch_record_t *record;
+	unsigned int i, k;
+
+	if (aff_iterate(&a) != 0)
+		perror("WARNING: Could not affine thread");
+
+	record = malloc(sizeof *record);
+	if (record == NULL)
+		ck_error("ERROR: Could not allocate epoch record\n");
+
+	ck_epoch_register(&epoch, record, NULL);
+	ck_pr_inc_uint(&barrier);
+	while (ck_pr_load_uint(&barrier) < nthr)
+		ck_pr_stall();
+
+	for (i = 0; i < ITERATIONS; i++) {
+		/* Writers contend on a small range of keys. */
+		k = common_rand() % 256;
+		if (PERSISTENT(k))
+			k++;
+
+		ck_epoch_begin(record, NULL);
+		if (common_rand() & 1) {
+			if (ck_skiplist_put(&sl, ENTRY(k)) == true)
+				local[k]++;
+		} else {
+			if (ck_skiplist_remove(&sl, ENTRY(k)) == ENTRY(k))
+				local[k]--;
+		}
+		ck_epoch_end(record, NULL);
+
+		if ((i & 15) == 0)
+			reader(record);
+	}
+
+	return NULL;
+}
+
+static void
+mpmc(void)
+{
+	ck_skiplist_iterator_t iterator;
+	pthread_t *threads;
+	unsigned int i, k, n;
+	long sum;
+	void *entry;
+
+	populate(CK_SKIPLIST_MODE_MPMC);
+	ck_pr_store_uint(&barrier, 0);
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	balance = calloc((size_t)nthr * KEYS, sizeof(long));
+	if (threads == NULL || balance == NULL)
+		ck_error("ERROR: Could not allocate threads\n");
+
+	for (i = 0; i < nthr; i++)
+		pthread_create(&threads[i], NULL, mpmc_writer, balance + i * KEYS);
+
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	n = 0;
+	for (k = 0; k < KEYS; k++) {
+		sum = PERSISTENT(k) ? 1 : 0;
+		for (i = 0; i < nthr; i++)
+			sum += balance[i * KEYS + k];
+
+		if (sum != 0 && sum != 1)
+			ck_error("ERROR: Key %u has balance %ld\n", k, sum);
+
+		if ((ck_skiplist_get(&sl, ENTRY(k)) != NULL) != (sum == 1))
+			ck_error("ERROR: Key %u presence does not match %ld\n", k, sum);
+
+		n += (unsigned int)sum;
+	}
+
+	if (ck_skiplist_count(&sl) != n)
+		ck_error("ERROR: Count %u != %u\n", ck_skiplist_count(&sl), n);
+
+	k = 0;
+	ck_skiplist_iterator_init(&sl, &iterator);
+	while (ck_skiplist_next(&sl, &iterator, &entry) == true)
+		k++;
+
+	if (k != n)
+		ck_error("ERROR: Iteration returned %u entries, expected %u\n", k, n);
+
+	ck_epoch_barrier(&epoch_wr);
+	ck_skiplist_destroy(&sl);
+	free(balance);
+	free(threads);
+	return;
+}
+
+int
+main(int argc, char *argv[])
+{
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr < 2)
+		nthr = 2;
+
+	a.delta = atoi(argv[2]);
+	ck_epoch_init(&epoch);
+	ck_epoch_register(&epoch, &epoch_wr, NULL);
+
+	fprintf(stderr, "Serial (SPMC)...");
+	serial(CK_SKIPLIST_MODE_SPMC);
+	fprintf(stderr, "done\nSerial (MPMC)...");
+	serial(CK_SKIPLIST_MODE_MPMC);
+	fprintf(stderr, "done\nSingle writer, %u readers...", nthr);
+	spmc();
+	fprintf(stderr, "done\n%u writers...", nthr);
+	mpmc();
+	fprintf(stderr, "done\n");
+	return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <ck_pr.h>
+#include <ck_snzi.h>
+
+#include "../../common.h"
+
+#ifndef ITERATE
+#define ITERATE 1000000
+#endif
+
+#ifndef LEAVES
+#define LEAVES 16
+#endif
+
+#ifndef FANOUT
+#define FANOUT 2
+#endif
+
+static struct affinity a;
+static int nthr;
+static int barrier;
+static ck_snzi_t snzi;
+
+static void
+check_sequential(void)
+{
+	ck_snzi_node_t *nodes;
+	ck_snzi_t s;
+	unsigned int i, j;
+
+	nodes = malloc(sizeof(ck_snzi_node_t) * ck_snzi_size(LEAVES, FANOUT));
+	if (nodes == NULL)
+		ck_error("ERROR: Could not allocate SNZI nodes\n");
+
+	ck_snzi_init(&s, nodes, LEAVES, FANOUT);
+	if (ck_snzi_query(&s) == true)
+		ck_error("ERROR: Initial query is non-zero\n");
+
+	for (i = 0; i < LEAVES; i++) {
+		for (j = 0; j <= i; j++) {
+			ck_snzi_arrive(&s, i);
+			if (ck_snzi_query(&s) == false)
+				ck_error("ERROR [%u, %u]: Query is zero after arrival\n", i, j);
+		}
+	}
+
+	for (i = 0; i < LEAVES; i++) {
+		for (j = 0; j <= i; j++) {
+			if (ck_snzi_query(&s) == false)
+				ck_error("ERROR [%u, %u]: Query is zero with surplus\n", i, j);
+
+			ck_snzi_depart(&s, i);
+		}
+	}
+
+	if (ck_snzi_query(&s) == true)
+		ck_error("ERROR: Query is non-zero after all departures\n");
+
+	free(nodes);
+	return;
+}
+
+static void *
+thread(void *null CK_CC_UNUSED)
+{
+	unsigned int seed, hint;
+	int i = ITERATE;
+
+	if (aff_iterate(&a)) {
+		perror("ERROR: Could not affine thread");
+		exit(EXIT_FAILURE);
+	}
+
+	seed = (unsigned int)(uintptr_t)&seed;
+
+	ck_pr_inc_int(&barrier);
+	while (ck_pr_load_int(&barrier) != nthr)
+		ck_pr_stall();
+
+	while (i--) {
+		hint = common_rand_r(&seed);
+		ck_snzi_arrive(&snzi, hint);
+		if (ck_snzi_query(&snzi) == false)
+			ck_error("ERROR [%d]: Query is zero after arrival\n", __LINE__);
+
+		ck_snzi_arrive(&snzi, hint + 1);
+		ck_snzi_depart(&snzi, hint);
+		if (ck_snzi_query(&snzi) == false)
+			ck_error("ERROR [%d]: Query is zero with surplus\n", __LINE__);
+
+		ck_snzi_depart(&snzi, hint + 1);
+	}
+
+	return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+	ck_snzi_node_t *nodes;
+	pthread_t *threads;
+	int i;
+
+	if (argc != 3) {
+		ck_error("Usage: validate <number of threads> <affinity delta>\n");
+	}
+
+	nthr = atoi(argv[1]);
+	if (nthr <= 0) {
+		ck_error("ERROR: Number of threads must be greater than 0\n");
+	}
+
+	threads = malloc(sizeof(pthread_t) * nthr);
+	if (threads == NULL) {
+		ck_error("ERROR: Could not allocate thread structures\n");
+	}
+
+	a.delta = atoi(argv[2]);
+
+	fprintf(stderr, "Sequential regression...");
+	check_sequential();
+	fprintf(stderr, "done\n");
+
+	nodes = malloc(sizeof(ck_snzi_node_t) * ck_snzi_size(LEAVES, FANOUT));
+	if (nodes == NULL) {
+		ck_error("ERROR: Could not allocate SNZI nodes\n");
+	}
+	ck_snzi_init(&snzi, nodes, LEAVES, FANOUT);
+
+	fprintf(stderr, "Creating threads (concurrent arrivals)...");
+	for (i = 0; i < nthr; i++) {
+		if (pthread_create(&threads[i], NULL, thread, NULL)) {
+			ck_error("ERROR: Could not create thread %d\n", i);
+		}
+	}
+	fprintf(stderr, "done\n");
+
+	fprintf(stderr, "Waiting for threads to finish correctness regression...");
+	for (i = 0; i < nthr; i++)
+		pthread_join(threads[i], NULL);
+
+	if (ck_snzi_query(&snzi) == true)
+		ck_error("ERROR: Query is non-zero after all departures\n");
+
+	fprintf(stderr, "done (passed)\n");
+	return (0);
+}
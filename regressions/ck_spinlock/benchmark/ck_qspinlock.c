@@ -0,0 +1,7 @@
+#include "../ck_qspinlock.h"
+
+#ifdef THROUGHPUT
+#include "throughput.h"
+#elif defined(LATENCY)
+#include "latency.h"
+#endif
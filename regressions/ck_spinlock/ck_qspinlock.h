@@ -0,0 +1,8 @@
+#include <ck_qspinlock.h>
+
+#define LOCK_NAME "ck_qspinlock"
+#define LOCK_DEFINE static ck_qspinlock_t CK_CC_CACHELINE lock = CK_QSPINLOCK_INITIALIZER
+#define LOCK ck_qspinlock_lock(&lock)
+#define TRYLOCK ck_qspinlock_trylock(&lock)
+#define UNLOCK ck_qspinlock_unlock(&lock)
+#define LOCKED ck_qspinlock_locked(&lock)
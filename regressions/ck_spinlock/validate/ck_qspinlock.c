@@ -0,0 +1,2 @@
+#include "../ck_qspinlock.h"
+#include "validate.h"
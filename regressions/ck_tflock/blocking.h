@@ -0,0 +1,14 @@
+#include <ck_tflock.h>
+#include <ck_tflock_ec.h>
+
+#define LOCK_NAME "ck_tflock_ticket"
+#define SPIN_LOCK_DEFINE static ck_tflock_ticket_t spin_lock = CK_TFLOCK_TICKET_INITIALIZER
+#define SPIN_READ_LOCK ck_tflock_ticket_read_lock(&spin_lock)
+#define SPIN_READ_UNLOCK ck_tflock_ticket_read_unlock(&spin_lock)
+#define SPIN_WRITE_LOCK ck_tflock_ticket_write_lock(&spin_lock)
+#define SPIN_WRITE_UNLOCK ck_tflock_ticket_write_unlock(&spin_lock)
+#define EC_LOCK_DEFINE static ck_tflock_ticket_ec_t ec_lock = CK_TFLOCK_TICKET_EC_INITIALIZER
+#define EC_READ_LOCK ck_tflock_ticket_ec_read_lock(&ec_lock, &ec_mode)
+#define EC_READ_UNLOCK ck_tflock_ticket_ec_read_unlock(&ec_lock, &ec_mode)
+#define EC_WRITE_LOCK ck_tflock_ticket_ec_write_lock(&ec_lock, &ec_mode)
+#define EC_WRITE_UNLOCK ck_tflock_ticket_ec_write_unlock(&ec_lock, &ec_mode)
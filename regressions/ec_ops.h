@@ -0,0 +1,103 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef CK_REGRESSIONS_EC_OPS_H
+#define CK_REGRESSIONS_EC_OPS_H
+
+/*
+ * ck_ec_mode for regressions of primitives layered on top of ck_ec. On
+ * Linux, this is the shipped futex provider. Elsewhere, waiters sleep
+ * for a short period, which is permitted since wait operations may
+ * return early.
+ */
+
+#include <ck_ec.h>
+
+#ifdef CK_F_EC_LINUX
+static const struct ck_ec_mode ec_mode = CK_EC_LINUX_MODE_MP;
+#else
+#include <time.h>
+
+static int
+ec_ops_gettime(const struct ck_ec_ops *ops CK_CC_UNUSED, struct timespec *out)
+{
+
+	return clock_gettime(CLOCK_MONOTONIC, out);
+}
+
+static void
+ec_ops_wait32(const struct ck_ec_wait_state *state CK_CC_UNUSED,
+    const uint32_t *address CK_CC_UNUSED, uint32_t expected CK_CC_UNUSED,
+    const struct timespec *deadline CK_CC_UNUSED)
+{
+	struct timespec ts = { 0, 100000 };
+
+	nanosleep(&ts, NULL);
+	return;
+}
+
+static void
+ec_ops_wait64(const struct ck_ec_wait_state *state CK_CC_UNUSED,
+    const uint64_t *address CK_CC_UNUSED, uint64_t expected CK_CC_UNUSED,
+    const struct timespec *deadline CK_CC_UNUSED)
+{
+	struct timespec ts = { 0, 100000 };
+
+	nanosleep(&ts, NULL);
+	return;
+}
+
+static void
+ec_ops_wake32(const struct ck_ec_ops *ops CK_CC_UNUSED,
+    const uint32_t *address CK_CC_UNUSED)
+{
+
+	return;
+}
+
+static void
+ec_ops_wake64(const struct ck_ec_ops *ops CK_CC_UNUSED,
+    const uint64_t *address CK_CC_UNUSED)
+{
+
+	return;
+}
+
+static const struct ck_ec_ops ec_ops = {
+	.gettime = ec_ops_gettime,
+	.wait32 = ec_ops_wait32,
+	.wait64 = ec_ops_wait64,
+	.wake32 = ec_ops_wake32,
+	.wake64 = ec_ops_wake64
+};
+
+static const struct ck_ec_mode ec_mode = {
+	.ops = &ec_ops,
+	.single_producer = false
+};
+#endif /* CK_F_EC_LINUX */
+
+#endif /* CK_REGRESSIONS_EC_OPS_H */
@@ -27,7 +27,9 @@
 
 #include <ck_array.h>
 #include <ck_cc.h>
+#include <ck_limits.h>
 #include <ck_pr.h>
+#include <ck_stack.h>
 #include <ck_stdbool.h>
 #include <ck_string.h>
 
@@ -51,9 +53,8 @@ ck_array_init(struct ck_array *array, unsigned int mode, struct ck_malloc *alloc
 {
 	struct _ck_array *active;
 
-	(void)mode;
-
-	if (allocator->realloc == NULL ||
+	if (mode > CK_ARRAY_MODE_MPMC ||
+	    allocator->realloc == NULL ||
 	    allocator->malloc == NULL ||
 	    allocator->free == NULL ||
 	    length == 0)
@@ -67,6 +68,9 @@ ck_array_init(struct ck_array *array, unsigned int mode, struct ck_malloc *alloc
 	array->allocator = allocator;
 	array->active = active;
 	array->transaction = NULL;
+	array->mode = mode;
+	array->combiner = 0;
+	ck_stack_init(&array->records);
 	return true;
 }
 
@@ -76,6 +80,10 @@ ck_array_put(struct ck_array *array, void *value)
 	struct _ck_array *target;
 	unsigned int size;
 
+	/* Writers of a multi-writer array go through their records. */
+	if (array->mode != CK_ARRAY_MODE_SPMC)
+		return false;
+
 	/*
 	 * If no transaction copy has been necessary, attempt to do in-place
 	 * modification of the array.
@@ -131,6 +139,9 @@ ck_array_put_unique(struct ck_array *array, void *value)
 	unsigned int i, limit;
 	void **v;
 
+	if (array->mode != CK_ARRAY_MODE_SPMC)
+		return -1;
+
 	limit = array->n_entries;
 	if (array->transaction != NULL) {
 		v = array->transaction->values;
@@ -152,6 +163,9 @@ ck_array_remove(struct ck_array *array, void *value)
 	struct _ck_array *target;
 	unsigned int i;
 
+	if (array->mode != CK_ARRAY_MODE_SPMC)
+		return false;
+
 	if (array->transaction != NULL) {
 		target = array->transaction;
 
@@ -204,6 +218,9 @@ ck_array_commit(ck_array_t *array)
 {
 	struct _ck_array *m = array->transaction;
 
+	if (array->mode != CK_ARRAY_MODE_SPMC)
+		return false;
+
 	if (m != NULL) {
 		struct _ck_array *p;
 
@@ -238,3 +255,203 @@ ck_array_deinit(struct ck_array *array, bool defer)
 	array->transaction = array->active = NULL;
 	return;
 }
+
+CK_STACK_CONTAINER(struct ck_array_record, record_next,
+    ck_array_record_container)
+
+/* Reported in n_failed if a log could not be applied for lack of memory. */
+#define CK_ARRAY_RECORD_NOMEM UINT_MAX
+
+void
+ck_array_register(struct ck_array *array, struct ck_array_record *record)
+{
+
+	record->n_staged = 0;
+	record->n_pending = 0;
+	record->n_combined = 0;
+	record->n_failed = 0;
+	ck_pr_fence_store();
+	ck_stack_push_upmc(&array->records, &record->record_next);
+	return;
+}
+
+static bool
+ck_array_record_stage(struct ck_array_record *record,
+    void *value,
+    unsigned int type)
+{
+	struct ck_array_operation *operation;
+
+	if (record->n_staged == CK_ARRAY_LOG)
+		return false;
+
+	operation = &record->log[record->n_staged++];
+	operation->value = value;
+	operation->type = type;
+	return true;
+}
+
+bool
+ck_array_record_put(struct ck_array *array,
+    struct ck_array_record *record,
+    void *value)
+{
+
+	(void)array;
+	return ck_array_record_stage(record, value, CK_ARRAY_OPERATION_PUT);
+}
+
+bool
+ck_array_record_remove(struct ck_array *array,
+    struct ck_array_record *record,
+    void *value)
+{
+
+	(void)array;
+	return ck_array_record_stage(record, value, CK_ARRAY_OPERATION_REMOVE);
+}
+
+/*
+ * Marks a published log as applied. The owner of the record may reuse
+ * its log as soon as it observes n_pending reach zero.
+ */
+static void
+ck_array_record_release(struct ck_array_record *record)
+{
+
+	record->n_combined = 0;
+	ck_pr_fence_store();
+	ck_pr_store_uint(&record->n_pending, 0);
+	return;
+}
+
+/*
+ * Applies every published log with a single copy of the active array.
+ * Must be called with the combiner held. A log that is published while
+ * the combiner runs is left for the next combining pass.
+ */
+static void
+ck_array_combine(struct ck_array *array)
+{
+	struct _ck_array *active = array->active;
+	struct ck_array_operation *operation;
+	struct ck_array_record *record;
+	struct _ck_array *target;
+	ck_stack_entry_t *cursor;
+	unsigned int i, j, n, length;
+
+	length = array->n_entries;
+	CK_STACK_FOREACH(&array->records, cursor) {
+		record = ck_array_record_container(cursor);
+		record->n_combined = ck_pr_load_uint(&record->n_pending);
+		ck_pr_fence_load();
+
+		for (i = 0; i < record->n_combined; i++)
+			length += record->log[i].type == CK_ARRAY_OPERATION_PUT;
+	}
+
+	if (length == 0)
+		length = 1;
+
+	target = ck_array_create(array->allocator, length);
+	if (target == NULL) {
+		CK_STACK_FOREACH(&array->records, cursor) {
+			record = ck_array_record_container(cursor);
+			if (record->n_combined == 0)
+				continue;
+
+			record->n_failed = CK_ARRAY_RECORD_NOMEM;
+			ck_array_record_release(record);
+		}
+
+		return;
+	}
+
+	n = array->n_entries;
+	memcpy(target->values, active->values, sizeof(void *) * n);
+
+	/* Removals of values that are not present are reported as failures. */
+	CK_STACK_FOREACH(&array->records, cursor) {
+		record = ck_array_record_container(cursor);
+
+		/*
+		 * The owner of a record that is not part of this pass may
+		 * still be reading n_failed from its previous commit.
+		 */
+		if (record->n_combined == 0)
+			continue;
+
+		record->n_failed = 0;
+		for (i = 0; i < record->n_combined; i++) {
+			operation = &record->log[i];
+
+			if (operation->type == CK_ARRAY_OPERATION_PUT) {
+				target->values[n++] = operation->value;
+				continue;
+			}
+
+			for (j = 0; j < n; j++) {
+				if (target->values[j] == operation->value)
+					break;
+			}
+
+			if (j == n) {
+				record->n_failed++;
+				continue;
+			}
+
+			target->values[j] = target->values[--n];
+		}
+	}
+
+	target->n_committed = n;
+	ck_pr_fence_store();
+	ck_pr_store_ptr(&array->active, target);
+	array->n_entries = n;
+	array->allocator->free(active, sizeof(struct _ck_array) +
+	    active->length * sizeof(void *), true);
+
+	CK_STACK_FOREACH(&array->records, cursor) {
+		record = ck_array_record_container(cursor);
+		if (record->n_combined != 0)
+			ck_array_record_release(record);
+	}
+
+	return;
+}
+
+bool
+ck_array_record_commit(struct ck_array *array, struct ck_array_record *record)
+{
+	unsigned int n_failed;
+
+	if (record->n_staged == 0)
+		return true;
+
+	/* Serialize the log with respect to its publication. */
+	ck_pr_fence_store();
+	ck_pr_store_uint(&record->n_pending, record->n_staged);
+
+	while (ck_pr_load_uint(&record->n_pending) != 0) {
+		if (ck_pr_load_uint(&array->combiner) == 0 &&
+		    ck_pr_fas_uint(&array->combiner, 1) == 0) {
+			ck_pr_fence_lock();
+			ck_array_combine(array);
+			ck_pr_fence_unlock();
+			ck_pr_store_uint(&array->combiner, 0);
+			continue;
+		}
+
+		ck_pr_stall();
+	}
+
+	ck_pr_fence_acquire();
+	n_failed = ck_pr_load_uint(&record->n_failed);
+
+	/* The log was not applied and remains staged for another commit. */
+	if (n_failed == CK_ARRAY_RECORD_NOMEM)
+		return false;
+
+	record->n_staged = 0;
+	return n_failed == 0;
+}
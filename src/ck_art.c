@@ -0,0 +1,1048 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_art.h>
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+#include <ck_string.h>
+
+/*
+ * Node16 is searched with a single vector comparison if the target
+ * supports SSE2. Define CK_ART_VECTOR_DISABLE to always use the scalar
+ * search.
+ */
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(CK_ART_VECTOR_DISABLE)
+#include <emmintrin.h>
+#define CK_ART_VECTOR
+#endif
+
+#define CK_ART_NODE4	0
+#define CK_ART_NODE16	1
+#define CK_ART_NODE48	2
+#define CK_ART_NODE256	3
+
+/*
+ * Children are tagged with the low bit if they are leaves. A leaf holds a
+ * copy of its complete key, so a leaf may hang off any node on the path of
+ * its key and a lookup that reaches it compares the rest of the key there.
+ */
+#define CK_ART_LEAF_TAG ((uintptr_t)1)
+
+struct ck_art_leaf {
+	const void *entry;
+	unsigned int length;
+	unsigned char key[];
+};
+
+/*
+ * Every inner node begins with this header and is followed in memory by
+ * its compressed prefix, which never changes once the node is published.
+ * A node also holds the leaf whose key ends at it, if any.
+ *
+ * In every node type, a key byte is bound to a child slot for the
+ * lifetime of the node. Removing a child clears its slot and adding a
+ * child with the same byte fills it again, so a reader that matched a byte
+ * can never be handed the child of another byte. Slots are reclaimed by
+ * copying the node.
+ */
+struct ck_art_node {
+	struct ck_art_leaf *leaf;
+	uint32_t prefix_length;
+	uint16_t live;
+	uint8_t type;
+	uint8_t used;
+};
+
+struct ck_art_node4 {
+	struct ck_art_node header;
+	uint8_t keys[4];
+	void *children[4];
+};
+
+struct ck_art_node16 {
+	struct ck_art_node header;
+	uint8_t keys[16];
+	void *children[16];
+};
+
+struct ck_art_node48 {
+	struct ck_art_node header;
+	uint8_t index[256];
+	void *children[48];
+};
+
+struct ck_art_node256 {
+	struct ck_art_node header;
+	void *children[256];
+};
+
+static const size_t ck_art_node_size[] = {
+	sizeof(struct ck_art_node4),
+	sizeof(struct ck_art_node16),
+	sizeof(struct ck_art_node48),
+	sizeof(struct ck_art_node256)
+};
+
+static const unsigned int ck_art_node_capacity[] = { 4, 16, 48, 256 };
+
+CK_CC_INLINE static bool
+ck_art_leaf_tagged(const void *p)
+{
+
+	return ((uintptr_t)p & CK_ART_LEAF_TAG) != 0;
+}
+
+CK_CC_INLINE static struct ck_art_leaf *
+ck_art_leaf_untag(const void *p)
+{
+
+	return (struct ck_art_leaf *)((uintptr_t)p & ~CK_ART_LEAF_TAG);
+}
+
+CK_CC_INLINE static void *
+ck_art_leaf_tag(const struct ck_art_leaf *leaf)
+{
+
+	return (void *)((uintptr_t)leaf | CK_ART_LEAF_TAG);
+}
+
+CK_CC_INLINE static unsigned char *
+ck_art_node_prefix(const struct ck_art_node *node)
+{
+
+	return (unsigned char *)((uintptr_t)node + ck_art_node_size[node->type]);
+}
+
+static struct ck_art_leaf *
+ck_art_leaf_create(struct ck_art *art,
+    const unsigned char *key,
+    unsigned int length,
+    const void *entry)
+{
+	struct ck_art_leaf *leaf;
+
+	leaf = art->m->malloc(sizeof(struct ck_art_leaf) + length);
+	if (leaf == NULL)
+		return NULL;
+
+	leaf->entry = entry;
+	leaf->length = length;
+	if (length > 0)
+		memcpy(leaf->key, key, length);
+
+	return leaf;
+}
+
+static void
+ck_art_leaf_destroy(struct ck_art *art, struct ck_art_leaf *leaf, bool defer)
+{
+
+	art->m->free(leaf, sizeof(struct ck_art_leaf) + leaf->length, defer);
+	return;
+}
+
+/*
+ * Compares the key of a leaf to a key, ordering a key before every longer
+ * key it is a prefix of.
+ */
+static int
+ck_art_leaf_compare(const struct ck_art_leaf *leaf,
+    const unsigned char *key,
+    unsigned int length)
+{
+	unsigned int n = leaf->length < length ? leaf->length : length;
+	int r;
+
+	if (n > 0) {
+		r = memcmp(leaf->key, key, n);
+		if (r != 0)
+			return r;
+	}
+
+	return (leaf->length > length) - (leaf->length < length);
+}
+
+static struct ck_art_node *
+ck_art_node_create(struct ck_art *art, unsigned int type, uint32_t prefix_length)
+{
+	struct ck_art_node *node;
+
+	node = art->m->malloc(ck_art_node_size[type] + prefix_length);
+	if (node == NULL)
+		return NULL;
+
+	memset(node, 0, ck_art_node_size[type]);
+	node->type = type;
+	node->prefix_length = prefix_length;
+	return node;
+}
+
+static void
+ck_art_node_destroy(struct ck_art *art, struct ck_art_node *node, bool defer)
+{
+
+	art->m->free(node, ck_art_node_size[node->type] + node->prefix_length,
+	    defer);
+	return;
+}
+
+/*
+ * Returns the number of bytes of the prefix of a node that match the key
+ * from the given depth.
+ */
+static unsigned int
+ck_art_node_match(const struct ck_art_node *node,
+    const unsigned char *key,
+    unsigned int length,
+    unsigned int depth)
+{
+	const unsigned char *prefix = ck_art_node_prefix(node);
+	unsigned int i, n = node->prefix_length;
+
+	if (n > length - depth)
+		n = length - depth;
+
+	for (i = 0; i < n && prefix[i] == key[depth + i]; i++);
+	return i;
+}
+
+/*
+ * Returns the slot bound to a key byte, or NULL if the byte is not bound.
+ * The slot itself may be empty. Key bytes and children of Node4 and
+ * Node16 are written before the number of used slots is released.
+ */
+static void **
+ck_art_node_find(struct ck_art_node *node, unsigned char byte)
+{
+	struct ck_art_node4 *n4;
+	struct ck_art_node16 *n16;
+	struct ck_art_node48 *n48;
+	unsigned int i, used;
+#ifdef CK_ART_VECTOR
+	__m128i match;
+	unsigned int mask;
+#endif
+
+	switch (node->type) {
+	case CK_ART_NODE4:
+		n4 = (struct ck_art_node4 *)node;
+		used = ck_pr_load_acquire_8(&node->used);
+		for (i = 0; i < used; i++) {
+			if (n4->keys[i] == byte)
+				return &n4->children[i];
+		}
+
+		break;
+	case CK_ART_NODE16:
+		n16 = (struct ck_art_node16 *)node;
+		used = ck_pr_load_acquire_8(&node->used);
+#ifdef CK_ART_VECTOR
+		match = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte),
+		    _mm_loadu_si128((const __m128i *)(const void *)n16->keys));
+		mask = (unsigned int)_mm_movemask_epi8(match) & ((1U << used) - 1);
+		if (mask != 0)
+			return &n16->children[ck_cc_ctz(mask)];
+#else
+		for (i = 0; i < used; i++) {
+			if (n16->keys[i] == byte)
+				return &n16->children[i];
+		}
+#endif
+
+		break;
+	case CK_ART_NODE48:
+		n48 = (struct ck_art_node48 *)node;
+		i = ck_pr_load_acquire_8(&n48->index[byte]);
+		if (i != 0)
+			return &n48->children[i - 1];
+
+		break;
+	case CK_ART_NODE256:
+		return &((struct ck_art_node256 *)node)->children[byte];
+	}
+
+	return NULL;
+}
+
+static int
+ck_art_node_next_sparse(const uint8_t *keys,
+    void **children,
+    unsigned int used,
+    int byte,
+    void **child)
+{
+	unsigned int i;
+	int best = 256;
+	void *c;
+
+	for (i = 0; i < used; i++) {
+		if (keys[i] <= byte || keys[i] >= best)
+			continue;
+
+		c = ck_pr_load_ptr(&children[i]);
+		if (c == NULL)
+			continue;
+
+		best = keys[i];
+		*child = c;
+	}
+
+	return best == 256 ? -1 : best;
+}
+
+/*
+ * Returns the smallest key byte greater than the given one that has a
+ * child, or -1 if there is none. Children of Node4 and Node16 are not kept
+ * in order, so they are scanned in full.
+ */
+static int
+ck_art_node_next(struct ck_art_node *node, int byte, void **child)
+{
+	struct ck_art_node4 *n4;
+	struct ck_art_node16 *n16;
+	struct ck_art_node48 *n48;
+	struct ck_art_node256 *n256;
+	unsigned int slot;
+	void *c;
+	int i;
+
+	switch (node->type) {
+	case CK_ART_NODE4:
+		n4 = (struct ck_art_node4 *)node;
+		return ck_art_node_next_sparse(n4->keys, n4->children,
+		    ck_pr_load_acquire_8(&node->used), byte, child);
+	case CK_ART_NODE16:
+		n16 = (struct ck_art_node16 *)node;
+		return ck_art_node_next_sparse(n16->keys, n16->children,
+		    ck_pr_load_acquire_8(&node->used), byte, child);
+	case CK_ART_NODE48:
+		n48 = (struct ck_art_node48 *)node;
+		for (i = byte + 1; i < 256; i++) {
+			slot = ck_pr_load_acquire_8(&n48->index[i]);
+			if (slot == 0)
+				continue;
+
+			c = ck_pr_load_ptr(&n48->children[slot - 1]);
+			if (c != NULL) {
+				*child = c;
+				return i;
+			}
+		}
+
+		break;
+	case CK_ART_NODE256:
+		n256 = (struct ck_art_node256 *)node;
+		for (i = byte + 1; i < 256; i++) {
+			c = ck_pr_load_ptr(&n256->children[i]);
+			if (c != NULL) {
+				*child = c;
+				return i;
+			}
+		}
+
+		break;
+	}
+
+	return -1;
+}
+
+/*
+ * Adds a child to a node in place, visible to concurrent readers. Returns
+ * false if the node has no free slot for the byte.
+ */
+static bool
+ck_art_node_add(struct ck_art_node *node, unsigned char byte, void *child)
+{
+	struct ck_art_node48 *n48;
+	unsigned int used = node->used;
+	uint8_t *keys;
+	void **children, **slot;
+
+	slot = ck_art_node_find(node, byte);
+	if (slot != NULL) {
+		ck_pr_store_release_ptr(slot, child);
+		node->live++;
+		return true;
+	}
+
+	switch (node->type) {
+	case CK_ART_NODE4:
+		keys = ((struct ck_art_node4 *)node)->keys;
+		children = ((struct ck_art_node4 *)node)->children;
+		break;
+	case CK_ART_NODE16:
+		keys = ((struct ck_art_node16 *)node)->keys;
+		children = ((struct ck_art_node16 *)node)->children;
+		break;
+	case CK_ART_NODE48:
+		n48 = (struct ck_art_node48 *)node;
+		if (used == ck_art_node_capacity[CK_ART_NODE48])
+			return false;
+
+		ck_pr_store_ptr(&n48->children[used], child);
+		ck_pr_store_release_8(&n48->index[byte], used + 1);
+		node->used = used + 1;
+		node->live++;
+		return true;
+	default:
+		return false;
+	}
+
+	if (used == ck_art_node_capacity[node->type])
+		return false;
+
+	ck_pr_store_8(&keys[used], byte);
+	ck_pr_store_ptr(&children[used], child);
+	ck_pr_store_release_8(&node->used, used + 1);
+	node->live++;
+	return true;
+}
+
+/*
+ * Copies the leaf and children of a node into a new node of the smallest
+ * type that holds n children. The prefix of the copy is left to the
+ * caller.
+ */
+static struct ck_art_node *
+ck_art_node_copy(struct ck_art *art,
+    struct ck_art_node *node,
+    unsigned int n,
+    uint32_t prefix_length)
+{
+	struct ck_art_node *copy;
+	unsigned int type = CK_ART_NODE4;
+	void *child;
+	int byte;
+
+	while (ck_art_node_capacity[type] < n)
+		type++;
+
+	copy = ck_art_node_create(art, type, prefix_length);
+	if (copy == NULL)
+		return NULL;
+
+	copy->leaf = node->leaf;
+	for (byte = -1; (byte = ck_art_node_next(node, byte, &child)) >= 0;)
+		ck_art_node_add(copy, (unsigned char)byte, child);
+
+	return copy;
+}
+
+/*
+ * Attaches a leaf to a node that ends at the given depth, either as the
+ * leaf of the node or as a child.
+ */
+static void
+ck_art_node_attach(struct ck_art_node *node,
+    struct ck_art_leaf *leaf,
+    unsigned int depth)
+{
+
+	if (leaf->length == depth) {
+		ck_pr_store_release_ptr(&node->leaf, leaf);
+	} else {
+		ck_art_node_add(node, leaf->key[depth], ck_art_leaf_tag(leaf));
+	}
+
+	return;
+}
+
+/*
+ * Replaces a leaf found at the given depth with a node holding both it and
+ * a new leaf, prefixed by the bytes their keys share.
+ */
+static struct ck_art_node *
+ck_art_split_leaf(struct ck_art *art,
+    struct ck_art_leaf *existing,
+    struct ck_art_leaf *leaf,
+    unsigned int depth)
+{
+	struct ck_art_node *node;
+	unsigned int i, limit;
+
+	limit = existing->length < leaf->length ? existing->length : leaf->length;
+	for (i = depth; i < limit && existing->key[i] == leaf->key[i]; i++);
+
+	node = ck_art_node_create(art, CK_ART_NODE4, i - depth);
+	if (node == NULL)
+		return NULL;
+
+	memcpy(ck_art_node_prefix(node), leaf->key + depth, i - depth);
+	ck_art_node_attach(node, existing, i);
+	ck_art_node_attach(node, leaf, i);
+	return node;
+}
+
+/*
+ * Replaces a node whose prefix diverges from the key of a new leaf after
+ * the given number of bytes with a node holding the common bytes, a copy
+ * of the original node holding the rest and the new leaf.
+ */
+static struct ck_art_node *
+ck_art_split_prefix(struct ck_art *art,
+    struct ck_art_node *node,
+    struct ck_art_leaf *leaf,
+    unsigned int depth,
+    unsigned int matched)
+{
+	const unsigned char *prefix = ck_art_node_prefix(node);
+	struct ck_art_node *parent, *child;
+	uint32_t rest = node->prefix_length - matched - 1;
+
+	parent = ck_art_node_create(art, CK_ART_NODE4, matched);
+	if (parent == NULL)
+		return NULL;
+
+	child = ck_art_node_copy(art, node, node->live, rest);
+	if (child == NULL) {
+		ck_art_node_destroy(art, parent, false);
+		return NULL;
+	}
+
+	memcpy(ck_art_node_prefix(parent), prefix, matched);
+	memcpy(ck_art_node_prefix(child), prefix + matched + 1, rest);
+	ck_art_node_add(parent, prefix[matched], child);
+	ck_art_node_attach(parent, leaf, depth + matched);
+	return parent;
+}
+
+static bool
+ck_art_insert(struct ck_art *art,
+    const unsigned char *key,
+    unsigned int length,
+    const void *entry,
+    void **previous)
+{
+	struct ck_art_leaf *leaf, *existing;
+	struct ck_art_node *node, *copy;
+	unsigned int depth = 0, matched;
+	void **slot = &art->root, **child;
+	void *p;
+
+	leaf = ck_art_leaf_create(art, key, length, entry);
+	if (leaf == NULL)
+		return false;
+
+	for (;;) {
+		p = *slot;
+		if (p == NULL) {
+			ck_pr_store_release_ptr(slot, ck_art_leaf_tag(leaf));
+			break;
+		}
+
+		if (ck_art_leaf_tagged(p) == true) {
+			existing = ck_art_leaf_untag(p);
+			if (ck_art_leaf_compare(existing, key, length) == 0)
+				goto exists;
+
+			node = ck_art_split_leaf(art, existing, leaf, depth);
+			if (node == NULL)
+				goto fail;
+
+			ck_pr_store_release_ptr(slot, node);
+			break;
+		}
+
+		node = p;
+		matched = ck_art_node_match(node, key, length, depth);
+		if (matched != node->prefix_length) {
+			copy = ck_art_split_prefix(art, node, leaf, depth, matched);
+			if (copy == NULL)
+				goto fail;
+
+			ck_pr_store_release_ptr(slot, copy);
+			ck_art_node_destroy(art, node, true);
+			break;
+		}
+
+		depth += node->prefix_length;
+		if (depth == length) {
+			existing = node->leaf;
+			if (existing != NULL)
+				goto exists;
+
+			ck_pr_store_release_ptr(&node->leaf, leaf);
+			break;
+		}
+
+		child = ck_art_node_find(node, key[depth]);
+		if (child != NULL && *child != NULL) {
+			slot = child;
+			depth++;
+			continue;
+		}
+
+		if (ck_art_node_add(node, key[depth], ck_art_leaf_tag(leaf)) == true)
+			break;
+
+		/* The node is full, so it is copied with room to spare. */
+		copy = ck_art_node_copy(art, node, node->live + 1,
+		    node->prefix_length);
+		if (copy == NULL)
+			goto fail;
+
+		memcpy(ck_art_node_prefix(copy), ck_art_node_prefix(node),
+		    node->prefix_length);
+		ck_art_node_add(copy, key[depth], ck_art_leaf_tag(leaf));
+		ck_pr_store_release_ptr(slot, copy);
+		ck_art_node_destroy(art, node, true);
+		break;
+	}
+
+	ck_pr_store_uint(&art->n_entries, art->n_entries + 1);
+	if (previous != NULL)
+		*previous = NULL;
+
+	return true;
+
+exists:
+	ck_art_leaf_destroy(art, leaf, false);
+	if (previous == NULL)
+		return false;
+
+	*previous = CK_CC_DECONST_PTR(existing->entry);
+	ck_pr_store_release_ptr(&existing->entry, entry);
+	return true;
+
+fail:
+	ck_art_leaf_destroy(art, leaf, false);
+	return false;
+}
+
+bool
+ck_art_put(struct ck_art *art,
+    const void *key,
+    unsigned int length,
+    const void *entry)
+{
+
+	return ck_art_insert(art, key, length, entry, NULL);
+}
+
+bool
+ck_art_set(struct ck_art *art,
+    const void *key,
+    unsigned int length,
+    const void *entry,
+    void **previous)
+{
+
+	return ck_art_insert(art, key, length, entry, previous);
+}
+
+/*
+ * Restores path compression after a leaf was removed from a node. A node
+ * left with only its own leaf is replaced by that leaf, and a node left
+ * with a single child is merged into it. If memory for the merge cannot
+ * be allocated, the node is left as is, which remains correct.
+ */
+static void
+ck_art_shrink(struct ck_art *art,
+    struct ck_art_node *parent,
+    void **slot,
+    struct ck_art_node *node)
+{
+	struct ck_art_node *copy, *child;
+	unsigned char *prefix;
+	void *p;
+	int byte;
+
+	if (node->live == 0) {
+		if (node->leaf != NULL) {
+			ck_pr_store_release_ptr(slot, ck_art_leaf_tag(node->leaf));
+		} else {
+			ck_pr_store_ptr(slot, NULL);
+			if (parent != NULL)
+				parent->live--;
+		}
+
+		ck_art_node_destroy(art, node, true);
+		return;
+	}
+
+	if (node->live == 1 && node->leaf == NULL) {
+		byte = ck_art_node_next(node, -1, &p);
+		if (ck_art_leaf_tagged(p) == true) {
+			ck_pr_store_release_ptr(slot, p);
+			ck_art_node_destroy(art, node, true);
+			return;
+		}
+
+		child = p;
+		copy = ck_art_node_copy(art, child, child->live,
+		    node->prefix_length + 1 + child->prefix_length);
+		if (copy == NULL)
+			return;
+
+		prefix = ck_art_node_prefix(copy);
+		memcpy(prefix, ck_art_node_prefix(node), node->prefix_length);
+		prefix[node->prefix_length] = (unsigned char)byte;
+		memcpy(prefix + node->prefix_length + 1,
+		    ck_art_node_prefix(child), child->prefix_length);
+		ck_pr_store_release_ptr(slot, copy);
+		ck_art_node_destroy(art, child, true);
+		ck_art_node_destroy(art, node, true);
+		return;
+	}
+
+	/* Shrink a node once it is less than half the size of a smaller type. */
+	if (node->type != CK_ART_NODE4 &&
+	    node->live <= ck_art_node_capacity[node->type - 1] / 2) {
+		copy = ck_art_node_copy(art, node, node->live,
+		    node->prefix_length);
+		if (copy == NULL)
+			return;
+
+		memcpy(ck_art_node_prefix(copy), ck_art_node_prefix(node),
+		    node->prefix_length);
+		ck_pr_store_release_ptr(slot, copy);
+		ck_art_node_destroy(art, node, true);
+	}
+
+	return;
+}
+
+void *
+ck_art_remove(struct ck_art *art, const void *key, unsigned int length)
+{
+	const unsigned char *k = key;
+	struct ck_art_node *node = NULL, *parent = NULL;
+	struct ck_art_leaf *leaf;
+	unsigned int depth = 0;
+	void **slot = &art->root, **node_slot = NULL;
+	void *p, *entry;
+
+	for (;;) {
+		p = *slot;
+		if (p == NULL)
+			return NULL;
+
+		if (ck_art_leaf_tagged(p) == true) {
+			leaf = ck_art_leaf_untag(p);
+			if (ck_art_leaf_compare(leaf, k, length) != 0)
+				return NULL;
+
+			ck_pr_store_ptr(slot, NULL);
+			if (node != NULL)
+				node->live--;
+
+			break;
+		}
+
+		parent = node;
+		node = p;
+		node_slot = slot;
+		if (ck_art_node_match(node, k, length, depth) != node->prefix_length)
+			return NULL;
+
+		depth += node->prefix_length;
+		if (depth == length) {
+			leaf = node->leaf;
+			if (leaf == NULL)
+				return NULL;
+
+			ck_pr_store_ptr(&node->leaf, NULL);
+			break;
+		}
+
+		slot = ck_art_node_find(node, k[depth++]);
+		if (slot == NULL)
+			return NULL;
+	}
+
+	entry = CK_CC_DECONST_PTR(leaf->entry);
+	ck_pr_store_uint(&art->n_entries, art->n_entries - 1);
+	if (node != NULL)
+		ck_art_shrink(art, parent, node_slot, node);
+
+	ck_art_leaf_destroy(art, leaf, true);
+	return entry;
+}
+
+void *
+ck_art_get(struct ck_art *art, const void *key, unsigned int length)
+{
+	const unsigned char *k = key;
+	struct ck_art_node *node;
+	struct ck_art_leaf *leaf;
+	unsigned int depth = 0;
+	void **slot;
+	void *p;
+
+	p = ck_pr_load_ptr(&art->root);
+	for (;;) {
+		if (p == NULL)
+			return NULL;
+
+		if (ck_art_leaf_tagged(p) == true) {
+			leaf = ck_art_leaf_untag(p);
+			break;
+		}
+
+		node = p;
+		if (ck_art_node_match(node, k, length, depth) != node->prefix_length)
+			return NULL;
+
+		depth += node->prefix_length;
+		if (depth == length) {
+			leaf = ck_pr_load_ptr(&node->leaf);
+			if (leaf == NULL)
+				return NULL;
+
+			break;
+		}
+
+		slot = ck_art_node_find(node, k[depth++]);
+		if (slot == NULL)
+			return NULL;
+
+		p = ck_pr_load_ptr(slot);
+	}
+
+	if (ck_art_leaf_compare(leaf, k, length) != 0)
+		return NULL;
+
+	return CK_CC_DECONST_PTR(ck_pr_load_ptr(&leaf->entry));
+}
+
+static struct ck_art_leaf *
+ck_art_minimum(void *p)
+{
+	struct ck_art_node *node;
+	struct ck_art_leaf *leaf;
+	void *child;
+	int byte;
+
+	if (p == NULL)
+		return NULL;
+
+	if (ck_art_leaf_tagged(p) == true)
+		return ck_art_leaf_untag(p);
+
+	node = p;
+	leaf = ck_pr_load_ptr(&node->leaf);
+	if (leaf != NULL)
+		return leaf;
+
+	for (byte = -1; (byte = ck_art_node_next(node, byte, &child)) >= 0;) {
+		leaf = ck_art_minimum(child);
+		if (leaf != NULL)
+			return leaf;
+	}
+
+	return NULL;
+}
+
+/*
+ * Returns the first leaf whose key follows the given key, or is equal to
+ * it if inclusive is set.
+ */
+static struct ck_art_leaf *
+ck_art_seek(void *p,
+    const unsigned char *key,
+    unsigned int length,
+    unsigned int depth,
+    bool inclusive)
+{
+	const unsigned char *prefix;
+	struct ck_art_node *node;
+	struct ck_art_leaf *leaf;
+	unsigned int i;
+	void **slot, *child;
+	int byte, r;
+
+	if (p == NULL)
+		return NULL;
+
+	if (ck_art_leaf_tagged(p) == true) {
+		leaf = ck_art_leaf_untag(p);
+		r = ck_art_leaf_compare(leaf, key, length);
+		return (r > 0 || (r == 0 && inclusive == true)) ? leaf : NULL;
+	}
+
+	node = p;
+	prefix = ck_art_node_prefix(node);
+	for (i = 0; i < node->prefix_length; i++) {
+		/* Every key below the node follows the key. */
+		if (depth + i == length || prefix[i] > key[depth + i])
+			return ck_art_minimum(node);
+
+		if (prefix[i] < key[depth + i])
+			return NULL;
+	}
+
+	depth += node->prefix_length;
+	if (depth == length) {
+		if (inclusive == true) {
+			leaf = ck_pr_load_ptr(&node->leaf);
+			if (leaf != NULL)
+				return leaf;
+		}
+
+		byte = -1;
+	} else {
+		byte = key[depth];
+		slot = ck_art_node_find(node, key[depth]);
+		if (slot != NULL) {
+			leaf = ck_art_seek(ck_pr_load_ptr(slot), key, length,
+			    depth + 1, inclusive);
+			if (leaf != NULL)
+				return leaf;
+		}
+	}
+
+	while ((byte = ck_art_node_next(node, byte, &child)) >= 0) {
+		leaf = ck_art_minimum(child);
+		if (leaf != NULL)
+			return leaf;
+	}
+
+	return NULL;
+}
+
+void
+ck_art_iterator_init(struct ck_art_iterator *iterator)
+{
+
+	iterator->key = NULL;
+	iterator->length = 0;
+	iterator->inclusive = true;
+	iterator->prefix = NULL;
+	iterator->prefix_length = 0;
+	return;
+}
+
+void
+ck_art_lower_bound(struct ck_art *art,
+    struct ck_art_iterator *iterator,
+    const void *key,
+    unsigned int length)
+{
+
+	(void)art;
+
+	ck_art_iterator_init(iterator);
+	iterator->key = key;
+	iterator->length = length;
+	return;
+}
+
+void
+ck_art_prefix(struct ck_art *art,
+    struct ck_art_iterator *iterator,
+    const void *prefix,
+    unsigned int length)
+{
+
+	ck_art_lower_bound(art, iterator, prefix, length);
+	iterator->prefix = prefix;
+	iterator->prefix_length = length;
+	return;
+}
+
+/*
+ * Every step searches for the successor of the last key returned, so an
+ * iterator is unaffected by nodes that the writer replaces in between.
+ */
+bool
+ck_art_next(struct ck_art *art, struct ck_art_iterator *iterator, void **entry)
+{
+	struct ck_art_leaf *leaf;
+
+	leaf = ck_art_seek(ck_pr_load_ptr(&art->root), iterator->key,
+	    iterator->length, 0, iterator->inclusive);
+	if (leaf == NULL)
+		return false;
+
+	if (iterator->prefix_length > 0 &&
+	    (leaf->length < iterator->prefix_length ||
+	     memcmp(leaf->key, iterator->prefix, iterator->prefix_length) != 0))
+		return false;
+
+	iterator->key = leaf->key;
+	iterator->length = leaf->length;
+	iterator->inclusive = false;
+	*entry = CK_CC_DECONST_PTR(ck_pr_load_ptr(&leaf->entry));
+	return true;
+}
+
+unsigned int
+ck_art_count(struct ck_art *art)
+{
+
+	return ck_pr_load_uint(&art->n_entries);
+}
+
+static void
+ck_art_free(struct ck_art *art, void *p)
+{
+	struct ck_art_node *node;
+	void *child;
+	int byte;
+
+	if (p == NULL)
+		return;
+
+	if (ck_art_leaf_tagged(p) == true) {
+		ck_art_leaf_destroy(art, ck_art_leaf_untag(p), false);
+		return;
+	}
+
+	node = p;
+	if (node->leaf != NULL)
+		ck_art_leaf_destroy(art, node->leaf, false);
+
+	for (byte = -1; (byte = ck_art_node_next(node, byte, &child)) >= 0;)
+		ck_art_free(art, child);
+
+	ck_art_node_destroy(art, node, false);
+	return;
+}
+
+void
+ck_art_destroy(struct ck_art *art)
+{
+
+	ck_art_free(art, art->root);
+	art->root = NULL;
+	art->n_entries = 0;
+	return;
+}
+
+bool
+ck_art_init(struct ck_art *art, struct ck_malloc *m)
+{
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL)
+		return false;
+
+	art->m = m;
+	art->root = NULL;
+	art->n_entries = 0;
+	return true;
+}
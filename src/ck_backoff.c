@@ -0,0 +1,84 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_backoff.h>
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+#include <time.h>
+
+/*
+ * Number of ck_pr_stall operations timed per calibration round, and the
+ * number of rounds. The fastest round is used, as slower rounds are the
+ * result of preemption or interrupts.
+ */
+#define CK_BACKOFF_CALIBRATE_STALLS 4096
+#define CK_BACKOFF_CALIBRATE_ROUNDS 8
+
+unsigned int ck_backoff_ns_scale = CK_BACKOFF_NS_SCALE_DEFAULT;
+
+bool
+ck_backoff_ns_calibrate(void)
+{
+#ifdef CLOCK_MONOTONIC
+	struct timespec start, end;
+	uint64_t elapsed, best = UINT64_MAX;
+	unsigned int i, j;
+
+	for (i = 0; i < CK_BACKOFF_CALIBRATE_ROUNDS; i++) {
+		if (clock_gettime(CLOCK_MONOTONIC, &start) != 0)
+			return false;
+
+		for (j = 0; j < CK_BACKOFF_CALIBRATE_STALLS; j++)
+			ck_pr_stall();
+
+		if (clock_gettime(CLOCK_MONOTONIC, &end) != 0)
+			return false;
+
+		elapsed = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000000ULL +
+		    (uint64_t)end.tv_nsec - (uint64_t)start.tv_nsec;
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	if (best == 0)
+		best = 1;
+
+	best = ((uint64_t)CK_BACKOFF_CALIBRATE_STALLS <<
+	    CK_BACKOFF_NS_SCALE_SHIFT) / best;
+	if (best == 0)
+		best = 1;
+	else if (best > UINT32_MAX)
+		best = UINT32_MAX;
+
+	ck_pr_store_uint(&ck_backoff_ns_scale, (unsigned int)best);
+	return true;
+#else
+	return false;
+#endif
+}
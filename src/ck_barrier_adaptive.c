@@ -0,0 +1,485 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_barrier_adaptive.h>
+#include <ck_cc.h>
+#include <ck_ec.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+#include <time.h>
+
+/*
+ * A centralized barrier is hard to beat for a handful of threads that
+ * share a cache.
+ */
+#define CK_BARRIER_ADAPTIVE_SMALL	4
+
+/*
+ * Every period, the first subscriber times a window of episodes with
+ * the current algorithm, and the following window with a candidate.
+ * The period and the window must be powers of two.
+ */
+#define CK_BARRIER_ADAPTIVE_PERIOD	4096
+#define CK_BARRIER_ADAPTIVE_WINDOW	64
+
+/* Number of candidates for spinning episodes. */
+#define CK_BARRIER_ADAPTIVE_SPINNING	CK_BARRIER_ADAPTIVE_BLOCKING
+
+/*
+ * Returns the next spinning candidate after the current probe, or the
+ * current algorithm if there is no other.
+ */
+static unsigned int
+ck_barrier_adaptive_next_probe(const struct ck_barrier_adaptive *barrier)
+{
+	const struct ck_barrier_adaptive_policy *policy = &barrier->policy;
+	unsigned int i, probe = policy->probe;
+
+	for (i = 0; i < CK_BARRIER_ADAPTIVE_SPINNING; i++) {
+		probe = (probe + 1) % CK_BARRIER_ADAPTIVE_SPINNING;
+		if (probe != policy->current &&
+		    (barrier->available & (1U << probe)) != 0)
+			return probe;
+	}
+
+	return policy->current;
+}
+
+/*
+ * Returns the algorithm of the given episode. Only called by the first
+ * subscriber, one episode in advance.
+ */
+static unsigned int
+ck_barrier_adaptive_schedule(struct ck_barrier_adaptive *barrier,
+    unsigned int episode)
+{
+	struct ck_barrier_adaptive_policy *policy = &barrier->policy;
+	unsigned int fixed = ck_pr_load_uint(&barrier->fixed);
+	unsigned int phase = episode & (CK_BARRIER_ADAPTIVE_PERIOD - 1);
+
+	if (fixed != CK_BARRIER_ADAPTIVE_AUTO) {
+		if (policy->current != fixed) {
+			ck_pr_store_uint(&policy->current, fixed);
+			policy->probe = ck_barrier_adaptive_next_probe(barrier);
+		}
+
+		return fixed;
+	}
+
+	if (policy->adapt == true && policy->probe != policy->current &&
+	    phase >= CK_BARRIER_ADAPTIVE_WINDOW &&
+	    phase < CK_BARRIER_ADAPTIVE_WINDOW * 2)
+		return policy->probe;
+
+	return policy->current;
+}
+
+CK_CC_INLINE static bool
+ck_barrier_adaptive_timed(const struct ck_barrier_adaptive *barrier,
+    unsigned int episode)
+{
+	const struct ck_barrier_adaptive_policy *policy = &barrier->policy;
+	unsigned int phase = episode & (CK_BARRIER_ADAPTIVE_PERIOD - 1);
+
+	return policy->adapt == true && policy->probe != policy->current &&
+	    phase < CK_BARRIER_ADAPTIVE_WINDOW * 2 &&
+	    ck_pr_load_uint(&barrier->fixed) == CK_BARRIER_ADAPTIVE_AUTO;
+}
+
+static void
+ck_barrier_adaptive_record(struct ck_barrier_adaptive *barrier,
+    unsigned int episode,
+    unsigned int algorithm,
+    uint64_t ns)
+{
+	struct ck_barrier_adaptive_policy *policy = &barrier->policy;
+	unsigned int phase = episode & (CK_BARRIER_ADAPTIVE_PERIOD - 1);
+	uint64_t current, probe;
+
+	if (phase < CK_BARRIER_ADAPTIVE_WINDOW) {
+		if (algorithm == policy->current) {
+			policy->latency[0] += ns;
+			policy->samples[0]++;
+		}
+
+		return;
+	}
+
+	if (algorithm == policy->probe) {
+		policy->latency[1] += ns;
+		policy->samples[1]++;
+	}
+
+	if (phase != CK_BARRIER_ADAPTIVE_WINDOW * 2 - 1)
+		return;
+
+	/*
+	 * Compare the mean latencies of both windows, and only switch if
+	 * the candidate is faster by more than an eighth, so that noise
+	 * does not make the barrier flip-flop.
+	 */
+	if (policy->samples[0] != 0 && policy->samples[1] != 0) {
+		current = policy->latency[0] * policy->samples[1];
+		probe = policy->latency[1] * policy->samples[0];
+		if (probe + (probe >> 3) < current)
+			ck_pr_store_uint(&policy->current, policy->probe);
+	}
+
+	policy->probe = ck_barrier_adaptive_next_probe(barrier);
+	policy->latency[0] = policy->latency[1] = 0;
+	policy->samples[0] = policy->samples[1] = 0;
+	return;
+}
+
+/*
+ * Sense-reversing counter whose waiters sleep on an event count. The
+ * generation is read before arriving, so the last thread cannot bump
+ * it before a waiter has taken its snapshot.
+ */
+static void
+ck_barrier_adaptive_blocking(struct ck_barrier_adaptive *barrier)
+{
+	struct ck_barrier_adaptive_blocking *blocking = &barrier->blocking;
+	uint32_t generation = ck_ec32_value(&blocking->generation);
+
+	if (ck_pr_faa_uint(&blocking->value, 1) == barrier->nthr - 1) {
+		ck_pr_store_uint(&blocking->value, 0);
+		ck_ec32_inc(&blocking->generation, barrier->mode);
+		return;
+	}
+
+	ck_ec32_wait(&blocking->generation, barrier->mode, generation, NULL);
+	return;
+}
+
+static void
+ck_barrier_adaptive_free(struct ck_barrier_adaptive *barrier)
+{
+	struct ck_malloc *m = barrier->allocator;
+	unsigned int nthr = barrier->nthr;
+	unsigned int dsize = ck_barrier_dissemination_size(nthr);
+	unsigned int tsize = ck_barrier_tournament_size(nthr);
+
+	if (dsize == 0)
+		dsize = 1;
+
+	if (barrier->groups != NULL) {
+		m->free(barrier->groups, sizeof(struct ck_barrier_combining_group) *
+		    (barrier->n_groups + 1), false);
+	}
+
+	if (barrier->dissemination != NULL) {
+		m->free(barrier->dissemination,
+		    sizeof(struct ck_barrier_dissemination) * nthr, false);
+	}
+
+	if (barrier->flags != NULL) {
+		if (barrier->flags[0] != NULL) {
+			m->free(barrier->flags[0],
+			    sizeof(struct ck_barrier_dissemination_flag) *
+			    dsize * nthr, false);
+		}
+
+		m->free(barrier->flags,
+		    sizeof(struct ck_barrier_dissemination_flag *) * nthr, false);
+	}
+
+	if (barrier->rounds != NULL) {
+		if (barrier->rounds[0] != NULL) {
+			m->free(barrier->rounds[0],
+			    sizeof(struct ck_barrier_tournament_round) *
+			    tsize * nthr, false);
+		}
+
+		m->free(barrier->rounds,
+		    sizeof(struct ck_barrier_tournament_round *) * nthr, false);
+	}
+
+	if (barrier->mcs != NULL)
+		m->free(barrier->mcs, sizeof(struct ck_barrier_mcs) * nthr, false);
+
+	return;
+}
+
+static bool
+ck_barrier_adaptive_allocate(struct ck_barrier_adaptive *barrier)
+{
+	struct ck_malloc *m = barrier->allocator;
+	struct ck_barrier_dissemination_flag *flags;
+	struct ck_barrier_tournament_round *rounds;
+	unsigned int nthr = barrier->nthr;
+	unsigned int dsize = ck_barrier_dissemination_size(nthr);
+	unsigned int tsize = ck_barrier_tournament_size(nthr);
+	unsigned int i;
+
+	/* A single thread needs no dissemination rounds. */
+	if (dsize == 0)
+		dsize = 1;
+
+	barrier->groups = m->malloc(sizeof(struct ck_barrier_combining_group) *
+	    (barrier->n_groups + 1));
+	barrier->dissemination = m->malloc(
+	    sizeof(struct ck_barrier_dissemination) * nthr);
+	barrier->flags = m->malloc(
+	    sizeof(struct ck_barrier_dissemination_flag *) * nthr);
+	barrier->rounds = m->malloc(
+	    sizeof(struct ck_barrier_tournament_round *) * nthr);
+	barrier->mcs = m->malloc(sizeof(struct ck_barrier_mcs) * nthr);
+
+	if (barrier->flags != NULL) {
+		barrier->flags[0] = NULL;
+		flags = m->malloc(sizeof(struct ck_barrier_dissemination_flag) *
+		    dsize * nthr);
+		if (flags != NULL) {
+			for (i = 0; i < nthr; i++)
+				barrier->flags[i] = flags + i * dsize;
+		}
+	}
+
+	if (barrier->rounds != NULL) {
+		barrier->rounds[0] = NULL;
+		rounds = m->malloc(sizeof(struct ck_barrier_tournament_round) *
+		    tsize * nthr);
+		if (rounds != NULL) {
+			for (i = 0; i < nthr; i++)
+				barrier->rounds[i] = rounds + i * tsize;
+		}
+	}
+
+	if (barrier->groups == NULL || barrier->dissemination == NULL ||
+	    barrier->flags == NULL || barrier->flags[0] == NULL ||
+	    barrier->rounds == NULL || barrier->rounds[0] == NULL ||
+	    barrier->mcs == NULL) {
+		ck_barrier_adaptive_free(barrier);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Initial choice: block when oversubscribed, centralized for a few
+ * threads, a combining tree that mirrors the cache domains when there
+ * are several, and a tournament otherwise.
+ */
+static unsigned int
+ck_barrier_adaptive_select(const struct ck_barrier_adaptive *barrier,
+    unsigned int n_cpus)
+{
+
+	if (barrier->mode != NULL && n_cpus != 0 && barrier->nthr > n_cpus)
+		return CK_BARRIER_ADAPTIVE_BLOCKING;
+
+	if (barrier->nthr <= CK_BARRIER_ADAPTIVE_SMALL)
+		return CK_BARRIER_ADAPTIVE_CENTRALIZED;
+
+	if (barrier->n_groups > 1)
+		return CK_BARRIER_ADAPTIVE_COMBINING;
+
+	return CK_BARRIER_ADAPTIVE_TOURNAMENT;
+}
+
+bool
+ck_barrier_adaptive_init(struct ck_barrier_adaptive *barrier,
+    struct ck_malloc *m,
+    unsigned int nthr,
+    unsigned int n_cpus,
+    unsigned int cluster,
+    const struct ck_ec_mode *mode)
+{
+	struct ck_barrier_adaptive_policy *policy = &barrier->policy;
+	unsigned int g, k, algorithm;
+
+	if (nthr == 0 || m == NULL || m->malloc == NULL || m->free == NULL)
+		return false;
+
+	if (cluster == 0 || cluster > nthr)
+		cluster = nthr;
+
+	barrier->allocator = m;
+	barrier->mode = mode;
+	barrier->nthr = nthr;
+	barrier->cluster = cluster;
+	barrier->n_groups = (nthr + cluster - 1) / cluster;
+	barrier->tid = 0;
+	if (ck_barrier_adaptive_allocate(barrier) == false)
+		return false;
+
+	barrier->centralized.value = 0;
+	barrier->centralized.sense = 0;
+
+	/* One combining group per cache domain, below a common root. */
+	ck_barrier_combining_init(&barrier->combining, &barrier->groups[0]);
+	for (g = 0; g < barrier->n_groups; g++) {
+		k = nthr - g * cluster;
+		if (k > cluster)
+			k = cluster;
+
+		ck_barrier_combining_group_init(&barrier->combining,
+		    &barrier->groups[g + 1], k);
+	}
+
+	ck_barrier_dissemination_init(barrier->dissemination, barrier->flags,
+	    nthr);
+	ck_barrier_tournament_init(&barrier->tournament, barrier->rounds, nthr);
+	ck_barrier_mcs_init(barrier->mcs, nthr);
+
+	barrier->blocking.value = 0;
+	ck_ec32_init(&barrier->blocking.generation, 0);
+
+	barrier->available = (1U << CK_BARRIER_ADAPTIVE_CENTRALIZED) |
+	    (1U << CK_BARRIER_ADAPTIVE_DISSEMINATION) |
+	    (1U << CK_BARRIER_ADAPTIVE_TOURNAMENT) |
+	    (1U << CK_BARRIER_ADAPTIVE_MCS);
+	if (barrier->n_groups > 1)
+		barrier->available |= 1U << CK_BARRIER_ADAPTIVE_COMBINING;
+
+	if (mode != NULL)
+		barrier->available |= 1U << CK_BARRIER_ADAPTIVE_BLOCKING;
+
+	algorithm = ck_barrier_adaptive_select(barrier, n_cpus);
+	policy->current = policy->probe = algorithm;
+	policy->probe = ck_barrier_adaptive_next_probe(barrier);
+
+	/* Spinning among oversubscribed threads is never a win. */
+	policy->adapt = algorithm != CK_BARRIER_ADAPTIVE_BLOCKING;
+	policy->latency[0] = policy->latency[1] = 0;
+	policy->samples[0] = policy->samples[1] = 0;
+
+	barrier->algorithm[0] = barrier->algorithm[1] = algorithm;
+	barrier->fixed = CK_BARRIER_ADAPTIVE_AUTO;
+	ck_pr_fence_store();
+	return true;
+}
+
+void
+ck_barrier_adaptive_destroy(struct ck_barrier_adaptive *barrier)
+{
+
+	ck_barrier_adaptive_free(barrier);
+	return;
+}
+
+void
+ck_barrier_adaptive_subscribe(struct ck_barrier_adaptive *barrier,
+    struct ck_barrier_adaptive_state *state)
+{
+
+	state->tid = ck_pr_faa_uint(&barrier->tid, 1);
+	state->episode = 0;
+	state->centralized.sense = 0;
+	state->group = &barrier->groups[1 + state->tid / barrier->cluster];
+	state->combining.sense = ~0U;
+	ck_barrier_dissemination_subscribe(barrier->dissemination,
+	    &state->dissemination);
+	ck_barrier_tournament_subscribe(&barrier->tournament,
+	    &state->tournament);
+	ck_barrier_mcs_subscribe(barrier->mcs, &state->mcs);
+	return;
+}
+
+bool
+ck_barrier_adaptive_set(struct ck_barrier_adaptive *barrier,
+    enum ck_barrier_adaptive_algorithm algorithm)
+{
+
+	if (algorithm != CK_BARRIER_ADAPTIVE_AUTO &&
+	    (barrier->available & (1U << algorithm)) == 0)
+		return false;
+
+	ck_pr_store_uint(&barrier->fixed, algorithm);
+	return true;
+}
+
+enum ck_barrier_adaptive_algorithm
+ck_barrier_adaptive_algorithm(const struct ck_barrier_adaptive *barrier)
+{
+
+	return ck_pr_load_uint(&barrier->policy.current);
+}
+
+void
+ck_barrier_adaptive(struct ck_barrier_adaptive *barrier,
+    struct ck_barrier_adaptive_state *state)
+{
+	const unsigned int episode = state->episode++;
+	unsigned int algorithm;
+	struct timespec begin, end;
+	bool timed = false;
+
+	/*
+	 * Episodes alternate between two algorithm slots. The first
+	 * subscriber fills the slot of the next episode before arriving
+	 * at this one, and nobody reads that slot before departing from
+	 * this episode; the slot of this episode is not rewritten until
+	 * every thread has arrived at the next one.
+	 */
+	algorithm = ck_pr_load_uint(&barrier->algorithm[episode & 1]);
+	if (state->tid == 0) {
+		ck_pr_store_uint(&barrier->algorithm[(episode + 1) & 1],
+		    ck_barrier_adaptive_schedule(barrier, episode + 1));
+		ck_pr_fence_store();
+
+		timed = ck_barrier_adaptive_timed(barrier, episode);
+		if (timed == true && clock_gettime(CLOCK_MONOTONIC, &begin) != 0)
+			timed = false;
+	}
+
+	switch (algorithm) {
+	case CK_BARRIER_ADAPTIVE_CENTRALIZED:
+		ck_barrier_centralized(&barrier->centralized,
+		    &state->centralized, barrier->nthr);
+		break;
+	case CK_BARRIER_ADAPTIVE_COMBINING:
+		ck_barrier_combining(&barrier->combining, state->group,
+		    &state->combining);
+		break;
+	case CK_BARRIER_ADAPTIVE_DISSEMINATION:
+		ck_barrier_dissemination(barrier->dissemination,
+		    &state->dissemination);
+		break;
+	case CK_BARRIER_ADAPTIVE_TOURNAMENT:
+		ck_barrier_tournament(&barrier->tournament, &state->tournament);
+		break;
+	case CK_BARRIER_ADAPTIVE_MCS:
+		ck_barrier_mcs(barrier->mcs, &state->mcs);
+		break;
+	case CK_BARRIER_ADAPTIVE_BLOCKING:
+		ck_barrier_adaptive_blocking(barrier);
+		break;
+	}
+
+	if (timed == true && clock_gettime(CLOCK_MONOTONIC, &end) == 0) {
+		ck_barrier_adaptive_record(barrier, episode, algorithm,
+		    (uint64_t)(end.tv_sec - begin.tv_sec) * 1000000000ULL +
+		    (uint64_t)end.tv_nsec - (uint64_t)begin.tv_nsec);
+	}
+
+	return;
+}
@@ -26,6 +26,7 @@
  */
 
 #include <ck_barrier.h>
+#include <ck_barrier_reduce.h>
 #include <ck_cc.h>
 #include <ck_pr.h>
 #include <ck_spinlock.h>
@@ -103,6 +104,8 @@ ck_barrier_combining_group_init(struct ck_barrier_combining *root,
 	tnode->k = nthr;
 	tnode->count = 0;
 	tnode->sense = 0;
+	tnode->value = (root->reduce != NULL) ? root->reduce->identity : 0;
+	tnode->result = 0;
 	tnode->left = tnode->right = NULL;
 
 	/*
@@ -148,9 +151,11 @@ ck_barrier_combining_init(struct ck_barrier_combining *root,
 	init_root->k = 0;
 	init_root->count = 0;
 	init_root->sense = 0;
+	init_root->value = init_root->result = 0;
 	init_root->parent = init_root->left = init_root->right = NULL;
 	ck_spinlock_fas_init(&root->mutex);
 	root->root = init_root;
+	root->reduce = NULL;
 	return;
 }
 
@@ -205,3 +210,94 @@ ck_barrier_combining(struct ck_barrier_combining *barrier,
 	state->sense = ~state->sense;
 	return;
 }
+
+#ifdef CK_F_BARRIER_REDUCE
+static void
+ck_barrier_combining_reduce_reset(struct ck_barrier_combining_group *tnode,
+    uint64_t identity)
+{
+
+	if (tnode == NULL)
+		return;
+
+	tnode->value = identity;
+	ck_barrier_combining_reduce_reset(tnode->left, identity);
+	ck_barrier_combining_reduce_reset(tnode->right, identity);
+	return;
+}
+
+void
+ck_barrier_combining_reduce_init(struct ck_barrier_combining *barrier,
+    const struct ck_barrier_reduce *reduce)
+{
+
+	ck_spinlock_fas_lock(&barrier->mutex);
+	barrier->reduce = reduce;
+	ck_barrier_combining_reduce_reset(barrier->root, reduce->identity);
+	ck_spinlock_fas_unlock(&barrier->mutex);
+	return;
+}
+
+static uint64_t
+ck_barrier_combining_reduce_aux(struct ck_barrier_combining *barrier,
+    struct ck_barrier_combining_group *tnode,
+    unsigned int sense,
+    uint64_t value)
+{
+	const struct ck_barrier_reduce *reduce = barrier->reduce;
+	uint64_t snapshot;
+
+	/*
+	 * Fold our value into the group before arriving, so that the last
+	 * thread to arrive finds every contribution.
+	 */
+	snapshot = ck_pr_load_64(&tnode->value);
+	while (ck_pr_cas_64_value(&tnode->value, snapshot,
+	    reduce->op(snapshot, value), &snapshot) == false)
+		ck_pr_stall();
+
+	if (ck_pr_faa_uint(&tnode->count, 1) == tnode->k - 1) {
+		/*
+		 * The group's total moves up the tree, and the group is
+		 * reset for the next episode before anyone is released.
+		 */
+		ck_pr_fence_atomic_load();
+		value = ck_pr_load_64(&tnode->value);
+		ck_pr_store_64(&tnode->value, reduce->identity);
+
+		if (tnode->parent != NULL) {
+			value = ck_barrier_combining_reduce_aux(barrier,
+			    tnode->parent, sense, value);
+		}
+
+		ck_pr_store_64(&tnode->result, value);
+		ck_pr_store_uint(&tnode->count, 0);
+		ck_pr_fence_store();
+		ck_pr_store_uint(&tnode->sense, ~tnode->sense);
+	} else {
+		while (sense != ck_pr_load_uint(&tnode->sense))
+			ck_pr_stall();
+
+		ck_pr_fence_load();
+		value = ck_pr_load_64(&tnode->result);
+	}
+
+	ck_pr_fence_memory();
+	return value;
+}
+
+uint64_t
+ck_barrier_combining_reduce(struct ck_barrier_combining *barrier,
+    struct ck_barrier_combining_group *tnode,
+    struct ck_barrier_combining_state *state,
+    uint64_t value)
+{
+
+	value = ck_barrier_combining_reduce_aux(barrier, tnode, state->sense,
+	    value);
+
+	/* Reverse the execution context's sense for the next barrier. */
+	state->sense = ~state->sense;
+	return value;
+}
+#endif /* CK_F_BARRIER_REDUCE */
@@ -26,6 +26,7 @@
  */
 
 #include <ck_barrier.h>
+#include <ck_barrier_reduce.h>
 #include <ck_pr.h>
 
 #include "ck_internal.h"
@@ -69,9 +70,11 @@ ck_barrier_tournament_init(struct ck_barrier_tournament *barrier,
 	for (i = 0; i < nthr; ++i) {
 		/* The first role is always CK_BARRIER_TOURNAMENT_DROPOUT. */
 		rounds[i][0].flag = 0;
+		rounds[i][0].value = 0;
 		rounds[i][0].role = CK_BARRIER_TOURNAMENT_DROPOUT;
 		for (k = 1, twok = 2, twokm1 = 1; k < size; ++k, twokm1 = twok, twok <<= 1) {
 			rounds[i][k].flag = 0;
+			rounds[i][k].value = 0;
 
 			imod2k = i & (twok - 1);
 			if (imod2k == 0) {
@@ -182,3 +185,94 @@ leave:
 	state->sense = ~state->sense;
 	return;
 }
+
+#ifdef CK_F_BARRIER_REDUCE
+uint64_t
+ck_barrier_tournament_reduce(struct ck_barrier_tournament *barrier,
+    struct ck_barrier_tournament_state *state,
+    uint64_t value,
+    const struct ck_barrier_reduce *reduce)
+{
+	struct ck_barrier_tournament_round **rounds = ck_pr_load_ptr(&barrier->rounds);
+	unsigned int vpid = state->vpid;
+	int round = 1;
+
+	if (barrier->size == 1)
+		return value;
+
+	/*
+	 * The opponent of a round-k loser is the winner 2^(k-1) threads
+	 * below it, and vice versa. A partial result is written to the
+	 * round of the thread that reads it before that thread's flag is
+	 * set, and is only read once the flag has been observed.
+	 */
+	for (;; ++round) {
+		switch (rounds[vpid][round].role) {
+		case CK_BARRIER_TOURNAMENT_BYE:
+			break;
+		case CK_BARRIER_TOURNAMENT_CHAMPION:
+			while (ck_pr_load_uint(&rounds[vpid][round].flag) != state->sense)
+				ck_pr_stall();
+
+			ck_pr_fence_load();
+			value = reduce->op(value,
+			    ck_pr_load_64(&rounds[vpid][round].value));
+			ck_pr_store_64(&rounds[vpid + (1U << (round - 1))][round].value,
+			    value);
+			ck_pr_fence_store();
+			ck_pr_store_uint(rounds[vpid][round].opponent, state->sense);
+			goto wakeup;
+		case CK_BARRIER_TOURNAMENT_DROPOUT:
+			/* NOTREACHED */
+			break;
+		case CK_BARRIER_TOURNAMENT_LOSER:
+			ck_pr_store_64(&rounds[vpid - (1U << (round - 1))][round].value,
+			    value);
+			ck_pr_fence_store();
+			ck_pr_store_uint(rounds[vpid][round].opponent, state->sense);
+			while (ck_pr_load_uint(&rounds[vpid][round].flag) != state->sense)
+				ck_pr_stall();
+
+			ck_pr_fence_load();
+			value = ck_pr_load_64(&rounds[vpid][round].value);
+			goto wakeup;
+		case CK_BARRIER_TOURNAMENT_WINNER:
+			while (ck_pr_load_uint(&rounds[vpid][round].flag) != state->sense)
+				ck_pr_stall();
+
+			ck_pr_fence_load();
+			value = reduce->op(value,
+			    ck_pr_load_64(&rounds[vpid][round].value));
+			break;
+		}
+	}
+
+wakeup:
+	for (round -= 1 ;; --round) {
+		switch (rounds[vpid][round].role) {
+		case CK_BARRIER_TOURNAMENT_BYE:
+			break;
+		case CK_BARRIER_TOURNAMENT_CHAMPION:
+			/* NOTREACHED */
+			break;
+		case CK_BARRIER_TOURNAMENT_DROPOUT:
+			goto leave;
+			break;
+		case CK_BARRIER_TOURNAMENT_LOSER:
+			/* NOTREACHED */
+			break;
+		case CK_BARRIER_TOURNAMENT_WINNER:
+			ck_pr_store_64(&rounds[vpid + (1U << (round - 1))][round].value,
+			    value);
+			ck_pr_fence_store();
+			ck_pr_store_uint(rounds[vpid][round].opponent, state->sense);
+			break;
+		}
+	}
+
+leave:
+	ck_pr_fence_memory();
+	state->sense = ~state->sense;
+	return value;
+}
+#endif /* CK_F_BARRIER_REDUCE */
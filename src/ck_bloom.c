@@ -0,0 +1,196 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_bloom.h>
+#include <ck_cc.h>
+#include <ck_limits.h>
+#include <ck_malloc.h>
+#include <ck_md.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+#include <ck_string.h>
+
+#ifdef CK_F_BLOOM
+
+#define CK_BLOOM_LN2		0.69314718055994530942
+#define CK_BLOOM_BYTES		(CK_BLOOM_BLOCK * sizeof(uint64_t))
+
+/*
+ * Number of keys ahead of the current one whose blocks are prefetched
+ * by batch queries.
+ */
+#define CK_BLOOM_PREFETCH	8
+
+/*
+ * Keys are not spread evenly over blocks, so a blocked filter has a
+ * higher false positive rate than a classic one of the same size. The
+ * classic size is grown by this fraction (in eighths) to compensate.
+ */
+#define CK_BLOOM_SLACK		1
+
+/*
+ * Natural logarithm of x in (0, 1], without relying on libm.
+ */
+static double
+ck_bloom_ln(double x)
+{
+	double y, y2, term, sum = 0;
+	unsigned int i;
+	int e = 0;
+
+	while (x < 0.5) {
+		x *= 2;
+		e--;
+	}
+
+	/* ln(x) = 2 atanh((x - 1) / (x + 1)), with |y| <= 1/3. */
+	y = (x - 1) / (x + 1);
+	y2 = y * y;
+	term = y;
+	for (i = 1; i < 64; i += 2) {
+		sum += term / i;
+		term *= y2;
+	}
+
+	return 2 * sum + e * CK_BLOOM_LN2;
+}
+
+/*
+ * Sizes the filter for the expected number of keys and the target
+ * false positive rate, using the classic optimum of
+ * -n ln(p) / ln(2)^2 probes and ln(2) m / n probes per key.
+ */
+bool
+ck_bloom_init(struct ck_bloom *bloom, unsigned int mode, struct ck_malloc *m,
+    unsigned long capacity, double rate)
+{
+	double probes, per_block;
+	uint64_t n_blocks;
+	unsigned int k;
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL)
+		return false;
+
+	if (capacity == 0 || !(rate > 0 && rate < 1))
+		return false;
+
+	probes = (double)capacity * -ck_bloom_ln(rate) /
+	    (CK_BLOOM_LN2 * CK_BLOOM_LN2);
+	k = (unsigned int)(probes / capacity * CK_BLOOM_LN2 + 0.5);
+	if (k == 0)
+		k = 1;
+	else if (k > CK_BLOOM_PROBES)
+		k = CK_BLOOM_PROBES;
+
+	probes += probes * CK_BLOOM_SLACK / 8;
+
+	/* A block holds 512 bits or 128 4-bit counters. */
+	per_block = CK_BLOOM_BYTES * CHAR_BIT;
+	if (mode & CK_BLOOM_MODE_COUNTING)
+		per_block /= 4;
+
+	n_blocks = (uint64_t)(probes / per_block) + 1;
+	if (n_blocks > UINT32_MAX)
+		return false;
+
+	bloom->size = n_blocks * CK_BLOOM_BYTES + CK_MD_CACHELINE - 1;
+	bloom->allocation = m->malloc(bloom->size);
+	if (bloom->allocation == NULL)
+		return false;
+
+	bloom->map = (uint64_t *)(((uintptr_t)bloom->allocation +
+	    CK_MD_CACHELINE - 1) & ~(uintptr_t)(CK_MD_CACHELINE - 1));
+	memset(bloom->map, 0, n_blocks * CK_BLOOM_BYTES);
+	bloom->n_blocks = n_blocks;
+	bloom->k = k;
+	bloom->mode = mode;
+	bloom->m = m;
+	ck_pr_fence_store();
+	return true;
+}
+
+void
+ck_bloom_destroy(struct ck_bloom *bloom)
+{
+
+	bloom->m->free(bloom->allocation, bloom->size, false);
+	bloom->allocation = NULL;
+	bloom->map = NULL;
+	return;
+}
+
+/*
+ * Removes every key from the filter. This is not a linearized operation
+ * with respect to concurrent insertions.
+ */
+void
+ck_bloom_clear(struct ck_bloom *bloom)
+{
+	size_t i, n = (size_t)bloom->n_blocks * CK_BLOOM_BLOCK;
+
+	for (i = 0; i < n; i++)
+		ck_pr_store_64(&bloom->map[i], 0);
+
+	return;
+}
+
+/*
+ * Returns the number of bytes used by the filter's blocks.
+ */
+size_t
+ck_bloom_size(const struct ck_bloom *bloom)
+{
+
+	return (size_t)bloom->n_blocks * CK_BLOOM_BYTES;
+}
+
+/*
+ * Queries n hashes, storing the result of each in the results array.
+ * Blocks are prefetched a few keys ahead, so that the cache misses of
+ * consecutive queries overlap.
+ */
+void
+ck_bloom_query_n(const struct ck_bloom *bloom, const uint64_t *hashes,
+    bool *results, unsigned int n)
+{
+	unsigned int i;
+
+	for (i = 0; i < n && i < CK_BLOOM_PREFETCH; i++)
+		ck_bloom_prefetch(bloom, hashes[i]);
+
+	for (i = 0; i < n; i++) {
+		if (i + CK_BLOOM_PREFETCH < n)
+			ck_bloom_prefetch(bloom, hashes[i + CK_BLOOM_PREFETCH]);
+
+		results[i] = ck_bloom_query(bloom, hashes[i]);
+	}
+
+	return;
+}
+
+#endif /* CK_F_BLOOM */
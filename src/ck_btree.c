@@ -0,0 +1,775 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_btree.h>
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_sequence.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+#include <ck_string.h>
+
+/*
+ * The sequence counter of a node is odd while a writer holds its latch. A
+ * writer latches a node by moving the counter from the even value it read
+ * optimistically to the next odd value, so it fails if the node changed
+ * since. Releasing the latch is ck_sequence_write_end, which invalidates
+ * every optimistic read that overlapped the update. A node removed from
+ * the tree is marked obsolete before it is released.
+ */
+struct ck_btree_node {
+	ck_sequence_t sequence;
+	uint16_t count;
+	uint8_t leaf;
+	uint8_t obsolete;
+};
+
+#define CK_BTREE_INNER							\
+	((CK_BTREE_NODE_SIZE - sizeof(struct ck_btree_node) -		\
+	    sizeof(void *)) / (sizeof(uint64_t) + sizeof(void *)))
+
+#define CK_BTREE_LEAF							\
+	((CK_BTREE_NODE_SIZE - sizeof(struct ck_btree_node) -		\
+	    sizeof(void *)) / (sizeof(uint64_t) + sizeof(void *)))
+
+/*
+ * The child at index i holds the keys from keys[i - 1] up to, but not
+ * including, keys[i].
+ */
+struct ck_btree_inner {
+	struct ck_btree_node header;
+	uint64_t keys[CK_BTREE_INNER];
+	struct ck_btree_node *children[CK_BTREE_INNER + 1];
+};
+
+struct ck_btree_leaf {
+	struct ck_btree_node header;
+	struct ck_btree_leaf *next;
+	uint64_t keys[CK_BTREE_LEAF];
+	const void *values[CK_BTREE_LEAF];
+};
+
+CK_CC_INLINE static unsigned int
+ck_btree_capacity(const struct ck_btree_node *node)
+{
+
+	return node->leaf != 0 ? CK_BTREE_LEAF : CK_BTREE_INNER;
+}
+
+/*
+ * An optimistic reader may observe a count that is later invalidated, so
+ * it is clamped to keep every access within the node.
+ */
+CK_CC_INLINE static unsigned int
+ck_btree_count(const struct ck_btree_node *node)
+{
+	unsigned int count = ck_pr_load_16(&node->count);
+	unsigned int capacity = ck_btree_capacity(node);
+
+	return count > capacity ? capacity : count;
+}
+
+CK_CC_INLINE static bool
+ck_btree_read(const struct ck_btree_node *node, unsigned int *version)
+{
+
+	*version = ck_sequence_read_begin(&node->sequence);
+	return ck_pr_load_8(&node->obsolete) == 0;
+}
+
+CK_CC_INLINE static bool
+ck_btree_valid(const struct ck_btree_node *node, unsigned int version)
+{
+
+	return ck_sequence_read_retry(&node->sequence, version) == false;
+}
+
+CK_CC_INLINE static bool
+ck_btree_latch(struct ck_btree_node *node, unsigned int version)
+{
+
+	if (ck_pr_cas_uint(&node->sequence.sequence, version, version + 1) == false)
+		return false;
+
+	ck_pr_fence_lock();
+	return true;
+}
+
+CK_CC_INLINE static bool
+ck_btree_trylatch(struct ck_btree_node *node)
+{
+	unsigned int version = ck_pr_load_uint(&node->sequence.sequence);
+
+	if ((version & 1) != 0)
+		return false;
+
+	return ck_btree_latch(node, version);
+}
+
+CK_CC_INLINE static void
+ck_btree_unlatch(struct ck_btree_node *node)
+{
+
+	ck_sequence_write_end(&node->sequence);
+	return;
+}
+
+CK_CC_INLINE static void
+ck_btree_unlatch_obsolete(struct ck_btree_node *node)
+{
+
+	ck_pr_store_8(&node->obsolete, 1);
+	ck_sequence_write_end(&node->sequence);
+	return;
+}
+
+CK_CC_INLINE static size_t
+ck_btree_node_size(bool leaf)
+{
+
+	return leaf == true ? sizeof(struct ck_btree_leaf) :
+	    sizeof(struct ck_btree_inner);
+}
+
+static struct ck_btree_node *
+ck_btree_node_create(struct ck_btree *tree, bool leaf)
+{
+	struct ck_btree_node *node;
+
+	node = tree->m->malloc(ck_btree_node_size(leaf));
+	if (node == NULL)
+		return NULL;
+
+	memset(node, 0, ck_btree_node_size(leaf));
+	node->leaf = leaf;
+	return node;
+}
+
+static void
+ck_btree_node_destroy(struct ck_btree *tree,
+    struct ck_btree_node *node,
+    bool defer)
+{
+
+	tree->m->free(node, ck_btree_node_size(node->leaf != 0), defer);
+	return;
+}
+
+/*
+ * Returns the index of the first key greater than the key if upper is
+ * set, or of the first key not less than it otherwise.
+ */
+static unsigned int
+ck_btree_search(const uint64_t *keys,
+    unsigned int count,
+    uint64_t key,
+    bool upper)
+{
+	unsigned int low = 0, high = count, middle;
+	uint64_t k;
+
+	while (low < high) {
+		middle = (low + high) >> 1;
+		k = ck_pr_load_64(&keys[middle]);
+		if (k < key || (upper == true && k == key)) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+static bool
+ck_btree_root(struct ck_btree *tree,
+    struct ck_btree_node **node,
+    unsigned int *version)
+{
+
+	*node = ck_pr_load_ptr(&tree->root);
+	if (ck_btree_read(*node, version) == false)
+		return false;
+
+	/* The root is only replaced while its latch is held. */
+	return ck_pr_load_ptr(&tree->root) == *node;
+}
+
+/*
+ * Steps from an inner node to the child covering the key. The child is
+ * only followed once the parent is validated, and the parent is validated
+ * again after the counter of the child is read, so the child cannot have
+ * been split or merged in between.
+ */
+static bool
+ck_btree_child(struct ck_btree_node *node,
+    unsigned int version,
+    uint64_t key,
+    struct ck_btree_node **child,
+    unsigned int *child_version,
+    unsigned int *position)
+{
+	struct ck_btree_inner *inner = (struct ck_btree_inner *)node;
+	unsigned int i;
+
+	i = ck_btree_search(inner->keys, ck_btree_count(node), key, true);
+	*child = ck_pr_load_ptr(&inner->children[i]);
+	if (ck_btree_valid(node, version) == false)
+		return false;
+
+	if (ck_btree_read(*child, child_version) == false)
+		return false;
+
+	*position = i;
+	return ck_btree_valid(node, version);
+}
+
+static struct ck_btree_leaf *
+ck_btree_find(struct ck_btree *tree, uint64_t key, unsigned int *version)
+{
+	struct ck_btree_node *node, *child;
+	unsigned int v, cv, position;
+
+retry:
+	if (ck_btree_root(tree, &node, &v) == false)
+		goto retry;
+
+	while (node->leaf == 0) {
+		if (ck_btree_child(node, v, key, &child, &cv, &position) == false)
+			goto retry;
+
+		node = child;
+		v = cv;
+	}
+
+	*version = v;
+	return (struct ck_btree_leaf *)node;
+}
+
+void *
+ck_btree_get(struct ck_btree *tree, uint64_t key)
+{
+	struct ck_btree_leaf *leaf;
+	unsigned int version, count, i;
+	const void *value;
+
+	for (;;) {
+		leaf = ck_btree_find(tree, key, &version);
+		count = ck_btree_count(&leaf->header);
+		i = ck_btree_search(leaf->keys, count, key, false);
+
+		value = NULL;
+		if (i < count && ck_pr_load_64(&leaf->keys[i]) == key)
+			value = ck_pr_load_ptr(&leaf->values[i]);
+
+		if (ck_btree_valid(&leaf->header, version) == true)
+			return CK_CC_DECONST_PTR(value);
+	}
+}
+
+/*
+ * Moves the upper half of a latched leaf into a new right sibling and
+ * returns the first key of the sibling.
+ */
+static uint64_t
+ck_btree_split_leaf(struct ck_btree_leaf *leaf, struct ck_btree_leaf *right)
+{
+	unsigned int count = leaf->header.count;
+	unsigned int middle = count / 2;
+	unsigned int i;
+
+	for (i = middle; i < count; i++) {
+		right->keys[i - middle] = leaf->keys[i];
+		right->values[i - middle] = leaf->values[i];
+	}
+
+	right->header.count = count - middle;
+	right->next = leaf->next;
+	ck_pr_store_release_ptr(&leaf->next, right);
+	ck_pr_store_16(&leaf->header.count, middle);
+	return right->keys[0];
+}
+
+/*
+ * Moves the keys and children above the median of a latched inner node
+ * into a new right sibling and returns the median.
+ */
+static uint64_t
+ck_btree_split_inner(struct ck_btree_inner *inner, struct ck_btree_inner *right)
+{
+	unsigned int count = inner->header.count;
+	unsigned int middle = count / 2;
+	unsigned int i;
+
+	for (i = middle + 1; i < count; i++)
+		right->keys[i - middle - 1] = inner->keys[i];
+
+	for (i = middle + 1; i <= count; i++)
+		right->children[i - middle - 1] = inner->children[i];
+
+	right->header.count = count - middle - 1;
+	ck_pr_store_16(&inner->header.count, middle);
+	return inner->keys[middle];
+}
+
+/*
+ * Inserts a separator and the child to its right into a latched inner
+ * node with room.
+ */
+static void
+ck_btree_inner_insert(struct ck_btree_inner *inner,
+    uint64_t key,
+    struct ck_btree_node *child)
+{
+	unsigned int count = inner->header.count;
+	unsigned int i, j;
+
+	i = ck_btree_search(inner->keys, count, key, true);
+	for (j = count; j > i; j--) {
+		ck_pr_store_64(&inner->keys[j], inner->keys[j - 1]);
+		ck_pr_store_ptr(&inner->children[j + 1], inner->children[j]);
+	}
+
+	ck_pr_store_64(&inner->keys[i], key);
+	ck_pr_store_ptr(&inner->children[i + 1], child);
+	ck_pr_store_16(&inner->header.count, count + 1);
+	return;
+}
+
+/*
+ * Splits a latched node whose parent is latched and has room, and
+ * publishes the new right sibling through the parent. The root is split
+ * by publishing a new root above it.
+ */
+static bool
+ck_btree_split(struct ck_btree *tree,
+    struct ck_btree_node *parent,
+    struct ck_btree_node *node)
+{
+	struct ck_btree_node *right, *root = NULL;
+	struct ck_btree_inner *inner;
+	uint64_t separator;
+
+	right = ck_btree_node_create(tree, node->leaf != 0);
+	if (right == NULL)
+		return false;
+
+	if (parent == NULL) {
+		root = ck_btree_node_create(tree, false);
+		if (root == NULL) {
+			ck_btree_node_destroy(tree, right, false);
+			return false;
+		}
+	}
+
+	if (node->leaf != 0) {
+		separator = ck_btree_split_leaf((struct ck_btree_leaf *)node,
+		    (struct ck_btree_leaf *)right);
+	} else {
+		separator = ck_btree_split_inner((struct ck_btree_inner *)node,
+		    (struct ck_btree_inner *)right);
+	}
+
+	if (parent != NULL) {
+		ck_btree_inner_insert((struct ck_btree_inner *)parent,
+		    separator, right);
+		return true;
+	}
+
+	inner = (struct ck_btree_inner *)root;
+	inner->keys[0] = separator;
+	inner->children[0] = node;
+	inner->children[1] = right;
+	inner->header.count = 1;
+	ck_pr_store_release_ptr(&tree->root, root);
+	return true;
+}
+
+static bool
+ck_btree_insert(struct ck_btree *tree,
+    uint64_t key,
+    const void *value,
+    void **previous)
+{
+	struct ck_btree_node *node, *parent, *child;
+	struct ck_btree_leaf *leaf;
+	unsigned int v, pv = 0, cv, i, j, count, position;
+	bool r;
+
+retry:
+	parent = NULL;
+	if (ck_btree_root(tree, &node, &v) == false)
+		goto retry;
+
+	for (;;) {
+		/*
+		 * Full nodes are split on the way down, so the parent of a
+		 * node being split always has room for the separator.
+		 */
+		if (ck_btree_count(node) == ck_btree_capacity(node)) {
+			if (parent != NULL && ck_btree_latch(parent, pv) == false)
+				goto retry;
+
+			if (ck_btree_latch(node, v) == false) {
+				if (parent != NULL)
+					ck_btree_unlatch(parent);
+
+				goto retry;
+			}
+
+			r = ck_btree_split(tree, parent, node);
+			ck_btree_unlatch(node);
+			if (parent != NULL)
+				ck_btree_unlatch(parent);
+
+			if (r == false)
+				return false;
+
+			goto retry;
+		}
+
+		if (node->leaf != 0)
+			break;
+
+		if (ck_btree_child(node, v, key, &child, &cv, &position) == false)
+			goto retry;
+
+		parent = node;
+		pv = v;
+		node = child;
+		v = cv;
+	}
+
+	/*
+	 * A leaf that is unchanged since it was reached through its parent
+	 * still covers the key, as splits and merges modify the leaf.
+	 */
+	if (ck_btree_latch(node, v) == false)
+		goto retry;
+
+	leaf = (struct ck_btree_leaf *)node;
+	count = leaf->header.count;
+	i = ck_btree_search(leaf->keys, count, key, false);
+	if (i < count && leaf->keys[i] == key) {
+		if (previous == NULL) {
+			ck_btree_unlatch(node);
+			return false;
+		}
+
+		*previous = CK_CC_DECONST_PTR(leaf->values[i]);
+		ck_pr_store_ptr(&leaf->values[i], value);
+		ck_btree_unlatch(node);
+		return true;
+	}
+
+	for (j = count; j > i; j--) {
+		ck_pr_store_64(&leaf->keys[j], leaf->keys[j - 1]);
+		ck_pr_store_ptr(&leaf->values[j], leaf->values[j - 1]);
+	}
+
+	ck_pr_store_64(&leaf->keys[i], key);
+	ck_pr_store_ptr(&leaf->values[i], value);
+	ck_pr_store_16(&leaf->header.count, count + 1);
+	ck_btree_unlatch(node);
+
+	if (previous != NULL)
+		*previous = NULL;
+
+	return true;
+}
+
+bool
+ck_btree_put(struct ck_btree *tree, uint64_t key, const void *value)
+{
+
+	return ck_btree_insert(tree, key, value, NULL);
+}
+
+bool
+ck_btree_set(struct ck_btree *tree,
+    uint64_t key,
+    const void *value,
+    void **previous)
+{
+
+	return ck_btree_insert(tree, key, value, previous);
+}
+
+/*
+ * Merges an underfull, latched leaf with a sibling under the same parent
+ * and releases its latch. Merging is opportunistic: if a latch cannot be
+ * taken immediately or the entries do not fit, the leaf is left as is.
+ */
+static void
+ck_btree_merge(struct ck_btree *tree,
+    struct ck_btree_node *parent,
+    unsigned int pv,
+    struct ck_btree_leaf *leaf,
+    unsigned int position)
+{
+	struct ck_btree_inner *inner = (struct ck_btree_inner *)parent;
+	struct ck_btree_leaf *left, *right, *sibling;
+	unsigned int i, count, index;
+
+	if (ck_btree_latch(parent, pv) == false)
+		goto leave;
+
+	if (position > 0) {
+		left = (struct ck_btree_leaf *)inner->children[position - 1];
+		right = leaf;
+		sibling = left;
+		index = position;
+	} else if (parent->count > 0) {
+		left = leaf;
+		right = (struct ck_btree_leaf *)inner->children[1];
+		sibling = right;
+		index = 1;
+	} else {
+		ck_btree_unlatch(parent);
+		goto leave;
+	}
+
+	if (ck_btree_trylatch(&sibling->header) == false) {
+		ck_btree_unlatch(parent);
+		goto leave;
+	}
+
+	count = left->header.count;
+	if (count + right->header.count > CK_BTREE_LEAF) {
+		ck_btree_unlatch(&sibling->header);
+		ck_btree_unlatch(parent);
+		goto leave;
+	}
+
+	for (i = 0; i < right->header.count; i++) {
+		ck_pr_store_64(&left->keys[count + i], right->keys[i]);
+		ck_pr_store_ptr(&left->values[count + i], right->values[i]);
+	}
+
+	ck_pr_store_16(&left->header.count, count + right->header.count);
+	ck_pr_store_ptr(&left->next, right->next);
+
+	/* Remove the right leaf and the separator before it. */
+	count = parent->count;
+	for (i = index - 1; i + 1 < count; i++)
+		ck_pr_store_64(&inner->keys[i], inner->keys[i + 1]);
+
+	for (i = index; i < count; i++)
+		ck_pr_store_ptr(&inner->children[i], inner->children[i + 1]);
+
+	ck_pr_store_16(&parent->count, count - 1);
+
+	ck_btree_unlatch(&left->header);
+	ck_btree_unlatch_obsolete(&right->header);
+	ck_btree_unlatch(parent);
+	ck_btree_node_destroy(tree, &right->header, true);
+	return;
+
+leave:
+	ck_btree_unlatch(&leaf->header);
+	return;
+}
+
+void *
+ck_btree_remove(struct ck_btree *tree, uint64_t key)
+{
+	struct ck_btree_node *node, *parent, *child;
+	struct ck_btree_leaf *leaf;
+	unsigned int v, pv = 0, cv, i, count, position = 0;
+	const void *value;
+
+retry:
+	parent = NULL;
+	if (ck_btree_root(tree, &node, &v) == false)
+		goto retry;
+
+	while (node->leaf == 0) {
+		if (ck_btree_child(node, v, key, &child, &cv, &position) == false)
+			goto retry;
+
+		parent = node;
+		pv = v;
+		node = child;
+		v = cv;
+	}
+
+	if (ck_btree_latch(node, v) == false)
+		goto retry;
+
+	leaf = (struct ck_btree_leaf *)node;
+	count = leaf->header.count;
+	i = ck_btree_search(leaf->keys, count, key, false);
+	if (i == count || leaf->keys[i] != key) {
+		ck_btree_unlatch(node);
+		return NULL;
+	}
+
+	value = leaf->values[i];
+	for (; i + 1 < count; i++) {
+		ck_pr_store_64(&leaf->keys[i], leaf->keys[i + 1]);
+		ck_pr_store_ptr(&leaf->values[i], leaf->values[i + 1]);
+	}
+
+	ck_pr_store_16(&leaf->header.count, count - 1);
+
+	if (parent != NULL && count - 1 < CK_BTREE_LEAF / 4) {
+		ck_btree_merge(tree, parent, pv, leaf, position);
+	} else {
+		ck_btree_unlatch(node);
+	}
+
+	return CK_CC_DECONST_PTR(value);
+}
+
+void
+ck_btree_iterator_init(struct ck_btree *tree, struct ck_btree_iterator *iterator)
+{
+
+	ck_btree_lower_bound(tree, iterator, 0);
+	return;
+}
+
+void
+ck_btree_lower_bound(struct ck_btree *tree,
+    struct ck_btree_iterator *iterator,
+    uint64_t key)
+{
+
+	(void)tree;
+
+	iterator->leaf = NULL;
+	iterator->version = 0;
+	iterator->index = 0;
+	iterator->key = key;
+	iterator->end = false;
+	return;
+}
+
+/*
+ * Scans walk the leaf links. If a leaf changes under the iterator, the
+ * iterator searches for the leaf covering the next key from the root.
+ */
+bool
+ck_btree_next(struct ck_btree *tree,
+    struct ck_btree_iterator *iterator,
+    uint64_t *key,
+    void **value)
+{
+	struct ck_btree_leaf *leaf, *next;
+	unsigned int count, version;
+	const void *v;
+	uint64_t k;
+
+	if (iterator->end == true)
+		return false;
+
+	for (;;) {
+		leaf = (struct ck_btree_leaf *)iterator->leaf;
+		if (leaf == NULL) {
+			leaf = ck_btree_find(tree, iterator->key, &iterator->version);
+			iterator->leaf = &leaf->header;
+			iterator->index = ck_btree_search(leaf->keys,
+			    ck_btree_count(&leaf->header), iterator->key, false);
+		}
+
+		count = ck_btree_count(&leaf->header);
+		if (iterator->index < count) {
+			k = ck_pr_load_64(&leaf->keys[iterator->index]);
+			v = ck_pr_load_ptr(&leaf->values[iterator->index]);
+			if (ck_btree_valid(&leaf->header, iterator->version) == false) {
+				iterator->leaf = NULL;
+				continue;
+			}
+
+			iterator->index++;
+			if (k == UINT64_MAX) {
+				iterator->end = true;
+			} else {
+				iterator->key = k + 1;
+			}
+
+			*key = k;
+			*value = CK_CC_DECONST_PTR(v);
+			return true;
+		}
+
+		next = ck_pr_load_ptr(&leaf->next);
+		if (ck_btree_valid(&leaf->header, iterator->version) == false) {
+			iterator->leaf = NULL;
+			continue;
+		}
+
+		if (next == NULL)
+			return false;
+
+		if (ck_btree_read(&next->header, &version) == false) {
+			iterator->leaf = NULL;
+			continue;
+		}
+
+		iterator->leaf = &next->header;
+		iterator->version = version;
+		iterator->index = ck_btree_search(next->keys,
+		    ck_btree_count(&next->header), iterator->key, false);
+	}
+}
+
+static void
+ck_btree_free(struct ck_btree *tree, struct ck_btree_node *node)
+{
+	struct ck_btree_inner *inner;
+	unsigned int i;
+
+	if (node->leaf == 0) {
+		inner = (struct ck_btree_inner *)node;
+		for (i = 0; i <= node->count; i++)
+			ck_btree_free(tree, inner->children[i]);
+	}
+
+	ck_btree_node_destroy(tree, node, false);
+	return;
+}
+
+void
+ck_btree_destroy(struct ck_btree *tree)
+{
+
+	ck_btree_free(tree, tree->root);
+	tree->root = NULL;
+	return;
+}
+
+bool
+ck_btree_init(struct ck_btree *tree, struct ck_malloc *m)
+{
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL)
+		return false;
+
+	tree->m = m;
+	tree->root = ck_btree_node_create(tree, true);
+	return tree->root != NULL;
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_counter.h>
+
+#ifdef CK_F_COUNTER
+
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+#include <ck_string.h>
+
+bool
+ck_counter_init(struct ck_counter *counter,
+    struct ck_malloc *m,
+    unsigned int n_shards,
+    uint64_t batch,
+    uint64_t limit)
+{
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL || n_shards == 0)
+		return false;
+
+	counter->size = sizeof(struct ck_counter_shard) * n_shards +
+	    CK_MD_CACHELINE - 1;
+	counter->allocation = m->malloc(counter->size);
+	if (counter->allocation == NULL)
+		return false;
+
+	counter->shards = (struct ck_counter_shard *)(((uintptr_t)counter->allocation +
+	    CK_MD_CACHELINE - 1) & ~(uintptr_t)(CK_MD_CACHELINE - 1));
+	memset(counter->shards, 0, sizeof(struct ck_counter_shard) * n_shards);
+	counter->n_shards = n_shards;
+	counter->batch = batch;
+	counter->limit = limit;
+	counter->m = m;
+	counter->global = 0;
+	counter->pool = limit;
+	ck_pr_fence_store();
+	return true;
+}
+
+void
+ck_counter_destroy(struct ck_counter *counter)
+{
+
+	counter->m->free(counter->allocation, counter->size, false);
+	counter->allocation = NULL;
+	counter->shards = NULL;
+	return;
+}
+
+/*
+ * Returns the sum of every shard. The sum is exact in the absence of
+ * concurrent updates, but is not linearized with respect to them.
+ */
+uint64_t
+ck_counter_sum(struct ck_counter *counter)
+{
+	uint64_t sum = 0;
+	unsigned int i;
+
+	for (i = 0; i < counter->n_shards; i++)
+		sum += ck_pr_load_64(&counter->shards[i].value);
+
+	return sum;
+}
+
+/*
+ * Takes up to want from the global pool and returns how much was taken.
+ */
+static uint64_t
+ck_counter_take(struct ck_counter *counter, uint64_t want, bool partial)
+{
+	uint64_t pool, take;
+
+	for (;;) {
+		pool = ck_pr_load_64(&counter->pool);
+		take = want;
+		if (pool < want) {
+			if (partial == false)
+				return 0;
+
+			take = pool;
+		}
+
+		if (take == 0)
+			return 0;
+
+		if (ck_pr_cas_64(&counter->pool, pool, pool - take) == true)
+			return take;
+
+		ck_pr_stall();
+	}
+}
+
+/*
+ * Moves enough budget into a shard for it to consume delta. A batch is
+ * borrowed at once so that the pool is rarely touched. Once the pool runs
+ * dry, the budget cached by every shard is returned to it and delta is
+ * borrowed exactly, failing only if the counter is truly at its limit.
+ */
+bool
+ck_counter_borrow(struct ck_counter *counter, unsigned int shard, uint64_t delta)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+	uint64_t want = delta + counter->batch;
+	uint64_t taken, budget;
+	unsigned int i;
+
+	if (want < delta)
+		want = delta;
+
+	taken = ck_counter_take(counter, want, true);
+	if (taken != 0) {
+		budget = ck_pr_faa_64(&s->budget, taken) + taken;
+		if (budget >= delta)
+			return true;
+	}
+
+	for (i = 0; i < counter->n_shards; i++) {
+		budget = ck_pr_fas_64(&counter->shards[i].budget, 0);
+		if (budget != 0)
+			ck_pr_add_64(&counter->pool, budget);
+	}
+
+	taken = ck_counter_take(counter, delta, false);
+	if (taken == 0)
+		return false;
+
+	ck_pr_add_64(&s->budget, taken);
+	return true;
+}
+
+void
+ck_counter_add_local_slow(struct ck_counter *counter,
+    unsigned int shard,
+    uint64_t value)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+
+	ck_pr_add_64(&counter->global, value - s->folded);
+	ck_pr_store_64(&s->folded, value);
+	return;
+}
+
+/*
+ * Only the thread that advances folded publishes the difference, so the
+ * global value is always the sum of what every shard has folded.
+ */
+void
+ck_counter_add_slow(struct ck_counter *counter,
+    unsigned int shard,
+    uint64_t value,
+    uint64_t folded)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+
+	if (ck_pr_cas_64(&s->folded, folded, value) == true)
+		ck_pr_add_64(&counter->global, value - folded);
+
+	return;
+}
+
+bool
+ck_counter_limit_add_slow(struct ck_counter *counter,
+    unsigned int shard,
+    uint64_t delta)
+{
+	struct ck_counter_shard *s = &counter->shards[shard];
+	uint64_t budget;
+
+	for (;;) {
+		budget = ck_pr_load_64(&s->budget);
+
+		if (budget < delta) {
+			if (ck_counter_borrow(counter, shard, delta) == false)
+				return false;
+
+			continue;
+		}
+
+		if (ck_pr_cas_64(&s->budget, budget, budget - delta) == true)
+			break;
+
+		ck_pr_stall();
+	}
+
+	ck_counter_add(counter, shard, delta);
+	return true;
+}
+
+#endif /* CK_F_COUNTER */
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_deque.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+#include <ck_string.h>
+
+#include "ck_internal.h"
+
+/*
+ * The difference between the bottom and top counters is interpreted as a
+ * signed value, so the array must hold less than 2^31 entries.
+ */
+#define CK_DEQUE_CAPACITY_MIN 2U
+#define CK_DEQUE_CAPACITY_MAX (1U << 30)
+
+static struct ck_deque_array *
+ck_deque_array_create(struct ck_malloc *m,
+    unsigned int capacity,
+    unsigned int size)
+{
+	struct ck_deque_array *array;
+	size_t length;
+
+	length = sizeof(*array) + (size_t)size * capacity +
+	    CK_MD_CACHELINE - 1;
+	array = m->malloc(length);
+	if (array == NULL)
+		return NULL;
+
+	/*
+	 * Entries are stored by value, so the buffer is aligned to a cache
+	 * line to satisfy the alignment of any element type.
+	 */
+	array->mask = capacity - 1;
+	array->size = length;
+	array->buffer = (void *)(((uintptr_t)(array + 1) +
+	    CK_MD_CACHELINE - 1) & ~(uintptr_t)(CK_MD_CACHELINE - 1));
+	return array;
+}
+
+bool
+_ck_deque_init(struct ck_deque *deque,
+    struct ck_malloc *m,
+    unsigned int capacity,
+    unsigned int size)
+{
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL || size == 0 ||
+	    capacity > CK_DEQUE_CAPACITY_MAX)
+		return false;
+
+	if (capacity < CK_DEQUE_CAPACITY_MIN)
+		capacity = CK_DEQUE_CAPACITY_MIN;
+
+	deque->array = ck_deque_array_create(m,
+	    ck_internal_power_2(capacity), size);
+	if (deque->array == NULL)
+		return false;
+
+	deque->top = 0;
+	deque->bottom = 0;
+	deque->size = size;
+	deque->m = m;
+	return true;
+}
+
+/*
+ * Steals up to half of the entries in the deque, rounded up, but no more
+ * than n. A single compare-and-swap cannot claim a range of entries, as the
+ * owner pops entries other than the last one without synchronizing with
+ * thieves, so each entry is stolen individually. Entries are returned in
+ * FIFO order.
+ */
+unsigned int
+_ck_deque_steal_batch(struct ck_deque *deque,
+    void *buffer,
+    unsigned int n,
+    unsigned int size)
+{
+	unsigned int i, target;
+
+	target = ck_deque_size(deque);
+	target -= target >> 1;
+	if (target > n)
+		target = n;
+
+	for (i = 0; i < target; i++) {
+		if (_ck_deque_steal(deque,
+		    (char *)buffer + size * i, size) == false)
+			break;
+	}
+
+	return i;
+}
+
+void
+ck_deque_destroy(struct ck_deque *deque)
+{
+
+	deque->m->free(deque->array, deque->array->size, false);
+	deque->array = NULL;
+	return;
+}
+
+/*
+ * Called by the owner when the array is full. Entries keep their position
+ * in the sequence, so the range [top, bottom) is copied into the new array
+ * before it is published. A thief that read top before it was advanced
+ * may copy the same entry out of either array, but only one compare-and-swap
+ * on top can succeed.
+ */
+bool
+_ck_deque_grow(struct ck_deque *deque, unsigned int top, unsigned int bottom)
+{
+	struct ck_deque_array *array = deque->array;
+	struct ck_deque_array *update;
+	unsigned int capacity = array->mask + 1;
+	unsigned int size = deque->size;
+	unsigned int i;
+
+	if (capacity >= CK_DEQUE_CAPACITY_MAX)
+		return false;
+
+	update = ck_deque_array_create(deque->m, capacity << 1, size);
+	if (update == NULL)
+		return false;
+
+	for (i = top; i != bottom; i++) {
+		memcpy((char *)update->buffer + size * (i & update->mask),
+		    (char *)array->buffer + size * (i & array->mask), size);
+	}
+
+	ck_pr_fence_store();
+	ck_pr_store_ptr(&deque->array, update);
+	deque->m->free(array, array->size, true);
+	return true;
+}
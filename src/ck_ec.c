@@ -26,6 +26,23 @@ struct ck_ec64_slow_path_state {
 };
 #endif
 
+struct ck_ec32_any_state {
+	const uint32_t *const *addresses;
+	const uint32_t *flagged_words;
+	size_t n;
+	uint32_t generation;
+	bool *shared;
+};
+
+/*
+ * Process-wide event count for ck_ec32_wait_any waiters without a
+ * wait32_any primitive. These waiters register in any_waiters, and
+ * every ck_ec32_wake that clears a waiter flag bumps any_generation
+ * while any are registered.
+ */
+static uint32_t ck_ec32_any_waiters CK_CC_CACHELINE;
+static uint32_t ck_ec32_any_generation CK_CC_CACHELINE;
+
 /* Once we've waited for >= 1 sec, go for the full deadline. */
 static const struct timespec final_wait_time = {
 	.tv_sec = 1
@@ -34,9 +51,26 @@ static const struct timespec final_wait_time = {
 void
 ck_ec32_wake(struct ck_ec32 *ec, const struct ck_ec_ops *ops)
 {
+	bool flagged;
+
 	/* Spurious wake-ups are OK. Clear the flag before futexing. */
-	ck_pr_and_32(&ec->counter, (1U << 31) - 1);
+	flagged = ck_pr_btr_32(&ec->counter, 31);
 	ops->wake32(ops, &ec->counter);
+
+	/*
+	 * Shared ck_ec32_wait_any waiters register before they flag ec.
+	 * If we cleared the flag, the load below cannot miss them; if
+	 * there was no flag, there is nobody to wake.
+	 */
+	if (flagged == false)
+		return;
+
+	ck_pr_fence_atomic_load();
+	if (ck_pr_load_32(&ck_ec32_any_waiters) != 0) {
+		ck_pr_inc_32(&ck_ec32_any_generation);
+		ops->wake32(ops, &ck_ec32_any_generation);
+	}
+
 	return;
 }
 
@@ -423,3 +457,174 @@ ck_ec64_wait_pred_slow(struct ck_ec64 *ec,
 #endif
 
 #undef WAIT_SLOW_BODY
+
+/*
+ * Returns the index of the first event count whose value differs from
+ * old_values, or -1 if none has changed.
+ */
+static int
+ck_ec32_any_changed(struct ck_ec32 *const *ecs,
+    const uint32_t *old_values,
+    size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		if ((ck_pr_load_32(&ecs[i]->counter) & ~(1UL << 31)) !=
+		    old_values[i]) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Blocks until partial_deadline on all the flagged counters at once,
+ * with ops->wait32_any, or on the process-wide generation counter.
+ * Returns true if any counter (or the generation) has changed.
+ */
+static bool
+ck_ec32_wait_any_once(const void *vstate,
+    const struct ck_ec_wait_state *wait_state,
+    const struct timespec *partial_deadline)
+{
+	const struct ck_ec32_any_state *state = vstate;
+	const struct ck_ec_ops *ops = wait_state->ops;
+	size_t i;
+
+	if (*state->shared == true) {
+		ops->wait32(wait_state, &ck_ec32_any_generation,
+			    state->generation, partial_deadline);
+		if (ck_pr_load_32(&ck_ec32_any_generation) !=
+		    state->generation) {
+			return true;
+		}
+	} else if (ops->wait32_any(wait_state, state->addresses,
+				   state->flagged_words, state->n,
+				   partial_deadline) != 0) {
+		/* Unsupported at runtime: redo the slow path in shared mode. */
+		*state->shared = true;
+		return true;
+	}
+
+	for (i = 0; i < state->n; i++) {
+		if (ck_pr_load_32(state->addresses[i]) !=
+		    state->flagged_words[i]) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int
+ck_ec32_wait_any_slow(struct ck_ec32 *const *ecs,
+    const struct ck_ec_ops *ops,
+    const uint32_t *old_values,
+    size_t n,
+    const struct timespec *deadline_ptr)
+{
+	const uint32_t *addresses[CK_EC_WAIT_ANY_MAX];
+	uint32_t flagged_words[CK_EC_WAIT_ANY_MAX];
+	struct ck_ec_wait_state wait_state = {
+		.ops = ops,
+		.data = NULL
+	};
+	const struct timespec deadline = canonical_deadline(deadline_ptr);
+	const size_t busy_loop_iter = (ops->busy_loop_iter != 0)
+	    ? ops->busy_loop_iter
+	    : DEFAULT_BUSY_LOOP_ITER;
+	bool shared = (ops->wait32_any == NULL);
+	bool registered = false;
+	struct ck_ec32_any_state state = {
+		.addresses = addresses,
+		.flagged_words = flagged_words,
+		.n = n,
+		.shared = &shared
+	};
+	size_t i;
+	int r;
+
+	if (CK_CC_UNLIKELY(n == 0 || n > CK_EC_WAIT_ANY_MAX)) {
+		return -1;
+	}
+
+	r = ck_ec32_any_changed(ecs, old_values, n);
+	if (CK_CC_UNLIKELY(r >= 0)) {
+		goto leave;
+	}
+
+	/* Detect infinite past deadlines. */
+	if (CK_CC_LIKELY(deadline.tv_sec <= 0)) {
+		return -1;
+	}
+
+	for (i = 0; i < busy_loop_iter; i++) {
+		ck_pr_stall();
+		r = ck_ec32_any_changed(ecs, old_values, n);
+		if (r >= 0) {
+			goto leave;
+		}
+	}
+
+	for (;;) {
+		if (shared == true) {
+			if (registered == false) {
+				ck_pr_inc_32(&ck_ec32_any_waiters);
+				registered = true;
+			}
+
+			/*
+			 * Snapshot the generation after registering, and
+			 * before flagging any counter: a producer that
+			 * sees our flag also sees the registration, and
+			 * bumps the generation past this snapshot.
+			 */
+			ck_pr_fence_memory();
+			state.generation =
+			    ck_pr_load_32(&ck_ec32_any_generation);
+			ck_pr_fence_memory();
+		}
+
+		for (i = 0; i < n; i++) {
+			const uint32_t unflagged_word = old_values[i];
+			const uint32_t flagged_word = unflagged_word |
+			    (1UL << 31);
+
+			if (ck_ec32_upgrade(ecs[i],
+			    ck_pr_load_32(&ecs[i]->counter),
+			    unflagged_word, flagged_word) == true) {
+				r = (int)i;
+				goto leave;
+			}
+
+			addresses[i] = &ecs[i]->counter;
+			flagged_words[i] = flagged_word;
+		}
+
+		r = exponential_backoff(&wait_state, ck_ec32_wait_any_once,
+					&state, NULL, &deadline);
+		if (r != 0) {
+			goto leave;
+		}
+
+		r = ck_ec32_any_changed(ecs, old_values, n);
+		if (r >= 0) {
+			goto leave;
+		}
+
+		/* Spurious wake-up. Redo the slow path. */
+	}
+
+leave:
+	if (registered == true) {
+		ck_pr_dec_32(&ck_ec32_any_waiters);
+	}
+
+	if (r >= 0) {
+		ck_pr_fence_acquire();
+	}
+
+	return r;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ec_eventfd.h>
+
+#ifdef CK_F_EC_EVENTFD
+
+#include <ck_pr.h>
+#include <ck_stdint.h>
+
+#include <errno.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#define CK_EC_EVENTFD_BUSY_LOOP_ITER 100U
+
+static const struct ck_ec_eventfd *
+ck_ec_eventfd_bridge(const struct ck_ec_ops *ops)
+{
+
+	return (const struct ck_ec_eventfd *)(const void *)ops;
+}
+
+static void
+ck_ec_eventfd_signal(const struct ck_ec_eventfd *bridge)
+{
+	const uint64_t one = 1;
+	ssize_t r;
+
+	/*
+	 * The write only fails with EAGAIN once the eventfd counter is
+	 * about to overflow, at which point it is readable anyway.
+	 */
+	do {
+		r = write(bridge->fd, &one, sizeof(one));
+	} while (r == -1 && errno == EINTR);
+
+	return;
+}
+
+static void
+ck_ec_eventfd_wake32(const struct ck_ec_ops *ops, const uint32_t *address)
+{
+
+	(void)address;
+	ck_ec_eventfd_signal(ck_ec_eventfd_bridge(ops));
+	return;
+}
+
+static void
+ck_ec_eventfd_wake64(const struct ck_ec_ops *ops, const uint64_t *address)
+{
+
+	(void)address;
+	ck_ec_eventfd_signal(ck_ec_eventfd_bridge(ops));
+	return;
+}
+
+int
+ck_ec_eventfd_init(struct ck_ec_eventfd *bridge, const struct ck_ec_ops *base)
+{
+	int fd;
+
+	fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (fd == -1)
+		return -1;
+
+	bridge->ops = *base;
+	bridge->ops.wake32 = ck_ec_eventfd_wake32;
+	bridge->ops.wake64 = ck_ec_eventfd_wake64;
+	bridge->fd = fd;
+	return 0;
+}
+
+void
+ck_ec_eventfd_destroy(struct ck_ec_eventfd *bridge)
+{
+
+	close(bridge->fd);
+	bridge->fd = -1;
+	return;
+}
+
+void
+ck_ec_eventfd_drain(struct ck_ec_eventfd *bridge)
+{
+	uint64_t value;
+	ssize_t r;
+
+	do {
+		r = read(bridge->fd, &value, sizeof(value));
+	} while (r == -1 && errno == EINTR);
+
+	return;
+}
+
+/*
+ * Flags the counter word, then spins briefly so that an in-flight
+ * single producer update either becomes visible here or observes the
+ * flag. Returns false if the counter no longer holds unflagged.
+ */
+#define CK_EC_EVENTFD_ARM(W, ec, bridge, unflagged, flagged)		\
+	do {								\
+		const struct ck_ec_ops *ops = &(bridge)->ops;		\
+		const size_t n = (ops->busy_loop_iter != 0)		\
+		    ? ops->busy_loop_iter				\
+		    : CK_EC_EVENTFD_BUSY_LOOP_ITER;			\
+		uint##W##_t current;					\
+		size_t i;						\
+									\
+		if (ck_pr_cas_##W##_value(&(ec)->counter, (unflagged),	\
+		    (flagged), &current) == false &&			\
+		    current != (flagged)) {				\
+			ck_pr_fence_acquire();				\
+			return false;					\
+		}							\
+									\
+		for (i = 0; i < n; i++) {				\
+			if (ck_pr_load_##W(&(ec)->counter) != (flagged)) { \
+				ck_pr_fence_acquire();			\
+				return false;				\
+			}						\
+									\
+			ck_pr_stall();					\
+		}							\
+									\
+		return true;						\
+	} while (0)
+
+bool
+ck_ec32_eventfd_arm(struct ck_ec32 *ec,
+    const struct ck_ec_eventfd *bridge,
+    uint32_t old_value)
+{
+
+	CK_EC_EVENTFD_ARM(32, ec, bridge, old_value, old_value | (1UL << 31));
+}
+
+#ifdef CK_F_EC64
+bool
+ck_ec64_eventfd_arm(struct ck_ec64 *ec,
+    const struct ck_ec_eventfd *bridge,
+    uint64_t old_value)
+{
+
+	CK_EC_EVENTFD_ARM(64, ec, bridge, old_value << 1,
+	    (old_value << 1) | 1);
+}
+#endif /* CK_F_EC64 */
+
+#undef CK_EC_EVENTFD_ARM
+
+#endif /* CK_F_EC_EVENTFD */
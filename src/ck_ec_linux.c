@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ec.h>
+
+#ifdef CK_F_EC_LINUX
+
+#include <ck_cc.h>
+#include <ck_limits.h>
+#include <ck_pr.h>
+#include <ck_stdint.h>
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * A futex wait and wake round trip costs a few microseconds, so spin
+ * for about as long before sleeping. Wake-ups are reliable, so the
+ * intermediate deadlines of the exponential back-off only guard against
+ * pathological cases and can start well above the generic default of
+ * 2 ms. With the default 8x scale factor, waiters reach the one second
+ * mark after three partial deadlines (16 ms, 128 ms, 1024 ms).
+ */
+#define CK_EC_LINUX_BUSY_LOOP_ITER 256
+#define CK_EC_LINUX_INITIAL_WAIT_NS 16000000
+
+/*
+ * The futex word of a 64-bit event count is its least significant half.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define CK_EC_LINUX_LOW_HALF(address) \
+	((const uint32_t *)(const void *)(address) + 1)
+#else
+#define CK_EC_LINUX_LOW_HALF(address) \
+	((const uint32_t *)(const void *)(address))
+#endif
+
+static int
+ck_ec_linux_gettime(const struct ck_ec_ops *ops, struct timespec *out)
+{
+
+	(void)ops;
+	return clock_gettime(CLOCK_MONOTONIC, out);
+}
+
+static void
+ck_ec_linux_wait32(const struct ck_ec_wait_state *state,
+    const uint32_t *address, uint32_t expected,
+    const struct timespec *deadline)
+{
+
+	(void)state;
+
+	/*
+	 * Unlike FUTEX_WAIT, FUTEX_WAIT_BITSET interprets its timeout as
+	 * an absolute CLOCK_MONOTONIC time, which is what ck_ec provides.
+	 * Early returns (EAGAIN, EINTR, ETIMEDOUT) are all permitted.
+	 */
+	syscall(SYS_futex, address, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+	    expected, deadline, NULL, FUTEX_BITSET_MATCH_ANY, 0);
+	return;
+}
+
+static void
+ck_ec_linux_wait64(const struct ck_ec_wait_state *state,
+    const uint64_t *address, uint64_t expected,
+    const struct timespec *deadline)
+{
+
+	ck_ec_linux_wait32(state, CK_EC_LINUX_LOW_HALF(address),
+	    (uint32_t)expected, deadline);
+	return;
+}
+
+#if defined(SYS_futex_waitv) && defined(FUTEX_32)
+/*
+ * Set once futex_waitv (Linux 5.16+) turns out to be unavailable, so
+ * later waits go straight to the shared fallback.
+ */
+static unsigned int ck_ec_linux_waitv_unsupported;
+
+static int
+ck_ec_linux_wait32_any(const struct ck_ec_wait_state *state,
+    const uint32_t *const *addresses, const uint32_t *expected, size_t n,
+    const struct timespec *deadline)
+{
+	struct futex_waitv waiters[CK_EC_WAIT_ANY_MAX];
+	size_t i;
+
+	(void)state;
+
+	if (ck_pr_load_uint(&ck_ec_linux_waitv_unsupported) != 0)
+		return -1;
+
+	for (i = 0; i < n; i++) {
+		waiters[i].val = expected[i];
+		waiters[i].uaddr = (uintptr_t)addresses[i];
+		waiters[i].flags = FUTEX_32 | FUTEX_PRIVATE_FLAG;
+		waiters[i].__reserved = 0;
+	}
+
+	/* The timeout is an absolute time on the given clock. */
+	if (syscall(SYS_futex_waitv, waiters, (unsigned int)n, 0,
+	    deadline, CLOCK_MONOTONIC) == -1 &&
+	    (errno == ENOSYS || errno == EPERM)) {
+		ck_pr_store_uint(&ck_ec_linux_waitv_unsupported, 1);
+		return -1;
+	}
+
+	return 0;
+}
+#define CK_EC_LINUX_WAIT32_ANY ck_ec_linux_wait32_any
+#else
+#define CK_EC_LINUX_WAIT32_ANY NULL
+#endif /* SYS_futex_waitv && FUTEX_32 */
+
+static void
+ck_ec_linux_wake32(const struct ck_ec_ops *ops, const uint32_t *address)
+{
+
+	(void)ops;
+	syscall(SYS_futex, address, FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+	    INT_MAX, NULL, NULL, 0);
+	return;
+}
+
+static void
+ck_ec_linux_wake64(const struct ck_ec_ops *ops, const uint64_t *address)
+{
+
+	ck_ec_linux_wake32(ops, CK_EC_LINUX_LOW_HALF(address));
+	return;
+}
+
+const struct ck_ec_ops ck_ec_linux_ops = {
+	.gettime = ck_ec_linux_gettime,
+	.wait32 = ck_ec_linux_wait32,
+	.wait64 = ck_ec_linux_wait64,
+	.wake32 = ck_ec_linux_wake32,
+	.wake64 = ck_ec_linux_wake64,
+	.busy_loop_iter = CK_EC_LINUX_BUSY_LOOP_ITER,
+	.initial_wait_ns = CK_EC_LINUX_INITIAL_WAIT_NS,
+	.wait32_any = CK_EC_LINUX_WAIT32_ANY
+};
+
+#endif /* CK_F_EC_LINUX */
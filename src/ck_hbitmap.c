@@ -0,0 +1,116 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_hbitmap.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+/*
+ * Word i of the specified level of a tree has a bit set, make sure every
+ * summary above it reflects this.
+ */
+void
+ck_hbitmap_mark(struct ck_hbitmap *hb, bool clear, unsigned int level,
+    unsigned int i)
+{
+
+	for (level++; level < hb->n_levels; level++) {
+		uint64_t *summary = ck_hbitmap_summary(hb, clear, level,
+		    i / CK_HBITMAP_BLOCK);
+		uint64_t bit = CK_HBITMAP_BIT(i);
+
+		/*
+		 * The update below this level must be visible before the
+		 * summary is sampled. If the bit is set, any thread clearing
+		 * it will observe the update when it re-checks the word.
+		 */
+		ck_pr_fence_atomic_load();
+		if (ck_pr_load_64(summary) & bit)
+			break;
+
+		ck_pr_or_64(summary, bit);
+		i /= CK_HBITMAP_BLOCK;
+	}
+
+	return;
+}
+
+/*
+ * Word i of the specified level of a tree may have become zero, clear
+ * the summaries above it that no longer have a reason to be set.
+ */
+void
+ck_hbitmap_unmark(struct ck_hbitmap *hb, bool clear, unsigned int level,
+    unsigned int i)
+{
+
+	for (; level + 1 < hb->n_levels; level++) {
+		uint64_t *summary;
+
+		if (ck_hbitmap_load(hb, clear, level, i) != 0)
+			break;
+
+		summary = ck_hbitmap_summary(hb, clear, level + 1,
+		    i / CK_HBITMAP_BLOCK);
+		ck_pr_and_64(summary, ~CK_HBITMAP_BIT(i));
+
+		/*
+		 * A concurrent update may have made the word non-zero
+		 * after it was sampled and found the summary bit still
+		 * set. Re-check the word and restore the summary if so.
+		 */
+		ck_pr_fence_atomic_load();
+		if (ck_hbitmap_load(hb, clear, level, i) != 0) {
+			ck_hbitmap_mark(hb, clear, level, i);
+			break;
+		}
+
+		i /= CK_HBITMAP_BLOCK;
+	}
+
+	return;
+}
+
+unsigned int
+ck_hbitmap_count(const struct ck_hbitmap *hb)
+{
+	unsigned int count = 0;
+	unsigned int i = 0;
+
+	if (hb->n_levels == 1) {
+		if (hb->n_bits == 0)
+			return 0;
+
+		return ck_cc_popcountll(ck_pr_load_64(&hb->map[0]));
+	}
+
+	while (ck_hbitmap_find(hb, false, 1, i, &i) == true)
+		count += ck_cc_popcountll(ck_pr_load_64(&hb->map[i++]));
+
+	return count;
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_hbitmap.h>
+#include <ck_idalloc.h>
+#include <ck_malloc.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+#ifdef CK_F_IDALLOC
+
+bool
+ck_idalloc_init(struct ck_idalloc *ida, struct ck_malloc *m,
+    unsigned int n_ids)
+{
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL)
+		return false;
+
+	ida->map = m->malloc(ck_hbitmap_size(n_ids));
+	if (ida->map == NULL)
+		return false;
+
+	ck_hbitmap_init(ida->map, n_ids, false);
+	ida->m = m;
+	ida->n_ids = n_ids;
+	ck_pr_fence_store();
+	return true;
+}
+
+void
+ck_idalloc_destroy(struct ck_idalloc *ida)
+{
+
+	ida->m->free(ida->map, ck_hbitmap_size(ida->n_ids), false);
+	ida->map = NULL;
+	return;
+}
+
+/*
+ * Bits of word i that correspond to identifiers.
+ */
+static uint64_t
+ck_idalloc_mask(const struct ck_idalloc *ida, unsigned int i)
+{
+
+	if (i == ida->n_ids / CK_HBITMAP_BLOCK)
+		return CK_HBITMAP_BIT(ida->n_ids) - 1;
+
+	return ~(uint64_t)0;
+}
+
+/*
+ * Finds the next identifier that appears free at or after *position,
+ * wrapping around to the beginning of the map once and stopping at the
+ * point the search started from.
+ */
+static bool
+ck_idalloc_search(const struct ck_idalloc *ida, unsigned int start,
+    unsigned int *position, bool *wrapped, unsigned int *id)
+{
+
+	if (ck_hbitmap_next_clear(ida->map, *position, id) == true)
+		return *wrapped == false || *id < start;
+
+	if (*wrapped == true || start == 0)
+		return false;
+
+	*wrapped = true;
+	*position = 0;
+	return ck_hbitmap_next_clear(ida->map, 0, id) == true && *id < start;
+}
+
+CK_CC_INLINE static unsigned int
+ck_idalloc_start(const struct ck_idalloc *ida, const unsigned int *hint)
+{
+
+	if (hint == NULL || *hint >= ida->n_ids)
+		return 0;
+
+	return *hint;
+}
+
+bool
+ck_idalloc_get(struct ck_idalloc *ida, unsigned int *hint, unsigned int *id)
+{
+	unsigned int start = ck_idalloc_start(ida, hint);
+	unsigned int position = start;
+	unsigned int candidate;
+	bool wrapped = false;
+
+	while (ck_idalloc_search(ida, start, &position, &wrapped,
+	    &candidate) == true) {
+		if (ck_hbitmap_bts(ida->map, candidate) == false) {
+			if (hint != NULL)
+				*hint = candidate + 1;
+
+			*id = candidate;
+			return true;
+		}
+
+		/* Another thread won the race for this identifier. */
+		position = candidate + 1;
+	}
+
+	return false;
+}
+
+unsigned int
+ck_idalloc_get_n(struct ck_idalloc *ida, unsigned int *hint,
+    unsigned int *ids, unsigned int n)
+{
+	unsigned int start = ck_idalloc_start(ida, hint);
+	unsigned int position = start;
+	unsigned int count = 0;
+	unsigned int candidate;
+	bool wrapped = false;
+
+	while (count < n && ck_idalloc_search(ida, start, &position,
+	    &wrapped, &candidate) == true) {
+		unsigned int i = candidate / CK_HBITMAP_BLOCK;
+		uint64_t *word = &ida->map->map[i];
+		uint64_t snapshot = ck_pr_load_64(word);
+		uint64_t claim;
+
+		/*
+		 * Claim the lowest free bits of the word, as many as are
+		 * still needed, with a single compare-and-swap.
+		 */
+		do {
+			uint64_t available = ~snapshot & ck_idalloc_mask(ida, i);
+			unsigned int want = n - count;
+
+			claim = 0;
+			while (available != 0 && want-- > 0) {
+				uint64_t lowest = available & (~available + 1);
+
+				claim |= lowest;
+				available ^= lowest;
+			}
+
+			if (claim == 0)
+				break;
+		} while (ck_pr_cas_64_value(word, snapshot, snapshot | claim,
+		    &snapshot) == false);
+
+		if (claim != 0) {
+			ck_hbitmap_mark(ida->map, false, 0, i);
+			ck_hbitmap_unmark(ida->map, true, 0, i);
+
+			do {
+				ids[count++] = i * CK_HBITMAP_BLOCK +
+				    ck_cc_ctzll(claim);
+				claim &= claim - 1;
+			} while (claim != 0);
+
+			if (hint != NULL)
+				*hint = ids[count - 1] + 1;
+		}
+
+		position = (i + 1) * CK_HBITMAP_BLOCK;
+	}
+
+	return count;
+}
+
+void
+ck_idalloc_put(struct ck_idalloc *ida, unsigned int id)
+{
+
+	ck_hbitmap_reset(ida->map, id);
+	return;
+}
+
+void
+ck_idalloc_put_n(struct ck_idalloc *ida, const unsigned int *ids,
+    unsigned int n)
+{
+	unsigned int j = 0;
+
+	while (j < n) {
+		unsigned int i = ids[j] / CK_HBITMAP_BLOCK;
+		uint64_t mask = 0;
+
+		for (; j < n && ids[j] / CK_HBITMAP_BLOCK == i; j++)
+			mask |= CK_HBITMAP_BIT(ids[j]);
+
+		ck_pr_and_64(&ida->map->map[i], ~mask);
+		ck_hbitmap_mark(ida->map, true, 0, i);
+		ck_hbitmap_unmark(ida->map, false, 0, i);
+	}
+
+	return;
+}
+
+#endif /* CK_F_IDALLOC */
@@ -0,0 +1,580 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_deque.h>
+#include <ck_ec.h>
+#include <ck_epoch.h>
+#include <ck_md.h>
+#include <ck_pool.h>
+#include <ck_pr.h>
+#include <ck_stack.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+CK_STACK_CONTAINER(struct ck_pool_task, injector_entry,
+    ck_pool_task_injector_container)
+
+struct ck_pool_range {
+	struct ck_pool_task task;
+	ck_pool_range_cb_t *function;
+	void *argument;
+	unsigned long begin;
+	unsigned long end;
+	unsigned long grain;
+};
+
+CK_CC_CONTAINER(struct ck_pool_task, struct ck_pool_range, task,
+    ck_pool_range_container)
+
+struct ck_pool_join_state {
+	struct ck_pool_worker *worker;
+	struct ck_pool_group *group;
+};
+
+static void
+ck_pool_execute(struct ck_pool_worker *worker, struct ck_pool_task *task)
+{
+	struct ck_pool_group *group = task->group;
+
+	/* The task may be released by its function. */
+	task->function(worker, task);
+	if (group != NULL)
+		_ck_pool_complete(worker->pool, group);
+
+	return;
+}
+
+static void
+ck_pool_push(struct ck_pool_worker *worker, struct ck_pool_task *task)
+{
+
+	if (ck_deque_push(&worker->deque, task) == false)
+		ck_pool_execute(worker, task);
+
+	return;
+}
+
+CK_CC_INLINE static unsigned int
+ck_pool_random(struct ck_pool_worker *worker)
+{
+	unsigned int x = worker->seed;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	worker->seed = x;
+	return x;
+}
+
+/*
+ * Takes every task in the injector. The stack returns the most recently
+ * submitted task first, so tasks are pushed in that order and the oldest
+ * is run first.
+ */
+static struct ck_pool_task *
+ck_pool_inject(struct ck_pool_worker *worker)
+{
+	struct ck_pool *pool = worker->pool;
+	struct ck_stack_entry *entry, *first, *next;
+
+	if (ck_pr_load_ptr(&pool->injector.head) == NULL)
+		return NULL;
+
+	first = entry = ck_stack_batch_pop_upmc(&pool->injector);
+	if (entry == NULL)
+		return NULL;
+
+	for (next = entry->next; next != NULL; next = entry->next) {
+		ck_pool_push(worker, ck_pool_task_injector_container(entry));
+		entry = next;
+	}
+
+	/* Let idle workers steal the tasks that were not run. */
+	if (entry != first)
+		ck_ec32_signal(&pool->ec, &pool->mode);
+
+	return ck_pool_task_injector_container(entry);
+}
+
+static unsigned int
+ck_pool_steal_range(struct ck_pool_worker *worker,
+    const unsigned int *victims,
+    unsigned int n,
+    struct ck_pool_task **batch)
+{
+	struct ck_pool *pool = worker->pool;
+	unsigned int i, j, r;
+
+	if (n == 0)
+		return 0;
+
+	j = ck_pool_random(worker) % n;
+	for (i = 0; i < n; i++) {
+		r = ck_deque_steal_batch(&pool->workers[victims[j]].deque,
+		    batch, CK_POOL_STEAL_BATCH);
+		if (r != 0)
+			return r;
+
+		if (++j == n)
+			j = 0;
+	}
+
+	return 0;
+}
+
+/*
+ * Steals up to half of the tasks of a victim, starting with the workers of
+ * the same domain. The oldest task is returned and the others are kept on
+ * the deque of the thief.
+ */
+static struct ck_pool_task *
+ck_pool_steal(struct ck_pool_worker *worker)
+{
+	struct ck_pool_task *batch[CK_POOL_STEAL_BATCH];
+	unsigned int i, n;
+
+	ck_epoch_begin(worker->record, NULL);
+	n = ck_pool_steal_range(worker, worker->victims, worker->n_local,
+	    batch);
+	if (n == 0) {
+		n = ck_pool_steal_range(worker,
+		    worker->victims + worker->n_local,
+		    worker->n_victims - worker->n_local, batch);
+	}
+	ck_epoch_end(worker->record, NULL);
+
+	if (n == 0)
+		return NULL;
+
+	for (i = n - 1; i > 0; i--)
+		ck_pool_push(worker, batch[i]);
+
+	if (n > 1)
+		ck_ec32_signal(&worker->pool->ec, &worker->pool->mode);
+
+	return batch[0];
+}
+
+static struct ck_pool_task *
+ck_pool_find(struct ck_pool_worker *worker)
+{
+	struct ck_pool_task *task;
+
+	if (ck_deque_pop(&worker->deque, &task) == true)
+		return task;
+
+	task = ck_pool_inject(worker);
+	if (task != NULL)
+		return task;
+
+	return ck_pool_steal(worker);
+}
+
+/*
+ * Returns true if another worker or the injector appears to have a task.
+ * The caller's own deque is known to be empty.
+ */
+static bool
+ck_pool_visible(const struct ck_pool_worker *worker)
+{
+	const struct ck_pool *pool = worker->pool;
+	unsigned int i;
+
+	if (ck_pr_load_ptr(&pool->injector.head) != NULL)
+		return true;
+
+	for (i = 0; i < worker->n_victims; i++) {
+		if (ck_deque_size(&pool->workers[worker->victims[i]].deque) != 0)
+			return true;
+	}
+
+	return false;
+}
+
+static bool
+ck_pool_idle_ready(void *data)
+{
+	const struct ck_pool_worker *worker = data;
+
+	return ck_pr_load_uint(&worker->pool->shutdown) != 0 ||
+	    ck_pool_visible(worker) == true;
+}
+
+static bool
+ck_pool_join_ready(void *data)
+{
+	const struct ck_pool_join_state *state = data;
+
+	return ck_pool_group_done(state->group) == true ||
+	    ck_pool_visible(state->worker) == true;
+}
+
+static bool
+ck_pool_wait_ready(void *data)
+{
+
+	return ck_pool_group_done(data);
+}
+
+static void
+ck_pool_worker_fini(struct ck_pool_worker *worker)
+{
+
+	ck_deque_destroy(&worker->deque);
+	ck_epoch_unregister(worker->record);
+	return;
+}
+
+/*
+ * Victims in the same domain as the worker are listed first.
+ */
+static void
+ck_pool_victims(struct ck_pool *pool, struct ck_pool_worker *worker)
+{
+	unsigned int i, n = 0;
+
+	for (i = 0; i < pool->n_workers; i++) {
+		if (i != worker->id && pool->workers[i].domain == worker->domain)
+			worker->victims[n++] = i;
+	}
+
+	worker->n_local = n;
+	for (i = 0; i < pool->n_workers; i++) {
+		if (pool->workers[i].domain != worker->domain)
+			worker->victims[n++] = i;
+	}
+
+	worker->n_victims = n;
+	return;
+}
+
+/*
+ * Epoch records can never be released, only recycled. A new record is
+ * aligned by hand, as the allocator only guarantees malloc alignment.
+ */
+static ck_epoch_record_t *
+ck_pool_record(struct ck_malloc *m, ck_epoch_t *epoch)
+{
+	ck_epoch_record_t *record;
+	uintptr_t p;
+
+	record = ck_epoch_recycle(epoch, NULL);
+	if (record != NULL)
+		return record;
+
+	p = (uintptr_t)m->malloc(sizeof *record + CK_MD_CACHELINE - 1);
+	if (p == 0)
+		return NULL;
+
+	p = (p + CK_MD_CACHELINE - 1) & ~(uintptr_t)(CK_MD_CACHELINE - 1);
+	record = (ck_epoch_record_t *)p;
+	ck_epoch_register(epoch, record, NULL);
+	return record;
+}
+
+bool
+ck_pool_init(struct ck_pool *pool,
+    struct ck_malloc *m,
+    ck_epoch_t *epoch,
+    const struct ck_ec_ops *ops,
+    unsigned int n_workers,
+    const unsigned int *domains)
+{
+	struct ck_pool_worker *worker;
+	ck_epoch_record_t *record;
+	unsigned int i;
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL ||
+	    epoch == NULL || ops == NULL || n_workers == 0)
+		return false;
+
+	pool->workers = m->malloc(sizeof(struct ck_pool_worker) * n_workers);
+	if (pool->workers == NULL)
+		return false;
+
+	pool->victims = m->malloc(sizeof(unsigned int) * n_workers * n_workers);
+	if (pool->victims == NULL) {
+		m->free(pool->workers,
+		    sizeof(struct ck_pool_worker) * n_workers, false);
+		return false;
+	}
+
+	ck_stack_init(&pool->injector);
+	ck_ec32_init(&pool->ec, 0);
+	pool->shutdown = 0;
+	pool->mode.ops = ops;
+	pool->mode.single_producer = false;
+	pool->m = m;
+	pool->epoch = epoch;
+	pool->n_workers = n_workers;
+
+	for (i = 0; i < n_workers; i++) {
+		worker = &pool->workers[i];
+		worker->pool = pool;
+		worker->victims = pool->victims + i * n_workers;
+		worker->id = i;
+		worker->domain = domains != NULL ? domains[i] : 0;
+		worker->seed = i * 2654435761U + 1;
+		worker->spin = 0;
+	}
+
+	for (i = 0; i < n_workers; i++) {
+		worker = &pool->workers[i];
+		ck_pool_victims(pool, worker);
+
+		if (ck_deque_init(&worker->deque, m,
+		    CK_POOL_DEQUE_CAPACITY) == false)
+			goto error;
+
+		record = ck_pool_record(m, epoch);
+		if (record == NULL) {
+			ck_deque_destroy(&worker->deque);
+			goto error;
+		}
+
+		worker->record = record;
+	}
+
+	return true;
+
+error:
+	while (i-- > 0)
+		ck_pool_worker_fini(&pool->workers[i]);
+
+	m->free(pool->victims, sizeof(unsigned int) * n_workers * n_workers,
+	    false);
+	m->free(pool->workers, sizeof(struct ck_pool_worker) * n_workers,
+	    false);
+	return false;
+}
+
+/*
+ * May only be called once every call to ck_pool_run has returned.
+ */
+void
+ck_pool_destroy(struct ck_pool *pool)
+{
+	unsigned int i, n = pool->n_workers;
+
+	for (i = 0; i < n; i++)
+		ck_pool_worker_fini(&pool->workers[i]);
+
+	pool->m->free(pool->victims, sizeof(unsigned int) * n * n, false);
+	pool->m->free(pool->workers, sizeof(struct ck_pool_worker) * n, false);
+	pool->workers = NULL;
+	pool->victims = NULL;
+	return;
+}
+
+void
+ck_pool_run(struct ck_pool *pool, unsigned int id)
+{
+	struct ck_pool_worker *worker = &pool->workers[id];
+	struct ck_pool_task *task;
+
+	for (;;) {
+		task = ck_pool_find(worker);
+		if (task != NULL) {
+			ck_pool_execute(worker, task);
+			continue;
+		}
+
+		if (ck_pr_load_uint(&pool->shutdown) != 0)
+			break;
+
+		ck_ec32_wait_until(&pool->ec, &pool->mode, &worker->spin,
+		    ck_pool_idle_ready, worker);
+	}
+
+	return;
+}
+
+/*
+ * Workers return from ck_pool_run once they no longer find any task. No
+ * task may be submitted after this call.
+ */
+void
+ck_pool_shutdown(struct ck_pool *pool)
+{
+
+	ck_pr_store_uint(&pool->shutdown, 1);
+	ck_pr_fence_store_load();
+	ck_ec32_signal(&pool->ec, &pool->mode);
+	return;
+}
+
+void
+ck_pool_submit(struct ck_pool *pool,
+    struct ck_pool_task *task,
+    ck_pool_task_cb_t *function,
+    struct ck_pool_group *group)
+{
+
+	task->function = function;
+	task->group = group;
+	if (group != NULL)
+		ck_pr_inc_uint(&group->forked);
+
+	ck_stack_push_upmc(&pool->injector, &task->injector_entry);
+	ck_pr_fence_atomic_load();
+	ck_ec32_signal(&pool->ec, &pool->mode);
+	return;
+}
+
+void
+ck_pool_wait(struct ck_pool *pool, struct ck_pool_group *group)
+{
+
+	ck_ec32_wait_until(&pool->ec, &pool->mode, NULL, ck_pool_wait_ready,
+	    group);
+	return;
+}
+
+/*
+ * The worker runs any task it can find while the group is incomplete. It
+ * only sleeps once neither its deque, the injector nor any other worker
+ * has a task, and is then woken through the event count of the pool by
+ * the completion of the group.
+ */
+void
+ck_pool_join(struct ck_pool_worker *worker, struct ck_pool_group *group)
+{
+	struct ck_pool_join_state state = {
+		.worker = worker,
+		.group = group
+	};
+	struct ck_pool_task *task;
+
+	while (ck_pool_group_done(group) == false) {
+		task = ck_pool_find(worker);
+		if (task != NULL) {
+			ck_pool_execute(worker, task);
+			continue;
+		}
+
+		ck_ec32_wait_until(&worker->pool->ec, &worker->pool->mode,
+		    &worker->spin, ck_pool_join_ready, &state);
+	}
+
+	/* Order the effects of the tasks before those of the caller. */
+	ck_pr_fence_acquire();
+	return;
+}
+
+static void ck_pool_range_task(struct ck_pool_worker *, struct ck_pool_task *);
+
+/*
+ * The upper half of the range is forked and the lower half is split
+ * further by the caller, so a task never outlives the stack frame that
+ * holds it.
+ */
+static void
+ck_pool_range_split(struct ck_pool_worker *worker,
+    unsigned long begin,
+    unsigned long end,
+    unsigned long grain,
+    ck_pool_range_cb_t *function,
+    void *argument)
+{
+	struct ck_pool_range upper;
+	struct ck_pool_group group;
+	unsigned long middle;
+
+	if (end - begin <= grain) {
+		function(worker, begin, end, argument);
+		return;
+	}
+
+	middle = begin + (end - begin) / 2;
+	upper.function = function;
+	upper.argument = argument;
+	upper.begin = middle;
+	upper.end = end;
+	upper.grain = grain;
+
+	ck_pool_group_init(&group);
+	ck_pool_fork(worker, &upper.task, ck_pool_range_task, &group);
+	ck_pool_range_split(worker, begin, middle, grain, function, argument);
+	ck_pool_join(worker, &group);
+	return;
+}
+
+static void
+ck_pool_range_task(struct ck_pool_worker *worker, struct ck_pool_task *task)
+{
+	struct ck_pool_range *range = ck_pool_range_container(task);
+
+	ck_pool_range_split(worker, range->begin, range->end, range->grain,
+	    range->function, range->argument);
+	return;
+}
+
+void
+ck_pool_worker_for(struct ck_pool_worker *worker,
+    unsigned long begin,
+    unsigned long end,
+    unsigned long grain,
+    ck_pool_range_cb_t *function,
+    void *argument)
+{
+
+	if (begin >= end)
+		return;
+
+	if (grain == 0)
+		grain = 1;
+
+	ck_pool_range_split(worker, begin, end, grain, function, argument);
+	return;
+}
+
+void
+ck_pool_for(struct ck_pool *pool,
+    unsigned long begin,
+    unsigned long end,
+    unsigned long grain,
+    ck_pool_range_cb_t *function,
+    void *argument)
+{
+	struct ck_pool_range range;
+	struct ck_pool_group group;
+
+	if (begin >= end)
+		return;
+
+	range.function = function;
+	range.argument = argument;
+	range.begin = begin;
+	range.end = end;
+	range.grain = grain == 0 ? 1 : grain;
+
+	ck_pool_group_init(&group);
+	ck_pool_submit(pool, &range.task, ck_pool_range_task, &group);
+	ck_pool_wait(pool, &group);
+	return;
+}
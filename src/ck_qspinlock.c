@@ -0,0 +1,308 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_qspinlock.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/*
+ * Number of iterations a pending waiter is willing to wait for an
+ * in-progress pending to locked hand-over before queueing.
+ */
+#define CK_QSPINLOCK_PENDING_LOOPS 1
+
+struct ck_qspinlock_node {
+	struct ck_qspinlock_node *next;
+	unsigned int locked;
+};
+
+struct ck_qspinlock_cpu {
+	unsigned int used;
+	struct ck_qspinlock_node node[CK_QSPINLOCK_NODES];
+} CK_CC_CACHELINE;
+
+static struct ck_qspinlock_cpu ck_qspinlock_nodes[CK_QSPINLOCK_CPU_MAX];
+
+CK_CC_INLINE static unsigned int
+ck_qspinlock_cpu_id(void)
+{
+	uintptr_t hint;
+
+#ifdef __linux__
+	int cpu = sched_getcpu();
+
+	if (cpu >= 0)
+		return (unsigned int)cpu % CK_QSPINLOCK_CPU_MAX;
+#endif
+
+	/*
+	 * Without a CPU identifier, spread threads by stack address. Any
+	 * value is correct since nodes are claimed atomically.
+	 */
+	hint = (uintptr_t)&hint;
+	hint ^= hint >> 17;
+	hint *= 0x9E3779B1U;
+	return (unsigned int)(hint >> 12) % CK_QSPINLOCK_CPU_MAX;
+}
+
+/*
+ * Claims a free node of the given CPU set. Returns the node index or
+ * CK_QSPINLOCK_NODES if every node is in use.
+ */
+CK_CC_INLINE static unsigned int
+ck_qspinlock_node_claim(struct ck_qspinlock_cpu *cpu)
+{
+	unsigned int used, idx;
+
+	used = ck_pr_load_uint(&cpu->used);
+	for (;;) {
+		idx = ck_cc_ffs(~used) - 1;
+		if (idx >= CK_QSPINLOCK_NODES)
+			return CK_QSPINLOCK_NODES;
+
+		if (ck_pr_cas_uint_value(&cpu->used, used,
+		    used | (1U << idx), &used) == true)
+			break;
+
+		ck_pr_stall();
+	}
+
+	return idx;
+}
+
+CK_CC_INLINE static void
+ck_qspinlock_node_release(struct ck_qspinlock_cpu *cpu, unsigned int idx)
+{
+
+	ck_pr_fence_release();
+	ck_pr_btr_uint(&cpu->used, idx);
+	return;
+}
+
+CK_CC_INLINE static uint32_t
+ck_qspinlock_encode_tail(unsigned int cpu, unsigned int idx)
+{
+
+	return ((cpu + 1) << CK_QSPINLOCK_TAIL_CPU_OFFSET) |
+	    (idx << CK_QSPINLOCK_TAIL_IDX_OFFSET);
+}
+
+CK_CC_INLINE static struct ck_qspinlock_node *
+ck_qspinlock_decode_tail(uint32_t tail)
+{
+	unsigned int cpu, idx;
+
+	cpu = (tail >> CK_QSPINLOCK_TAIL_CPU_OFFSET) - 1;
+	idx = (tail & CK_QSPINLOCK_TAIL_IDX_MASK) >> CK_QSPINLOCK_TAIL_IDX_OFFSET;
+	return &ck_qspinlock_nodes[cpu].node[idx];
+}
+
+/*
+ * Atomically replaces the tail, preserving the locked byte and the pending
+ * bit. Returns the previous value of the lock word.
+ */
+CK_CC_INLINE static uint32_t
+ck_qspinlock_xchg_tail(struct ck_qspinlock *lock, uint32_t tail)
+{
+	uint32_t value, update;
+
+	value = ck_pr_load_32(&lock->value);
+	for (;;) {
+		update = (value & ~CK_QSPINLOCK_TAIL_MASK) | tail;
+		if (ck_pr_cas_32_value(&lock->value, value, update,
+		    &value) == true)
+			break;
+	}
+
+	return value;
+}
+
+/*
+ * Atomically sets the pending bit and returns the previous value of the
+ * lock word.
+ */
+CK_CC_INLINE static uint32_t
+ck_qspinlock_fetch_set_pending(struct ck_qspinlock *lock)
+{
+	uint32_t value;
+
+	value = ck_pr_load_32(&lock->value);
+	while (ck_pr_cas_32_value(&lock->value, value,
+	    value | CK_QSPINLOCK_PENDING, &value) == false);
+
+	return value;
+}
+
+static void
+ck_qspinlock_spin(struct ck_qspinlock *lock)
+{
+
+	while (ck_qspinlock_trylock(lock) == false)
+		ck_pr_stall();
+
+	return;
+}
+
+void
+ck_qspinlock_lock_slow(struct ck_qspinlock *lock, uint32_t value)
+{
+	struct ck_qspinlock_cpu *cpu;
+	struct ck_qspinlock_node *node, *previous, *next;
+	unsigned int cpu_id, idx, loop;
+	uint32_t tail;
+
+	/*
+	 * If a pending waiter is in the middle of being handed the lock,
+	 * wait a little for it to complete rather than queueing.
+	 */
+	if (value == CK_QSPINLOCK_PENDING) {
+		for (loop = 0; loop < CK_QSPINLOCK_PENDING_LOOPS; loop++) {
+			value = ck_pr_load_32(&lock->value);
+			if (value != CK_QSPINLOCK_PENDING)
+				break;
+
+			ck_pr_stall();
+		}
+	}
+
+	/* Any contention beyond the lock holder means we must queue. */
+	if (value & ~CK_QSPINLOCK_LOCKED_MASK)
+		goto queue;
+
+	/*
+	 * Become the pending waiter. The pending bit is only set when there
+	 * is neither a queue nor another pending waiter.
+	 */
+	value = ck_qspinlock_fetch_set_pending(lock);
+	if (value & ~CK_QSPINLOCK_LOCKED_MASK) {
+		/* Undo the pending bit if we were the one to set it. */
+		if ((value & CK_QSPINLOCK_PENDING_MASK) == 0)
+			ck_pr_sub_32(&lock->value, CK_QSPINLOCK_PENDING);
+
+		goto queue;
+	}
+
+	/*
+	 * We are the pending waiter, only the current owner is ahead of us
+	 * and nobody may queue behind us without observing the pending bit.
+	 */
+	if (value & CK_QSPINLOCK_LOCKED_MASK) {
+		while (ck_pr_load_32(&lock->value) & CK_QSPINLOCK_LOCKED_MASK)
+			ck_pr_stall();
+	}
+
+	/* Clear pending and set locked in one step. */
+	ck_pr_add_32(&lock->value, CK_QSPINLOCK_LOCKED - CK_QSPINLOCK_PENDING);
+	ck_pr_fence_lock();
+	return;
+
+queue:
+	cpu_id = ck_qspinlock_cpu_id();
+	cpu = &ck_qspinlock_nodes[cpu_id];
+	idx = ck_qspinlock_node_claim(cpu);
+	if (CK_CC_UNLIKELY(idx >= CK_QSPINLOCK_NODES)) {
+		/*
+		 * Every node of this CPU is held by a (possibly migrated or
+		 * preempted) thread. This is rare enough that it is acceptable
+		 * to fall back to test-and-set semantics.
+		 */
+		ck_qspinlock_spin(lock);
+		return;
+	}
+
+	node = &cpu->node[idx];
+	tail = ck_qspinlock_encode_tail(cpu_id, idx);
+
+	/*
+	 * The lock may have been released while a node was being claimed,
+	 * avoid the cost of queueing if so.
+	 */
+	if (ck_qspinlock_trylock(lock) == true)
+		goto release;
+
+	ck_pr_store_uint(&node->locked, true);
+	ck_pr_store_ptr(&node->next, NULL);
+	ck_pr_fence_store_atomic();
+
+	/*
+	 * Publish the node as the new tail. If there was a previous tail,
+	 * link behind it and wait to become the head of the queue.
+	 */
+	value = ck_qspinlock_xchg_tail(lock, tail);
+	if (value & CK_QSPINLOCK_TAIL_MASK) {
+		previous = ck_qspinlock_decode_tail(value & CK_QSPINLOCK_TAIL_MASK);
+		ck_pr_store_ptr(&previous->next, node);
+
+		while (ck_pr_load_uint(&node->locked) == true)
+			ck_pr_stall();
+	}
+
+	/*
+	 * We are at the head of the queue. Wait for both the owner and any
+	 * pending waiter to leave.
+	 */
+	for (;;) {
+		value = ck_pr_load_32(&lock->value);
+		if ((value & (CK_QSPINLOCK_LOCKED_MASK |
+		    CK_QSPINLOCK_PENDING_MASK)) == 0)
+			break;
+
+		ck_pr_stall();
+	}
+
+	/*
+	 * If we are still the tail, the queue is empty once we own the
+	 * lock. Otherwise, take the lock and hand the head over to the
+	 * successor.
+	 */
+	if ((value & CK_QSPINLOCK_TAIL_MASK) == tail &&
+	    ck_pr_cas_32(&lock->value, value, CK_QSPINLOCK_LOCKED) == true) {
+		goto release;
+	}
+
+	ck_pr_add_32(&lock->value, CK_QSPINLOCK_LOCKED);
+
+	while ((next = ck_pr_load_ptr(&node->next)) == NULL)
+		ck_pr_stall();
+
+	ck_pr_store_uint(&next->locked, false);
+
+release:
+	ck_pr_fence_lock();
+	ck_qspinlock_node_release(cpu, idx);
+	return;
+}
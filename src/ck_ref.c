@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_ref.h>
+
+#ifdef CK_F_REF
+
+#include <ck_epoch.h>
+#include <ck_pr.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+/*
+ * The shards never fold into the global value of the counter, since only
+ * their exact sum is of interest once the count is killed.
+ */
+bool
+ck_ref_init(struct ck_ref *ref, struct ck_malloc *m, unsigned int n_shards)
+{
+
+	if (ck_counter_init(&ref->shards, m, n_shards,
+	    CK_COUNTER_UNLIMITED, CK_COUNTER_UNLIMITED) == false)
+		return false;
+
+	ref->mode = CK_REF_LIVE;
+	ref->count = CK_REF_BIAS + 1;
+	ck_pr_fence_store();
+	return true;
+}
+
+void
+ck_ref_destroy(struct ck_ref *ref)
+{
+
+	ck_counter_destroy(&ref->shards);
+	return;
+}
+
+/*
+ * Switches the count to atomic mode and drops the initial reference,
+ * returning true if it was the last one. The caller must not be within
+ * a read section of the epoch, and the count may only be killed once.
+ */
+bool
+ck_ref_kill(struct ck_ref *ref, struct ck_epoch_record *record)
+{
+	uint64_t sum;
+
+	ck_pr_store_uint(&ref->mode, CK_REF_ATOMIC);
+	ck_pr_fence_memory();
+
+	/*
+	 * Every get or put that observed the live mode has completed after
+	 * a grace period, so that the shards are stable.
+	 */
+	ck_epoch_synchronize(record);
+
+	sum = ck_counter_sum(&ref->shards);
+	ck_pr_add_64(&ref->count, sum - CK_REF_BIAS);
+	return _ck_ref_release(ref);
+}
+
+#endif /* CK_F_REF */
@@ -0,0 +1,463 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_limits.h>
+#include <ck_pr.h>
+#include <ck_sarray.h>
+#include <ck_stdbool.h>
+#include <ck_string.h>
+
+#define CK_SARRAY_HANDLE_NONE UINT_MAX
+#define CK_SARRAY_SEGMENT_SIZE (sizeof(void *) * CK_SARRAY_SEGMENT)
+
+static struct _ck_sarray *
+ck_sarray_directory(struct ck_malloc *allocator, unsigned int n_segments)
+{
+	struct _ck_sarray *d;
+
+	d = allocator->malloc(sizeof(struct _ck_sarray) +
+	    sizeof(void **) * n_segments);
+	if (d == NULL)
+		return NULL;
+
+	d->n_committed = 0;
+	d->n_segments = n_segments;
+	return d;
+}
+
+static void
+ck_sarray_directory_free(struct ck_malloc *allocator,
+    struct _ck_sarray *d,
+    bool defer)
+{
+
+	allocator->free(d, sizeof(struct _ck_sarray) +
+	    sizeof(void **) * d->n_segments, defer);
+	return;
+}
+
+/*
+ * The directory that the writer operates on: the pending transaction if
+ * one exists, otherwise the active snapshot itself.
+ */
+static struct _ck_sarray *
+ck_sarray_target(struct ck_sarray *array)
+{
+
+	if (array->transaction != NULL)
+		return array->transaction;
+
+	return array->active;
+}
+
+static bool
+ck_sarray_transaction(struct ck_sarray *array, unsigned int n_segments)
+{
+	struct _ck_sarray *source = ck_sarray_target(array);
+	struct _ck_sarray_segment *state;
+	struct _ck_sarray *d;
+
+	if (array->transaction != NULL && n_segments <= source->n_segments)
+		return true;
+
+	if (n_segments < source->n_segments)
+		n_segments = source->n_segments;
+
+	d = ck_sarray_directory(array->allocator, n_segments);
+	if (d == NULL)
+		return false;
+
+	if (n_segments > source->n_segments) {
+		state = array->allocator->realloc(array->state,
+		    sizeof(*state) * source->n_segments,
+		    sizeof(*state) * n_segments, false);
+		if (state == NULL) {
+			ck_sarray_directory_free(array->allocator, d, false);
+			return false;
+		}
+
+		memset(state + source->n_segments, 0,
+		    sizeof(*state) * (n_segments - source->n_segments));
+		array->state = state;
+	}
+
+	memcpy(d->segments, source->segments,
+	    sizeof(void **) * array->n_allocated);
+
+	/* A transaction directory was never visible to readers. */
+	if (array->transaction != NULL)
+		ck_sarray_directory_free(array->allocator, source, false);
+
+	array->transaction = d;
+	return true;
+}
+
+/*
+ * Returns the location to which the value of slot may be written. Slots
+ * that no published snapshot of the segment has exposed are invisible to
+ * readers and are written in place. Otherwise, the segment is copied into
+ * the transaction once and subsequent writes land in the copy.
+ */
+static void **
+ck_sarray_slot(struct ck_sarray *array, unsigned int slot)
+{
+	unsigned int s = slot / CK_SARRAY_SEGMENT;
+	unsigned int offset = slot % CK_SARRAY_SEGMENT;
+	struct _ck_sarray_segment *state = &array->state[s];
+	void **segment = ck_sarray_target(array)->segments[s];
+	void **copy;
+
+	if (offset >= state->exposed || state->owned != 0)
+		return &segment[offset];
+
+	if (ck_sarray_transaction(array, 0) == false)
+		return NULL;
+
+	copy = array->allocator->malloc(CK_SARRAY_SEGMENT_SIZE);
+	if (copy == NULL)
+		return NULL;
+
+	memcpy(copy, segment, CK_SARRAY_SEGMENT_SIZE);
+	array->transaction->segments[s] = copy;
+
+	/* The state array may have moved while creating the transaction. */
+	state = &array->state[s];
+	state->owned = 1;
+	state->exposed = 0;
+	return &copy[offset];
+}
+
+static bool
+ck_sarray_map(struct ck_sarray *array, unsigned int n)
+{
+	unsigned int *slots, *handles;
+	unsigned int n_map = array->n_map;
+
+	if (n <= n_map)
+		return true;
+
+	if (n < n_map << 1)
+		n = n_map << 1;
+
+	slots = array->allocator->realloc(array->slots,
+	    sizeof(unsigned int) * n_map, sizeof(unsigned int) * n, false);
+	if (slots == NULL)
+		return false;
+
+	array->slots = slots;
+	handles = array->allocator->realloc(array->handles,
+	    sizeof(unsigned int) * n_map, sizeof(unsigned int) * n, false);
+	if (handles == NULL)
+		return false;
+
+	array->handles = handles;
+	array->n_map = n;
+	return true;
+}
+
+/*
+ * Appends a new segment. Existing segments are never copied, only the
+ * directory of segment pointers once it runs out of room.
+ */
+static bool
+ck_sarray_grow(struct ck_sarray *array)
+{
+	struct _ck_sarray *target = ck_sarray_target(array);
+	unsigned int n = array->n_allocated;
+	void **segment;
+
+	if (n > (UINT_MAX - CK_SARRAY_SEGMENT) / CK_SARRAY_SEGMENT)
+		return false;
+
+	if (ck_sarray_map(array, (n + 1) * CK_SARRAY_SEGMENT) == false)
+		return false;
+
+	if (n == target->n_segments) {
+		if (ck_sarray_transaction(array, n << 1) == false)
+			return false;
+
+		target = array->transaction;
+	}
+
+	segment = array->allocator->malloc(CK_SARRAY_SEGMENT_SIZE);
+	if (segment == NULL)
+		return false;
+
+	ck_pr_store_ptr(&target->segments[n], segment);
+	array->state[n].exposed = 0;
+	array->state[n].owned = 0;
+	array->n_allocated = n + 1;
+	return true;
+}
+
+bool
+ck_sarray_init(struct ck_sarray *array,
+    unsigned int mode,
+    struct ck_malloc *allocator,
+    unsigned int length)
+{
+	unsigned int n_segments;
+
+	(void)mode;
+
+	if (allocator->realloc == NULL ||
+	    allocator->malloc == NULL ||
+	    allocator->free == NULL ||
+	    length == 0)
+		return false;
+
+	n_segments = (length + CK_SARRAY_SEGMENT - 1) / CK_SARRAY_SEGMENT;
+	if (n_segments == 0)
+		n_segments = 1;
+
+	array->active = ck_sarray_directory(allocator, n_segments);
+	if (array->active == NULL)
+		return false;
+
+	array->state = allocator->malloc(sizeof(struct _ck_sarray_segment) *
+	    n_segments);
+	if (array->state == NULL) {
+		ck_sarray_directory_free(allocator, array->active, false);
+		return false;
+	}
+
+	memset(array->state, 0, sizeof(struct _ck_sarray_segment) * n_segments);
+	array->allocator = allocator;
+	array->transaction = NULL;
+	array->n_entries = 0;
+	array->n_allocated = 0;
+	array->n_map = 0;
+	array->n_handles = 0;
+	array->free_handle = CK_SARRAY_HANDLE_NONE;
+	array->slots = NULL;
+	array->handles = NULL;
+	return true;
+}
+
+bool
+ck_sarray_put(struct ck_sarray *array, void *value, unsigned int *handle)
+{
+	unsigned int slot = array->n_entries;
+	unsigned int h;
+	void **target;
+
+	if (slot == array->n_allocated * CK_SARRAY_SEGMENT &&
+	    ck_sarray_grow(array) == false)
+		return false;
+
+	target = ck_sarray_slot(array, slot);
+	if (target == NULL)
+		return false;
+
+	ck_pr_store_ptr(target, value);
+
+	h = array->free_handle;
+	if (h != CK_SARRAY_HANDLE_NONE) {
+		array->free_handle = array->slots[h];
+	} else {
+		h = array->n_handles++;
+	}
+
+	array->slots[h] = slot;
+	array->handles[slot] = h;
+	array->n_entries = slot + 1;
+	*handle = h;
+	return true;
+}
+
+/*
+ * Free handles are chained through the slot map. A free handle never
+ * passes this check, since the slot it links to is owned by a live handle.
+ */
+static bool
+ck_sarray_valid(struct ck_sarray *array, unsigned int handle)
+{
+	unsigned int slot;
+
+	if (handle >= array->n_handles)
+		return false;
+
+	slot = array->slots[handle];
+	return slot < array->n_entries && array->handles[slot] == handle;
+}
+
+static void *
+ck_sarray_value(struct ck_sarray *array, unsigned int slot)
+{
+	struct _ck_sarray *target = ck_sarray_target(array);
+
+	return target->segments[slot / CK_SARRAY_SEGMENT][slot % CK_SARRAY_SEGMENT];
+}
+
+void *
+ck_sarray_get(struct ck_sarray *array, unsigned int handle)
+{
+
+	if (ck_sarray_valid(array, handle) == false)
+		return NULL;
+
+	return ck_sarray_value(array, array->slots[handle]);
+}
+
+bool
+ck_sarray_remove(struct ck_sarray *array, unsigned int handle)
+{
+	unsigned int slot, last, moved;
+	void **target;
+
+	if (ck_sarray_valid(array, handle) == false)
+		return false;
+
+	slot = array->slots[handle];
+	last = array->n_entries - 1;
+	if (slot != last) {
+		target = ck_sarray_slot(array, slot);
+		if (target == NULL)
+			return false;
+
+		ck_pr_store_ptr(target, ck_sarray_value(array, last));
+		moved = array->handles[last];
+		array->handles[slot] = moved;
+		array->slots[moved] = slot;
+	}
+
+	array->slots[handle] = array->free_handle;
+	array->free_handle = handle;
+	array->n_entries = last;
+	return true;
+}
+
+/*
+ * Raises the exposure of every segment covered by the snapshot being
+ * published. Exposure only grows, so the walk stops at the first segment
+ * that is already fully exposed; copied segments are handled by the caller.
+ */
+static void
+ck_sarray_expose(struct ck_sarray *array, unsigned int n_entries)
+{
+	struct _ck_sarray_segment *state;
+	unsigned int s, fill;
+
+	for (s = n_entries / CK_SARRAY_SEGMENT + 1; s-- > 0;) {
+		fill = n_entries - s * CK_SARRAY_SEGMENT;
+		if (fill > CK_SARRAY_SEGMENT)
+			fill = CK_SARRAY_SEGMENT;
+
+		if (s >= array->n_allocated)
+			continue;
+
+		state = &array->state[s];
+		if (state->exposed == CK_SARRAY_SEGMENT)
+			break;
+
+		if (state->exposed < fill)
+			state->exposed = fill;
+	}
+
+	return;
+}
+
+bool
+ck_sarray_commit(struct ck_sarray *array)
+{
+	struct _ck_sarray *previous = array->active;
+	struct _ck_sarray *transaction = array->transaction;
+	unsigned int i, n, fill;
+
+	ck_sarray_expose(array, array->n_entries);
+
+	if (transaction == NULL) {
+		ck_pr_fence_store();
+		ck_pr_store_uint(&previous->n_committed, array->n_entries);
+		return true;
+	}
+
+	transaction->n_committed = array->n_entries;
+	ck_pr_fence_store();
+	ck_pr_store_ptr(&array->active, transaction);
+	array->transaction = NULL;
+
+	/*
+	 * Only segments that existed in the previous snapshot can have been
+	 * copied, so the old versions of those are retired.
+	 */
+	n = previous->n_segments;
+	if (n > array->n_allocated)
+		n = array->n_allocated;
+
+	for (i = 0; i < n; i++) {
+		if (array->state[i].owned == 0)
+			continue;
+
+		array->allocator->free(previous->segments[i],
+		    CK_SARRAY_SEGMENT_SIZE, true);
+		array->state[i].owned = 0;
+
+		fill = 0;
+		if (array->n_entries > i * CK_SARRAY_SEGMENT)
+			fill = array->n_entries - i * CK_SARRAY_SEGMENT;
+
+		if (fill > CK_SARRAY_SEGMENT)
+			fill = CK_SARRAY_SEGMENT;
+
+		if (array->state[i].exposed < fill)
+			array->state[i].exposed = fill;
+	}
+
+	ck_sarray_directory_free(array->allocator, previous, true);
+	return true;
+}
+
+void
+ck_sarray_deinit(struct ck_sarray *array, bool defer)
+{
+	struct ck_malloc *allocator = array->allocator;
+	struct _ck_sarray *target = ck_sarray_target(array);
+	unsigned int i;
+
+	for (i = 0; i < array->n_allocated; i++) {
+		allocator->free(target->segments[i], CK_SARRAY_SEGMENT_SIZE, defer);
+
+		if (array->state[i].owned != 0) {
+			allocator->free(array->active->segments[i],
+			    CK_SARRAY_SEGMENT_SIZE, defer);
+		}
+	}
+
+	allocator->free(array->state,
+	    sizeof(struct _ck_sarray_segment) * target->n_segments, false);
+	allocator->free(array->slots, sizeof(unsigned int) * array->n_map, false);
+	allocator->free(array->handles, sizeof(unsigned int) * array->n_map, false);
+
+	if (array->transaction != NULL)
+		ck_sarray_directory_free(allocator, array->transaction, defer);
+
+	ck_sarray_directory_free(allocator, array->active, defer);
+	array->active = NULL;
+	array->transaction = NULL;
+	return;
+}
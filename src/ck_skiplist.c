@@ -0,0 +1,550 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_skiplist.h>
+#include <ck_stdbool.h>
+#include <ck_stdint.h>
+
+/*
+ * In MPMC mode, a node is deleted by setting the low bit of every pointer
+ * in its tower, from the top down. The writer that marks the bottom level
+ * owns the removal. Any writer that meets a marked node during a search
+ * unlinks it at that level.
+ *
+ * A node may be linked at an upper level by its inserter after the
+ * remover has finished unlinking it, so a node carries two references:
+ * one for its inserter and one for its presence in the set. Whoever drops
+ * the last reference searches for the node once more, which unlinks it
+ * from every level, before releasing it.
+ */
+#define CK_SKIPLIST_MARK ((uintptr_t)1)
+
+CK_CC_INLINE static struct ck_skiplist_node *
+ck_skiplist_unmark(const struct ck_skiplist_node *node)
+{
+
+	return (struct ck_skiplist_node *)((uintptr_t)node & ~CK_SKIPLIST_MARK);
+}
+
+CK_CC_INLINE static struct ck_skiplist_node *
+ck_skiplist_mark(const struct ck_skiplist_node *node)
+{
+
+	return (struct ck_skiplist_node *)((uintptr_t)node | CK_SKIPLIST_MARK);
+}
+
+CK_CC_INLINE static bool
+ck_skiplist_marked(const struct ck_skiplist_node *node)
+{
+
+	return ((uintptr_t)node & CK_SKIPLIST_MARK) != 0;
+}
+
+CK_CC_INLINE static size_t
+ck_skiplist_node_size(unsigned int height)
+{
+
+	return sizeof(struct ck_skiplist_node) +
+	    sizeof(struct ck_skiplist_node *) * height;
+}
+
+static struct ck_skiplist_node *
+ck_skiplist_node_create(struct ck_skiplist *sl,
+    const void *entry,
+    unsigned int height)
+{
+	struct ck_skiplist_node *node;
+
+	node = sl->m->malloc(ck_skiplist_node_size(height));
+	if (node == NULL)
+		return NULL;
+
+	node->entry = entry;
+	node->height = height;
+	node->references = 2;
+	return node;
+}
+
+static void
+ck_skiplist_node_destroy(struct ck_skiplist *sl,
+    struct ck_skiplist_node *node,
+    bool defer)
+{
+
+	sl->m->free(node, ck_skiplist_node_size(node->height), defer);
+	return;
+}
+
+/*
+ * Heights are derived from a seeded sequence number rather than a shared
+ * generator state, so concurrent writers only need to agree on the
+ * sequence. Every level is kept with a probability of one in four.
+ */
+static unsigned int
+ck_skiplist_height(struct ck_skiplist *sl)
+{
+	unsigned int sequence, height = 1;
+	uint64_t x;
+
+	if (sl->mode == CK_SKIPLIST_MODE_MPMC) {
+		sequence = ck_pr_faa_uint(&sl->sequence, 1);
+	} else {
+		sequence = sl->sequence++;
+	}
+
+	x = (uint64_t)sl->seed + (uint64_t)sequence * 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+
+	while ((x & 3) == 0 && height < CK_SKIPLIST_HEIGHT) {
+		height++;
+		x >>= 2;
+	}
+
+	return height;
+}
+
+/*
+ * Readers begin their search at the tallest level in use. The hint only
+ * ever grows, and a reader that observes a stale value merely skips
+ * levels that were linked after it started.
+ */
+static void
+ck_skiplist_raise(struct ck_skiplist *sl, unsigned int height)
+{
+	unsigned int current = ck_pr_load_uint(&sl->height);
+
+	while (current < height) {
+		if (sl->mode == CK_SKIPLIST_MODE_SPMC) {
+			ck_pr_store_uint(&sl->height, height);
+			break;
+		}
+
+		if (ck_pr_cas_uint_value(&sl->height, current, height,
+		    &current) == true)
+			break;
+	}
+
+	return;
+}
+
+/*
+ * Records the last node ordered before key and the first node ordered at
+ * or after key at every level. Marked nodes met along the way are
+ * unlinked. Returns true if an unmarked node matching key was found.
+ */
+static bool
+ck_skiplist_find(struct ck_skiplist *sl,
+    const void *key,
+    struct ck_skiplist_node **predecessors,
+    struct ck_skiplist_node **successors)
+{
+	struct ck_skiplist_node *predecessor, *current, *next, *stop;
+	unsigned int level;
+
+retry:
+	predecessor = sl->head;
+	current = stop = NULL;
+
+	for (level = CK_SKIPLIST_HEIGHT; level-- > 0;) {
+		current = ck_skiplist_unmark(
+		    ck_pr_load_ptr(&predecessor->next[level]));
+
+		while (current != NULL) {
+			next = ck_pr_load_ptr(&current->next[level]);
+			if (ck_skiplist_marked(next) == true) {
+				if (ck_pr_cas_ptr(&predecessor->next[level],
+				    current, ck_skiplist_unmark(next)) == false)
+					goto retry;
+
+				current = ck_skiplist_unmark(next);
+				continue;
+			}
+
+			if (current == stop ||
+			    sl->compare(current->entry, key) >= 0)
+				break;
+
+			predecessor = current;
+			current = next;
+		}
+
+		predecessors[level] = predecessor;
+		successors[level] = current;
+		stop = current;
+	}
+
+	return current != NULL && sl->compare(current->entry, key) == 0;
+}
+
+/*
+ * Drops a reference to a node in MPMC mode, releasing the node if it was
+ * the last.
+ */
+static void
+ck_skiplist_release(struct ck_skiplist *sl, struct ck_skiplist_node *node)
+{
+	struct ck_skiplist_node *predecessors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *successors[CK_SKIPLIST_HEIGHT];
+
+	ck_pr_fence_atomic();
+	if (ck_pr_faa_uint(&node->references, (unsigned int)-1) != 1)
+		return;
+
+	ck_pr_fence_memory();
+	ck_skiplist_find(sl, node->entry, predecessors, successors);
+	ck_skiplist_node_destroy(sl, node, true);
+	return;
+}
+
+static bool
+ck_skiplist_put_spmc(struct ck_skiplist *sl, const void *entry)
+{
+	struct ck_skiplist_node *predecessors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *successors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *node;
+	unsigned int height, i;
+
+	if (ck_skiplist_find(sl, entry, predecessors, successors) == true)
+		return false;
+
+	height = ck_skiplist_height(sl);
+	node = ck_skiplist_node_create(sl, entry, height);
+	if (node == NULL)
+		return false;
+
+	for (i = 0; i < height; i++)
+		node->next[i] = successors[i];
+
+	ck_skiplist_raise(sl, height);
+
+	/* Link from the bottom up, so the node is in the set once reachable. */
+	for (i = 0; i < height; i++)
+		ck_pr_store_release_ptr(&predecessors[i]->next[i], node);
+
+	ck_pr_store_uint(&sl->n_entries, sl->n_entries + 1);
+	return true;
+}
+
+static bool
+ck_skiplist_put_mpmc(struct ck_skiplist *sl, const void *entry)
+{
+	struct ck_skiplist_node *predecessors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *successors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *node, *next;
+	unsigned int height, i;
+
+	height = ck_skiplist_height(sl);
+	node = ck_skiplist_node_create(sl, entry, height);
+	if (node == NULL)
+		return false;
+
+	ck_skiplist_raise(sl, height);
+
+	for (;;) {
+		if (ck_skiplist_find(sl, entry, predecessors, successors) == true) {
+			ck_skiplist_node_destroy(sl, node, false);
+			return false;
+		}
+
+		for (i = 0; i < height; i++)
+			node->next[i] = successors[i];
+
+		ck_pr_fence_store_atomic();
+		if (ck_pr_cas_ptr(&predecessors[0]->next[0],
+		    successors[0], node) == true)
+			break;
+	}
+
+	ck_pr_inc_uint(&sl->n_entries);
+
+	/*
+	 * The node is now in the set. Upper levels are linked on a best-effort
+	 * basis and abandoned as soon as the node is marked for removal.
+	 */
+	for (i = 1; i < height; i++) {
+		for (;;) {
+			next = ck_pr_load_ptr(&node->next[i]);
+			if (ck_skiplist_marked(next) == true)
+				goto leave;
+
+			if (next != successors[i] &&
+			    ck_pr_cas_ptr(&node->next[i], next,
+			    successors[i]) == false)
+				goto leave;
+
+			ck_pr_fence_atomic();
+			if (ck_pr_cas_ptr(&predecessors[i]->next[i],
+			    successors[i], node) == true)
+				break;
+
+			ck_skiplist_find(sl, entry, predecessors, successors);
+			if (successors[0] != node)
+				goto leave;
+		}
+	}
+
+leave:
+	ck_skiplist_release(sl, node);
+	return true;
+}
+
+bool
+ck_skiplist_put(struct ck_skiplist *sl, const void *entry)
+{
+
+	if (sl->mode == CK_SKIPLIST_MODE_MPMC)
+		return ck_skiplist_put_mpmc(sl, entry);
+
+	return ck_skiplist_put_spmc(sl, entry);
+}
+
+static void *
+ck_skiplist_remove_spmc(struct ck_skiplist *sl, const void *key)
+{
+	struct ck_skiplist_node *predecessors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *successors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *node;
+	const void *entry;
+	unsigned int i;
+
+	if (ck_skiplist_find(sl, key, predecessors, successors) == false)
+		return NULL;
+
+	/* Unlink from the top down, so the node leaves the set last. */
+	node = successors[0];
+	for (i = node->height; i-- > 0;)
+		ck_pr_store_release_ptr(&predecessors[i]->next[i], node->next[i]);
+
+	entry = node->entry;
+	ck_pr_store_uint(&sl->n_entries, sl->n_entries - 1);
+	ck_skiplist_node_destroy(sl, node, true);
+	return CK_CC_DECONST_PTR(entry);
+}
+
+static void *
+ck_skiplist_remove_mpmc(struct ck_skiplist *sl, const void *key)
+{
+	struct ck_skiplist_node *predecessors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *successors[CK_SKIPLIST_HEIGHT];
+	struct ck_skiplist_node *node, *next;
+	const void *entry;
+	unsigned int i;
+
+	if (ck_skiplist_find(sl, key, predecessors, successors) == false)
+		return NULL;
+
+	node = successors[0];
+	for (i = node->height; i-- > 1;) {
+		do {
+			next = ck_pr_load_ptr(&node->next[i]);
+			if (ck_skiplist_marked(next) == true)
+				break;
+		} while (ck_pr_cas_ptr(&node->next[i], next,
+		    ck_skiplist_mark(next)) == false);
+	}
+
+	/* Only one writer may mark the bottom level. */
+	ck_pr_fence_atomic();
+	do {
+		next = ck_pr_load_ptr(&node->next[0]);
+		if (ck_skiplist_marked(next) == true)
+			return NULL;
+	} while (ck_pr_cas_ptr(&node->next[0], next,
+	    ck_skiplist_mark(next)) == false);
+
+	entry = node->entry;
+	ck_pr_dec_uint(&sl->n_entries);
+	ck_skiplist_release(sl, node);
+	return CK_CC_DECONST_PTR(entry);
+}
+
+void *
+ck_skiplist_remove(struct ck_skiplist *sl, const void *key)
+{
+
+	if (sl->mode == CK_SKIPLIST_MODE_MPMC)
+		return ck_skiplist_remove_mpmc(sl, key);
+
+	return ck_skiplist_remove_spmc(sl, key);
+}
+
+/*
+ * Returns the first node at or after node that is not logically deleted.
+ */
+static struct ck_skiplist_node *
+ck_skiplist_live(struct ck_skiplist_node *node)
+{
+	struct ck_skiplist_node *next;
+
+	while (node != NULL) {
+		next = ck_pr_load_ptr(&node->next[0]);
+		if (ck_skiplist_marked(next) == false)
+			break;
+
+		node = ck_skiplist_unmark(next);
+	}
+
+	return node;
+}
+
+/*
+ * Returns the first live node ordered at or after key. Readers never
+ * unlink marked nodes, they step over them.
+ */
+static struct ck_skiplist_node *
+ck_skiplist_lower(struct ck_skiplist *sl, const void *key)
+{
+	struct ck_skiplist_node *predecessor = sl->head;
+	struct ck_skiplist_node *current = NULL, *stop = NULL;
+	unsigned int level = ck_pr_load_uint(&sl->height);
+
+	while (level-- > 0) {
+		current = ck_skiplist_unmark(
+		    ck_pr_load_ptr(&predecessor->next[level]));
+
+		while (current != NULL && current != stop &&
+		    sl->compare(current->entry, key) < 0) {
+			predecessor = current;
+			current = ck_skiplist_unmark(
+			    ck_pr_load_ptr(&current->next[level]));
+		}
+
+		stop = current;
+	}
+
+	return ck_skiplist_live(current);
+}
+
+void *
+ck_skiplist_get(struct ck_skiplist *sl, const void *key)
+{
+	struct ck_skiplist_node *node;
+
+	node = ck_skiplist_lower(sl, key);
+	if (node == NULL || sl->compare(node->entry, key) != 0)
+		return NULL;
+
+	return CK_CC_DECONST_PTR(node->entry);
+}
+
+unsigned int
+ck_skiplist_count(struct ck_skiplist *sl)
+{
+
+	return ck_pr_load_uint(&sl->n_entries);
+}
+
+void
+ck_skiplist_iterator_init(struct ck_skiplist *sl,
+    struct ck_skiplist_iterator *iterator)
+{
+
+	iterator->cursor = ck_skiplist_live(ck_skiplist_unmark(
+	    ck_pr_load_ptr(&sl->head->next[0])));
+	return;
+}
+
+void
+ck_skiplist_lower_bound(struct ck_skiplist *sl,
+    struct ck_skiplist_iterator *iterator,
+    const void *key)
+{
+
+	iterator->cursor = ck_skiplist_lower(sl, key);
+	return;
+}
+
+bool
+ck_skiplist_next(struct ck_skiplist *sl,
+    struct ck_skiplist_iterator *iterator,
+    void **entry)
+{
+	struct ck_skiplist_node *node = iterator->cursor;
+
+	(void)sl;
+
+	if (node == NULL)
+		return false;
+
+	*entry = CK_CC_DECONST_PTR(node->entry);
+	iterator->cursor = ck_skiplist_live(ck_skiplist_unmark(
+	    ck_pr_load_ptr(&node->next[0])));
+	return true;
+}
+
+void
+ck_skiplist_destroy(struct ck_skiplist *sl)
+{
+	struct ck_skiplist_node *node, *next;
+
+	node = ck_skiplist_unmark(sl->head->next[0]);
+	while (node != NULL) {
+		next = ck_skiplist_unmark(node->next[0]);
+		ck_skiplist_node_destroy(sl, node, false);
+		node = next;
+	}
+
+	ck_skiplist_node_destroy(sl, sl->head, false);
+	sl->head = NULL;
+	return;
+}
+
+bool
+ck_skiplist_init(struct ck_skiplist *sl,
+    unsigned int mode,
+    ck_skiplist_compare_cb_t *compare,
+    struct ck_malloc *m,
+    unsigned long seed)
+{
+	unsigned int i;
+
+	if (m == NULL || m->malloc == NULL || m->free == NULL ||
+	    compare == NULL || mode > CK_SKIPLIST_MODE_MPMC)
+		return false;
+
+	sl->head = m->malloc(ck_skiplist_node_size(CK_SKIPLIST_HEIGHT));
+	if (sl->head == NULL)
+		return false;
+
+	sl->head->entry = NULL;
+	sl->head->height = CK_SKIPLIST_HEIGHT;
+	sl->head->references = 1;
+	for (i = 0; i < CK_SKIPLIST_HEIGHT; i++)
+		sl->head->next[i] = NULL;
+
+	sl->m = m;
+	sl->compare = compare;
+	sl->mode = mode;
+	sl->height = 1;
+	sl->n_entries = 0;
+	sl->sequence = 0;
+	sl->seed = seed;
+	return true;
+}
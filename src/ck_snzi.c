@@ -0,0 +1,236 @@
+/*
+ * Copyright 2026 Samy Al Bahra.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <ck_cc.h>
+#include <ck_pr.h>
+#include <ck_snzi.h>
+#include <ck_stdbool.h>
+#include <ck_stddef.h>
+#include <ck_stdint.h>
+
+#ifdef CK_F_SNZI
+
+static void ck_snzi_node_arrive(struct ck_snzi *, struct ck_snzi_node *);
+static void ck_snzi_node_depart(struct ck_snzi *, struct ck_snzi_node *);
+
+static void
+ck_snzi_root_arrive(struct ck_snzi *snzi)
+{
+	uint64_t i, x, y;
+
+	do {
+		x = ck_pr_load_64(&snzi->root);
+		if (CK_SNZI_ROOT_COUNT(x) == 0) {
+			y = CK_SNZI_STATE(CK_SNZI_ROOT_ANNOUNCE | 1,
+			    CK_SNZI_VERSION(x) + 1);
+		} else {
+			y = x + 1;
+		}
+	} while (ck_pr_cas_64(&snzi->root, x, y) == false);
+
+	if ((y & CK_SNZI_ROOT_ANNOUNCE) == 0)
+		return;
+
+	/*
+	 * Publish the indicator. Bumping the version invalidates any
+	 * departure that observed the indicator before this arrival.
+	 */
+	do {
+		i = ck_pr_load_64(&snzi->indicator);
+	} while (ck_pr_cas_64(&snzi->indicator, i,
+	    (i | CK_SNZI_INDICATOR) + 2) == false);
+
+	ck_pr_fence_atomic();
+	ck_pr_cas_64(&snzi->root, y, y & ~CK_SNZI_ROOT_ANNOUNCE);
+	return;
+}
+
+static void
+ck_snzi_root_depart(struct ck_snzi *snzi)
+{
+	uint64_t i, x, y;
+
+	do {
+		x = ck_pr_load_64(&snzi->root);
+		y = CK_SNZI_STATE(CK_SNZI_ROOT_COUNT(x) - 1,
+		    CK_SNZI_VERSION(x));
+	} while (ck_pr_cas_64(&snzi->root, x, y) == false);
+
+	if (CK_SNZI_ROOT_COUNT(x) > 1)
+		return;
+
+	/*
+	 * This was the last departure. Clear the indicator, unless a new
+	 * arrival (which bumps the root version) has since raced with us,
+	 * in which case it owns the indicator.
+	 */
+	ck_pr_fence_atomic_load();
+	for (;;) {
+		i = ck_pr_load_64(&snzi->indicator);
+		ck_pr_fence_load();
+		if (CK_SNZI_VERSION(ck_pr_load_64(&snzi->root)) !=
+		    CK_SNZI_VERSION(x))
+			break;
+
+		if (ck_pr_cas_64(&snzi->indicator, i,
+		    (i & ~CK_SNZI_INDICATOR) + 2) == true)
+			break;
+	}
+
+	return;
+}
+
+CK_CC_INLINE static void
+ck_snzi_parent_arrive(struct ck_snzi *snzi, struct ck_snzi_node *node)
+{
+
+	if (node->parent == NULL) {
+		ck_snzi_root_arrive(snzi);
+	} else {
+		ck_snzi_node_arrive(snzi, node->parent);
+	}
+
+	return;
+}
+
+CK_CC_INLINE static void
+ck_snzi_parent_depart(struct ck_snzi *snzi, struct ck_snzi_node *node)
+{
+
+	if (node->parent == NULL) {
+		ck_snzi_root_depart(snzi);
+	} else {
+		ck_snzi_node_depart(snzi, node->parent);
+	}
+
+	return;
+}
+
+static void
+ck_snzi_node_arrive(struct ck_snzi *snzi, struct ck_snzi_node *node)
+{
+	unsigned int undo = 0;
+	bool success = false;
+	uint64_t x, y;
+
+	while (success == false) {
+		x = ck_pr_load_64(&node->state);
+		if (CK_SNZI_COUNT(x) >= CK_SNZI_ONE &&
+		    ck_pr_cas_64(&node->state, x, x + CK_SNZI_ONE) == true)
+			break;
+
+		if (CK_SNZI_COUNT(x) == 0) {
+			y = CK_SNZI_STATE(CK_SNZI_HALF, CK_SNZI_VERSION(x) + 1);
+			if (ck_pr_cas_64(&node->state, x, y) == true) {
+				success = true;
+				x = y;
+			}
+		}
+
+		/*
+		 * A 0 to 1 transition is in progress. Any arriving thread
+		 * helps by arriving at the parent on its behalf; all but
+		 * one of these parent arrivals are undone below.
+		 */
+		if (CK_SNZI_COUNT(x) == CK_SNZI_HALF) {
+			ck_snzi_parent_arrive(snzi, node);
+			ck_pr_fence_atomic();
+			y = CK_SNZI_STATE(CK_SNZI_ONE, CK_SNZI_VERSION(x));
+			if (ck_pr_cas_64(&node->state, x, y) == false)
+				undo++;
+		}
+	}
+
+	while (undo-- > 0)
+		ck_snzi_parent_depart(snzi, node);
+
+	return;
+}
+
+static void
+ck_snzi_node_depart(struct ck_snzi *snzi, struct ck_snzi_node *node)
+{
+	uint64_t x;
+
+	do {
+		x = ck_pr_load_64(&node->state);
+	} while (ck_pr_cas_64(&node->state, x, x - CK_SNZI_ONE) == false);
+
+	if (CK_SNZI_COUNT(x) == CK_SNZI_ONE) {
+		ck_pr_fence_atomic();
+		ck_snzi_parent_depart(snzi, node);
+	}
+
+	return;
+}
+
+void
+ck_snzi_arrive_slow(struct ck_snzi *snzi, struct ck_snzi_node *leaf)
+{
+
+	ck_snzi_node_arrive(snzi, leaf);
+	return;
+}
+
+void
+ck_snzi_depart_slow(struct ck_snzi *snzi, struct ck_snzi_node *leaf)
+{
+
+	ck_snzi_node_depart(snzi, leaf);
+	return;
+}
+
+void
+ck_snzi_init(struct ck_snzi *snzi, struct ck_snzi_node *nodes,
+    unsigned int n_leaves, unsigned int fanout)
+{
+	struct ck_snzi_node *level = nodes;
+	struct ck_snzi_node *next;
+	unsigned int i, n = n_leaves;
+
+	for (;;) {
+		next = level + n;
+		for (i = 0; i < n; i++) {
+			level[i].state = 0;
+			level[i].parent = (n <= fanout) ? NULL : next + i / fanout;
+		}
+
+		if (n <= fanout)
+			break;
+
+		level = next;
+		n = (n + fanout - 1) / fanout;
+	}
+
+	snzi->root = 0;
+	snzi->indicator = 0;
+	snzi->leaves = nodes;
+	snzi->n_leaves = n_leaves;
+	ck_pr_barrier();
+	return;
+}
+
+#endif /* CK_F_SNZI */